@@ -1,13 +1,21 @@
 #include <SDL3/SDL.h>
 #include <memory>
+#include <vector>
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <Lucky/BatchRenderer.hpp>
 #include <Lucky/Camera.hpp>
+#include <Lucky/DynamicResolution.hpp>
 #include <Lucky/ForwardRenderer.hpp>
+#include <Lucky/FrameSnapshot.hpp>
 #include <Lucky/GraphicsDevice.hpp>
 #include <Lucky/Mesh.hpp>
+#include <Lucky/OcclusionCuller.hpp>
+#include <Lucky/RetainedScene.hpp>
 #include <Lucky/Scene3D.hpp>
+#include <Lucky/SimulationThread.hpp>
+#include <Lucky/ThreadPool.hpp>
 
 #include "../DemoBase.hpp"
 #include "../DemoRegistry.hpp"
@@ -21,7 +29,9 @@ namespace {
 // asset dependency.
 class Demo3D : public LuckyDemos::DemoBase {
   public:
-    explicit Demo3D(SDL_Window *window) : graphicsDevice(window), forwardRenderer(graphicsDevice) {
+    explicit Demo3D(SDL_Window *window)
+        : graphicsDevice(window), forwardRenderer(graphicsDevice),
+          batchRenderer(graphicsDevice, 64), dynamicResolution(graphicsDevice) {
         graphicsDevice.SetClearColor({0.08f, 0.10f, 0.13f, 1.0f});
         graphicsDevice.SetDepthEnabled(true);
 
@@ -35,6 +45,7 @@ class Demo3D : public LuckyDemos::DemoBase {
         // light right at the base.
         slabMesh = std::make_unique<Lucky::Mesh>(
             graphicsDevice, Lucky::MakeBoxMeshData(0.08f, 1.5f, 1.5f));
+        slabOccluder = Lucky::MakeOccluderMesh(Lucky::MakeBoxMeshData(0.06f, 1.45f, 1.45f));
 
         camera.position = {4.0f, 3.0f, 5.0f};
         camera.fovY = glm::radians(60.0f);
@@ -44,7 +55,7 @@ class Demo3D : public LuckyDemos::DemoBase {
         camera.yaw = std::atan2(-toOrigin.x, -toOrigin.z);
         camera.pitch = std::asin(glm::clamp(toOrigin.y, -1.0f, 1.0f));
 
-        scene.ambientColor = {0.10f, 0.11f, 0.13f};
+        scene.SetAmbientColor({0.10f, 0.11f, 0.13f});
 
         Lucky::Light sun;
         sun.type = Lucky::LightType::Directional;
@@ -55,7 +66,8 @@ class Demo3D : public LuckyDemos::DemoBase {
         sun.color = {1.0f, 0.95f, 0.85f};
         sun.intensity = 1.0f;
         sun.castsShadows = true;
-        scene.lights.push_back(sun);
+        sun.isStatic = true;
+        scene.GetLights().push_back(sun);
 
         Lucky::Light fill;
         fill.type = Lucky::LightType::Point;
@@ -63,45 +75,21 @@ class Demo3D : public LuckyDemos::DemoBase {
         fill.color = {0.4f, 0.6f, 1.0f};
         fill.intensity = 3.0f;
         fill.range = 6.0f;
-        scene.lights.push_back(fill);
-    }
-
-    void HandleEvent(const SDL_Event &event) override {
-        if (event.type != SDL_EVENT_KEY_DOWN || event.key.repeat) {
-            return;
-        }
-        switch (event.key.key) {
-        case SDLK_ESCAPE:
-            RequestExit();
-            break;
-        case SDLK_PAGEDOWN:
-            RequestNextDemo();
-            break;
-        case SDLK_PAGEUP:
-            RequestPrevDemo();
-            break;
-        }
-    }
-
-    void Update(float deltaSeconds) override {
-        diamondRotation += deltaSeconds * 0.6f;
-
-        scene.objects.clear();
+        scene.GetLights().push_back(fill);
 
+        // The scene is retained: objects are added once, and only the
+        // diamond is touched per frame.
         Lucky::SceneObject ground;
         ground.mesh = planeMesh.get();
         ground.transform = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -0.5f, 0.0f));
         ground.color = glm::vec3(0.6f, 0.6f, 0.65f);
-        scene.objects.push_back(ground);
+        ground.isStatic = true;
+        scene.AddObject(ground);
 
         Lucky::SceneObject diamond;
         diamond.mesh = diamondMesh.get();
-        const glm::mat4 t = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 1.2f, 0.0f));
-        const glm::mat4 r =
-            glm::rotate(glm::mat4(1.0f), diamondRotation, glm::vec3(0.0f, 1.0f, 0.0f));
-        diamond.transform = t * r;
         diamond.color = glm::vec3(0.85f, 0.45f, 0.30f);
-        scene.objects.push_back(diamond);
+        diamondHandle = scene.AddObject(diamond);
 
         // Two slabs on either side of the diamond, with their bottom
         // edges touching the ground (slab half-height = 0.75, ground at
@@ -111,7 +99,8 @@ class Demo3D : public LuckyDemos::DemoBase {
         slabLeft.mesh = slabMesh.get();
         slabLeft.transform = glm::translate(glm::mat4(1.0f), glm::vec3(-2.5f, 0.25f, 0.0f));
         slabLeft.color = glm::vec3(0.7f, 0.7f, 0.75f);
-        scene.objects.push_back(slabLeft);
+        slabLeft.occluder = &slabOccluder;
+        scene.AddObject(slabLeft);
 
         Lucky::SceneObject slabRight;
         slabRight.mesh = slabMesh.get();
@@ -120,7 +109,74 @@ class Demo3D : public LuckyDemos::DemoBase {
                 glm::radians(45.0f),
                 glm::vec3(0.0f, 1.0f, 0.0f));
         slabRight.color = glm::vec3(0.7f, 0.7f, 0.75f);
-        scene.objects.push_back(slabRight);
+        slabRight.occluder = &slabOccluder;
+        scene.AddObject(slabRight);
+    }
+
+    void HandleEvent(const SDL_Event &event) override {
+        if (event.type != SDL_EVENT_KEY_DOWN || event.key.repeat) {
+            return;
+        }
+        switch (event.key.key) {
+        case SDLK_ESCAPE:
+            RequestExit();
+            break;
+        case SDLK_PAGEDOWN:
+            RequestNextDemo();
+            break;
+        case SDLK_PAGEUP:
+            RequestPrevDemo();
+            break;
+        case SDLK_P:
+            // Toggle the depth pre-pass to compare frame times with and
+            // without it.
+            renderOptions.depthPrePass = !renderOptions.depthPrePass;
+            break;
+        case SDLK_T:
+            // Toggle multi-threaded recording the same way.
+            renderOptions.threadPool = renderOptions.threadPool ? nullptr : &threadPool;
+            break;
+        case SDLK_O:
+            // Toggle CPU occlusion culling behind the slabs.
+            renderOptions.occlusionCulling = !renderOptions.occlusionCulling;
+            break;
+        case SDLK_G:
+            // Toggle GPU culling with indirect draws.
+            renderOptions.gpuCulling = !renderOptions.gpuCulling;
+            break;
+        case SDLK_V:
+            // Split the screen with a second, overhead camera.
+            splitScreen = !splitScreen;
+            break;
+        case SDLK_D:
+            // Render the scene at a scale that holds 60 fps, stretched
+            // over the screen.
+            useDynamicResolution = !useDynamicResolution;
+            break;
+        case SDLK_R:
+            // Move the simulation onto its own thread, drawing snapshots
+            // of the frame before while it computes the next one.
+            if (simulationThread) {
+                simulationThread.reset();
+            } else {
+                simulationThread = std::make_unique<Lucky::SimulationThread>(
+                    [this](float deltaSeconds, Lucky::FrameSnapshot &snapshot) {
+                        Simulate(deltaSeconds);
+                        snapshot.Clear();
+                        snapshot.CaptureScene(scene.GetScene());
+                    });
+            }
+            break;
+        }
+    }
+
+    void Update(float deltaSeconds) override {
+        dynamicResolution.Update(deltaSeconds);
+        if (simulationThread) {
+            simulationThread->Step(deltaSeconds);
+        } else {
+            Simulate(deltaSeconds);
+        }
     }
 
     void Draw() override {
@@ -128,21 +184,84 @@ class Demo3D : public LuckyDemos::DemoBase {
         if (!graphicsDevice.GetCommandBuffer()) {
             return;
         }
-        forwardRenderer.Render(scene, camera);
+        const Lucky::Rectangle area =
+            useDynamicResolution
+                ? dynamicResolution.Begin()
+                : Lucky::Rectangle(
+                      0, 0, graphicsDevice.GetScreenWidth(), graphicsDevice.GetScreenHeight());
+        if (simulationThread) {
+            // The retained scene belongs to the simulation thread now.
+            // Its changes are left uncleared so the retained path picks
+            // them all up once threading is switched off again.
+            if (const Lucky::FrameSnapshot *snapshot = simulationThread->GetRenderSnapshot()) {
+                RenderScene(snapshot->scene, area);
+            }
+        } else {
+            RenderScene(scene, area);
+            scene.ClearChanges();
+        }
+        if (useDynamicResolution) {
+            dynamicResolution.End(batchRenderer);
+        }
         graphicsDevice.EndFrame();
     }
 
   private:
+    void Simulate(float deltaSeconds) {
+        diamondRotation += deltaSeconds * 0.6f;
+
+        const glm::mat4 t = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 1.2f, 0.0f));
+        const glm::mat4 r =
+            glm::rotate(glm::mat4(1.0f), diamondRotation, glm::vec3(0.0f, 1.0f, 0.0f));
+        scene.SetObjectTransform(diamondHandle, t * r);
+    }
+
+    // Takes either the retained scene or a snapshot's plain Scene3D, and
+    // draws it into `area` of the current target.
+    template <typename SceneType>
+    void RenderScene(const SceneType &sceneToRender, const Lucky::Rectangle &area) {
+        if (area.width <= 0 || area.height <= 0) {
+            return;
+        }
+        std::vector<Lucky::ForwardView> views(1);
+        views[0].camera = camera;
+        views[0].viewport = area;
+        if (splitScreen) {
+            const int half = area.width / 2;
+            views.resize(2);
+            views[0].viewport.width = half;
+            views[1].camera = camera;
+            views[1].camera.position = {0.0f, 9.0f, 0.5f};
+            views[1].camera.pitch = glm::radians(-85.0f);
+            views[1].camera.yaw = 0.0f;
+            views[1].viewport =
+                Lucky::Rectangle(area.x + half, area.y, area.width - half, area.height);
+        }
+        forwardRenderer.Render(sceneToRender, views, renderOptions);
+    }
+
+    Lucky::ThreadPool threadPool;
     Lucky::GraphicsDevice graphicsDevice;
     Lucky::ForwardRenderer forwardRenderer;
+    Lucky::BatchRenderer batchRenderer;
+    Lucky::DynamicResolution dynamicResolution;
 
     std::unique_ptr<Lucky::Mesh> diamondMesh;
     std::unique_ptr<Lucky::Mesh> planeMesh;
     std::unique_ptr<Lucky::Mesh> slabMesh;
+    Lucky::OccluderMesh slabOccluder;
 
     Lucky::Camera camera;
-    Lucky::Scene3D scene;
+    Lucky::RetainedScene scene;
+    Lucky::SceneObjectHandle diamondHandle;
+    Lucky::ForwardRenderOptions renderOptions;
+    bool splitScreen = false;
+    bool useDynamicResolution = false;
     float diamondRotation = 0.0f;
+
+    // Declared last so it is destroyed, and its thread joined, before
+    // the scene it simulates.
+    std::unique_ptr<Lucky::SimulationThread> simulationThread;
 };
 
 } // namespace
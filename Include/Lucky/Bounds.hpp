@@ -0,0 +1,111 @@
+#pragma once
+
+#include <limits>
+
+#include <glm/glm.hpp>
+
+namespace Lucky {
+
+/**
+ * An axis-aligned bounding box in 3D.
+ *
+ * `min` and `max` are the inclusive corners. A default-constructed box
+ * is empty (`min` at +infinity, `max` at -infinity) so it can be grown
+ * point by point with `ExpandBounds` without a special first case.
+ * Empty boxes never intersect anything.
+ */
+struct BoundingBox {
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+    /** Returns true if no point has been added to this box. */
+    bool IsEmpty() const {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    /** Returns the midpoint of the box. Undefined for an empty box. */
+    glm::vec3 GetCenter() const {
+        return (min + max) * 0.5f;
+    }
+
+    /** Returns the half-size of the box on each axis. Undefined for an empty box. */
+    glm::vec3 GetExtents() const {
+        return (max - min) * 0.5f;
+    }
+};
+
+/**
+ * Six clip planes describing a view volume.
+ *
+ * Each plane is stored as `(normal, distance)` with the normal pointing
+ * into the volume, so a point `p` is inside a plane when
+ * `dot(normal, p) + distance >= 0`. Build one with `MakeFrustum`.
+ */
+struct Frustum {
+    glm::vec4 planes[6];
+};
+
+/**
+ * Grows `box` to include `point`.
+ */
+void ExpandBounds(BoundingBox &box, const glm::vec3 &point);
+
+/**
+ * Returns the smallest box containing both `a` and `b`. Empty inputs
+ * are ignored, so merging with an empty box returns the other box.
+ */
+BoundingBox MergeBounds(const BoundingBox &a, const BoundingBox &b);
+
+/**
+ * Returns the axis-aligned box enclosing `box` after it has been
+ * transformed by the affine matrix `transform`.
+ *
+ * The result is conservative: rotating a box grows it to enclose the
+ * rotated corners. An empty box stays empty.
+ */
+BoundingBox TransformBounds(const BoundingBox &box, const glm::mat4 &transform);
+
+/**
+ * Extracts the six clip planes of a view-projection matrix.
+ *
+ * Assumes the zero-to-one clip depth convention used by the renderer's
+ * `*_ZO` projections. Planes are normalized so the signed distances
+ * they produce are in world units.
+ */
+Frustum MakeFrustum(const glm::mat4 &viewProjection);
+
+/**
+ * Tests whether `box` is at least partially inside `frustum`.
+ *
+ * Conservative: a box that straddles two planes outside a frustum
+ * corner may be reported as intersecting. That only costs a wasted
+ * draw, never a missing one.
+ */
+bool IntersectsFrustum(const BoundingBox &box, const Frustum &frustum);
+
+/**
+ * Tests whether the sphere at `center` with `radius` is at least
+ * partially inside `frustum`. Conservative in the same way as the box
+ * test, and relies on the planes being normalized as `MakeFrustum`
+ * leaves them.
+ */
+bool IntersectsFrustum(const glm::vec3 &center, float radius, const Frustum &frustum);
+
+/**
+ * Tests whether `box` overlaps the sphere at `center` with `radius`.
+ */
+bool IntersectsSphere(const BoundingBox &box, const glm::vec3 &center, float radius);
+
+/**
+ * Returns roughly how many pixels one world unit covers at the part of
+ * `box` nearest the viewer, for a view `viewportHeight` pixels tall.
+ *
+ * Works for perspective and orthographic projections. The estimate is
+ * taken at the box's nearest depth, so it errs towards more pixels; a
+ * box reaching the camera plane returns `FLT_MAX`. Used to pick levels
+ * of detail with `SelectMeshLod`.
+ */
+float ProjectedPixelsPerUnit(
+    const BoundingBox &box, const glm::mat4 &viewProjection, float viewportHeight);
+
+} // namespace Lucky
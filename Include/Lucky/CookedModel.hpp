@@ -0,0 +1,160 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Lucky/Mesh.hpp>
+#include <Lucky/MeshArena.hpp>
+#include <Lucky/Model.hpp>
+#include <Lucky/SkinnedMesh.hpp>
+
+namespace Lucky {
+
+struct MappedFile;
+
+/**
+ * Version written into, and required of, cooked model files. Bumped
+ * whenever the layout changes, including any change to `Vertex3D` or
+ * `Vertex3DSkinned`, whose bytes the file stores as-is.
+ */
+constexpr uint32_t CookedModelVersion = 3;
+
+/**
+ * A `Material` as a cooked model stores it: the factors, plus the index
+ * of each texture's image in the model's image table, or `-1` for none.
+ */
+struct CookedMaterial {
+    glm::vec4 baseColorFactor = {1.0f, 1.0f, 1.0f, 1.0f};
+    float metallicFactor = 0.0f;
+    float roughnessFactor = 0.5f;
+    glm::vec3 emissiveFactor = {0.0f, 0.0f, 0.0f};
+    float normalScale = 1.0f;
+    int baseColorImage = -1;
+    int metallicRoughnessImage = -1;
+    int emissiveImage = -1;
+    int normalImage = -1;
+};
+
+/**
+ * A decoded image: tightly packed 8-bit RGBA rows. A zero width marks an
+ * image that failed to load; materials referencing it get no texture.
+ */
+struct CookedImage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+/**
+ * Everything `Model` builds from a glTF file before it touches the GPU:
+ * optimized geometry, decoded images, and the material, node, skin and
+ * animation tables.
+ *
+ * `meshMaterials` and `skinnedMeshMaterials` run parallel to `meshes`
+ * and `skinnedMeshes`, with `-1` for a primitive with no material. Node
+ * mesh indices reference `meshes` and `skinnedMeshes` directly.
+ */
+struct CookedModelData {
+    std::vector<MeshData> meshes;
+    std::vector<int> meshMaterials;
+    std::vector<SkinnedMeshData> skinnedMeshes;
+    std::vector<int> skinnedMeshMaterials;
+    std::vector<CookedMaterial> materials;
+    std::vector<CookedImage> images;
+    std::vector<NodeTemplate> nodes;
+    std::vector<Skin> skins;
+    std::vector<AnimationDef> animations;
+};
+
+/**
+ * Writes `model` to `path` as a cooked model file.
+ *
+ * The file starts with a magic number and `CookedModelVersion`, then
+ * stores each vertex type's meshes as one arena (see `MeshArena`), with
+ * any levels of detail and meshlets, then the images and the remaining
+ * tables. Bulk data is 16-byte aligned so a reader can use it in place.
+ * Numbers are written in the host's byte order; cook on the platform
+ * that loads.
+ *
+ * \throws std::runtime_error if the file cannot be written.
+ */
+void WriteCookedModel(const CookedModelData &model, const std::string &path);
+
+/**
+ * Returns true if `path` starts with the cooked model magic number,
+ * whatever its version. Returns false if it cannot be read.
+ */
+bool IsCookedModelFile(const std::string &path);
+
+/**
+ * One vertex type's meshes inside a cooked file, laid out as a
+ * `MeshArena`. `vertices`, `indices` and `meshlets` point into the
+ * mapped file.
+ */
+template <typename VertexType> struct CookedMeshArena {
+    const VertexType *vertices = nullptr;
+    uint32_t vertexCount = 0;
+    const uint32_t *indices = nullptr;
+    uint32_t indexCount = 0;
+    const Meshlet *meshlets = nullptr;
+    uint32_t meshletCount = 0;
+    std::vector<MeshArenaRange> ranges;
+    std::vector<int> materials; // parallel to ranges; -1 = no material
+};
+
+/**
+ * A decoded image inside a cooked file. `pixels` points into the mapped
+ * file, and is null when `width` is zero.
+ */
+struct CookedImageView {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    const uint8_t *pixels = nullptr;
+};
+
+/**
+ * A cooked model file, memory-mapped and validated.
+ *
+ * Geometry and image pixels are left in the mapping, so uploading them
+ * reads straight from the page cache; the small tables are parsed into
+ * the public members, which a loader may move out of.
+ *
+ * # Lifetime
+ *
+ * The pointers in `meshes`, `skinnedMeshes` and `images` stay valid
+ * until the CookedModelFile is destroyed.
+ */
+struct CookedModelFile {
+    /**
+     * Maps and parses `path`.
+     *
+     * \throws std::runtime_error if the file cannot be mapped, is not a
+     *                            cooked model, has a different version,
+     *                            or is truncated or inconsistent.
+     */
+    explicit CookedModelFile(const std::string &path);
+
+    CookedModelFile(const CookedModelFile &) = delete;
+    CookedModelFile &operator=(const CookedModelFile &) = delete;
+    CookedModelFile(CookedModelFile &&) = delete;
+    CookedModelFile &operator=(CookedModelFile &&) = delete;
+
+    ~CookedModelFile();
+
+    CookedMeshArena<Vertex3D> meshes;
+    CookedMeshArena<Vertex3DSkinned> skinnedMeshes;
+    std::vector<CookedMaterial> materials;
+    std::vector<CookedImageView> images;
+    std::vector<NodeTemplate> nodes;
+    std::vector<Skin> skins;
+    std::vector<AnimationDef> animations;
+
+  private:
+    std::unique_ptr<MappedFile> file;
+};
+
+} // namespace Lucky
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+
+#include <Lucky/Rectangle.hpp>
+
+namespace Lucky {
+
+struct BatchRenderer;
+struct GraphicsDevice;
+struct Texture;
+
+/** Tuning for `DynamicResolutionController`. */
+struct DynamicResolutionSettings {
+    /** Frame time to hold, in seconds. */
+    float targetFrameSeconds = 1.0f / 60.0f;
+
+    /** Lowest and highest render scale, per axis, relative to the screen. */
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+
+    /** Scales are multiples of this, so small jitter can't change them. */
+    float scaleStep = 0.05f;
+
+    /**
+     * Frames longer than `targetFrameSeconds * overBudgetRatio` count as
+     * over budget, and a smoothed frame time at or below
+     * `targetFrameSeconds * underBudgetRatio` as under it. The default
+     * under-budget ratio sits just above one: with vsync, frame times
+     * settle at the refresh interval and never show any headroom, so a
+     * frame that hit the target has to count as having room to grow.
+     */
+    float overBudgetRatio = 1.1f;
+    float underBudgetRatio = 1.02f;
+
+    /** Consecutive over-budget frames before the scale drops. */
+    int framesToDecrease = 4;
+
+    /** Consecutive under-budget frames before the scale rises a step. */
+    int framesToIncrease = 60;
+};
+
+/**
+ * Picks a render scale from measured frame times so that a GPU-bound
+ * frame holds its target frame rate.
+ *
+ * # Behavior
+ *
+ * When several consecutive frames run over budget, the scale drops in
+ * one go by as much as the smoothed frame time calls for (pixel cost
+ * goes with the square of the scale); a lone hitch doesn't count. When
+ * the smoothed frame time stays under budget for much longer, the scale
+ * rises a single step. Every change restarts the measurements.
+ *
+ * Each rise is a probe: if it pushes the frame over budget, the scale
+ * drops back and the next probe waits twice as long, up to sixteen
+ * times `framesToIncrease`. A scale that holds for that long resets the
+ * wait. This keeps a frame that sits right at a scale boundary from
+ * oscillating between two resolutions.
+ *
+ * The controller only does arithmetic; `DynamicResolution` pairs it
+ * with the render targets.
+ */
+struct DynamicResolutionController {
+    explicit DynamicResolutionController(
+        const DynamicResolutionSettings &settings = DynamicResolutionSettings{});
+
+    /** Records the duration of the last frame, in seconds, and updates the scale. */
+    void Update(float frameSeconds);
+
+    /** Returns the render scale per axis, between the settings' min and max. */
+    float GetScale() const {
+        return scale;
+    }
+
+    /** Returns the smoothed frame time, in seconds. */
+    float GetSmoothedFrameSeconds() const {
+        return smoothedFrameSeconds;
+    }
+
+    const DynamicResolutionSettings &GetSettings() const {
+        return settings;
+    }
+
+  private:
+    void SetScale(float newScale);
+
+    DynamicResolutionSettings settings;
+    float scale;
+    float smoothedFrameSeconds = 0.0f;
+    bool hasSample = false;
+    int overBudgetFrames = 0;
+    int underBudgetFrames = 0;
+    int increaseDelay;
+    int framesSinceIncrease = -1;
+};
+
+/**
+ * Renders the 3D pass at a scale picked by a
+ * `DynamicResolutionController` and stretches it over the screen.
+ *
+ * # Usage
+ *
+ * Opt in by routing the scene pass through it. Feed it each frame's
+ * delta time, render into the viewport `Begin` returns, and upscale
+ * with `End` before drawing UI at full resolution:
+ *
+ *     dynamicResolution.Update(deltaSeconds);
+ *     graphicsDevice.BeginFrame();
+ *     ForwardView view;
+ *     view.camera = camera;
+ *     view.viewport = dynamicResolution.Begin();
+ *     forwardRenderer.Render(scene, {view}, options);
+ *     dynamicResolution.End(batchRenderer);
+ *     // ... UI ...
+ *     graphicsDevice.EndFrame();
+ *
+ * # Render targets
+ *
+ * `Begin` binds a color and depth target large enough for the screen at
+ * the maximum scale and sets a viewport covering only the scaled part,
+ * so changing the scale never reallocates anything; the targets are
+ * only recreated when the screen size changes. `End` unbinds them and
+ * draws the scaled region over the whole screen with bilinear
+ * filtering, replacing the swapchain's contents.
+ *
+ * # Lifetime
+ *
+ * Holds a pointer to the `GraphicsDevice`, which must outlive it.
+ */
+struct DynamicResolution {
+    explicit DynamicResolution(GraphicsDevice &graphicsDevice,
+        const DynamicResolutionSettings &settings = DynamicResolutionSettings{});
+    ~DynamicResolution();
+
+    DynamicResolution(const DynamicResolution &) = delete;
+    DynamicResolution &operator=(const DynamicResolution &) = delete;
+
+    /** Records the duration of the last frame, in seconds. */
+    void Update(float frameSeconds) {
+        controller.Update(frameSeconds);
+    }
+
+    /**
+     * Binds the scaled render targets and returns the viewport to render
+     * the scene into. Call after `GraphicsDevice::BeginFrame`, outside a
+     * render pass. Returns an empty rectangle, and binds nothing, while
+     * the screen has no area.
+     */
+    Rectangle Begin();
+
+    /**
+     * Unbinds the render targets and draws the rendered region over the
+     * whole screen with `batchRenderer`, which must not have a batch open.
+     */
+    void End(BatchRenderer &batchRenderer);
+
+    /** Returns the current render scale per axis. */
+    float GetScale() const {
+        return controller.GetScale();
+    }
+
+    const DynamicResolutionController &GetController() const {
+        return controller;
+    }
+
+  private:
+    GraphicsDevice *graphicsDevice;
+    DynamicResolutionController controller;
+    std::unique_ptr<Texture> colorTarget;
+    std::unique_ptr<Texture> depthTarget;
+    Rectangle renderViewport;
+    bool active = false;
+};
+
+} // namespace Lucky
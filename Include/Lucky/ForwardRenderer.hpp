@@ -2,18 +2,134 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include <SDL3/SDL_gpu.h>
 
+#include <Lucky/Camera.hpp>
+#include <Lucky/Rectangle.hpp>
+#include <Lucky/VertexCompression.hpp>
+
 namespace Lucky {
 
-struct Camera;
+struct ForwardCullData;
+struct ForwardIndirectBatch;
+struct ForwardMaterialData;
+struct ForwardObjectData;
+struct ForwardShadowLightState;
 struct GraphicsDevice;
 struct Material;
+struct RetainedScene;
+struct OcclusionCuller;
 struct Sampler;
 struct Scene3D;
 struct Shader;
+template <typename T> struct StorageBuffer;
 struct Texture;
+struct ThreadPool;
+
+/**
+ * Per-call switches for `ForwardRenderer::Render`.
+ *
+ * Defaults reproduce the plain single-pass forward render. Options are
+ * passed per call rather than stored on the renderer so the same frame
+ * can be rendered both ways when measuring their cost.
+ */
+struct ForwardRenderOptions {
+    /**
+     * Lay down scene depth with a depth-only pass before shading.
+     *
+     * The color pass then tests depth `EQUAL` with writes off, so the
+     * lighting shader runs once per visible pixel instead of once per
+     * covering fragment. Pays for a second geometry pass; worthwhile
+     * when overdraw is high (dense interiors, foliage) and shading is
+     * the bottleneck, a loss for sparse scenes.
+     */
+    bool depthPrePass = false;
+
+    /**
+     * Spread per-frame CPU work across this pool. Null renders on the
+     * calling thread alone.
+     *
+     * See "Threading" on `ForwardRenderer`. The pool must not be
+     * running other work that calls into the same `GraphicsDevice`.
+     */
+    ThreadPool *threadPool = nullptr;
+
+    /**
+     * Skip objects hidden behind `SceneObject::occluder` geometry.
+     *
+     * Each view rasterizes the occluders it can see into a small CPU
+     * depth buffer (see `OcclusionCuller`) and drops objects whose
+     * bounds are entirely behind them, before any draw is recorded.
+     * Costs CPU time proportional to occluder triangles and screen
+     * coverage; worthwhile for interiors and dense cities, wasted on
+     * open scenes.
+     */
+    bool occlusionCulling = false;
+
+    /**
+     * Frustum-cull rigid objects on the GPU and draw them with indirect
+     * draws.
+     *
+     * A compute pass culls every `Scene3D::objects` entry against every
+     * view and writes the survivors' indices and instance counts, which
+     * one indirect draw per mesh and material then consumes. Saves the
+     * per-object CPU culling and draw recording of the main pass; pays
+     * off with many objects sharing few meshes. Shadow tiles and
+     * skinned objects still use the CPU path, and `occlusionCulling`
+     * has no effect while this is on.
+     */
+    bool gpuCulling = false;
+
+    /**
+     * Largest error, in pixels, a mesh's level of detail may show.
+     *
+     * Meshes with levels of detail (see `Mesh::GetLod`) draw the
+     * coarsest one whose simplification error projects to no more than
+     * this many pixels, measured at the nearest point of the object's
+     * bounds in the view where it appears largest. Zero always draws
+     * full detail.
+     */
+    float lodPixelError = 1.0f;
+
+    /**
+     * Multiplies `lodPixelError` for shadow tiles, where the error is
+     * measured in tile texels.
+     *
+     * Shadows are filtered and seldom looked at closely, so casters can
+     * usually drop to coarser levels there than in the main pass. One
+     * uses the main pass's tolerance.
+     */
+    float shadowLodBias = 4.0f;
+
+    /**
+     * Also skip meshlets that face entirely away from the camera.
+     *
+     * Rigid meshes with meshlets (see `Mesh::GetMeshlet`) drawn at full
+     * detail are always culled cluster by cluster against each view's
+     * frustum, and only the clusters in view are drawn. The forward
+     * pipelines draw both sides of every triangle, though, so dropping
+     * back-facing clusters is only correct for closed meshes and for
+     * surfaces never seen from behind; turn it on when the scene's are.
+     * Has no effect on objects culled by `gpuCulling`, or in shadow
+     * tiles, which draw whole meshes.
+     */
+    bool meshletBackfaceCulling = false;
+};
+
+/**
+ * One camera's share of the render target in a multi-view
+ * `ForwardRenderer::Render` call.
+ *
+ * `viewport` is in SDL Y-down pixel coordinates, like
+ * `GraphicsDevice::SetViewport`; the projection uses its aspect ratio.
+ * Nothing is drawn outside it.
+ */
+struct ForwardView {
+    Camera camera;
+    Rectangle viewport;
+};
 
 /**
  * Renders a `Scene3D` of opaque meshes from a `Camera` using a forward
@@ -22,17 +138,117 @@ struct Texture;
  * # Pipeline
  *
  * Each frame:
- *   1. For each shadow-casting `Directional` or `Spot` light (up to 4),
- *      render scene depth into the light's 2D shadow texture.
- *   2. For each shadow-casting `Point` light (up to 2), render scene
- *      depth into all six faces of the light's cube shadow texture
- *      (six passes per cube).
+ *   1. Allocate each shadow-casting light a region of the shadow atlas
+ *      (one tile for `Directional` and `Spot`, six for the faces of a
+ *      `Point` light) and render scene depth into the tiles.
+ *   2. If `ForwardRenderOptions::depthPrePass` is set, render scene
+ *      depth into the bound depth target with color writes disabled.
  *   3. Render the scene into the bound color/depth target with full
- *      lighting from `Scene3D::lights`, sampling the appropriate shadow
- *      map (2D or cube) per light to attenuate the BRDF contribution.
+ *      lighting from `Scene3D::lights`, sampling each light's atlas
+ *      tiles to attenuate the BRDF contribution.
+ *
+ * # Lights
+ *
+ * The first 64 entries of `Scene3D::lights` are uploaded each frame,
+ * but each object is only lit by the eight of them that matter most to
+ * it: directional lights by brightness, point and spot lights by
+ * brightness attenuated over the distance to the object's bounds.
+ * Lights estimated at under 1% of a unit light are dropped entirely, so
+ * an object far from every local light pays only for the directional
+ * ones. The choice is made on the CPU and travels with the object's
+ * other per-object data; scenes with eight or fewer nearby lights look
+ * the same as before.
+ *
+ * # Multiple views
+ *
+ * Split-screen and picture-in-picture pass several `ForwardView`s to
+ * one `Render` call. The shadow atlas is laid out and rendered once,
+ * sized for whichever view sees each light largest, and every view
+ * samples the same tiles. Objects are culled against all view frusta
+ * in a single pass over the scene, then each view draws its own
+ * visible set inside its viewport, all in one render pass. The
+ * single-camera overload is a one-view call covering the whole screen.
+ *
+ * With `ForwardRenderOptions::occlusionCulling`, each view also tests
+ * its frustum-visible objects against a CPU depth buffer of the
+ * scene's occluders and drops the hidden ones.
  *
- * Per-frame slot caps are first-come-first-served by `scene.lights`
- * order; lights past the cap are still lit but cast no shadow.
+ * # GPU culling
+ *
+ * With `ForwardRenderOptions::gpuCulling`, rigid objects are grouped
+ * into batches of the same mesh and material, and `forward_cull.comp`
+ * culls them against every view before the main pass. It compacts the
+ * visible object indices per batch and view and counts them into
+ * indirect draw arguments. Each batch is then one
+ * `SDL_DrawGPUIndexedPrimitivesIndirect` per view, instanced over its
+ * visible objects, whose indices the vertex shader looks up by
+ * instance.
+ *
+ * # Shadow atlas
+ *
+ * All shadows share one `ShadowAtlasSize` depth texture, bound to a
+ * single sampler slot. Tile sizes follow importance: directional lights
+ * get `MaxShadowTileSize`, spot and point lights get enough texels to
+ * match their on-screen size (point faces half that), between
+ * `MinShadowTileSize` and the maximum. A new size only takes effect
+ * after it has been wanted for several consecutive frames, so a light
+ * hovering at a size boundary doesn't re-render every frame. When the
+ * atlas is full, the least important lights (by screen coverage times
+ * intensity) shrink first and lose their shadow last; lights that lose
+ * it are still lit. Each light's view-projection and atlas UV rect
+ * travel in the lighting uniform buffer.
+ *
+ * # Scene buffers
+ *
+ * Object transforms, tints, and material indices live in a storage
+ * buffer that persists across frames, indexed by position in
+ * `Scene3D::objects`; material parameters live in a second one. Both
+ * are rebuilt on the CPU each frame but only the entries that changed
+ * are uploaded, and each draw pushes just its object index. Skinned
+ * objects push their tint and material index per draw along with their
+ * joint palette. Material textures are still bound per draw.
+ *
+ * Rendering a `RetainedScene` skips most of the rebuild: only the
+ * objects it lists as changed are repacked, as long as the previous
+ * frame rendered the same retained scene.
+ *
+ * # Material permutations
+ *
+ * `forward.frag` is compiled once per combination of optional material
+ * textures (base color, metallic-roughness, emissive, normal) and each
+ * draw uses the variant matching its material, so a material without a
+ * normal or emissive map neither samples nor binds one. Draws are
+ * grouped by variant to keep pipeline switches to one per variant.
+ *
+ * # Shadow caching
+ *
+ * Each tile draws only the casters inside its frustum and the light's
+ * range, and is skipped entirely when its placement, light, and casters
+ * are unchanged since it was last rendered -- empty tiles are cleared
+ * once and then left alone.
+ *
+ * For lights flagged `Light::isStatic`, casters flagged
+ * `SceneObject::isStatic` are rendered into the same tile of a second,
+ * static-only atlas that is only redrawn when a static caster or the
+ * light changes. The cached tile is copied into the live atlas and
+ * dynamic casters (including all skinned objects) are drawn on top, so
+ * a static level mostly costs a tile copy per light, or nothing when no
+ * dynamic caster moved. All stale tiles are redrawn in at most two
+ * render passes, one per atlas.
+ *
+ * # Threading
+ *
+ * With `ForwardRenderOptions::threadPool` set, caster bounds, object
+ * packing, and per-tile culling are split across the pool, and stale
+ * shadow tiles are recorded by worker threads into command buffers of
+ * their own -- contiguous runs of tiles, one render pass each, static
+ * atlas first. They are submitted in that fixed order regardless of
+ * which worker finishes first, while the calling thread records the
+ * main pass into the device's command buffer. The storage buffer
+ * uploads go ahead of them in a separate command buffer. The main pass
+ * stays on the device's command buffer because the swapchain texture
+ * can only be used in the command buffer that acquired it. `Render`
+ * returns once every shadow command buffer has been submitted.
  *
  * # Usage
  *
@@ -45,7 +261,7 @@ struct Texture;
  * # Lifetime
  *
  * Holds a pointer to the `GraphicsDevice` and owns a handful of GPU
- * resources (shaders, pipelines, shadow maps, sampler). The
+ * resources (shaders, pipelines, shadow atlases, samplers). The
  * `GraphicsDevice` must outlive this renderer.
  */
 struct ForwardRenderer {
@@ -53,8 +269,13 @@ struct ForwardRenderer {
      * Loads the forward + shadow-depth shaders and allocates shadow
      * resources.
      *
-     * Shaders are loaded from `Content/Shaders/forward.vert/.frag` and
-     * `Content/Shaders/shadow_depth.vert/.frag` next to the executable.
+     * Shaders are loaded from `Content/Shaders/forward.vert`, the
+     * `Content/Shaders/forward_<N>.frag` permutations (N = 0..15),
+     * `Content/Shaders/shadow_depth.vert/.frag`, the compressed-vertex
+     * builds `forward_compressed.vert` and `shadow_depth_compressed.vert`,
+     * and
+     * `Content/Shaders/shadow_tile.vert` / `shadow_tile_copy.frag` next
+     * to the executable.
      * Throws `std::runtime_error` on shader load failure.
      */
     explicit ForwardRenderer(GraphicsDevice &graphicsDevice);
@@ -67,36 +288,64 @@ struct ForwardRenderer {
     ~ForwardRenderer();
 
     /**
-     * Renders all `scene.objects` from `camera`, populating shadow maps
-     * for shadow-casting directional and spot lights first.
+     * Renders `scene` from `camera` over the whole screen, bringing the
+     * shadow atlas up to date for shadow-casting lights first. Objects
+     * outside the camera's frustum are skipped.
+     *
+     * Draws into whatever targets are bound: the swapchain, or a color
+     * target with a depth target (see `DynamicResolution`). Both are
+     * cleared, and are bound again with the caller's viewport when this
+     * returns.
      *
      * Skips objects whose `mesh` is null. Asserts that the device has
-     * depth enabled and that no render pass is currently active.
+     * depth enabled or a depth target bound, and that no render pass is
+     * currently active.
+     */
+    void Render(
+        const Scene3D &scene, const Camera &camera, const ForwardRenderOptions &options = {});
+
+    /**
+     * Renders `scene` once per entry of `views`, sharing one shadow
+     * atlas update between them. Views are drawn in order, so a
+     * picture-in-picture view goes last.
+     *
+     * Asserts that there is at least one and at most `MaxViews` views.
+     */
+    void Render(const Scene3D &scene, const std::vector<ForwardView> &views,
+        const ForwardRenderOptions &options = {});
+
+    /**
+     * Renders a retained scene from `camera`, repacking only the objects
+     * changed since the last frame. Call `scene.ClearChanges()` after
+     * rendering.
      */
-    void Render(const Scene3D &scene, const Camera &camera);
+    void Render(const RetainedScene &scene, const Camera &camera,
+        const ForwardRenderOptions &options = {});
 
-    /** Maximum number of 2D shadow maps the renderer maintains. */
-    static constexpr int MaxShadowMaps = 4;
+    /** Renders a retained scene once per entry of `views`. */
+    void Render(const RetainedScene &scene, const std::vector<ForwardView> &views,
+        const ForwardRenderOptions &options = {});
 
-    /** Edge length of each 2D shadow map in texels. */
-    static constexpr uint32_t ShadowMapSize = 2048;
+    /** Maximum number of views in one `Render` call. */
+    static constexpr uint32_t MaxViews = 8;
+
+    /** Edge length of the shadow atlas in texels. */
+    static constexpr uint32_t ShadowAtlasSize = 4096;
+
+    /** Largest tile a single shadow view gets, in texels. */
+    static constexpr uint32_t MaxShadowTileSize = 2048;
 
     /**
-     * Maximum number of cube shadow maps the renderer maintains. Each
-     * cube costs six render passes per frame, so this cap is intentionally
-     * lower than MaxShadowMaps -- a typical scene might place a single
-     * point caster (a torch, a magic effect) and accept that everything
-     * else is unshadowed.
+     * Smallest tile a shadow view gets, in texels. Lights that would
+     * need a smaller tile to fit get no shadow instead.
      */
-    static constexpr int MaxPointShadows = 2;
+    static constexpr uint32_t MinShadowTileSize = 128;
 
     /**
-     * Edge length of each cube face in texels. Smaller than ShadowMapSize
-     * because cube shadows render six times per frame and the player is
-     * usually closer to the point caster than to the sun, so per-texel
-     * world coverage is naturally tighter.
+     * Maximum number of atlas tiles per frame, sized to the lighting
+     * uniform buffer. A point light uses six, any other light one.
      */
-    static constexpr uint32_t PointShadowMapSize = 1024;
+    static constexpr int MaxShadowTiles = 48;
 
     /**
      * Maximum number of joints per skinned mesh.
@@ -110,59 +359,153 @@ struct ForwardRenderer {
     static constexpr int MaxJoints = 128;
 
   private:
-    SDL_GPUGraphicsPipeline *GetOrCreateForwardPipeline(
-        SDL_GPUTextureFormat colorFormat, SDL_GPUTextureFormat depthFormat);
+    // Number of forward.frag permutations: one per combination of the
+    // four optional material textures.
+    static constexpr uint32_t MaterialVariantCount = 16;
 
-    SDL_GPUGraphicsPipeline *GetOrCreateShadowPipeline(SDL_GPUTextureFormat depthFormat);
+    // `depthEqual` selects the variant used after a depth pre-pass:
+    // depth compare EQUAL with depth writes off. `features` is the
+    // material feature mask choosing the fragment shader permutation.
+    // `vertexFormat` is the mesh's vertex layout; the rigid shadow and
+    // pre-pass pipelines take it too.
+    SDL_GPUGraphicsPipeline *GetOrCreateForwardPipeline(SDL_GPUTextureFormat colorFormat,
+        SDL_GPUTextureFormat depthFormat, bool depthEqual, uint32_t features,
+        MeshVertexFormat vertexFormat);
 
-    SDL_GPUGraphicsPipeline *GetOrCreateForwardSkinnedPipeline(
-        SDL_GPUTextureFormat colorFormat, SDL_GPUTextureFormat depthFormat);
+    SDL_GPUGraphicsPipeline *GetOrCreateShadowPipeline(
+        SDL_GPUTextureFormat depthFormat, MeshVertexFormat vertexFormat);
+
+    SDL_GPUGraphicsPipeline *GetOrCreateForwardSkinnedPipeline(SDL_GPUTextureFormat colorFormat,
+        SDL_GPUTextureFormat depthFormat, bool depthEqual, uint32_t features);
 
     SDL_GPUGraphicsPipeline *GetOrCreateShadowSkinnedPipeline(SDL_GPUTextureFormat depthFormat);
 
+    // Full-tile pipelines for the shadow atlas: reset a tile to the far
+    // plane, or fill it from the static atlas.
+    SDL_GPUGraphicsPipeline *GetOrCreateShadowTileClearPipeline(SDL_GPUTextureFormat depthFormat);
+
+    SDL_GPUGraphicsPipeline *GetOrCreateShadowTileCopyPipeline(SDL_GPUTextureFormat depthFormat);
+
+    // Depth pre-pass pipelines: the depth-only shaders, but targeting
+    // the forward pass's color + depth attachments (color writes masked
+    // off) so both passes can share one render pass.
+    SDL_GPUGraphicsPipeline *GetOrCreateDepthPrePassPipeline(SDL_GPUTextureFormat colorFormat,
+        SDL_GPUTextureFormat depthFormat, MeshVertexFormat vertexFormat);
+
+    SDL_GPUGraphicsPipeline *GetOrCreateDepthPrePassSkinnedPipeline(
+        SDL_GPUTextureFormat colorFormat, SDL_GPUTextureFormat depthFormat);
+
+    // Shared by every public Render; `retained` is the scene's source
+    // when it came from a RetainedScene.
+    void RenderViews(const Scene3D &scene, const RetainedScene *retained,
+        const std::vector<ForwardView> &views, const ForwardRenderOptions &options);
+
+    // Groups `scene.objects` into indirect batches, one per mesh,
+    // material and level of detail in `objectLods`, uploads their cull
+    // records and draw arguments, and dispatches forward_cull.comp for
+    // the first `viewCount` view-projections. Returns false if the
+    // compute pass can't run; the CPU path then draws everything.
+    bool CullOnGpu(const Scene3D &scene, const Material &defaultMaterial,
+        const glm::mat4 *viewProjections, uint32_t viewCount,
+        const std::vector<uint8_t> &objectLods, std::vector<ForwardIndirectBatch> &batches);
+
     struct ForwardPipelineKey {
         SDL_GPUTextureFormat colorFormat;
         SDL_GPUTextureFormat depthFormat;
+        bool depthEqual = false;
+        uint32_t features = 0;
+        MeshVertexFormat vertexFormat = MeshVertexFormat::Standard;
 
         bool operator==(const ForwardPipelineKey &other) const {
-            return colorFormat == other.colorFormat && depthFormat == other.depthFormat;
+            return colorFormat == other.colorFormat && depthFormat == other.depthFormat &&
+                   depthEqual == other.depthEqual && features == other.features &&
+                   vertexFormat == other.vertexFormat;
         }
     };
     struct ForwardPipelineKeyHash {
         size_t operator()(const ForwardPipelineKey &k) const {
-            return (static_cast<size_t>(k.colorFormat) << 16) ^ static_cast<size_t>(k.depthFormat);
+            return (static_cast<size_t>(k.colorFormat) << 16) ^
+                   static_cast<size_t>(k.depthFormat) ^ (static_cast<size_t>(k.features) << 26) ^
+                   (static_cast<size_t>(k.vertexFormat) << 30) ^
+                   (static_cast<size_t>(k.depthEqual) << 31);
         }
     };
 
     GraphicsDevice *graphicsDevice;
 
     std::unique_ptr<Shader> forwardVertexShader;
-    std::unique_ptr<Shader> forwardFragmentShader;
+    std::unique_ptr<Shader> forwardCompressedVertexShader;
+    std::unique_ptr<Shader> forwardFragmentShaders[MaterialVariantCount];
     std::unique_ptr<Shader> forwardSkinnedVertexShader;
     std::unique_ptr<Shader> shadowVertexShader;
+    std::unique_ptr<Shader> shadowCompressedVertexShader;
     std::unique_ptr<Shader> shadowFragmentShader;
     std::unique_ptr<Shader> shadowSkinnedVertexShader;
+    std::unique_ptr<Shader> shadowTileVertexShader;
+    std::unique_ptr<Shader> shadowTileCopyFragmentShader;
 
     std::unordered_map<ForwardPipelineKey, SDL_GPUGraphicsPipeline *, ForwardPipelineKeyHash>
         forwardPipelines;
     std::unordered_map<ForwardPipelineKey, SDL_GPUGraphicsPipeline *, ForwardPipelineKeyHash>
         forwardSkinnedPipelines;
-    SDL_GPUGraphicsPipeline *shadowPipeline = nullptr;
+    std::unordered_map<ForwardPipelineKey, SDL_GPUGraphicsPipeline *, ForwardPipelineKeyHash>
+        depthPrePassPipelines;
+    std::unordered_map<ForwardPipelineKey, SDL_GPUGraphicsPipeline *, ForwardPipelineKeyHash>
+        depthPrePassSkinnedPipelines;
+    SDL_GPUGraphicsPipeline *shadowPipelines[MeshVertexFormatCount] = {};
     SDL_GPUTextureFormat shadowPipelineDepthFormat = SDL_GPU_TEXTUREFORMAT_INVALID;
     SDL_GPUGraphicsPipeline *shadowSkinnedPipeline = nullptr;
     SDL_GPUTextureFormat shadowSkinnedPipelineDepthFormat = SDL_GPU_TEXTUREFORMAT_INVALID;
+    SDL_GPUGraphicsPipeline *shadowTileClearPipeline = nullptr;
+    SDL_GPUTextureFormat shadowTileClearPipelineDepthFormat = SDL_GPU_TEXTUREFORMAT_INVALID;
+    SDL_GPUGraphicsPipeline *shadowTileCopyPipeline = nullptr;
+    SDL_GPUTextureFormat shadowTileCopyPipelineDepthFormat = SDL_GPU_TEXTUREFORMAT_INVALID;
+
+    std::unique_ptr<Texture> shadowAtlas;
+
+    // Static-caster cache with the same layout as shadowAtlas, created
+    // the first time a static light casts a shadow. Each tile holds
+    // only the static casters' depth and is copied into the live atlas
+    // before dynamic casters are drawn on top.
+    std::unique_ptr<Texture> staticShadowAtlas;
+
+    // Tile size and cache fingerprints per entry of Scene3D::lights,
+    // carried across frames. See ForwardShadowLightState.
+    std::vector<ForwardShadowLightState> shadowLightStates;
+
+    // One per view, kept between frames to reuse their depth buffers.
+    std::vector<OcclusionCuller> occlusionCullers;
+
+    // GPU culling state; see "GPU culling" above. The visible list is
+    // written only by the GPU, so it is a bare buffer grown on demand;
+    // it is always bound, since forward.vert and shadow_depth.vert
+    // declare it even for direct draws.
+    SDL_GPUComputePipeline *cullPipeline = nullptr;
+    std::unique_ptr<StorageBuffer<ForwardCullData>> cullBuffer;
+    std::unique_ptr<StorageBuffer<SDL_GPUIndexedIndirectDrawCommand>> drawArgsBuffer;
+    SDL_GPUBuffer *visibleBuffer = nullptr;
+    uint32_t visibleCapacity = 0;
+    // The visible list replaced by the last growth, kept alive until the
+    // frame's shadow tiles, which may have bound it, finish recording.
+    SDL_GPUBuffer *retiredVisibleBuffer = nullptr;
 
-    std::unique_ptr<Texture> shadowMaps[MaxShadowMaps];
-    std::unique_ptr<Texture> pointShadowMaps[MaxPointShadows];
     std::unique_ptr<Sampler> shadowSampler;
 
-    // 1x1 white texture used as the base-color fallback when an object's
-    // material has no base-color texture (or no material at all). Same
-    // for the metallic-roughness slot so the shader always has a valid
-    // sample even when the texture-presence flag tells it to ignore the
-    // sample's value.
-    std::unique_ptr<Texture> whiteTexture;
     std::unique_ptr<Sampler> defaultMaterialSampler;
+
+    // Persistent per-object and per-material tables read by the forward
+    // and depth shaders. See "Scene buffers" above.
+    std::unique_ptr<StorageBuffer<ForwardObjectData>> objectBuffer;
+    std::unique_ptr<StorageBuffer<ForwardMaterialData>> materialBuffer;
+
+    // CPU side of the object table, kept between frames so a retained
+    // scene only repacks its changed objects. `packedChangeEpoch` is the
+    // RetainedScene::GetChangeEpoch it was last packed at, or zero if it
+    // wasn't packed from a retained scene, and `packedLightsSignature`
+    // fingerprints the lights each object's light list was chosen from.
+    std::vector<ForwardObjectData> packedObjects;
+    uint64_t packedChangeEpoch = 0;
+    uint64_t packedLightsSignature = 0;
 };
 
 } // namespace Lucky
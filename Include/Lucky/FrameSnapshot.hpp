@@ -0,0 +1,131 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Lucky/BatchRenderer.hpp>
+#include <Lucky/Color.hpp>
+#include <Lucky/ForwardRenderer.hpp>
+#include <Lucky/Rectangle.hpp>
+#include <Lucky/Scene3D.hpp>
+#include <Lucky/Types.hpp>
+
+namespace Lucky {
+
+class SlugFont;
+struct SlugRenderer;
+struct Texture;
+
+/** One `BatchRenderer::BatchSprite` call, captured by value. */
+struct SpriteSnapshot {
+    /** Source sub-rectangle in texture pixels; ignored unless `hasSourceRectangle`. */
+    Rectangle sourceRectangle;
+    bool hasSourceRectangle = false;
+    glm::vec2 position = {0.0f, 0.0f};
+    float rotation = 0.0f;
+    glm::vec2 scale = {1.0f, 1.0f};
+    glm::vec2 origin = {0.5f, 0.5f};
+    UVMode uvMode = UVMode::Normal;
+    Color color = Color::White;
+};
+
+/**
+ * One `BatchRenderer` Begin/End block, captured by value.
+ *
+ * Replayed as `Begin`, every sprite in order, the raw triangles, then
+ * `End`. `texture` is non-owned and must stay alive until the snapshot
+ * has been drawn; null begins the batch with the built-in white texture.
+ */
+struct SpriteBatchSnapshot {
+    BlendMode blendMode = BlendMode::Alpha;
+    Texture *texture = nullptr;
+    glm::mat4 transform = glm::mat4(1.0f);
+    std::vector<SpriteSnapshot> sprites;
+
+    /** Three vertices per triangle, as for `BatchRenderer::BatchTriangles`. */
+    std::vector<BatchVertex> triangles;
+};
+
+/** One `SlugFont::DrawString` call, captured by value. */
+struct TextLineSnapshot {
+    std::string text;
+    float x = 0.0f;
+    float y = 0.0f;
+    float fontSize = 16.0f;
+    Color color = Color::White;
+};
+
+/**
+ * One `SlugRenderer` Begin/End block against a single font, captured by
+ * value. `font` is non-owned and must stay alive until the snapshot has
+ * been drawn.
+ */
+struct TextBatchSnapshot {
+    BlendMode blendMode = BlendMode::Alpha;
+    SlugFont *font = nullptr;
+    glm::mat4 mvpMatrix = glm::mat4(1.0f);
+    std::vector<TextLineSnapshot> lines;
+};
+
+/**
+ * Everything needed to draw one frame, copied out of the simulation so
+ * it can be drawn while the simulation moves on to the next frame.
+ *
+ * # Usage
+ *
+ * The simulation fills a snapshot at the end of its step: `CaptureScene`
+ * for the 3D scene, `views` for the cameras, and sprite and text batches
+ * in place of the `BatchRenderer` and `SlugRenderer` calls it would
+ * otherwise make. The renderer then passes `scene` and `views` to
+ * `ForwardRenderer::Render` and replays the 2D batches with
+ * `DrawSpriteBatches` and `DrawTextBatches`. See `SimulationThread` for
+ * running the two on separate threads.
+ *
+ * # Ownership
+ *
+ * Everything the simulation changes from frame to frame is copied:
+ * objects, lights, cameras, sprite parameters, strings, and the joint
+ * palettes of skinned objects. GPU resources -- meshes, materials,
+ * textures, fonts -- are still referenced by pointer and must not be
+ * destroyed while a snapshot that names them may still be drawn.
+ *
+ * Snapshots are meant to be reused: `Clear` keeps every vector's
+ * capacity, so a steady-state frame allocates nothing.
+ */
+struct FrameSnapshot {
+    Scene3D scene;
+    std::vector<ForwardView> views;
+    std::vector<SpriteBatchSnapshot> spriteBatches;
+    std::vector<TextBatchSnapshot> textBatches;
+
+    /**
+     * Copies `source` into `scene`, giving each skinned object its own
+     * copy of its joint palette so the original can keep animating.
+     */
+    void CaptureScene(const Scene3D &source);
+
+    /** Empties the snapshot, keeping its allocations. */
+    void Clear();
+
+    /**
+     * Replays `spriteBatches` into `renderer`. Call between
+     * `GraphicsDevice::BeginFrame` and `EndFrame`, with no batch open.
+     */
+    void DrawSpriteBatches(BatchRenderer &renderer) const;
+
+    /**
+     * Replays `textBatches` into `renderer`. Call between
+     * `GraphicsDevice::BeginFrame` and `EndFrame`, with no batch open.
+     */
+    void DrawTextBatches(SlugRenderer &renderer) const;
+
+  private:
+    // Joint palettes copied by CaptureScene; scene.skinnedObjects point
+    // into these. Only the first `jointPaletteCount` are in use.
+    std::vector<std::vector<glm::mat4>> jointPalettes;
+    size_t jointPaletteCount = 0;
+};
+
+} // namespace Lucky
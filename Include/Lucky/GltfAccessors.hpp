@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include <cgltf.h>
+
+namespace Lucky {
+
+struct Vertex3DSkinned;
+
+/**
+ * Readers that copy glTF accessor data into Lucky's vertex and index
+ * arrays, used by `Model` when it builds its meshes.
+ *
+ * Accessors whose elements are already in the destination's component
+ * type are copied straight out of the loaded buffer, honoring their
+ * byte stride, so interleaved buffers take the fast path too. Sparse
+ * and normalized accessors fall back to cgltf's general conversion.
+ */
+
+/**
+ * Returns the first byte of `accessor`'s elements when they can be read
+ * straight out of the loaded buffer as `componentType` -- no sparse
+ * substitution, no normalization -- or nullptr if they need cgltf's
+ * general conversion.
+ */
+const uint8_t *DirectAccessorData(
+    const cgltf_accessor *accessor, cgltf_component_type componentType);
+
+/**
+ * Copies up to `components` floats per element of `accessor` into the
+ * vertex array starting at `dst`, one element every `dstStride` bytes.
+ * Elements past `vertexCount`, and components the accessor lacks, are
+ * left as they were. Float accessors are copied straight from the
+ * buffer, whatever their stride; anything else (normalized integers,
+ * sparse accessors) goes through one cgltf_accessor_unpack_floats call
+ * rather than a read per element.
+ */
+void ReadAttribute(const cgltf_accessor *accessor, size_t vertexCount, int components,
+    float *dst, size_t dstStride);
+
+/** Reads every index of `accessor` into `out`, widening to 32 bits. */
+void ReadIndices(const cgltf_accessor *accessor, std::vector<uint32_t> &out);
+
+/**
+ * Reads JOINTS_0, which glTF stores as unsigned bytes or shorts, into
+ * the joint indices of `vertices`.
+ */
+void ReadJoints(const cgltf_accessor *accessor, std::vector<Vertex3DSkinned> &vertices);
+
+} // namespace Lucky
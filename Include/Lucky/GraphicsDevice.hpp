@@ -249,11 +249,17 @@ struct GraphicsDevice {
      * the next render pass writes to. The same texture can be re-bound
      * with a different layer between passes to render all six faces.
      *
+     * Pass `clear = false` to keep the layer's existing depth (LOADOP_LOAD)
+     * instead, e.g. to draw more geometry over depth copied in from a
+     * cache.
+     *
      * \param depth depth render target. Must remain alive until unbound.
      *              Must be a `DepthTarget` or `CubeDepthTarget` Texture.
      * \param layer layer index (0 for 2D depth, 0..5 for cube depth).
+     * \param clear if true (default), the next render pass clears the
+     *              layer to 1.0; if false, it loads the existing contents.
      */
-    void BindDepthRenderTarget(const Texture &depth, uint32_t layer = 0);
+    void BindDepthRenderTarget(const Texture &depth, uint32_t layer = 0, bool clear = true);
 
     /**
      * Releases the bound depth render target.
@@ -284,6 +290,17 @@ struct GraphicsDevice {
      */
     bool IsUsingDepthTarget() const;
 
+    /**
+     * Returns the bound color render target, or nullptr while rendering
+     * to the swapchain.
+     */
+    const Texture *GetRenderTarget() const;
+
+    /**
+     * Returns the bound depth render target, or nullptr if none is bound.
+     */
+    const Texture *GetDepthRenderTarget() const;
+
     /**
      * Acquires a fresh command buffer and the swapchain texture for this
      * frame.
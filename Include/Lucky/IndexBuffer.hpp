@@ -2,7 +2,9 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 #include <SDL3/SDL_assert.h>
 #include <SDL3/SDL_gpu.h>
@@ -26,6 +28,22 @@ template <typename IndexType> constexpr SDL_GPUIndexElementSize IndexElementSize
     }
 }
 
+/**
+ * Largest vertex count a mesh can have and still be drawn with 16-bit
+ * indices. The largest index is then 0xFFFE: some backends read 0xFFFF
+ * as a primitive restart even in list topologies, so it is never used.
+ */
+constexpr uint32_t MaxShortIndexedVertices = 0xFFFF;
+
+/**
+ * Returns the smallest index element size that can address `vertexCount`
+ * vertices.
+ */
+constexpr SDL_GPUIndexElementSize IndexElementSizeFor(uint32_t vertexCount) {
+    return vertexCount <= MaxShortIndexedVertices ? SDL_GPU_INDEXELEMENTSIZE_16BIT
+                                                  : SDL_GPU_INDEXELEMENTSIZE_32BIT;
+}
+
 /**
  * A typed wrapper around an SDL_GPUBuffer holding an index array.
  *
@@ -241,4 +259,74 @@ template <typename IndexType> struct IndexBuffer {
     uint32_t bufferSize = 0;
 };
 
+/**
+ * A static index buffer that picks its element size from the vertex count
+ * it indexes.
+ *
+ * Takes 32-bit indices and stores them as 16-bit whenever
+ * `IndexElementSizeFor` allows, halving index memory and fetch bandwidth
+ * for the common case of meshes of up to 65535 vertices. Bind it with
+ * `GetElementSize()`, not a fixed size.
+ *
+ * # Lifetime
+ *
+ * Holds a pointer to the `GraphicsDevice` through its buffer. The
+ * `GraphicsDevice` must outlive this buffer.
+ */
+struct CompactIndexBuffer {
+    /**
+     * Uploads `indices`, converting them to 16 bits when `vertexCount`
+     * allows.
+     *
+     * \param graphicsDevice the graphics device. Must outlive this buffer.
+     * \param indices index data to upload. Must not be null, and every
+     *                index must be below `vertexCount`.
+     * \param indexCount number of indices in `indices`. Must be positive.
+     * \param vertexCount number of vertices the indices address.
+     */
+    CompactIndexBuffer(GraphicsDevice &graphicsDevice, const uint32_t *indices,
+        uint32_t indexCount, uint32_t vertexCount)
+        : elementSize(IndexElementSizeFor(vertexCount)) {
+        SDL_assert(indices != nullptr);
+        if (elementSize == SDL_GPU_INDEXELEMENTSIZE_16BIT) {
+            std::vector<uint16_t> shortIndices(indexCount);
+            for (uint32_t i = 0; i < indexCount; i++) {
+                SDL_assert(indices[i] < vertexCount);
+                shortIndices[i] = static_cast<uint16_t>(indices[i]);
+            }
+            shortBuffer = std::make_unique<IndexBuffer<uint16_t>>(
+                graphicsDevice, shortIndices.data(), indexCount);
+        } else {
+            longBuffer =
+                std::make_unique<IndexBuffer<uint32_t>>(graphicsDevice, indices, indexCount);
+        }
+    }
+
+    CompactIndexBuffer(const CompactIndexBuffer &) = delete;
+    CompactIndexBuffer &operator=(const CompactIndexBuffer &) = delete;
+    CompactIndexBuffer(CompactIndexBuffer &&) = delete;
+    CompactIndexBuffer &operator=(CompactIndexBuffer &&) = delete;
+
+    /**
+     * Returns the underlying SDL_GPUBuffer handle for use in pipeline
+     * binding.
+     */
+    SDL_GPUBuffer *GetGPUBuffer() const {
+        return shortBuffer ? shortBuffer->GetGPUBuffer() : longBuffer->GetGPUBuffer();
+    }
+
+    /**
+     * Returns the element size the indices were stored with. Pass
+     * alongside `GetGPUBuffer()` to `SDL_BindGPUIndexBuffer`.
+     */
+    SDL_GPUIndexElementSize GetElementSize() const {
+        return elementSize;
+    }
+
+  private:
+    SDL_GPUIndexElementSize elementSize;
+    std::unique_ptr<IndexBuffer<uint16_t>> shortBuffer;
+    std::unique_ptr<IndexBuffer<uint32_t>> longBuffer;
+};
+
 } // namespace Lucky
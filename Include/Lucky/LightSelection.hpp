@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace Lucky {
+
+struct BoundingBox;
+struct Light;
+
+/**
+ * Lights evaluated per object, chosen by SelectObjectLights. Their
+ * indices are packed a byte each into the two words of ObjectLights.
+ */
+constexpr int MaxObjectLights = 8;
+
+/**
+ * Largest light list SelectObjectLights chooses from. Bounded by the
+ * byte each packed index gets.
+ */
+constexpr int MaxSelectableLights = 256;
+
+/**
+ * Lights whose estimated contribution to an object falls below this
+ * fraction of a unit white light aren't evaluated for it at all.
+ */
+constexpr float MinLightInfluence = 0.01f;
+
+/**
+ * The lights one object is shaded with, in the packed form the
+ * forward shaders read: light `n` of `count` is byte `n % 4` of
+ * `indices[n / 4]`.
+ */
+struct ObjectLights {
+    uint32_t count = 0;
+    uint32_t indices[2] = {};
+
+    /** Returns the index of the `n`th selected light. */
+    uint32_t GetIndex(uint32_t n) const {
+        return (indices[n / 4] >> ((n % 4) * 8)) & 0xFF;
+    }
+};
+
+/**
+ * Rough estimate of how much `light` adds to a surface inside `bounds`:
+ * its brightest channel, attenuated as in forward.frag.hlsl over the
+ * distance to the nearest point of the box. Directional lights, and
+ * any light against empty bounds, aren't attenuated. Spot cones are
+ * ignored, so a spotlight pointing away still counts as if it faced
+ * the object.
+ */
+float LightInfluence(const Light &light, const BoundingBox &bounds);
+
+/**
+ * Chooses the (up to) MaxObjectLights most influential of the first
+ * `lightCount` lights for an object with world bounds `bounds`,
+ * dropping any under MinLightInfluence. Indices are kept in ascending
+ * order, so objects near the same lights shade them in the same order.
+ * `lightCount` must not exceed MaxSelectableLights or `lights.size()`.
+ */
+ObjectLights SelectObjectLights(
+    const std::vector<Light> &lights, int lightCount, const BoundingBox &bounds);
+
+/**
+ * Fingerprint of everything SelectObjectLights reads from the first
+ * `lightCount` lights. Selections made with equal fingerprints and
+ * equal bounds are equal.
+ */
+uint64_t HashLightsForSelection(const std::vector<Light> &lights, int lightCount);
+
+} // namespace Lucky
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace Lucky {
+
+/**
+ * A whole file mapped read-only into memory.
+ *
+ * The operating system pages the contents in as they are first read, so
+ * opening a large file costs almost nothing up front and the bytes go
+ * from the page cache to their consumer without an intermediate copy.
+ * `Model` uses this to hand cooked vertex and index data straight to
+ * the GPU upload path.
+ *
+ * The file must not be truncated by another process while it is mapped;
+ * reading past the new end of file faults rather than throwing.
+ *
+ * # Lifetime
+ *
+ * Pointers returned by `GetData()` stay valid until the MappedFile is
+ * destroyed.
+ */
+struct MappedFile {
+    /**
+     * Opens and maps `path`.
+     *
+     * \param path filesystem path, UTF-8.
+     * \throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string &path);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&) = delete;
+    MappedFile &operator=(MappedFile &&) = delete;
+
+    ~MappedFile();
+
+    /** Returns the file's contents, or null for an empty file. */
+    const uint8_t *GetData() const {
+        return data;
+    }
+
+    /** Returns the file's size in bytes. */
+    size_t GetSize() const {
+        return size;
+    }
+
+  private:
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+};
+
+} // namespace Lucky
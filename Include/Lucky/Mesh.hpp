@@ -1,10 +1,17 @@
 #pragma once
 
 #include <stdint.h>
+#include <memory>
 #include <vector>
 
+#include <SDL3/SDL_assert.h>
+#include <glm/glm.hpp>
+
+#include <Lucky/Bounds.hpp>
 #include <Lucky/IndexBuffer.hpp>
+#include <Lucky/MeshArena.hpp>
 #include <Lucky/VertexBuffer.hpp>
+#include <Lucky/VertexCompression.hpp>
 
 namespace Lucky {
 
@@ -32,16 +39,36 @@ struct Vertex3D {
     float tx, ty, tz, tw; /**< tangent xyz + bitangent handedness w. */
 };
 
+/**
+ * A simplified version of a `MeshData`'s triangles, indexing the same
+ * vertices. `error` is the simplifier's bound on how far the surface
+ * moved, in mesh-local units.
+ */
+struct MeshLodData {
+    std::vector<uint32_t> indices;
+    float error = 0.0f;
+};
+
 /**
  * CPU-side mesh data: a vertex array plus a 32-bit index array.
  *
  * Returned by the `Make*MeshData` generators so callers can inspect or
  * transform the geometry before uploading. To upload, hand the contained
  * arrays to a `Mesh` constructor.
+ *
+ * `lods` holds optional coarser levels of detail, finest first, with at
+ * most `MaxMeshLods - 1` entries; `GenerateMeshLods` fills it. Anything
+ * that reorders or removes vertices must run before it is filled.
+ *
+ * `meshlets` optionally splits `indices` into clusters that cover them
+ * back to back; `BuildMeshlets` fills it. Reordering the triangles
+ * afterwards, as `OptimizeMeshData` does, invalidates it.
  */
 struct MeshData {
     std::vector<Vertex3D> vertices;
     std::vector<uint32_t> indices;
+    std::vector<MeshLodData> lods;
+    std::vector<Meshlet> meshlets;
 };
 
 /**
@@ -97,18 +124,77 @@ MeshData MakePlaneMeshData(float size = 1.0f);
  */
 MeshData MakeDiamondMeshData(float radius = 1.0f, float height = 1.5f);
 
+/**
+ * Picks the coarsest level of detail whose error stays within
+ * `maxPixelError` pixels on screen.
+ *
+ * \param lods the mesh's levels, finest first, as `Mesh::GetLod`
+ *             returns them. Errors must not decrease.
+ * \param lodCount number of entries in `lods`. Positive.
+ * \param pixelsPerUnit how many pixels one mesh-local unit covers, such
+ *                      as `ProjectedPixelsPerUnit` times the object's
+ *                      scale.
+ * \param maxPixelError largest error to accept, in pixels. Zero or less
+ *                      always picks level 0.
+ * \return an index into `lods`.
+ */
+int SelectMeshLod(const MeshLod *lods, int lodCount, float pixelsPerUnit, float maxPixelError);
+
+/**
+ * Returns true if every triangle of `meshlet` faces away from a viewer
+ * at `viewPosition`, so the whole cluster can be skipped when back faces
+ * are not drawn. Both are in mesh-local space.
+ *
+ * Conservative: a viewer inside the meshlet's bounding sphere, or a
+ * meshlet too curved to have a useful normal cone, is never culled.
+ */
+bool IsMeshletBackfacing(const Meshlet &meshlet, const glm::vec3 &viewPosition);
+
 /**
  * GPU-resident mesh: paired vertex and index buffers, both static.
  *
  * Uploads the supplied geometry once at construction and holds onto the
- * GPU buffers for the lifetime of the object. Index format is fixed at
- * 32 bits so meshes from different sources (generated primitives,
- * cgltf-loaded models) share a single binding path.
+ * GPU buffers for the lifetime of the object. Indices are always
+ * supplied as 32 bits so meshes from different sources (generated
+ * primitives, cgltf-loaded models) share a single construction path, and
+ * stored as 16 bits when the mesh has few enough vertices; bind them with
+ * `GetIndexElementSize()`.
+ *
+ * # Vertex formats
+ *
+ * Vertices are supplied as `Vertex3D` and stored as-is unless the mesh
+ * opts into one of the compressed `MeshVertexFormat`s, which halve the
+ * vertex buffer at a small cost in precision. `ForwardRenderer` picks
+ * the matching pipeline from `GetVertexFormat()`, so meshes of every
+ * format can share a scene.
+ *
+ * # Shared buffers
+ *
+ * A Mesh can also be a view of one range of a `MeshArena`, owning no
+ * buffers of its own; `Model` builds its meshes this way. Draw a mesh
+ * with `GetFirstIndex()` and `GetBaseVertex()`, which are zero for a
+ * mesh that owns its buffers.
+ *
+ * # Levels of detail
+ *
+ * A mesh built from a `MeshData` with `lods`, or a view of an arena
+ * range with them, carries up to `MaxMeshLods` levels. All of them draw
+ * from the same vertices; each is its own run of the index buffer,
+ * given by `GetLod()`. `ForwardRenderer` picks one per draw with
+ * `SelectMeshLod`.
+ *
+ * # Meshlets
+ *
+ * A mesh whose `MeshData` went through `BuildMeshlets` also carries its
+ * full level of detail split into meshlets, from `GetMeshlet()`.
+ * `ForwardRenderer` culls them one by one, so a large mesh that is
+ * mostly off screen only draws the clusters that can be seen.
  *
  * # Lifetime
  *
  * Holds a reference to the `GraphicsDevice` through its internal buffers.
- * The `GraphicsDevice` must outlive this Mesh.
+ * The `GraphicsDevice` must outlive this Mesh, and the arena must outlive
+ * a view into it.
  *
  * # Non-movable
  *
@@ -128,14 +214,25 @@ struct Mesh {
      * \param indices index array, in 32-bit format. Must not be null.
      *                Must contain at least `indexCount` entries.
      * \param indexCount number of indices. Must be positive.
+     * \param vertexFormat how to store the vertices on the GPU.
      */
     Mesh(GraphicsDevice &graphicsDevice, const Vertex3D *vertices, uint32_t vertexCount,
-        const uint32_t *indices, uint32_t indexCount);
+        const uint32_t *indices, uint32_t indexCount,
+        MeshVertexFormat vertexFormat = MeshVertexFormat::Standard);
 
     /**
-     * Convenience overload: uploads the contents of a `MeshData` directly.
+     * Convenience overload: uploads the contents of a `MeshData`
+     * directly, along with its levels of detail and meshlets.
      */
-    Mesh(GraphicsDevice &graphicsDevice, const MeshData &data);
+    Mesh(GraphicsDevice &graphicsDevice, const MeshData &data,
+        MeshVertexFormat vertexFormat = MeshVertexFormat::Standard);
+
+    /**
+     * Makes a view of the mesh at `rangeIndex` in `arena`. Uploads
+     * nothing; the view draws from the arena's buffers, in the arena's
+     * vertex format.
+     */
+    Mesh(const MeshArena<Vertex3D> &arena, int rangeIndex);
 
     Mesh(const Mesh &) = delete;
     Mesh &operator=(const Mesh &) = delete;
@@ -146,18 +243,59 @@ struct Mesh {
 
     /**
      * Returns the vertex GPU buffer handle for binding via
-     * `SDL_BindGPUVertexBuffers`.
+     * `SDL_BindGPUVertexBuffers`. Its layout is given by
+     * `GetVertexFormat()`.
      */
     SDL_GPUBuffer *GetVertexBuffer() const {
-        return vertexBuffer.GetGPUBuffer();
+        return vertexGpuBuffer;
+    }
+
+    MeshVertexFormat GetVertexFormat() const {
+        return vertexFormat;
+    }
+
+    /**
+     * Returns the offset and scale that map stored positions back to
+     * mesh space: `position * scale + offset`. For
+     * `MeshVertexFormat::Quantized` these are the bounding box's minimum
+     * and size, with stored positions read as [0, 1] fractions; for the
+     * other formats they are zero and one.
+     */
+    const glm::vec3 &GetPositionOffset() const {
+        return positionOffset;
+    }
+
+    const glm::vec3 &GetPositionScale() const {
+        return positionScale;
     }
 
     /**
      * Returns the index GPU buffer handle for binding via
-     * `SDL_BindGPUIndexBuffer`. The element size is always 32-bit.
+     * `SDL_BindGPUIndexBuffer`, with `GetIndexElementSize()`.
      */
     SDL_GPUBuffer *GetIndexBuffer() const {
-        return indexBuffer.GetGPUBuffer();
+        return indexGpuBuffer;
+    }
+
+    /**
+     * Returns the size of the stored indices: 16-bit for meshes of up to
+     * `MaxShortIndexedVertices` vertices, 32-bit otherwise.
+     */
+    SDL_GPUIndexElementSize GetIndexElementSize() const {
+        return indexElementSize;
+    }
+
+    /** Returns the mesh's first index in `GetIndexBuffer()`. */
+    uint32_t GetFirstIndex() const {
+        return firstIndex;
+    }
+
+    /**
+     * Returns the mesh's first vertex in `GetVertexBuffer()`, which the
+     * draw adds to every index.
+     */
+    uint32_t GetBaseVertex() const {
+        return baseVertex;
     }
 
     uint32_t GetVertexCount() const {
@@ -168,11 +306,67 @@ struct Mesh {
         return indexCount;
     }
 
+    /**
+     * Returns the mesh-local bounding box of the vertex positions,
+     * computed once at upload time.
+     */
+    const BoundingBox &GetBounds() const {
+        return bounds;
+    }
+
+    /** Number of levels of detail, counting the full mesh. At least 1. */
+    int GetLodCount() const {
+        return lodCount;
+    }
+
+    /**
+     * Returns level of detail `index`, where 0 is the full mesh. Draw it
+     * with the level's `firstIndex` and `indexCount` in place of
+     * `GetFirstIndex()` and `GetIndexCount()`.
+     */
+    const MeshLod &GetLod(int index) const {
+        SDL_assert(index >= 0 && index < lodCount);
+        return lods[index];
+    }
+
+    /** Number of meshlets the full mesh is split into; zero if it isn't. */
+    uint32_t GetMeshletCount() const {
+        return meshletCount;
+    }
+
+    /**
+     * Returns meshlet `index`. Its `firstIndex` is relative to
+     * `GetFirstIndex()`.
+     */
+    const Meshlet &GetMeshlet(uint32_t index) const {
+        SDL_assert(index < meshletCount);
+        return meshlets[index];
+    }
+
   private:
-    VertexBuffer<Vertex3D> vertexBuffer;
-    IndexBuffer<uint32_t> indexBuffer;
+    // Only the buffer matching vertexFormat exists, and none of them for
+    // a view into a MeshArena.
+    std::unique_ptr<VertexBuffer<Vertex3D>> standardVertexBuffer;
+    std::unique_ptr<VertexBuffer<CompressedVertex3D>> compressedVertexBuffer;
+    std::unique_ptr<VertexBuffer<QuantizedVertex3D>> quantizedVertexBuffer;
+    std::unique_ptr<CompactIndexBuffer> indexBuffer;
+    SDL_GPUBuffer *vertexGpuBuffer = nullptr;
+    SDL_GPUBuffer *indexGpuBuffer = nullptr;
+    SDL_GPUIndexElementSize indexElementSize;
+    uint32_t firstIndex = 0;
+    uint32_t baseVertex = 0;
     uint32_t vertexCount;
     uint32_t indexCount;
+    MeshVertexFormat vertexFormat;
+    BoundingBox bounds;
+    glm::vec3 positionOffset = glm::vec3(0.0f);
+    glm::vec3 positionScale = glm::vec3(1.0f);
+    MeshLod lods[MaxMeshLods];
+    int lodCount = 1;
+    // Points into ownedMeshlets, or into the arena for a view.
+    std::vector<Meshlet> ownedMeshlets;
+    const Meshlet *meshlets = nullptr;
+    uint32_t meshletCount = 0;
 };
 
 } // namespace Lucky
@@ -0,0 +1,337 @@
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_gpu.h>
+#include <glm/glm.hpp>
+
+#include <Lucky/Bounds.hpp>
+#include <Lucky/IndexBuffer.hpp>
+#include <Lucky/VertexBuffer.hpp>
+#include <Lucky/VertexCompression.hpp>
+
+namespace Lucky {
+
+struct GraphicsDevice;
+
+/** Most levels of detail a mesh carries, counting the full mesh. */
+constexpr int MaxMeshLods = 4;
+
+/**
+ * One level of detail of a mesh: a run of indices in the mesh's index
+ * buffer that draws a simplified version of it from the same vertices.
+ *
+ * `error` bounds how far, in mesh-local units, the simplified surface
+ * strays from the full mesh. Level 0 is the full mesh, with no error.
+ */
+struct MeshLod {
+    uint32_t firstIndex = 0; /**< first index in the index buffer. */
+    uint32_t indexCount = 0; /**< number of indices. */
+    float error = 0.0f;      /**< geometric error in mesh-local units. */
+};
+
+/** Default limits on the size of one `Meshlet`. */
+constexpr uint32_t MeshletMaxTriangles = 124;
+constexpr uint32_t MeshletMaxVertices = 64;
+
+/**
+ * A cluster of neighboring triangles that can be culled on its own: one
+ * run of the full mesh's indices, with a bounding sphere and a cone
+ * bounding its triangles' normals, all in mesh-local space.
+ *
+ * Every triangle's unit normal is within the angle whose cosine is
+ * `coneCutoff` of `coneAxis`. A cutoff of zero or less means the
+ * cluster is too curved to ever face entirely away from a viewer.
+ */
+struct Meshlet {
+    uint32_t firstIndex = 0; /**< first index, relative to the mesh's own. */
+    uint32_t indexCount = 0; /**< number of indices. */
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+    glm::vec3 coneAxis = glm::vec3(0.0f);
+    float coneCutoff = -1.0f;
+};
+
+/**
+ * Where one mesh's geometry sits inside a `MeshArena`.
+ *
+ * Indices are stored relative to the mesh's own first vertex, so a draw
+ * passes `firstIndex` and `baseVertex` through to the GPU rather than
+ * rewriting them. A mesh's coarser levels of detail follow its own
+ * indices and share its vertices.
+ */
+struct MeshArenaRange {
+    uint32_t firstIndex = 0;       /**< first index in the arena's index buffer. */
+    uint32_t indexCount = 0;       /**< number of indices. */
+    uint32_t baseVertex = 0;       /**< first vertex in the arena's vertex buffer. */
+    uint32_t vertexCount = 0;      /**< number of vertices. */
+    BoundingBox bounds;            /**< mesh-local bounds of the vertex positions. */
+    uint32_t lodCount = 0;         /**< number of entries used in `lods`. */
+    MeshLod lods[MaxMeshLods - 1]; /**< coarser levels, finest first. */
+    uint32_t firstMeshlet = 0;     /**< first entry in the arena's meshlets. */
+    uint32_t meshletCount = 0;     /**< number of meshlets; zero if unsplit. */
+};
+
+namespace detail {
+
+// Whether a mesh data type can carry levels of detail and meshlets.
+// `MeshData` does; `SkinnedMeshData` doesn't.
+template <typename MeshDataType, typename = void> struct IsRigidMeshData : std::false_type {};
+
+template <typename MeshDataType>
+struct IsRigidMeshData<MeshDataType, std::void_t<decltype(std::declval<MeshDataType>().lods)>>
+    : std::true_type {};
+
+} // namespace detail
+
+/**
+ * Appends `mesh` to the arena-layout arrays `vertices` and `indices`,
+ * followed by its levels of detail if it has any, and its meshlets to
+ * `meshlets`, and returns where it landed. `MeshArena` and the cooked
+ * model writer both lay meshes out through this, so their layouts match.
+ */
+template <typename MeshDataType, typename VertexType>
+MeshArenaRange AppendArenaMesh(const MeshDataType &mesh, std::vector<VertexType> &vertices,
+    std::vector<uint32_t> &indices, std::vector<Meshlet> &meshlets) {
+    SDL_assert(!mesh.vertices.empty());
+    SDL_assert(!mesh.indices.empty());
+    MeshArenaRange range;
+    range.firstIndex = static_cast<uint32_t>(indices.size());
+    range.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    range.baseVertex = static_cast<uint32_t>(vertices.size());
+    range.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    for (const VertexType &vertex : mesh.vertices) {
+        ExpandBounds(range.bounds, glm::vec3(vertex.x, vertex.y, vertex.z));
+    }
+    vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+    indices.insert(indices.end(), mesh.indices.begin(), mesh.indices.end());
+    if constexpr (detail::IsRigidMeshData<MeshDataType>::value) {
+        SDL_assert(mesh.lods.size() < MaxMeshLods);
+        for (const auto &lod : mesh.lods) {
+            MeshLod &entry = range.lods[range.lodCount++];
+            entry.firstIndex = static_cast<uint32_t>(indices.size());
+            entry.indexCount = static_cast<uint32_t>(lod.indices.size());
+            entry.error = lod.error;
+            indices.insert(indices.end(), lod.indices.begin(), lod.indices.end());
+        }
+        range.firstMeshlet = static_cast<uint32_t>(meshlets.size());
+        range.meshletCount = static_cast<uint32_t>(mesh.meshlets.size());
+        meshlets.insert(meshlets.end(), mesh.meshlets.begin(), mesh.meshlets.end());
+    }
+    return range;
+}
+
+/**
+ * Returns the vertex count of the largest mesh in `ranges`, which is
+ * what decides whether an arena's indices fit in 16 bits (see
+ * `IndexElementSizeFor`): indices are relative to `baseVertex`, so the
+ * arena's total vertex count doesn't matter.
+ */
+inline uint32_t LargestArenaMesh(const std::vector<MeshArenaRange> &ranges) {
+    uint32_t largest = 0;
+    for (const MeshArenaRange &range : ranges) {
+        largest = std::max(largest, range.vertexCount);
+    }
+    return largest;
+}
+
+/**
+ * One static vertex buffer and one static index buffer holding the
+ * geometry of many meshes.
+ *
+ * `Model` packs all of its rigid primitives into one arena and its
+ * skinned primitives into another, then hands out `Mesh` and
+ * `SkinnedMesh` views into them. Draws of views that share an arena
+ * share a buffer binding, so the renderer binds them once per run
+ * instead of once per object, and a model with hundreds of primitives
+ * costs two GPU buffers instead of hundreds.
+ *
+ * The index buffer is 16-bit when no single mesh exceeds
+ * `MaxShortIndexedVertices` vertices, however large the arena as a
+ * whole; see `LargestArenaMesh`.
+ *
+ * An arena of `Vertex3D` can store its vertices in any
+ * `MeshVertexFormat`, like a standalone `Mesh`. Quantized positions are
+ * fractions of each mesh's own bounds, so views decode them per mesh.
+ *
+ * # Lifetime
+ *
+ * Holds a pointer to the `GraphicsDevice` through its buffers. The
+ * `GraphicsDevice` must outlive the arena, and the arena must outlive
+ * every view into it.
+ */
+template <typename VertexType> struct MeshArena {
+    /**
+     * Uploads every mesh in `meshes`, in order, with any levels of
+     * detail they carry. Range `i` describes `meshes[i]`.
+     *
+     * \param graphicsDevice the graphics device. Must outlive this arena.
+     * \param meshes `MeshData` or `SkinnedMeshData` entries whose vertex
+     *               type is `VertexType`. Must not be empty, and every
+     *               entry must have vertices and indices.
+     * \param vertexFormat how to store the vertices on the GPU. Only
+     *                     `Standard` for arenas of other vertex types.
+     */
+    template <typename MeshDataType>
+    MeshArena(GraphicsDevice &graphicsDevice, const std::vector<MeshDataType> &meshes,
+        MeshVertexFormat vertexFormat = MeshVertexFormat::Standard)
+        : vertexFormat(vertexFormat) {
+        SDL_assert(!meshes.empty());
+        size_t totalVertices = 0;
+        size_t totalIndices = 0;
+        for (const MeshDataType &mesh : meshes) {
+            totalVertices += mesh.vertices.size();
+            totalIndices += mesh.indices.size();
+            if constexpr (detail::IsRigidMeshData<MeshDataType>::value) {
+                for (const auto &lod : mesh.lods) {
+                    totalIndices += lod.indices.size();
+                }
+            }
+        }
+
+        std::vector<VertexType> vertices;
+        std::vector<uint32_t> indices;
+        vertices.reserve(totalVertices);
+        indices.reserve(totalIndices);
+        ranges.reserve(meshes.size());
+        for (const MeshDataType &mesh : meshes) {
+            ranges.push_back(AppendArenaMesh(mesh, vertices, indices, meshlets));
+        }
+
+        UploadVertices(graphicsDevice, vertices.data(), static_cast<uint32_t>(vertices.size()));
+        indexBuffer = std::make_unique<CompactIndexBuffer>(graphicsDevice,
+            indices.data(),
+            static_cast<uint32_t>(indices.size()),
+            LargestArenaMesh(ranges));
+    }
+
+    /**
+     * Uploads geometry that is already laid out as an arena, such as the
+     * blobs of a cooked model file, without copying it first.
+     *
+     * \param graphicsDevice the graphics device. Must outlive this arena.
+     * \param vertices every mesh's vertices, back to back.
+     * \param vertexCount number of entries in `vertices`. Must be positive.
+     * \param indices every mesh's indices, each relative to its mesh's
+     *                `baseVertex`.
+     * \param indexCount number of entries in `indices`. Must be positive.
+     * \param ranges where each mesh sits in `vertices` and `indices`.
+     *               Must not be empty.
+     * \param meshlets every mesh's meshlets, back to back. May be null
+     *                 when `meshletCount` is zero.
+     * \param meshletCount number of entries in `meshlets`.
+     * \param vertexFormat as for the other constructor.
+     */
+    MeshArena(GraphicsDevice &graphicsDevice, const VertexType *vertices, uint32_t vertexCount,
+        const uint32_t *indices, uint32_t indexCount, std::vector<MeshArenaRange> ranges,
+        const Meshlet *meshlets = nullptr, uint32_t meshletCount = 0,
+        MeshVertexFormat vertexFormat = MeshVertexFormat::Standard)
+        : ranges(std::move(ranges)), meshlets(meshlets, meshlets + meshletCount),
+          vertexFormat(vertexFormat) {
+        SDL_assert(!this->ranges.empty());
+        for (const MeshArenaRange &range : this->ranges) {
+            SDL_assert(range.baseVertex + range.vertexCount <= vertexCount);
+            SDL_assert(range.firstIndex + range.indexCount <= indexCount);
+            SDL_assert(range.lodCount < MaxMeshLods);
+            SDL_assert(range.firstMeshlet + range.meshletCount <= meshletCount);
+        }
+
+        UploadVertices(graphicsDevice, vertices, vertexCount);
+        indexBuffer = std::make_unique<CompactIndexBuffer>(
+            graphicsDevice, indices, indexCount, LargestArenaMesh(this->ranges));
+    }
+
+    MeshArena(const MeshArena &) = delete;
+    MeshArena &operator=(const MeshArena &) = delete;
+    MeshArena(MeshArena &&) = delete;
+    MeshArena &operator=(MeshArena &&) = delete;
+
+    /** Returns the vertex buffer, laid out as `GetVertexFormat()`. */
+    SDL_GPUBuffer *GetVertexBuffer() const {
+        return vertexGpuBuffer;
+    }
+
+    MeshVertexFormat GetVertexFormat() const {
+        return vertexFormat;
+    }
+
+    SDL_GPUBuffer *GetIndexBuffer() const {
+        return indexBuffer->GetGPUBuffer();
+    }
+
+    SDL_GPUIndexElementSize GetIndexElementSize() const {
+        return indexBuffer->GetElementSize();
+    }
+
+    /** Number of meshes in the arena. */
+    int GetRangeCount() const {
+        return static_cast<int>(ranges.size());
+    }
+
+    /** Returns where mesh `index` sits in the arena's buffers. */
+    const MeshArenaRange &GetRange(int index) const {
+        return ranges[index];
+    }
+
+    /**
+     * Returns every mesh's meshlets, back to back; a range's
+     * `firstMeshlet` indexes into this. Null if there are none.
+     */
+    const Meshlet *GetMeshlets() const {
+        return meshlets.empty() ? nullptr : meshlets.data();
+    }
+
+  private:
+    // Converts `vertices` to `vertexFormat` and uploads them. Each mesh
+    // is quantized against its own range's bounds.
+    void UploadVertices(
+        GraphicsDevice &graphicsDevice, const VertexType *vertices, uint32_t vertexCount) {
+        if constexpr (std::is_same_v<VertexType, Vertex3D>) {
+            if (vertexFormat == MeshVertexFormat::Compressed) {
+                std::vector<CompressedVertex3D> packed(vertexCount);
+                for (uint32_t i = 0; i < vertexCount; i++) {
+                    packed[i] = CompressVertex(vertices[i]);
+                }
+                compressedVertexBuffer = std::make_unique<VertexBuffer<CompressedVertex3D>>(
+                    graphicsDevice, packed.data(), vertexCount);
+                vertexGpuBuffer = compressedVertexBuffer->GetGPUBuffer();
+                return;
+            }
+            if (vertexFormat == MeshVertexFormat::Quantized) {
+                std::vector<QuantizedVertex3D> packed(vertexCount);
+                for (const MeshArenaRange &range : ranges) {
+                    for (uint32_t i = 0; i < range.vertexCount; i++) {
+                        const uint32_t vertex = range.baseVertex + i;
+                        packed[vertex] = QuantizeVertex(vertices[vertex], range.bounds);
+                    }
+                }
+                quantizedVertexBuffer = std::make_unique<VertexBuffer<QuantizedVertex3D>>(
+                    graphicsDevice, packed.data(), vertexCount);
+                vertexGpuBuffer = quantizedVertexBuffer->GetGPUBuffer();
+                return;
+            }
+        }
+        SDL_assert(vertexFormat == MeshVertexFormat::Standard);
+        vertexBuffer =
+            std::make_unique<VertexBuffer<VertexType>>(graphicsDevice, vertices, vertexCount);
+        vertexGpuBuffer = vertexBuffer->GetGPUBuffer();
+    }
+
+    // Only the buffer matching vertexFormat exists.
+    std::unique_ptr<VertexBuffer<VertexType>> vertexBuffer;
+    std::unique_ptr<VertexBuffer<CompressedVertex3D>> compressedVertexBuffer;
+    std::unique_ptr<VertexBuffer<QuantizedVertex3D>> quantizedVertexBuffer;
+    std::unique_ptr<CompactIndexBuffer> indexBuffer;
+    SDL_GPUBuffer *vertexGpuBuffer = nullptr;
+    std::vector<MeshArenaRange> ranges;
+    std::vector<Meshlet> meshlets;
+    MeshVertexFormat vertexFormat;
+};
+
+} // namespace Lucky
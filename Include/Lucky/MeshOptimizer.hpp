@@ -0,0 +1,158 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include <Lucky/MeshArena.hpp>
+
+namespace Lucky {
+
+struct MeshData;
+struct SkinnedMeshData;
+struct Vertex3D;
+
+/**
+ * Post-transform vertex cache behavior of an index buffer, as measured
+ * by `AnalyzeVertexCache`.
+ */
+struct VertexCacheStatistics {
+    /** Vertices the simulated cache had to transform. */
+    uint32_t vertexTransforms = 0;
+
+    /**
+     * Average cache miss ratio: transforms per triangle. 3 is the worst
+     * case; well-ordered meshes land between 0.5 and 1.
+     */
+    float acmr = 0.0f;
+
+    /**
+     * Average transform to vertex ratio: transforms per vertex. 1 means
+     * every vertex was transformed exactly once.
+     */
+    float atvr = 0.0f;
+};
+
+/**
+ * Runs `indices` through a simulated FIFO post-transform cache of
+ * `cacheSize` entries and reports how many vertices it transformed.
+ *
+ * The FIFO model doesn't match any GPU exactly, but it tracks real
+ * hardware closely enough to compare two orderings of the same mesh.
+ */
+VertexCacheStatistics AnalyzeVertexCache(
+    const std::vector<uint32_t> &indices, size_t vertexCount, int cacheSize = 16);
+
+/**
+ * Merges vertices that are bitwise identical and rewrites the indices to
+ * match. Returns the new vertex count.
+ *
+ * Exporters often split vertices along seams that turn out to carry the
+ * same attributes, or emit unindexed triangles outright. Vertices that
+ * differ in any attribute, including joints and weights for skinned
+ * meshes, are kept apart. A `MeshData` must not have levels of detail
+ * yet.
+ */
+size_t DeduplicateVertices(MeshData &meshData);
+size_t DeduplicateVertices(SkinnedMeshData &meshData);
+
+/**
+ * Reorders triangles so that consecutive triangles share vertices,
+ * using Forsyth's greedy vertex cache optimization.
+ *
+ * Only the order changes: every triangle keeps its vertices and winding.
+ */
+void OptimizeVertexCache(std::vector<uint32_t> &indices, size_t vertexCount);
+
+/**
+ * Reorders clusters of triangles so that outward-facing ones draw first
+ * and occlude what's behind them, reducing overdraw.
+ *
+ * The index buffer is cut into clusters where the cut costs the vertex
+ * cache little: a cluster ends once its own miss ratio is within
+ * `threshold` of the whole mesh's. Clusters are then sorted by how far
+ * their average normal points away from the mesh center. Run it after
+ * `OptimizeVertexCache`, whose order the clusters keep. Clears any
+ * meshlets a `MeshData` has, since they no longer match.
+ */
+void OptimizeOverdraw(MeshData &meshData, float threshold = 1.05f);
+void OptimizeOverdraw(SkinnedMeshData &meshData, float threshold = 1.05f);
+
+/**
+ * Reorders vertices into the order the indices first use them, so the
+ * GPU reads the vertex buffer front to back, and drops vertices no index
+ * refers to. Returns the new vertex count. A `MeshData` must not have
+ * levels of detail yet.
+ */
+size_t OptimizeVertexFetch(MeshData &meshData);
+size_t OptimizeVertexFetch(SkinnedMeshData &meshData);
+
+/**
+ * Runs every stage above in order: deduplication, vertex cache, overdraw,
+ * vertex fetch.
+ *
+ * The glTF loader applies this to every primitive before creating its
+ * `Mesh` or `SkinnedMesh`. The result draws the same triangles with the
+ * same windings.
+ */
+void OptimizeMeshData(MeshData &meshData);
+void OptimizeMeshData(SkinnedMeshData &meshData);
+
+/**
+ * Simplifies the triangles in `indices` by collapsing edges, cheapest
+ * first by quadric error, until at most `targetIndexCount` indices are
+ * left or the next collapse would move the surface more than `maxError`
+ * mesh-local units. Returns the simplified indices, which refer to the
+ * same, unmodified `vertices`.
+ *
+ * Vertices on open borders and attribute seams (positions shared by
+ * vertices with different normals or UVs) never move, so outlines and
+ * texture layouts survive; a mesh made mostly of seams simplifies
+ * little. Collapses that would fold a triangle over are skipped.
+ *
+ * \param resultError receives the largest error of the collapses made,
+ *                    in mesh-local units, if not null.
+ */
+std::vector<uint32_t> SimplifyIndices(const std::vector<Vertex3D> &vertices,
+    const std::vector<uint32_t> &indices, size_t targetIndexCount, float maxError,
+    float *resultError = nullptr);
+
+/**
+ * Fills `meshData.lods` with up to `MaxMeshLods - 1` coarser levels of
+ * detail, each simplified from the one before to about half its
+ * triangles and then reordered for the vertex cache.
+ *
+ * Each level's error is the sum of the errors along the way, so it
+ * bounds the distance to the full mesh. Generation stops early when a
+ * level would remove less than a quarter of the triangles or exceed
+ * `maxError` times the mesh's bounding box diagonal, so small and
+ * seam-heavy meshes get fewer levels or none.
+ *
+ * The glTF loader runs this on every rigid primitive after
+ * `OptimizeMeshData`.
+ */
+void GenerateMeshLods(MeshData &meshData, float maxError = 0.05f);
+
+/**
+ * Splits `meshData` into meshlets of at most `maxTriangles` triangles
+ * and `maxVertices` distinct vertices each, filling `meshData.meshlets`
+ * and reordering the triangles so each meshlet's are contiguous.
+ *
+ * Meshlets grow from a seed triangle through triangles sharing its
+ * vertices, preferring ones that add few vertices and face the same way,
+ * so their bounding spheres stay small and their normal cones narrow.
+ * Seeds are taken in the current order, so run this after
+ * `OptimizeMeshData`; levels of detail are left alone.
+ *
+ * The new order replaces the one `OptimizeMeshData` chose: each
+ * meshlet's triangles are reordered for the vertex cache again, but
+ * `OptimizeOverdraw`'s front-to-back ordering only survives as far as
+ * meshlets are emitted roughly in the order of their seeds.
+ *
+ * The glTF loader runs this on large rigid primitives, which
+ * `ForwardRenderer` then culls cluster by cluster.
+ */
+void BuildMeshlets(MeshData &meshData, size_t maxTriangles = MeshletMaxTriangles,
+    size_t maxVertices = MeshletMaxVertices);
+
+} // namespace Lucky
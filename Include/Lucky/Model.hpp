@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdint.h>
 #include <memory>
 #include <string>
 #include <vector>
@@ -13,10 +14,15 @@
 
 namespace Lucky {
 
+struct CookedImageView;
+struct CookedMaterial;
 struct GraphicsDevice;
+struct RetainedScene;
 struct Sampler;
 struct Scene3D;
+struct SceneObjectHandle;
 struct Texture;
+struct ThreadPool;
 
 /**
  * One node in a `Model`'s rest hierarchy.
@@ -48,6 +54,16 @@ struct NodeTemplate {
     int skinIndex = -1;
 };
 
+/**
+ * Returns the indices of `nodes` ordered so every node comes after its
+ * parent, otherwise keeping their order. Walking nodes in this order,
+ * a parent's world transform is always ready before its children need
+ * it. A cycle, which a valid hierarchy never has, is cut where the
+ * walk up from its first node meets it again; every node is still
+ * returned exactly once.
+ */
+std::vector<int> SortNodesParentFirst(const std::vector<NodeTemplate> &nodes);
+
 /**
  * Which TRS component an animation channel targets.
  */
@@ -166,6 +182,31 @@ struct Skin {
  * (specular-glossiness, clearcoat, etc.). External-URI textures are
  * skipped. These will land alongside the matching consumers.
  *
+ * # Geometry
+ *
+ * All rigid primitives share one vertex and one index buffer, as do all
+ * skinned primitives: each `Mesh` and `SkinnedMesh` the model hands out
+ * is a view into its `MeshArena`, so consecutive draws of one model need
+ * no buffer rebinds. The views stay valid as long as the Model. The
+ * rigid arena can store its vertices in a compressed `MeshVertexFormat`.
+ *
+ * Each rigid primitive also gets up to three simplified levels of detail
+ * (see `GenerateMeshLods`), which `ForwardRenderer` swaps in as the
+ * object shrinks on screen. Large rigid primitives are also split into
+ * meshlets (see `BuildMeshlets`) so a partly visible one only draws the
+ * parts in view. Skinned primitives are kept whole and at full detail.
+ *
+ * # Cooked models
+ *
+ * `Cook` runs the whole import -- glTF parsing, accessor conversion,
+ * vertex cache optimization, simplification and image decoding -- once,
+ * offline, and writes the result to a versioned binary file (see
+ * `CookedModel.hpp`). The constructor recognizes a cooked file by its
+ * header and maps it instead of parsing it, uploading the geometry and
+ * pixels in place, so loading costs little more than reading the file.
+ * Images are stored decoded, which makes cooked files larger than their
+ * source: budget width * height * 4 bytes per texture.
+ *
  * # Lifetime
  *
  * Holds `Mesh` instances, each of which references the `GraphicsDevice`.
@@ -173,15 +214,41 @@ struct Skin {
  */
 struct Model {
     /**
-     * Loads a `.glb` or `.gltf` file into GPU buffers.
+     * Loads a `.glb`, `.gltf` or cooked model file into GPU buffers.
      *
      * \param graphicsDevice the graphics device that owns the GPU
      *                       resources. Must outlive this Model.
      * \param path filesystem path to the model file. Forward or back
      *             slashes both work on Windows.
-     * \throws std::runtime_error on parse, buffer-load, or upload failure.
+     * \param threadPool decodes the images and decodes and optimizes
+     *                   the primitives in parallel when given; null
+     *                   loads on the calling thread alone. Unused for
+     *                   cooked files, which need no processing. GPU
+     *                   uploads always happen on the calling thread.
+     * \param vertexFormat how to store the rigid meshes' vertices on the
+     *                     GPU. Skinned meshes are always stored as
+     *                     `Vertex3DSkinned`.
+     * \throws std::runtime_error on parse, buffer-load, or upload failure,
+     *                            or for a cooked file of another version.
      */
-    Model(GraphicsDevice &graphicsDevice, const std::string &path);
+    Model(GraphicsDevice &graphicsDevice, const std::string &path,
+        ThreadPool *threadPool = nullptr,
+        MeshVertexFormat vertexFormat = MeshVertexFormat::Standard);
+
+    /**
+     * Imports a `.glb` or `.gltf` file and writes it out as a cooked
+     * model file, which the constructor then loads without parsing or
+     * decoding anything. Needs no `GraphicsDevice`, so it can run in an
+     * asset build step.
+     *
+     * \param sourcePath the glTF file to import.
+     * \param cookedPath where to write the cooked file. Overwritten if
+     *                   it exists.
+     * \param threadPool as for the constructor.
+     * \throws std::runtime_error on parse, buffer-load, or write failure.
+     */
+    static void Cook(const std::string &sourcePath, const std::string &cookedPath,
+        ThreadPool *threadPool = nullptr);
 
     Model(const Model &) = delete;
     Model &operator=(const Model &) = delete;
@@ -309,7 +376,8 @@ struct Model {
      *
      * Output is sized to `GetNodeCount()`. `rootTransform` is left-
      * multiplied so the model can be placed in the scene without
-     * touching the per-node TRS data.
+     * touching the per-node TRS data. The rest pose itself is resolved
+     * once at load, so this costs one multiply per node.
      */
     void ComputeRestWorldTransforms(
         std::vector<glm::mat4> &out, const glm::mat4 &rootTransform = glm::mat4(1.0f)) const;
@@ -325,11 +393,53 @@ struct Model {
      * per-instance content, use `ModelInstance` instead. Non-const
      * because it hands out non-const pointers into the model's
      * material storage.
+     *
+     * Objects are appended parent node first. The rest-pose transforms
+     * are cached at load, so each call costs one multiply per object
+     * and allocates nothing beyond `scene.objects` growth.
      */
     void AppendToScene(Scene3D &scene, const glm::mat4 &rootTransform = glm::mat4(1.0f),
         const glm::vec3 &colorTint = glm::vec3(1.0f));
 
+    /**
+     * Appends one copy of the model per entry in `rootTransforms`, as
+     * `AppendToScene` would for each in turn, growing `scene.objects`
+     * once for all of them. Use it to place many static copies of a
+     * model in a frame.
+     */
+    void AppendInstancesToScene(Scene3D &scene, const std::vector<glm::mat4> &rootTransforms,
+        const glm::vec3 &colorTint = glm::vec3(1.0f));
+
+    /**
+     * Like `AppendToScene`, but adds the objects to a retained scene
+     * once and appends their handles to `handles`, so the model can
+     * later be moved or removed without rebuilding the scene.
+     */
+    void AddToScene(RetainedScene &scene, std::vector<SceneObjectHandle> &handles,
+        const glm::mat4 &rootTransform = glm::mat4(1.0f),
+        const glm::vec3 &colorTint = glm::vec3(1.0f));
+
   private:
+    void LoadMaterials(GraphicsDevice &graphicsDevice,
+        const std::vector<CookedMaterial> &cookedMaterials,
+        const std::vector<CookedImageView> &images);
+
+    // Resolves the rest pose into restWorldTransforms and restMeshNodes.
+    // Runs once, after nodes and meshes are loaded.
+    void BuildRestPose();
+
+    // A node that carries meshes, with its rest-pose world transform
+    // under an identity root and its run of restMeshIndices.
+    struct RestMeshNode {
+        glm::mat4 worldTransform;
+        uint32_t firstMesh = 0;
+        uint32_t meshCount = 0;
+    };
+
+    // Every mesh is a view into one of these; see MeshArena. Declared
+    // before the views so they outlive them.
+    std::unique_ptr<MeshArena<Vertex3D>> meshArena;
+    std::unique_ptr<MeshArena<Vertex3DSkinned>> skinnedMeshArena;
     std::vector<std::unique_ptr<Mesh>> meshes;
     std::vector<int> meshMaterialIndices; // parallel to meshes; -1 = no material
     std::vector<std::unique_ptr<SkinnedMesh>> skinnedMeshes;
@@ -340,6 +450,9 @@ struct Model {
     std::unique_ptr<Sampler> materialSampler;
     std::vector<AnimationDef> animations;
     std::vector<Skin> skins;
+    std::vector<glm::mat4> restWorldTransforms; // parallel to nodes
+    std::vector<RestMeshNode> restMeshNodes;    // parents before children
+    std::vector<int> restMeshIndices;
 };
 
 } // namespace Lucky
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Lucky/Bounds.hpp>
+
+namespace Lucky {
+
+struct MeshData;
+
+/**
+ * Triangle geometry for the CPU occlusion culler: positions only,
+ * indexed as a triangle list.
+ *
+ * Occluders should be simple and sit inside the surfaces they stand in
+ * for -- a wall's occluder is a box no larger than the wall -- since
+ * anything they cover is skipped.
+ */
+struct OccluderMesh {
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+};
+
+/**
+ * Copies the positions and indices of `meshData` into an occluder.
+ *
+ * Suitable for meshes that are already low-poly and closed, like the
+ * generated boxes and planes; detailed meshes should get a hand-made
+ * stand-in instead.
+ */
+OccluderMesh MakeOccluderMesh(const MeshData &meshData);
+
+/**
+ * A low-resolution CPU depth buffer for skipping objects hidden behind
+ * large occluders.
+ *
+ * # Usage
+ *
+ * Each frame, per view: call `Begin` with the view-projection, feed
+ * every occluder through `RasterizeOccluder`, then ask `IsVisible` for
+ * each object's world bounds. Objects whose bounds are behind the
+ * occluders at every pixel they cover are reported hidden.
+ *
+ * # Precision
+ *
+ * Depth uses the renderer's zero-to-one clip convention and the buffer
+ * keeps the nearest occluder depth per pixel, sampled at pixel centers.
+ * Triangles crossing the near plane are skipped rather than clipped,
+ * and bounds crossing it are always visible, so both simplifications
+ * only ever keep objects. Occluder edges are resolved at buffer
+ * resolution, which is why occluders should be inset slightly.
+ *
+ * Rasterization and testing process four pixels at a time with SSE2
+ * where available and fall back to scalar code elsewhere; both paths
+ * evaluate the same expressions, so results don't depend on the
+ * platform. Nothing touches the GPU, so the culler can be used and
+ * tested headlessly.
+ */
+struct OcclusionCuller {
+    /**
+     * Allocates a `width` x `height` depth buffer. `width` is rounded up
+     * to a multiple of four.
+     */
+    explicit OcclusionCuller(uint32_t width = 256, uint32_t height = 128);
+
+    /** Clears the buffer to the far plane and sets the view to cull for. */
+    void Begin(const glm::mat4 &viewProjection);
+
+    /** Rasterizes `occluder`, placed in the world by `transform`. */
+    void RasterizeOccluder(const OccluderMesh &occluder, const glm::mat4 &transform);
+
+    /**
+     * Returns false if every buffer pixel under `worldBounds` holds an
+     * occluder nearer than the box's nearest point. Empty boxes are
+     * never visible.
+     */
+    bool IsVisible(const BoundingBox &worldBounds) const;
+
+    uint32_t GetWidth() const {
+        return width;
+    }
+
+    uint32_t GetHeight() const {
+        return height;
+    }
+
+    /** Returns the stored depth at pixel (`x`, `y`); 1 is the far plane. */
+    float GetDepth(uint32_t x, uint32_t y) const {
+        return depth[y * width + x];
+    }
+
+  private:
+    void RasterizeTriangle(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c);
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    std::vector<float> depth;
+    std::vector<glm::vec4> clipPositions;
+};
+
+} // namespace Lucky
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Lucky/Scene3D.hpp>
+
+namespace Lucky {
+
+/**
+ * Names one object in a `RetainedScene`. Default-constructed handles
+ * name nothing; a removed object's handle stays invalid even after its
+ * slot is reused.
+ */
+struct SceneObjectHandle {
+    uint32_t slot = 0xFFFFFFFFu;
+    uint32_t generation = 0;
+};
+
+/** Names one skinned object in a `RetainedScene`. */
+struct SkinnedSceneObjectHandle {
+    uint32_t slot = 0xFFFFFFFFu;
+    uint32_t generation = 0;
+};
+
+/**
+ * A `Scene3D` that is kept from frame to frame and edited in place, with
+ * stable handles for its objects and a record of what changed.
+ *
+ * # Usage
+ *
+ * Add each object once and keep the returned handle; move it with
+ * `SetObjectTransform` or replace it with `UpdateObject`, and remove it
+ * when it goes away. Unlike clearing and refilling a `Scene3D`, nothing
+ * is done for objects that didn't change. `GetScene` exposes the result
+ * as a plain `Scene3D`, so everything that reads one still works;
+ * `ForwardRenderer` additionally has an overload that takes the
+ * retained scene and repacks only the changed objects.
+ *
+ * # Ordering
+ *
+ * `GetScene().objects` stays dense: removing an object moves the last
+ * one into its place. `GetObjectIndex` maps a handle to its current
+ * position.
+ *
+ * # Changes
+ *
+ * Every position in `GetScene().objects` whose contents changed since
+ * the last `ClearChanges` -- added, updated, or filled by a move after a
+ * removal -- is listed once in `GetChangedObjects`. Removals shrink the
+ * vector, so a consumer that mirrors the objects resizes to the new
+ * count and refreshes the listed positions. Call `ClearChanges` once
+ * every consumer has seen the frame's changes, typically after
+ * rendering; a consumer that skips a frame must resynchronize from
+ * scratch. `GetChangeEpoch` tells a consumer whether it has.
+ *
+ * Skinned objects are tracked by handle too, but not for changes: their
+ * joint matrices live outside the scene and are re-read every frame.
+ */
+struct RetainedScene {
+    /** Adds `object` and returns its handle. */
+    SceneObjectHandle AddObject(const SceneObject &object);
+
+    /**
+     * Removes the object named by `handle`.
+     *
+     * \returns false if `handle` doesn't name a live object.
+     */
+    bool RemoveObject(SceneObjectHandle handle);
+
+    /** Returns true if `handle` names a live object. */
+    bool Contains(SceneObjectHandle handle) const;
+
+    /** Returns the object named by `handle`, which must be live. */
+    const SceneObject &GetObject(SceneObjectHandle handle) const;
+
+    /** Replaces the object named by `handle`, which must be live. */
+    void UpdateObject(SceneObjectHandle handle, const SceneObject &object);
+
+    /** Moves the object named by `handle`, which must be live. */
+    void SetObjectTransform(SceneObjectHandle handle, const glm::mat4 &transform);
+
+    /** Returns the position of a live object in `GetScene().objects`. */
+    uint32_t GetObjectIndex(SceneObjectHandle handle) const;
+
+    /** Adds `object` and returns its handle. */
+    SkinnedSceneObjectHandle AddSkinnedObject(const SkinnedSceneObject &object);
+
+    /**
+     * Removes the skinned object named by `handle`.
+     *
+     * \returns false if `handle` doesn't name a live skinned object.
+     */
+    bool RemoveSkinnedObject(SkinnedSceneObjectHandle handle);
+
+    /** Returns true if `handle` names a live skinned object. */
+    bool Contains(SkinnedSceneObjectHandle handle) const;
+
+    /** Replaces the skinned object named by `handle`, which must be live. */
+    void UpdateSkinnedObject(SkinnedSceneObjectHandle handle, const SkinnedSceneObject &object);
+
+    /**
+     * Removes every object and skinned object; lights are kept. Also
+     * starts a change run no consumer is in sync with.
+     */
+    void Clear();
+
+    /** Lights are plain data and can be edited freely. */
+    std::vector<Light> &GetLights() {
+        return scene.lights;
+    }
+
+    void SetAmbientColor(const glm::vec3 &color) {
+        scene.ambientColor = color;
+    }
+
+    /** Returns the current contents as a plain scene. */
+    const Scene3D &GetScene() const {
+        return scene;
+    }
+
+    /** Returns the positions in `GetScene().objects` changed since `ClearChanges`. */
+    const std::vector<uint32_t> &GetChangedObjects() const {
+        return changedObjects;
+    }
+
+    /** Forgets the recorded changes. */
+    void ClearChanges();
+
+    /**
+     * Returns the number naming the current run of recorded changes.
+     * Every `ClearChanges` starts a new run, and no two runs share a
+     * number, even across different RetainedScenes; zero is never used.
+     *
+     * A consumer that mirrored the scene during run `E` is still in sync
+     * after refreshing `GetChangedObjects` if the current run is `E`
+     * (nothing was cleared since) or directly follows it
+     * (`GetPreviousChangeEpoch() == E`). Otherwise it missed changes and
+     * must resynchronize from scratch.
+     */
+    uint64_t GetChangeEpoch() const {
+        return changeEpoch;
+    }
+
+    /** Returns the run `ClearChanges` last ended, or zero if none. */
+    uint64_t GetPreviousChangeEpoch() const {
+        return previousChangeEpoch;
+    }
+
+  private:
+    // Maps handle slots to positions in one of the scene's vectors and
+    // back. Freed slots are reused with a bumped generation, so stale
+    // handles never resolve.
+    struct SlotTable {
+        std::vector<uint32_t> indices;
+        std::vector<uint32_t> generations;
+        std::vector<uint32_t> freeSlots;
+        std::vector<uint32_t> slotsByIndex;
+
+        uint32_t Add(uint32_t &generation);
+        uint32_t Find(uint32_t slot, uint32_t generation) const;
+        // Frees `slot`, whose element is swapped with the last one and
+        // popped by the caller; returns the freed element's position.
+        uint32_t Remove(uint32_t slot);
+        void Clear();
+    };
+
+    void MarkChanged(uint32_t index);
+
+    static uint64_t NextChangeEpoch();
+
+    Scene3D scene;
+    SlotTable objectSlots;
+    SlotTable skinnedSlots;
+    std::vector<uint32_t> changedObjects;
+    std::vector<bool> objectChanged;
+    uint64_t changeEpoch = NextChangeEpoch();
+    uint64_t previousChangeEpoch = 0;
+};
+
+} // namespace Lucky
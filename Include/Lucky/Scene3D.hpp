@@ -8,6 +8,7 @@ namespace Lucky {
 
 struct Material;
 struct Mesh;
+struct OccluderMesh;
 struct SkinnedMesh;
 
 /**
@@ -42,10 +43,17 @@ enum class LightType {
  *
  * # Shadows
  *
- * `castsShadows = true` opts a `Directional`/`Spot` light into a 2D shadow
- * map and a `Point` light into a cube shadow map. The renderer enforces
- * the per-frame caps (4 directional/spot, 2 point) by rejecting extras
- * silently rather than asserting.
+ * `castsShadows = true` gives the light space in the renderer's shadow
+ * atlas: one tile for a `Directional`/`Spot` light, six (one per cube
+ * face) for a `Point` light. Tile resolution follows the light's
+ * importance and screen coverage; when the atlas runs out, the least
+ * important lights lose their shadow silently rather than asserting.
+ *
+ * `isStatic = true` promises the light rarely moves or changes. The
+ * renderer then caches the depth of static casters (`SceneObject::
+ * isStatic`) in a separate atlas and only redraws dynamic casters each
+ * frame. Changes to a static light are still detected; they just cost
+ * a rebuild of its cache.
  */
 struct Light {
     LightType type = LightType::Directional;
@@ -66,6 +74,9 @@ struct Light {
     float outerCone = 0.85f;
 
     bool castsShadows = false;
+
+    /** Opts the light's shadow tiles into static-caster caching. */
+    bool isStatic = false;
 };
 
 /**
@@ -81,12 +92,25 @@ struct Light {
  * `color` is multiplied into the material's `baseColorFactor` before
  * lighting. Useful for tinting the same loaded model in different
  * colors without cloning materials.
+ *
+ * `isStatic` marks geometry that rarely moves. Static objects lit by a
+ * static light are rendered into that light's cached shadow tiles
+ * instead of its per-frame ones; moving a static object is allowed but
+ * invalidates the caches of every static light that sees it.
+ *
+ * `occluder` optionally marks the object as a large occluder (a wall,
+ * floor, or building) for `ForwardRenderOptions::occlusionCulling`. It
+ * is a non-owned, simplified stand-in placed by `transform`, and should
+ * stay inside the visible mesh. Occluders themselves are never culled
+ * by occlusion.
  */
 struct SceneObject {
     Mesh *mesh = nullptr;
     Material *material = nullptr;
     glm::mat4 transform = glm::mat4(1.0f);
     glm::vec3 color = {1.0f, 1.0f, 1.0f};
+    bool isStatic = false;
+    const OccluderMesh *occluder = nullptr;
 };
 
 /**
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Lucky/Bounds.hpp>
+
+namespace Lucky {
+
+struct Scene3D;
+
+/**
+ * A half-line from `origin` along `direction`. `direction` need not be
+ * normalized; distances along the ray are in multiples of its length.
+ */
+struct Ray {
+    glm::vec3 origin = {0.0f, 0.0f, 0.0f};
+    glm::vec3 direction = {0.0f, 0.0f, -1.0f};
+};
+
+/** The nearest item box a ray enters, from `SceneBVH::Raycast`. */
+struct SceneBVHHit {
+    uint32_t item = 0;
+    float distance = 0.0f;
+};
+
+/**
+ * A bounding volume hierarchy over world-space boxes, for answering
+ * visibility and picking queries in logarithmic rather than linear time.
+ *
+ * # Items
+ *
+ * Items are numbered `[0, GetItemCount())` in the order their boxes were
+ * handed to `Build`. Built from a `Scene3D`, item `i` is
+ * `scene.objects[i]`, bounded by its mesh bounds placed by its
+ * transform; objects without a mesh get an empty box. Items with empty
+ * boxes are kept, so indices stay aligned, but never match a query.
+ *
+ * # Updating
+ *
+ * `Build` constructs the tree from scratch, splitting each node at the
+ * median of its items' centers along the widest axis. When items move
+ * but none are added or removed, `SetItemBounds` followed by `Refit`
+ * updates only the nodes above the changed items, keeping the tree's
+ * shape. Refitting is much cheaper than rebuilding but lets node boxes
+ * grow and overlap as items wander from where they were built, so
+ * rebuild once the scene has changed substantially.
+ *
+ * # Queries
+ *
+ * Queries append matching item indices to `results` without clearing
+ * it, in no particular order. Like `IntersectsFrustum`, they test boxes,
+ * so they may report items whose geometry doesn't actually touch the
+ * query volume, but never miss one whose box does.
+ */
+struct SceneBVH {
+    /** Items per leaf node at most. */
+    static constexpr uint32_t MaxLeafItems = 4;
+
+    /** Rebuilds the tree over `itemBounds`. */
+    void Build(const std::vector<BoundingBox> &itemBounds);
+
+    /** Rebuilds the tree over the world bounds of `scene.objects`. */
+    void Build(const Scene3D &scene);
+
+    /**
+     * Replaces the box of `item`. The tree's node boxes are stale until
+     * the next `Refit`.
+     */
+    void SetItemBounds(uint32_t item, const BoundingBox &bounds);
+
+    /**
+     * Re-reads the world bounds of every object in `scene`, which must
+     * have the same number of objects as when the tree was built, and
+     * marks the ones that changed. Call `Refit` afterwards.
+     */
+    void UpdateItemBounds(const Scene3D &scene);
+
+    /** Brings node boxes up to date with every changed item. */
+    void Refit();
+
+    /** Appends the items whose boxes intersect `frustum`. */
+    void QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &results) const;
+
+    /** Appends the items whose boxes overlap the sphere. */
+    void QuerySphere(
+        const glm::vec3 &center, float radius, std::vector<uint32_t> &results) const;
+
+    /**
+     * Appends the items whose boxes the ray passes through within
+     * `maxDistance` of its origin.
+     */
+    void QueryRay(const Ray &ray, float maxDistance, std::vector<uint32_t> &results) const;
+
+    /**
+     * Finds the item whose box the ray enters first within
+     * `maxDistance`; a ray starting inside a box enters it at zero.
+     *
+     * \returns true and fills `hit` if any box was hit.
+     */
+    bool Raycast(const Ray &ray, float maxDistance, SceneBVHHit &hit) const;
+
+    uint32_t GetItemCount() const {
+        return static_cast<uint32_t>(itemBounds.size());
+    }
+
+    uint32_t GetNodeCount() const {
+        return static_cast<uint32_t>(nodes.size());
+    }
+
+    /** Returns the box of `item` as last set. */
+    const BoundingBox &GetItemBounds(uint32_t item) const {
+        return itemBounds[item];
+    }
+
+    /** Returns the box enclosing every item; empty for an empty tree. */
+    BoundingBox GetBounds() const {
+        return nodes.empty() ? BoundingBox{} : nodes[0].bounds;
+    }
+
+  private:
+    // Children of an inner node are allocated together, so the right
+    // child is always `first + 1`; leaves own `items[first, first +
+    // count)`. Parents always precede their children in `nodes`.
+    struct Node {
+        BoundingBox bounds;
+        uint32_t first = 0;
+        uint32_t count = 0;
+        uint32_t parent = 0;
+        bool dirty = false;
+
+        bool IsLeaf() const {
+            return count > 0;
+        }
+    };
+
+    void BuildNode(uint32_t node, uint32_t begin, uint32_t end);
+    void RefitNode(Node &node) const;
+
+    template <typename Overlaps>
+    void Query(const Overlaps &overlaps, std::vector<uint32_t> &results) const;
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> items;
+    std::vector<BoundingBox> itemBounds;
+    std::vector<uint32_t> itemLeaves;
+    std::vector<glm::vec3> centers;
+    std::vector<uint32_t> dirtyNodes;
+};
+
+} // namespace Lucky
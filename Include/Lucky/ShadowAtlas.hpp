@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace Lucky {
+
+/**
+ * A request for square tiles in a shadow atlas.
+ *
+ * `size` is the desired edge length in texels and must be a power of
+ * two; `count` tiles of that size are allocated together (6 for the
+ * faces of a point light, 1 otherwise). `priority` decides who gives
+ * up resolution first when the atlas is over-subscribed: higher is
+ * more important.
+ */
+struct ShadowTileRequest {
+    uint32_t size = 0;
+    uint32_t count = 1;
+    float priority = 0.0f;
+};
+
+/**
+ * One square tile of a shadow atlas, in texels from the top-left
+ * corner.
+ */
+struct ShadowAtlasTile {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t size = 0;
+};
+
+/**
+ * Result of `PackShadowAtlas`.
+ *
+ * `tiles` holds every allocated tile. `firstTile[i]` is the index of
+ * request `i`'s first tile in `tiles`, with its `count` tiles stored
+ * consecutively, or -1 if the request was dropped.
+ */
+struct ShadowAtlasLayout {
+    std::vector<ShadowAtlasTile> tiles;
+    std::vector<int> firstTile;
+};
+
+/**
+ * Assigns each request a set of non-overlapping tiles in a square atlas
+ * of `atlasSize` texels.
+ *
+ * Requested sizes are clamped to `[minTileSize, atlasSize]`. While the
+ * requests do not fit -- by area or by the `maxTiles` limit -- the
+ * lowest-priority request above `minTileSize` is halved; once every
+ * survivor is at `minTileSize`, the lowest-priority request is dropped.
+ * Ties go against the later request.
+ *
+ * Placement sorts tiles by size (largest first, then by request order)
+ * and walks a Morton-order cursor over the atlas in units of
+ * `minTileSize`. Because every size is a power of two and sizes only
+ * shrink along the walk, each tile lands on a cell aligned to its own
+ * size and no space is wasted. The layout depends only on the final
+ * sizes and request order, so unchanged requests produce an unchanged
+ * layout frame to frame.
+ *
+ * \param requests the tiles wanted, in a stable order.
+ * \param atlasSize atlas edge length. Must be a power of two.
+ * \param minTileSize smallest tile handed out. Must be a power of two
+ *                    no larger than `atlasSize`.
+ * \param maxTiles upper bound on the total number of tiles.
+ */
+ShadowAtlasLayout PackShadowAtlas(const std::vector<ShadowTileRequest> &requests,
+    uint32_t atlasSize, uint32_t minTileSize, uint32_t maxTiles);
+
+/**
+ * Returns the power-of-two tile edge that gives at least one shadow
+ * texel per pixel for a light covering `coveragePixels` on screen,
+ * clamped to `[minTileSize, maxTileSize]`.
+ */
+uint32_t ShadowTileSizeForCoverage(
+    float coveragePixels, uint32_t minTileSize, uint32_t maxTileSize);
+
+} // namespace Lucky
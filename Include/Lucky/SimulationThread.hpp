@@ -0,0 +1,114 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <Lucky/FrameSnapshot.hpp>
+
+namespace Lucky {
+
+/**
+ * Runs a game's simulation on a thread of its own, one frame ahead of
+ * rendering, handing each finished frame over as a `FrameSnapshot`.
+ *
+ * # Usage
+ *
+ * Construct it with the function that advances the simulation by one
+ * step and captures the result into the snapshot it is given. Once per
+ * frame on the rendering thread, call `Step` with the frame's delta
+ * time, then draw `GetRenderSnapshot`:
+ *
+ *     simulationThread.Step(deltaSeconds);
+ *     if (const FrameSnapshot *snapshot = simulationThread.GetRenderSnapshot()) {
+ *         forwardRenderer.Render(snapshot->scene, snapshot->views, options);
+ *     }
+ *
+ * `Step` waits for the step started by the previous call, publishes its
+ * snapshot for rendering, and starts the next step. While the rendering
+ * thread records the GPU commands for frame N, the simulation thread
+ * computes frame N+1, so a frame costs the longer of the two instead of
+ * their sum, at the price of one frame of latency. The first call has
+ * nothing to publish yet and `GetRenderSnapshot` returns null until the
+ * second.
+ *
+ * # Threads
+ *
+ * SDL only allows the swapchain to be acquired on the thread that
+ * created the window, and a `GraphicsDevice` is bound to that thread, so
+ * rendering stays where it is and the simulation is what moves. The
+ * simulate function must therefore not touch the `GraphicsDevice` or any
+ * renderer, and anything it shares with the rendering thread (input,
+ * settings) must be handed over explicitly; the snapshot is the only
+ * thing passed back.
+ *
+ * # Double buffering
+ *
+ * Two snapshots alternate: the simulation writes one while the renderer
+ * reads the other, and `Step` swaps them. The snapshot returned by
+ * `GetRenderSnapshot` stays valid and unchanged until the next `Step`.
+ * The simulate function receives its snapshot with the contents of two
+ * frames earlier; calling `FrameSnapshot::Clear` first reuses its
+ * allocations.
+ *
+ * # Errors
+ *
+ * An exception thrown by the simulate function is rethrown from the
+ * next `Step`, which then starts no new step.
+ *
+ * # Lifetime
+ *
+ * The destructor waits for a step in progress to finish, then joins the
+ * thread.
+ */
+struct SimulationThread {
+    /** Advances the simulation by `deltaSeconds` and captures the result into `snapshot`. */
+    using SimulateFunction = std::function<void(float deltaSeconds, FrameSnapshot &snapshot)>;
+
+    explicit SimulationThread(SimulateFunction simulate);
+
+    SimulationThread(const SimulationThread &) = delete;
+    SimulationThread &operator=(const SimulationThread &) = delete;
+    SimulationThread(SimulationThread &&) = delete;
+    SimulationThread &operator=(SimulationThread &&) = delete;
+
+    ~SimulationThread();
+
+    /**
+     * Waits for the previous step, publishes its snapshot, and starts a
+     * step of `deltaSeconds` on the simulation thread.
+     */
+    void Step(float deltaSeconds);
+
+    /** Waits for the step in progress, if any, without starting another. */
+    void Wait();
+
+    /** Returns the most recently published snapshot, or null before the first. */
+    const FrameSnapshot *GetRenderSnapshot() const {
+        return renderSnapshot;
+    }
+
+  private:
+    void ThreadLoop();
+
+    SimulateFunction simulate;
+    FrameSnapshot snapshots[2];
+    const FrameSnapshot *renderSnapshot = nullptr;
+
+    // Guarded by `mutex`.
+    int simulatingIndex = 0;
+    float pendingDeltaSeconds = 0.0f;
+    bool stepPending = false;
+    bool stepFinished = false;
+    bool stopping = false;
+    std::exception_ptr error;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::thread thread;
+};
+
+} // namespace Lucky
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <stdint.h>
+#include <memory>
 #include <vector>
 
+#include <Lucky/Bounds.hpp>
 #include <Lucky/IndexBuffer.hpp>
+#include <Lucky/MeshArena.hpp>
 #include <Lucky/VertexBuffer.hpp>
 
 namespace Lucky {
@@ -53,7 +56,8 @@ struct SkinnedMeshData {
  * static.
  *
  * Mirrors `Mesh` but stores `Vertex3DSkinned` in the vertex buffer.
- * The renderer routes it through the skinned forward pipeline.
+ * The renderer routes it through the skinned forward pipeline. Like
+ * `Mesh`, it can instead be a view into a `MeshArena`.
  *
  * # Lifetime
  *
@@ -86,6 +90,12 @@ struct SkinnedMesh {
      */
     SkinnedMesh(GraphicsDevice &graphicsDevice, const SkinnedMeshData &data);
 
+    /**
+     * Makes a view of the mesh at `rangeIndex` in `arena`. Uploads
+     * nothing; the view draws from the arena's buffers.
+     */
+    SkinnedMesh(const MeshArena<Vertex3DSkinned> &arena, int rangeIndex);
+
     SkinnedMesh(const SkinnedMesh &) = delete;
     SkinnedMesh &operator=(const SkinnedMesh &) = delete;
     SkinnedMesh(SkinnedMesh &&) = delete;
@@ -94,11 +104,26 @@ struct SkinnedMesh {
     ~SkinnedMesh() = default;
 
     SDL_GPUBuffer *GetVertexBuffer() const {
-        return vertexBuffer.GetGPUBuffer();
+        return vertexGpuBuffer;
     }
 
     SDL_GPUBuffer *GetIndexBuffer() const {
-        return indexBuffer.GetGPUBuffer();
+        return indexGpuBuffer;
+    }
+
+    /** Returns the size of the stored indices, as `Mesh` picks it. */
+    SDL_GPUIndexElementSize GetIndexElementSize() const {
+        return indexElementSize;
+    }
+
+    /** Returns the mesh's first index in `GetIndexBuffer()`. */
+    uint32_t GetFirstIndex() const {
+        return firstIndex;
+    }
+
+    /** Returns the mesh's first vertex in `GetVertexBuffer()`. */
+    uint32_t GetBaseVertex() const {
+        return baseVertex;
     }
 
     uint32_t GetVertexCount() const {
@@ -109,11 +134,29 @@ struct SkinnedMesh {
         return indexCount;
     }
 
+    /**
+     * Returns the mesh-local bounding box of the vertex positions,
+     * computed once at upload time.
+     *
+     * Covers the bind pose only; a skinned draw's world-space extent
+     * depends on its joint matrices.
+     */
+    const BoundingBox &GetBounds() const {
+        return bounds;
+    }
+
   private:
-    VertexBuffer<Vertex3DSkinned> vertexBuffer;
-    IndexBuffer<uint32_t> indexBuffer;
+    // Null for a view into a MeshArena.
+    std::unique_ptr<VertexBuffer<Vertex3DSkinned>> vertexBuffer;
+    std::unique_ptr<CompactIndexBuffer> indexBuffer;
+    SDL_GPUBuffer *vertexGpuBuffer = nullptr;
+    SDL_GPUBuffer *indexGpuBuffer = nullptr;
+    SDL_GPUIndexElementSize indexElementSize;
+    uint32_t firstIndex = 0;
+    uint32_t baseVertex = 0;
     uint32_t vertexCount;
     uint32_t indexCount;
+    BoundingBox bounds;
 };
 
 } // namespace Lucky
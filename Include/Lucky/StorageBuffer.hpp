@@ -0,0 +1,290 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_gpu.h>
+#include <Lucky/GraphicsDevice.hpp>
+
+namespace Lucky {
+
+/**
+ * A run of consecutive elements, `[first, first + count)`.
+ */
+struct ElementRange {
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
+/**
+ * Compares `current` against `previous` element by element and returns
+ * the runs of elements that differ.
+ *
+ * Elements past `previousCount` are always reported as changed.
+ * Changed runs separated by fewer than `mergeGap` unchanged elements
+ * are merged into one range: re-sending a few unchanged elements is
+ * cheaper than issuing another upload. Comparison is bytewise, so
+ * `T` must be trivially copyable and any padding must be zeroed.
+ */
+template <typename T>
+std::vector<ElementRange> FindChangedRanges(const T *previous, uint32_t previousCount,
+    const T *current, uint32_t currentCount, uint32_t mergeGap = 4) {
+    static_assert(std::is_trivially_copyable_v<T>, "FindChangedRanges compares raw bytes");
+
+    std::vector<ElementRange> ranges;
+    for (uint32_t i = 0; i < currentCount; i++) {
+        const bool changed =
+            i >= previousCount || memcmp(&previous[i], &current[i], sizeof(T)) != 0;
+        if (!changed) {
+            continue;
+        }
+        if (!ranges.empty()) {
+            ElementRange &last = ranges.back();
+            if (i - (last.first + last.count) < mergeGap) {
+                last.count = i + 1 - last.first;
+                continue;
+            }
+        }
+        ranges.push_back({i, 1});
+    }
+    return ranges;
+}
+
+/**
+ * A typed GPU storage buffer that stays resident across frames and
+ * uploads only the elements that changed.
+ *
+ * Keeps a CPU copy of the last uploaded contents. Each `SetData` call
+ * diffs the new array against that copy and copies only the changed
+ * ranges, so a mostly-static array (object transforms, material
+ * parameters) costs an upload proportional to what moved, not to its
+ * size. By default the buffer is created with `GRAPHICS_STORAGE_READ`
+ * usage for binding with `SDL_BindGPUVertexStorageBuffers` /
+ * `SDL_BindGPUFragmentStorageBuffers`; pass other usage flags to read
+ * it from compute shaders or draw from it indirectly.
+ *
+ * Capacity grows to the next power of two when `SetData` is handed more
+ * elements than fit; growing recreates the buffer and uploads
+ * everything once.
+ *
+ * `T` must be trivially copyable and match the HLSL `StructuredBuffer`
+ * element layout, padding included.
+ *
+ * # Lifetime
+ *
+ * Holds a pointer to the `GraphicsDevice`. The `GraphicsDevice` must
+ * outlive this buffer.
+ */
+template <typename T> struct StorageBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "StorageBuffer elements are copied bytewise");
+
+    /**
+     * Constructs an empty storage buffer with room for `initialCapacity`
+     * elements.
+     *
+     * \param graphicsDevice the graphics device. Must outlive this buffer.
+     * \param initialCapacity number of elements to allocate up front.
+     *                        Must be positive.
+     * \param usage how the GPU may access the buffer.
+     */
+    StorageBuffer(GraphicsDevice &graphicsDevice, uint32_t initialCapacity,
+        SDL_GPUBufferUsageFlags usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ)
+        : graphicsDevice(&graphicsDevice), usage(usage) {
+        SDL_assert(initialCapacity > 0);
+        Allocate(initialCapacity);
+    }
+
+    StorageBuffer(const StorageBuffer &) = delete;
+    StorageBuffer &operator=(const StorageBuffer &) = delete;
+    StorageBuffer(StorageBuffer &&) = delete;
+    StorageBuffer &operator=(StorageBuffer &&) = delete;
+
+    ~StorageBuffer() {
+        Release();
+    }
+
+    /**
+     * Makes the buffer hold `elements[0..count)`, uploading only the
+     * elements that differ from the previous contents.
+     *
+     * Internally calls `BeginCopyPass` / `EndCopyPass` on the
+     * `GraphicsDevice` when anything changed, which auto-ends any
+     * active render pass. Call between passes.
+     *
+     * \param elements new contents. May be null only when `count` is 0.
+     * \param count number of elements.
+     * \returns the number of elements uploaded.
+     */
+    uint32_t SetData(const T *elements, uint32_t count) {
+        if (!Stage(elements, count)) {
+            return 0;
+        }
+
+        graphicsDevice->BeginCopyPass();
+        SDL_GPUCopyPass *copyPass = graphicsDevice->GetCurrentCopyPass();
+        if (!copyPass) {
+            // Nothing reached the GPU; force a full upload next time.
+            shadow.clear();
+            return 0;
+        }
+        const uint32_t uploaded = Upload(copyPass);
+        graphicsDevice->EndCopyPass();
+        return uploaded;
+    }
+
+    /**
+     * Like `SetData(elements, count)`, but records the uploads into
+     * `copyPass` instead of a copy pass on the `GraphicsDevice`'s
+     * command buffer.
+     *
+     * Use this when the data must reach the GPU ahead of that command
+     * buffer, e.g. from a separate upload command buffer submitted
+     * before work recorded on other threads.
+     *
+     * \param copyPass an open copy pass. Must not be null.
+     * \param elements new contents. May be null only when `count` is 0.
+     * \param count number of elements.
+     * \returns the number of elements uploaded.
+     */
+    uint32_t SetData(SDL_GPUCopyPass *copyPass, const T *elements, uint32_t count) {
+        SDL_assert(copyPass != nullptr);
+        if (!Stage(elements, count)) {
+            return 0;
+        }
+        return Upload(copyPass);
+    }
+
+    /**
+     * Forgets what the GPU holds, so the next `SetData` uploads every
+     * element. Call this when uploads recorded with the copy-pass
+     * overload never reached the GPU.
+     */
+    void Invalidate() {
+        shadow.clear();
+    }
+
+    /**
+     * Returns the underlying SDL_GPUBuffer handle for use in storage
+     * buffer binding.
+     */
+    SDL_GPUBuffer *GetGPUBuffer() const {
+        return gpuBuffer;
+    }
+
+    /** Returns the number of elements set by the last `SetData`. */
+    uint32_t GetCount() const {
+        return static_cast<uint32_t>(shadow.size());
+    }
+
+    /** Returns the number of elements the buffer can hold without growing. */
+    uint32_t GetCapacity() const {
+        return capacity;
+    }
+
+  private:
+    // Grows the buffer if needed, diffs `elements` against the CPU copy,
+    // and packs the changed runs back to back in the transfer buffer.
+    // Returns false if there is nothing to upload.
+    bool Stage(const T *elements, uint32_t count) {
+        SDL_assert(elements != nullptr || count == 0);
+
+        if (count > capacity) {
+            uint32_t newCapacity = capacity;
+            while (newCapacity < count) {
+                newCapacity *= 2;
+            }
+            Release();
+            Allocate(newCapacity);
+            shadow.clear();
+        }
+
+        pendingRanges = FindChangedRanges(
+            shadow.data(), static_cast<uint32_t>(shadow.size()), elements, count);
+        shadow.assign(elements, elements + count);
+        if (pendingRanges.empty()) {
+            return false;
+        }
+
+        SDL_GPUDevice *device = graphicsDevice->GetDevice();
+        uint8_t *mapped =
+            static_cast<uint8_t *>(SDL_MapGPUTransferBuffer(device, transferBuffer, true));
+        if (!mapped) {
+            shadow.clear();
+            return false;
+        }
+        uint32_t packed = 0;
+        for (const ElementRange &range : pendingRanges) {
+            memcpy(mapped + packed * sizeof(T), &elements[range.first], range.count * sizeof(T));
+            packed += range.count;
+        }
+        SDL_UnmapGPUTransferBuffer(device, transferBuffer);
+        return true;
+    }
+
+    // Issues one upload per staged run. Returns the elements uploaded.
+    uint32_t Upload(SDL_GPUCopyPass *copyPass) {
+        uint32_t packed = 0;
+        for (const ElementRange &range : pendingRanges) {
+            SDL_GPUTransferBufferLocation src;
+            SDL_zero(src);
+            src.transfer_buffer = transferBuffer;
+            src.offset = packed * sizeof(T);
+
+            SDL_GPUBufferRegion dst;
+            SDL_zero(dst);
+            dst.buffer = gpuBuffer;
+            dst.offset = range.first * sizeof(T);
+            dst.size = range.count * sizeof(T);
+
+            // No cycling: the unchanged elements must survive.
+            SDL_UploadToGPUBuffer(copyPass, &src, &dst, false);
+            packed += range.count;
+        }
+        pendingRanges.clear();
+        return packed;
+    }
+
+    void Allocate(uint32_t elementCapacity) {
+        capacity = elementCapacity;
+
+        SDL_GPUBufferCreateInfo bufCI;
+        SDL_zero(bufCI);
+        bufCI.usage = usage;
+        bufCI.size = capacity * sizeof(T);
+        gpuBuffer = SDL_CreateGPUBuffer(graphicsDevice->GetDevice(), &bufCI);
+        SDL_assert(gpuBuffer);
+
+        // Worst case every element changed, so the transfer buffer is
+        // sized to the whole array.
+        SDL_GPUTransferBufferCreateInfo tbCI;
+        SDL_zero(tbCI);
+        tbCI.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+        tbCI.size = capacity * sizeof(T);
+        transferBuffer = SDL_CreateGPUTransferBuffer(graphicsDevice->GetDevice(), &tbCI);
+        SDL_assert(transferBuffer);
+    }
+
+    void Release() {
+        if (transferBuffer) {
+            SDL_ReleaseGPUTransferBuffer(graphicsDevice->GetDevice(), transferBuffer);
+            transferBuffer = nullptr;
+        }
+        if (gpuBuffer) {
+            SDL_ReleaseGPUBuffer(graphicsDevice->GetDevice(), gpuBuffer);
+            gpuBuffer = nullptr;
+        }
+    }
+
+    GraphicsDevice *graphicsDevice;
+    SDL_GPUBufferUsageFlags usage;
+    SDL_GPUBuffer *gpuBuffer = nullptr;
+    SDL_GPUTransferBuffer *transferBuffer = nullptr;
+    uint32_t capacity = 0;
+    std::vector<T> shadow;
+    std::vector<ElementRange> pendingRanges;
+};
+
+} // namespace Lucky
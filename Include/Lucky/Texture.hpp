@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 #include <SDL3/SDL_gpu.h>
 
@@ -377,4 +378,38 @@ struct Texture {
     SDL_GPUSampler *sampler = nullptr;
 };
 
+/**
+ * Pixel data for one whole texture, for `UploadTextures`.
+ *
+ * `pixelData` must hold exactly
+ * `GetWidth() * GetHeight() * BytesPerPixel(GetTextureFormat())` bytes
+ * of tightly packed rows for `texture`, which must be a `Default` or
+ * `RenderTarget` texture.
+ */
+struct TextureUpload {
+    Texture *texture = nullptr;
+    const uint8_t *pixelData = nullptr;
+    uint32_t dataLength = 0;
+};
+
+/**
+ * Fills many textures at once.
+ *
+ * `Texture::SetTextureData` and the pixel constructors each create a
+ * transfer buffer and submit a command buffer per texture. This packs
+ * every upload into shared transfer buffers and records them into one
+ * copy pass per batch, so loading a model's textures costs a handful of
+ * submissions instead of one each. Batches are capped at 64 MiB of
+ * staging memory; a single larger texture gets a batch of its own.
+ *
+ * Create the textures with null pixel data, then pass them here. Like
+ * `SetTextureData`, the uploads are not ordered relative to a render
+ * pass that is currently open on the GraphicsDevice.
+ *
+ * \param graphicsDevice the graphics device that owns the textures.
+ * \param uploads the textures and their pixels. May be empty.
+ * \throws std::runtime_error on GPU allocation or upload failure.
+ */
+void UploadTextures(GraphicsDevice &graphicsDevice, const std::vector<TextureUpload> &uploads);
+
 } // namespace Lucky
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Lucky {
+
+/**
+ * A fixed set of worker threads that run submitted tasks and split
+ * loops across cores.
+ *
+ * # Usage
+ *
+ * Construct one pool for the application and share it. `ParallelFor`
+ * splits an index range into chunks and blocks until every chunk has
+ * run; the calling thread works through chunks alongside the workers,
+ * so it is safe to call from inside a pool task. `Submit` queues a
+ * single task and returns a future for its completion.
+ *
+ * Chunks are handed out in increasing index order, so a chunk may wait
+ * on work from lower-indexed chunks (e.g. to publish results in order)
+ * without deadlocking.
+ *
+ * Exceptions thrown by a `ParallelFor` body are rethrown from
+ * `ParallelFor` once all chunks have finished; only the first is kept.
+ * Exceptions thrown by a submitted task surface from its future.
+ *
+ * # Lifetime
+ *
+ * The destructor finishes every queued task, then joins the workers.
+ */
+struct ThreadPool {
+    /**
+     * Starts `workerCount` worker threads. Zero picks one fewer than the
+     * number of hardware threads, leaving a core for the caller; the
+     * pool always has at least one worker.
+     */
+    explicit ThreadPool(uint32_t workerCount = 0);
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ThreadPool(ThreadPool &&) = delete;
+    ThreadPool &operator=(ThreadPool &&) = delete;
+
+    ~ThreadPool();
+
+    /**
+     * Calls `body(begin, end)` over consecutive sub-ranges covering
+     * `[0, count)`, each at most `grainSize` long, and returns when all
+     * have finished.
+     *
+     * \param count number of indices. Zero returns immediately.
+     * \param grainSize maximum indices per call. Must be positive.
+     * \param body called once per chunk, possibly concurrently.
+     */
+    void ParallelFor(uint32_t count, uint32_t grainSize,
+        const std::function<void(uint32_t begin, uint32_t end)> &body);
+
+    /** Queues `task` to run on a worker. */
+    std::future<void> Submit(std::function<void()> task);
+
+    /** Returns the number of worker threads, not counting callers. */
+    uint32_t GetWorkerCount() const {
+        return static_cast<uint32_t>(workers.size());
+    }
+
+  private:
+    void WorkerLoop();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+};
+
+} // namespace Lucky
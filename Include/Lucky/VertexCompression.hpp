@@ -0,0 +1,98 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <glm/glm.hpp>
+
+#include <Lucky/Bounds.hpp>
+
+namespace Lucky {
+
+struct Vertex3D;
+
+/**
+ * How a `Mesh` stores its vertices on the GPU.
+ *
+ * The compressed layouts carry the same attributes as `Vertex3D` at
+ * lower precision, for static meshes whose vertex fetch shows up in the
+ * shadow and main passes. Normals and tangents are octahedral-encoded
+ * into two 16-bit components each (under 0.01 degrees of error) and
+ * UVs are half floats, which hold three decimal digits: plenty for UVs
+ * in [0, 1], but a texture tiled hundreds of times across one triangle
+ * will visibly swim.
+ */
+enum class MeshVertexFormat {
+    /** `Vertex3D`: full floats, 48 bytes. The default. */
+    Standard,
+
+    /** `CompressedVertex3D`: float positions, packed attributes, 28 bytes. */
+    Compressed,
+
+    /**
+     * `QuantizedVertex3D`: like `Compressed`, but positions are 16-bit
+     * fractions of the mesh's bounding box, 24 bytes. The error is
+     * 1/65535 of the box along each axis, so it suits props better than
+     * large terrain pieces.
+     */
+    Quantized,
+};
+
+/** Number of `MeshVertexFormat` values. */
+constexpr int MeshVertexFormatCount = 3;
+
+/**
+ * `Vertex3D` with packed normal, tangent and UV. The layout behind
+ * `MeshVertexFormat::Compressed`.
+ *
+ * The tangent's handedness is stored as a full component, +32767 or
+ * -32767, so it decodes to exactly +1 or -1.
+ */
+struct CompressedVertex3D {
+    float x, y, z;                  /**< position in mesh-local space. */
+    uint16_t u, v;                  /**< texture coordinates, half floats. */
+    int16_t nx, ny;                 /**< unit normal, octahedral, snorm16. */
+    int16_t tx, ty, tw, tangentPad; /**< tangent octahedral xy + handedness, snorm16. */
+};
+static_assert(sizeof(CompressedVertex3D) == 28, "CompressedVertex3D must stay tightly packed");
+
+/**
+ * `CompressedVertex3D` with positions quantized to the mesh's bounding
+ * box. The layout behind `MeshVertexFormat::Quantized`; decode with
+ * `min + (x, y, z) / 65535 * (max - min)`.
+ */
+struct QuantizedVertex3D {
+    uint16_t x, y, z, positionPad;  /**< position within the bounding box, unorm16. */
+    uint16_t u, v;                  /**< texture coordinates, half floats. */
+    int16_t nx, ny;                 /**< unit normal, octahedral, snorm16. */
+    int16_t tx, ty, tw, tangentPad; /**< tangent octahedral xy + handedness, snorm16. */
+};
+static_assert(sizeof(QuantizedVertex3D) == 24, "QuantizedVertex3D must stay tightly packed");
+
+/**
+ * Converts a float to an IEEE half float, rounding to nearest even.
+ * Values beyond the half range become infinity; NaN stays NaN.
+ */
+uint16_t FloatToHalf(float value);
+
+/** Converts an IEEE half float back to a float. Exact. */
+float HalfToFloat(uint16_t value);
+
+/**
+ * Encodes a unit vector as an octahedral pair in [-1, 1], scaled to
+ * snorm16. A zero vector encodes as +Z.
+ */
+void EncodeOctahedral(const glm::vec3 &direction, int16_t &x, int16_t &y);
+
+/** Decodes an octahedral snorm16 pair back to a unit vector. */
+glm::vec3 DecodeOctahedral(int16_t x, int16_t y);
+
+/** Packs `vertex` into the `MeshVertexFormat::Compressed` layout. */
+CompressedVertex3D CompressVertex(const Vertex3D &vertex);
+
+/**
+ * Packs `vertex` into the `MeshVertexFormat::Quantized` layout, with its
+ * position quantized to `bounds`, which must contain it.
+ */
+QuantizedVertex3D QuantizeVertex(const Vertex3D &vertex, const BoundingBox &bounds);
+
+} // namespace Lucky
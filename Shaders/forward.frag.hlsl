@@ -12,73 +12,164 @@ struct Light {
     int    Type;        // 0=Directional, 1=Point, 2=Spot
     float  InnerCone;
     float  OuterCone;
-    int    ShadowIndex; // -1 = no shadow; for 2D path, index into ShadowVP / shadow maps;
-                        // for cube path, index into PointShadowNearFar / point shadow cubes.
-    int    ShadowType;  // 0 = 2D spot/directional shadow, 1 = point cube shadow.
+    int    ShadowIndex; // -1 = no shadow; otherwise the light's first entry in ShadowTiles.
+    int    ShadowType;  // 0 = one tile (spot/directional),
+                        // 1 = six cube-face tiles, +X -X +Y -Y +Z -Z (point).
+};
+
+// One shadow atlas tile: the light view-projection it was rendered with
+// and its rect in atlas UV space (offset xy, scale zw). Layout mirrors
+// ShadowTileUBOEntry in ForwardRenderer.cpp.
+struct ShadowTile {
+    float4x4 ViewProj;
+    float4   UVRect;
 };
 
 cbuffer LightingUBO : register(b0, space3) {
-    float3   AmbientColor;
-    int      LightCount;
-    float3   CameraPosition;
-    float    _frameLightPad;
-    Light    Lights[8];
-    float4x4 ShadowVP[4];
-    // (n0, f0, n1, f1) for the two point shadow cubes, used by
-    // ComputePointShadow to convert eye-space distance into the same
-    // normalized depth that the depth target stored.
-    float4   PointShadowNearFar;
+    float3     AmbientColor;
+    int        LightCount;
+    float3     CameraPosition;
+    float      _frameLightPad;
+    Light      Lights[64]; // ForwardRenderer's MaxLights
+    ShadowTile ShadowTiles[48]; // ForwardRenderer::MaxShadowTiles
+    float      ShadowAtlasTexelSize;
+    float3     _shadowPad;
 };
 
-cbuffer MaterialUBO : register(b1, space3) {
+
+// Material feature permutations. The build compiles this file once per
+// FEATURES value (0..15) into forward_<FEATURES>.frag; ForwardRenderer
+// picks the variant from the textures a material actually has. Bits
+// must match MaterialFeature in ForwardRenderer.cpp.
+#ifndef FEATURES
+#define FEATURES 15
+#endif
+#define FEATURE_BASE_COLOR_TEXTURE         ((FEATURES & 1) != 0)
+#define FEATURE_METALLIC_ROUGHNESS_TEXTURE ((FEATURES & 2) != 0)
+#define FEATURE_EMISSIVE_TEXTURE           ((FEATURES & 4) != 0)
+#define FEATURE_NORMAL_TEXTURE             ((FEATURES & 8) != 0)
+
+// Fragment sampler slots must be dense, so absent material textures
+// take no slot: the shadow atlas comes first at slot 0, then whichever
+// material textures this variant uses, in bit order, then the material
+// table (storage buffers follow sampled textures in space2). Two-level
+// macros so the slot number is expanded before it is pasted onto the
+// register letter.
+#define REGISTER_CONCAT(kind, slot) register(kind##slot, space2)
+#define TEXTURE_REGISTER(slot) REGISTER_CONCAT(t, slot)
+#define SAMPLER_REGISTER(slot) REGISTER_CONCAT(s, slot)
+
+#define BASE_COLOR_SLOT 1
+#if FEATURE_BASE_COLOR_TEXTURE
+#define METALLIC_ROUGHNESS_SLOT 2
+#else
+#define METALLIC_ROUGHNESS_SLOT 1
+#endif
+#if FEATURE_METALLIC_ROUGHNESS_TEXTURE
+#if METALLIC_ROUGHNESS_SLOT == 2
+#define EMISSIVE_SLOT 3
+#else
+#define EMISSIVE_SLOT 2
+#endif
+#else
+#define EMISSIVE_SLOT METALLIC_ROUGHNESS_SLOT
+#endif
+#if FEATURE_EMISSIVE_TEXTURE
+#if EMISSIVE_SLOT == 3
+#define NORMAL_SLOT 4
+#elif EMISSIVE_SLOT == 2
+#define NORMAL_SLOT 3
+#else
+#define NORMAL_SLOT 2
+#endif
+#else
+#define NORMAL_SLOT EMISSIVE_SLOT
+#endif
+#if FEATURE_NORMAL_TEXTURE
+#if NORMAL_SLOT == 4
+#define MATERIAL_TABLE_SLOT 5
+#elif NORMAL_SLOT == 3
+#define MATERIAL_TABLE_SLOT 4
+#elif NORMAL_SLOT == 2
+#define MATERIAL_TABLE_SLOT 3
+#else
+#define MATERIAL_TABLE_SLOT 2
+#endif
+#else
+#define MATERIAL_TABLE_SLOT NORMAL_SLOT
+#endif
+
+// SDL_shadercross classifies each texture+sampler PAIR as a "sampler"
+// binding and any unpaired textures as "storage_textures". To get all
+// the textures into the SDL_BindGPUFragmentSamplers path, every
+// texture needs its own SamplerState declaration.
+Texture2D    ShadowAtlas        : register(t0, space2);
+SamplerState ShadowAtlasSampler : register(s0, space2);
+
+#if FEATURE_BASE_COLOR_TEXTURE
+Texture2D    BaseColorTexture : TEXTURE_REGISTER(BASE_COLOR_SLOT);
+SamplerState BaseColorSampler : SAMPLER_REGISTER(BASE_COLOR_SLOT);
+#endif
+#if FEATURE_METALLIC_ROUGHNESS_TEXTURE
+Texture2D    MetallicRoughnessTexture : TEXTURE_REGISTER(METALLIC_ROUGHNESS_SLOT);
+SamplerState MetallicRoughnessSampler : SAMPLER_REGISTER(METALLIC_ROUGHNESS_SLOT);
+#endif
+#if FEATURE_EMISSIVE_TEXTURE
+Texture2D    EmissiveTexture : TEXTURE_REGISTER(EMISSIVE_SLOT);
+SamplerState EmissiveSampler : SAMPLER_REGISTER(EMISSIVE_SLOT);
+#endif
+#if FEATURE_NORMAL_TEXTURE
+Texture2D    NormalTexture : TEXTURE_REGISTER(NORMAL_SLOT);
+SamplerState NormalSampler : SAMPLER_REGISTER(NORMAL_SLOT);
+#endif
+
+// Material table, one entry per distinct material in the frame. Layout
+// mirrors ForwardMaterialData in ForwardRenderer.cpp; do not reorder.
+struct MaterialData {
     float4 BaseColorFactor;
     float3 EmissiveFactor;
     float  MetallicFactor;
     float  RoughnessFactor;
-    int    HasBaseColorTexture;
-    int    HasMetallicRoughnessTexture;
-    int    HasEmissiveTexture;
-    int    HasNormalTexture;
     float  NormalScale;
     float  _matPad0;
     float  _matPad1;
 };
 
-// SDL_shadercross classifies each texture+sampler PAIR as a "sampler"
-// binding and any unpaired textures as "storage_textures". To get all
-// eight textures into the SDL_BindGPUFragmentSamplers path, every
-// texture needs its own SamplerState declaration -- even though we
-// bind the same Lucky::Sampler instance to all four shadow slots.
-Texture2D        BaseColorTexture          : register(t0, space2);
-Texture2D        MetallicRoughnessTexture  : register(t1, space2);
-Texture2D        ShadowMap0                : register(t2, space2);
-Texture2D        ShadowMap1                : register(t3, space2);
-Texture2D        ShadowMap2                : register(t4, space2);
-Texture2D        ShadowMap3                : register(t5, space2);
-Texture2D        EmissiveTexture           : register(t6, space2);
-Texture2D        NormalTexture             : register(t7, space2);
-TextureCube<float> PointShadowMap0         : register(t8, space2);
-TextureCube<float> PointShadowMap1         : register(t9, space2);
-
-SamplerState BaseColorSampler          : register(s0, space2);
-SamplerState MetallicRoughnessSampler  : register(s1, space2);
-SamplerState ShadowSampler0            : register(s2, space2);
-SamplerState ShadowSampler1            : register(s3, space2);
-SamplerState ShadowSampler2            : register(s4, space2);
-SamplerState ShadowSampler3            : register(s5, space2);
-SamplerState EmissiveSampler           : register(s6, space2);
-SamplerState NormalSampler             : register(s7, space2);
-SamplerState PointShadowSampler0       : register(s8, space2);
-SamplerState PointShadowSampler1       : register(s9, space2);
+StructuredBuffer<MaterialData> Materials : TEXTURE_REGISTER(MATERIAL_TABLE_SLOT);
 
 static const float PI = 3.14159265359;
 
-float SampleShadowMap(int index, float2 uv) {
-    // Sample .r channel: depth maps store depth in red.
-    if (index == 0) return ShadowMap0.Sample(ShadowSampler0, uv).r;
-    if (index == 1) return ShadowMap1.Sample(ShadowSampler1, uv).r;
-    if (index == 2) return ShadowMap2.Sample(ShadowSampler2, uv).r;
-    return ShadowMap3.Sample(ShadowSampler3, uv).r;
+// PCF over a (2 * radius + 1)^2 texel kernel in one atlas tile.
+// Positions outside the tile's frustum are unshadowed, and taps are
+// clamped to the tile so the kernel never reads a neighbouring tile.
+float SampleShadowTile(int tileIndex, float3 worldPos, int radius) {
+    float4 lightClip = mul(ShadowTiles[tileIndex].ViewProj, float4(worldPos, 1.0));
+    float3 ndc = lightClip.xyz / lightClip.w;
+
+    float2 tileUV = ndc.xy * 0.5 + 0.5;
+    tileUV.y = 1.0 - tileUV.y;
+    float currentDepth = ndc.z;
+
+    if (any(tileUV < 0.0) || any(tileUV > 1.0)) return 1.0;
+    if (currentDepth < 0.0 || currentDepth > 1.0) return 1.0;
+
+    float4 rect = ShadowTiles[tileIndex].UVRect;
+    float2 atlasUV = rect.xy + tileUV * rect.zw;
+    float texelSize = ShadowAtlasTexelSize;
+    float2 minUV = rect.xy + 0.5 * texelSize;
+    float2 maxUV = rect.xy + rect.zw - 0.5 * texelSize;
+
+    float shadow = 0.0;
+    for (int y = -radius; y <= radius; y++) {
+        for (int x = -radius; x <= radius; x++) {
+            float2 uv = clamp(atlasUV + float2(x, y) * texelSize, minUV, maxUV);
+            // Sample .r channel: depth textures store depth in red.
+            float depth = ShadowAtlas.Sample(ShadowAtlasSampler, uv).r;
+            shadow += (currentDepth > depth) ? 0.0 : 1.0;
+        }
+    }
+    float taps = 2 * radius + 1;
+    return shadow / (taps * taps);
 }
 
 float ComputeShadow(int shadowIndex, float3 worldPos, float3 N, float3 L) {
@@ -93,40 +184,14 @@ float ComputeShadow(int shadowIndex, float3 worldPos, float3 N, float3 L) {
     float normalOffset = 0.08 * (1.0 - NdotL) + 0.02;
     float3 biasedPos = worldPos + N * normalOffset;
 
-    float4 lightClip = mul(ShadowVP[shadowIndex], float4(biasedPos, 1.0));
-    float3 ndc = lightClip.xyz / lightClip.w;
-
-    float2 shadowUV = ndc.xy * 0.5 + 0.5;
-    shadowUV.y = 1.0 - shadowUV.y;
-    float currentDepth = ndc.z;
-
-    if (any(shadowUV < 0.0) || any(shadowUV > 1.0)) return 1.0;
-    if (currentDepth < 0.0 || currentDepth > 1.0) return 1.0;
-
-    float texelSize = 1.0 / 2048.0; // must match ForwardRenderer::ShadowMapSize
-    float shadow = 0.0;
-    for (int y = -2; y <= 2; y++) {
-        for (int x = -2; x <= 2; x++) {
-            float depth = SampleShadowMap(shadowIndex, shadowUV + float2(x, y) * texelSize);
-            shadow += (currentDepth > depth) ? 0.0 : 1.0;
-        }
-    }
-    return shadow / 25.0;
-}
-
-float SamplePointShadowMap(int index, float3 dir) {
-    if (index == 0) return PointShadowMap0.Sample(PointShadowSampler0, dir);
-    return PointShadowMap1.Sample(PointShadowSampler1, dir);
+    return SampleShadowTile(shadowIndex, biasedPos, 2);
 }
 
-// Cube-shadow lookup for point lights. The depth target stores
-// hardware (clip-space) depth, so we have to reconstruct what value
-// the rasterizer would have written for the current fragment's
-// distance from the light. The dominant axis of `fragToLight` plays
-// the role of eye-space Z because each cube face's view matrix points
-// straight down its own axis -- so |max component| is z_eye for the
-// matching face. Reverse-projection of the perspective matrix gives
-// the normalized depth value to compare against the sampled texel.
+// Point light shadows are six perspective tiles, one per cube face.
+// The dominant axis of the light-to-fragment direction picks the face
+// whose frustum contains the fragment, and the lookup is then the same
+// as for a spot light. PCF taps stop at the face's tile edge, so the
+// kernel narrows slightly across cube seams.
 float ComputePointShadow(int shadowIndex, float3 worldPos, float3 lightPos, float3 N) {
     if (shadowIndex < 0) return 1.0;
 
@@ -140,39 +205,18 @@ float ComputePointShadow(int shadowIndex, float3 worldPos, float3 lightPos, floa
     float normalOffset = 0.05 * (1.0 - NdotL) + 0.01;
     float3 biasedPos = worldPos + N * normalOffset;
 
-    float3 fragToLight = biasedPos - lightPos;
-    float near = (shadowIndex == 0) ? PointShadowNearFar.x : PointShadowNearFar.z;
-    float far  = (shadowIndex == 0) ? PointShadowNearFar.y : PointShadowNearFar.w;
-
-    // Eye-space Z for the cube face this direction targets is the
-    // magnitude of the dominant axis. (One of |x|, |y|, |z| equals
-    // the eye-space Z for the face whose forward is that axis.)
-    float3 absDir = abs(fragToLight);
-    float z_eye = max(absDir.x, max(absDir.y, absDir.z));
-
-    // Perspective depth = far*(z-near) / (z*(far-near)). Matches the
-    // glm::perspectiveRH_ZO projection the renderer uses per face.
-    float expectedZ = far * (z_eye - near) / (z_eye * (far - near));
-    if (expectedZ < 0.0 || expectedZ > 1.0) return 1.0;
-
-    // PCF: build a basis perpendicular to fragToLight and tap a 3x3
-    // grid in tangent space. Offset scale grows with distance so the
-    // kernel covers a roughly constant world-space area.
-    float3 dir = fragToLight / max(distToLight, 1e-4);
-    float3 helper = (abs(dir.y) < 0.99) ? float3(0, 1, 0) : float3(1, 0, 0);
-    float3 tangent = normalize(cross(helper, dir));
-    float3 bitangent = cross(dir, tangent);
-    float offsetScale = z_eye / 1024.0 * 2.0; // matches PointShadowMapSize
-
-    float shadow = 0.0;
-    for (int y = -1; y <= 1; y++) {
-        for (int x = -1; x <= 1; x++) {
-            float3 sampleDir = fragToLight + (tangent * x + bitangent * y) * offsetScale;
-            float depth = SamplePointShadowMap(shadowIndex, sampleDir);
-            shadow += (expectedZ > depth) ? 0.0 : 1.0;
-        }
+    float3 fragFromLight = biasedPos - lightPos;
+    float3 absDir = abs(fragFromLight);
+    int face;
+    if (absDir.x >= absDir.y && absDir.x >= absDir.z) {
+        face = (fragFromLight.x >= 0.0) ? 0 : 1;
+    } else if (absDir.y >= absDir.z) {
+        face = (fragFromLight.y >= 0.0) ? 2 : 3;
+    } else {
+        face = (fragFromLight.z >= 0.0) ? 4 : 5;
     }
-    return shadow / 9.0;
+
+    return SampleShadowTile(shadowIndex + face, biasedPos, 1);
 }
 
 // GGX / Trowbridge-Reitz normal distribution function.
@@ -207,6 +251,9 @@ struct PSInput {
     float3 Normal    : TEXCOORD2;
     float3 ColorTint : TEXCOORD3;
     float4 Tangent   : TEXCOORD4; // xyz tangent, w handedness
+    nointerpolation uint MaterialIndex : TEXCOORD5;
+    nointerpolation uint LightCount : TEXCOORD6;
+    nointerpolation uint2 LightIndices : TEXCOORD7;
 };
 
 struct PSOutput {
@@ -214,7 +261,10 @@ struct PSOutput {
 };
 
 PSOutput main(PSInput input) {
-    // Sample material textures (1x1 white fallback if the flag is off).
+    MaterialData material = Materials[input.MaterialIndex];
+
+    float4 baseColor = material.BaseColorFactor;
+#if FEATURE_BASE_COLOR_TEXTURE
     float4 baseColorSample = BaseColorTexture.Sample(BaseColorSampler, input.TexCoord);
     // glTF base-color textures are encoded in sRGB. Lucky's Texture
     // loads them as linear UNORM, so we decode in-shader. 2.2 is the
@@ -222,21 +272,18 @@ PSOutput main(PSInput input) {
     // but the visual difference is small. The proper fix is a
     // TextureFormat::sRGB that lets the GPU do this in hardware.
     baseColorSample.rgb = pow(baseColorSample.rgb, 2.2);
-
-    float4 baseColor = BaseColorFactor;
-    if (HasBaseColorTexture != 0) {
-        baseColor *= baseColorSample;
-    }
+    baseColor *= baseColorSample;
+#endif
     baseColor.rgb *= input.ColorTint;
 
+    float metallic = material.MetallicFactor;
+    float roughness = material.RoughnessFactor;
+#if FEATURE_METALLIC_ROUGHNESS_TEXTURE
+    // glTF 2.0 packs metallic in B and roughness in G.
     float4 mrSample = MetallicRoughnessTexture.Sample(MetallicRoughnessSampler, input.TexCoord);
-    float metallic = MetallicFactor;
-    float roughness = RoughnessFactor;
-    if (HasMetallicRoughnessTexture != 0) {
-        // glTF 2.0 packs metallic in B and roughness in G.
-        metallic *= mrSample.b;
-        roughness *= mrSample.g;
-    }
+    metallic *= mrSample.b;
+    roughness *= mrSample.g;
+#endif
     // Roughness floor for non-IBL rendering. Production engines with
     // image-based lighting clamp at 0.045-0.08 because IBL
     // prefiltering localizes the specular peak. With only analytical
@@ -255,20 +302,25 @@ PSOutput main(PSInput input) {
     // then unpack the sample from [0,1] to [-1,1] and apply the
     // per-material xy scale before reconstructing z and rotating into
     // world space. Normal maps are linear data -- no sRGB decode here.
-    if (HasNormalTexture != 0) {
+#if FEATURE_NORMAL_TEXTURE
+    {
         float3 T = normalize(input.Tangent.xyz - N * dot(N, input.Tangent.xyz));
         float3 B = cross(N, T) * input.Tangent.w;
         float3 nm = NormalTexture.Sample(NormalSampler, input.TexCoord).rgb * 2.0 - 1.0;
-        nm.xy *= NormalScale;
+        nm.xy *= material.NormalScale;
         N = normalize(T * nm.x + B * nm.y + N * nm.z);
     }
+#endif
 
     float3 F0 = lerp(float3(0.04, 0.04, 0.04), baseColor.rgb, metallic);
     float3 albedo = baseColor.rgb * (1.0 - metallic);
 
     float3 lighting = AmbientColor * albedo;
 
-    for (int i = 0; i < LightCount; i++) {
+    // Each object carries its own short list of the lights that matter
+    // most to it, chosen on the CPU; LightCount above is the scene total.
+    for (uint n = 0; n < input.LightCount; n++) {
+        uint i = (input.LightIndices[n >> 2] >> ((n & 3) * 8)) & 0xFF;
         float3 L;
         float attenuation;
 
@@ -330,11 +382,11 @@ PSOutput main(PSInput input) {
 
     // Emissive: factor * (texture if present, else 1). The texture is
     // sRGB-encoded so we decode like base color.
-    float3 emissive = EmissiveFactor;
-    if (HasEmissiveTexture != 0) {
-        float3 emissiveSample = EmissiveTexture.Sample(EmissiveSampler, input.TexCoord).rgb;
-        emissive *= pow(emissiveSample, 2.2);
-    }
+    float3 emissive = material.EmissiveFactor;
+#if FEATURE_EMISSIVE_TEXTURE
+    float3 emissiveSample = EmissiveTexture.Sample(EmissiveSampler, input.TexCoord).rgb;
+    emissive *= pow(emissiveSample, 2.2);
+#endif
     lighting += emissive;
 
     // Tonemap-ish exposure compression to keep bright accumulations in [0,1].
@@ -1,18 +1,71 @@
+// The build compiles this file twice: as forward.vert for Vertex3D, and
+// with COMPRESSED_VERTICES=1 as forward_compressed.vert for the
+// compressed MeshVertexFormats.
+#ifndef COMPRESSED_VERTICES
+#define COMPRESSED_VERTICES 0
+#endif
+
 cbuffer Frame : register(b0, space1) {
     float4x4 ViewProjection;
 };
 
-cbuffer Object : register(b1, space1) {
+// Per-object record in the renderer's persistent object buffer. Layout
+// mirrors ObjectData in ForwardRenderer.cpp; do not reorder.
+struct ObjectData {
     float4x4 Model;
     float4   ColorTint;
+    uint     MaterialIndex;
+    uint     LightCount;
+    uint2    LightIndices; // byte indices into Lights, four per word
+};
+
+StructuredBuffer<ObjectData> Objects : register(t0, space0);
+
+// Object indices written by forward_cull.comp for indirect draws, one
+// run per batch. Only read when UseVisibleList is set.
+StructuredBuffer<uint> VisibleObjects : register(t1, space0);
+
+// Direct draws push ObjectIndex. Indirect draws instead push the
+// batch's first slot in VisibleObjects and index it by instance.
+// PositionScale and PositionOffset map the mesh's stored positions back
+// to mesh space; only the COMPRESSED_VERTICES build reads them.
+cbuffer Draw : register(b1, space1) {
+    uint ObjectIndex;
+    uint FirstVisible;
+    uint UseVisibleList;
+    uint _drawPad;
+    float4 PositionOffset;
+    float4 PositionScale;
+};
+
+#if COMPRESSED_VERTICES
+// CompressedVertex3D / QuantizedVertex3D in VertexCompression.hpp. The
+// pipeline's attribute formats do the unpacking to float: positions are
+// floats or unorm16 fractions of the bounds, UVs half floats, and normal
+// and tangent snorm16 octahedral pairs.
+struct VSInput {
+    float3 Position : TEXCOORD0;
+    float2 TexCoord : TEXCOORD1;
+    float2 Normal   : TEXCOORD2;
+    float4 Tangent  : TEXCOORD3; // xy = octahedral tangent, z = bitangent handedness
 };
 
+// Mirrors DecodeOctahedral in VertexCompression.cpp.
+float3 DecodeOctahedral(float2 encoded) {
+    float3 direction = float3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = saturate(-direction.z);
+    direction.x += direction.x >= 0.0 ? -fold : fold;
+    direction.y += direction.y >= 0.0 ? -fold : fold;
+    return normalize(direction);
+}
+#else
 struct VSInput {
     float3 Position : TEXCOORD0;
     float2 TexCoord : TEXCOORD1;
     float3 Normal   : TEXCOORD2;
     float4 Tangent  : TEXCOORD3; // xyz = tangent, w = bitangent handedness
 };
+#endif
 
 struct VSOutput {
     float3 WorldPos  : TEXCOORD0;
@@ -20,27 +73,50 @@ struct VSOutput {
     float3 Normal    : TEXCOORD2;
     float3 ColorTint : TEXCOORD3;
     float4 Tangent   : TEXCOORD4; // xyz transformed; w handedness preserved
+    nointerpolation uint MaterialIndex : TEXCOORD5;
+    nointerpolation uint LightCount : TEXCOORD6;
+    nointerpolation uint2 LightIndices : TEXCOORD7;
     float4 Position  : SV_Position;
 };
 
-VSOutput main(VSInput input) {
+VSOutput main(VSInput input, uint instance : SV_InstanceID) {
     VSOutput o;
+    uint objectIndex = UseVisibleList != 0 ? VisibleObjects[FirstVisible + instance] : ObjectIndex;
+    ObjectData object = Objects[objectIndex];
+    float4x4 Model = object.Model;
+
+#if COMPRESSED_VERTICES
+    precise float3 position = input.Position * PositionScale.xyz + PositionOffset.xyz;
+    float3 normal = DecodeOctahedral(input.Normal);
+    float4 tangent = float4(DecodeOctahedral(input.Tangent.xy), input.Tangent.z);
+#else
+    float3 position = input.Position;
+    float3 normal = input.Normal;
+    float4 tangent = input.Tangent;
+#endif
 
-    float4 worldPos = mul(Model, float4(input.Position, 1.0));
+    // `precise` pins the position math so the depth pre-pass and the
+    // forward pass (different shaders, same expression) produce
+    // bit-identical depth for the EQUAL depth test.
+    precise float4 worldPos = mul(Model, float4(position, 1.0));
     o.WorldPos = worldPos.xyz;
-    o.Position = mul(ViewProjection, worldPos);
+    precise float4 clipPos = mul(ViewProjection, worldPos);
+    o.Position = clipPos;
 
     // Normal is transformed by the upper 3x3 of the model matrix.
     // For non-uniform scales the inverse-transpose would be more correct,
     // but uniform scales (and the demo's transforms) are fine with this.
-    o.Normal = normalize(mul((float3x3)Model, input.Normal));
+    o.Normal = normalize(mul((float3x3)Model, normal));
 
     // Tangent: transform xyz the same way as the normal; preserve w
     // (bitangent handedness) untouched. Don't normalize here -- the
     // fragment shader does it after Gram-Schmidt against the normal.
-    o.Tangent = float4(mul((float3x3)Model, input.Tangent.xyz), input.Tangent.w);
+    o.Tangent = float4(mul((float3x3)Model, tangent.xyz), tangent.w);
 
     o.TexCoord = input.TexCoord;
-    o.ColorTint = ColorTint.rgb;
+    o.ColorTint = object.ColorTint.rgb;
+    o.MaterialIndex = object.MaterialIndex;
+    o.LightCount = object.LightCount;
+    o.LightIndices = object.LightIndices;
     return o;
 }
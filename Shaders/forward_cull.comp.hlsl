@@ -0,0 +1,81 @@
+// Frustum-culls ForwardRenderer's rigid objects for every view and
+// compacts the survivors into per-batch runs of VisibleObjects, bumping
+// each batch's instance count in DrawArgs. One thread per object.
+
+#define MAX_VIEWS 8
+
+// Per-object record in the renderer's persistent object buffer. Layout
+// mirrors ObjectData in ForwardRenderer.cpp; only Model is read here.
+struct ObjectData {
+    float4x4 Model;
+    float4   ColorTint;
+    uint     MaterialIndex;
+    uint     LightCount;
+    uint2    LightIndices; // byte indices into Lights, four per word
+};
+
+// Mirrors ForwardCullData in ForwardRenderer.cpp. Bounds are in mesh
+// space; Batch is 0xFFFFFFFF for objects the indirect path skips.
+struct CullData {
+    float3 BoundsCenter;
+    uint   Batch;
+    float3 BoundsExtents;
+    uint   FirstVisible;
+};
+
+StructuredBuffer<ObjectData> Objects : register(t0, space0);
+StructuredBuffer<CullData> CullRecords : register(t1, space0);
+
+RWStructuredBuffer<uint> VisibleObjects : register(u0, space1);
+// SDL_GPUIndexedIndirectDrawCommand per (view, batch): five uints, the
+// second being the instance count.
+RWByteAddressBuffer DrawArgs : register(u1, space1);
+
+// Frustum planes point inward: a point p is inside when
+// dot(plane.xyz, p) + plane.w >= 0.
+cbuffer Cull : register(b0, space2) {
+    float4 Planes[MAX_VIEWS * 6];
+    uint ObjectCount;
+    uint ViewCount;
+    uint BatchCount;
+    uint VisiblePerView;
+};
+
+[numthreads(64, 1, 1)]
+void main(uint3 tid : SV_DispatchThreadID) {
+    uint index = tid.x;
+    if (index >= ObjectCount) {
+        return;
+    }
+    CullData cull = CullRecords[index];
+    if (cull.Batch == 0xFFFFFFFF) {
+        return;
+    }
+
+    // World-space box: transform the center, project the extents
+    // through the absolute upper 3x3 (matches TransformBounds).
+    float4x4 model = Objects[index].Model;
+    float3 center = mul(model, float4(cull.BoundsCenter, 1.0)).xyz;
+    float3x3 axes = (float3x3)model;
+    float3 extents = mul(abs(axes), cull.BoundsExtents);
+
+    for (uint view = 0; view < ViewCount; view++) {
+        bool inside = true;
+        for (uint p = 0; p < 6; p++) {
+            float4 plane = Planes[view * 6 + p];
+            float reach = dot(abs(plane.xyz), extents);
+            if (dot(plane.xyz, center) + plane.w + reach < 0.0) {
+                inside = false;
+                break;
+            }
+        }
+        if (!inside) {
+            continue;
+        }
+
+        uint args = (view * BatchCount + cull.Batch) * 20;
+        uint slot;
+        DrawArgs.InterlockedAdd(args + 4, 1, slot);
+        VisibleObjects[view * VisiblePerView + cull.FirstVisible + slot] = index;
+    }
+}
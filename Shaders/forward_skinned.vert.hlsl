@@ -10,6 +10,9 @@ cbuffer Frame : register(b0, space1) {
 
 cbuffer Object : register(b1, space1) {
     float4 ColorTint;
+    uint   MaterialIndex;
+    uint   LightCount;
+    uint2  LightIndices; // byte indices into Lights, four per word
 };
 
 // Joint matrices are world-space (already include the model placement),
@@ -36,6 +39,9 @@ struct VSOutput {
     float3 Normal    : TEXCOORD2;
     float3 ColorTint : TEXCOORD3;
     float4 Tangent   : TEXCOORD4; // xyz transformed; w handedness preserved
+    nointerpolation uint MaterialIndex : TEXCOORD5;
+    nointerpolation uint LightCount : TEXCOORD6;
+    nointerpolation uint2 LightIndices : TEXCOORD7;
     float4 Position  : SV_Position;
 };
 
@@ -66,5 +72,8 @@ VSOutput main(VSInput input) {
 
     o.TexCoord = input.TexCoord;
     o.ColorTint = ColorTint.rgb;
+    o.MaterialIndex = MaterialIndex;
+    o.LightCount = LightCount;
+    o.LightIndices = LightIndices;
     return o;
 }
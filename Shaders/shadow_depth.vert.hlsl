@@ -1,25 +1,74 @@
+// The build compiles this file twice: as shadow_depth.vert for Vertex3D, and
+// with COMPRESSED_VERTICES=1 as shadow_depth_compressed.vert for the
+// compressed MeshVertexFormats.
+#ifndef COMPRESSED_VERTICES
+#define COMPRESSED_VERTICES 0
+#endif
+
 cbuffer Frame : register(b0, space1) {
     float4x4 LightViewProj;
 };
 
-cbuffer Object : register(b1, space1) {
+// Per-object record in the renderer's persistent object buffer. Layout
+// mirrors ObjectData in ForwardRenderer.cpp; do not reorder.
+// Only Model is read here; the rest is shared with the forward pass.
+struct ObjectData {
     float4x4 Model;
-    float4   ColorTint; // unused in shadow pass; kept to share the per-draw UBO
+    float4   ColorTint;
+    uint     MaterialIndex;
+    uint     LightCount;
+    uint2    LightIndices; // byte indices into Lights, four per word
+};
+
+StructuredBuffer<ObjectData> Objects : register(t0, space0);
+
+// Object indices written by forward_cull.comp for indirect draws, one
+// run per batch. Only read when UseVisibleList is set.
+StructuredBuffer<uint> VisibleObjects : register(t1, space0);
+
+// Direct draws push ObjectIndex. Indirect draws instead push the
+// batch's first slot in VisibleObjects and index it by instance.
+// PositionScale and PositionOffset map the mesh's stored positions back
+// to mesh space; only the COMPRESSED_VERTICES build reads them.
+cbuffer Draw : register(b1, space1) {
+    uint ObjectIndex;
+    uint FirstVisible;
+    uint UseVisibleList;
+    uint _drawPad;
+    float4 PositionOffset;
+    float4 PositionScale;
 };
 
+// Only Position is read. The compressed layouts' attributes arrive
+// already converted to float; see forward.vert.hlsl.
 struct VSInput {
     float3 Position : TEXCOORD0;
     float2 TexCoord : TEXCOORD1;
+#if COMPRESSED_VERTICES
+    float2 Normal   : TEXCOORD2;
+#else
     float3 Normal   : TEXCOORD2;
+#endif
 };
 
 struct VSOutput {
     float4 Position : SV_Position;
 };
 
-VSOutput main(VSInput input) {
+VSOutput main(VSInput input, uint instance : SV_InstanceID) {
     VSOutput o;
-    float4 worldPos = mul(Model, float4(input.Position, 1.0));
-    o.Position = mul(LightViewProj, worldPos);
+    uint objectIndex = UseVisibleList != 0 ? VisibleObjects[FirstVisible + instance] : ObjectIndex;
+    float4x4 Model = Objects[objectIndex].Model;
+#if COMPRESSED_VERTICES
+    precise float3 position = input.Position * PositionScale.xyz + PositionOffset.xyz;
+#else
+    float3 position = input.Position;
+#endif
+    // `precise` pins the position math so the depth pre-pass and the
+    // forward pass (different shaders, same expression) produce
+    // bit-identical depth for the EQUAL depth test.
+    precise float4 worldPos = mul(Model, float4(position, 1.0));
+    precise float4 clipPos = mul(LightViewProj, worldPos);
+    o.Position = clipPos;
     return o;
 }
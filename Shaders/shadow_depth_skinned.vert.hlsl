@@ -14,6 +14,8 @@ cbuffer Frame : register(b0, space1) {
 // stop dxc from stripping the declaration.
 cbuffer ObjectUnused : register(b1, space1) {
     float4 ColorTintUnused;
+    uint   MaterialIndexUnused;
+    uint3  _objectPadUnused;
 };
 
 cbuffer Joints : register(b2, space1) {
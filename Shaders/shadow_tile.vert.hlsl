@@ -0,0 +1,15 @@
+// Full-viewport triangle at the far plane, used to reset or composite
+// one tile of the shadow atlas. The renderer points the viewport and
+// scissor at the tile, so the triangle only ever touches that tile.
+// No vertex buffer: positions come from SV_VertexID.
+
+struct VSOutput {
+    float4 Position : SV_Position;
+};
+
+VSOutput main(uint vertexId : SV_VertexID) {
+    float2 uv = float2((vertexId << 1) & 2, vertexId & 2);
+    VSOutput o;
+    o.Position = float4(uv * 2.0 - 1.0, 1.0, 1.0);
+    return o;
+}
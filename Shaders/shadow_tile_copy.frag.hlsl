@@ -0,0 +1,22 @@
+// Copies one tile of the static shadow atlas into the live atlas by
+// writing the cached depth through SV_Depth. Both atlases share a
+// layout, so the source texel sits at the same pixel position as the
+// fragment. Used instead of a texture copy because D3D12 can only copy
+// depth textures whole.
+
+// Paired with a sampler so shadercross exposes it through
+// SDL_BindGPUFragmentSamplers; the point sampler at the texel center
+// returns the stored value exactly.
+Texture2D    StaticShadowAtlas        : register(t0, space2);
+SamplerState StaticShadowAtlasSampler : register(s0, space2);
+
+struct PSInput {
+    float4 Position : SV_Position;
+};
+
+float main(PSInput input) : SV_Depth {
+    float width, height;
+    StaticShadowAtlas.GetDimensions(width, height);
+    float2 uv = input.Position.xy / float2(width, height);
+    return StaticShadowAtlas.Sample(StaticShadowAtlasSampler, uv).r;
+}
@@ -0,0 +1,465 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include <glm/gtc/quaternion.hpp>
+#include <spdlog/spdlog.h>
+
+#include <Lucky/CookedModel.hpp>
+#include <Lucky/MappedFile.hpp>
+
+namespace Lucky {
+
+namespace {
+
+// "LKMD" when read as little-endian bytes.
+constexpr uint32_t CookedModelMagic = 0x444D4B4C;
+
+// Every blob starts on this boundary, so its contents can be read in
+// place from the mapping.
+constexpr size_t BlobAlignment = 16;
+
+// The file stores these as raw bytes; a size change is a format change.
+static_assert(sizeof(Vertex3D) == 48, "Vertex3D changed; bump CookedModelVersion");
+static_assert(sizeof(Vertex3DSkinned) == 80, "Vertex3DSkinned changed; bump CookedModelVersion");
+static_assert(sizeof(AnimationKeyframe) == 20, "AnimationKeyframe must stay tightly packed");
+static_assert(sizeof(glm::mat4) == 64, "glm::mat4 must stay tightly packed");
+static_assert(sizeof(MeshLod) == 12, "MeshLod changed; bump CookedModelVersion");
+static_assert(sizeof(Meshlet) == 40, "Meshlet changed; bump CookedModelVersion");
+
+struct Writer {
+    std::ofstream stream;
+    size_t offset = 0;
+
+    void WriteBytes(const void *bytes, size_t count) {
+        stream.write(static_cast<const char *>(bytes), static_cast<std::streamsize>(count));
+        offset += count;
+    }
+
+    template <typename T> void Write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Write takes plain values");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void Align() {
+        static const uint8_t zeros[BlobAlignment] = {};
+        WriteBytes(zeros, (BlobAlignment - offset % BlobAlignment) % BlobAlignment);
+    }
+
+    void WriteString(const std::string &value) {
+        Write(static_cast<uint32_t>(value.size()));
+        WriteBytes(value.data(), value.size());
+    }
+
+    template <typename T> void WriteVector(const std::vector<T> &values) {
+        Write(static_cast<uint32_t>(values.size()));
+        Align();
+        WriteBytes(values.data(), values.size() * sizeof(T));
+    }
+};
+
+struct Reader {
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    size_t offset = 0;
+
+    const uint8_t *Take(size_t count) {
+        if (count > size - offset) {
+            throw std::runtime_error("Cooked model file is truncated");
+        }
+        const uint8_t *bytes = data + offset;
+        offset += count;
+        return bytes;
+    }
+
+    template <typename T> T Read() {
+        T value;
+        std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    void Align() {
+        Take((BlobAlignment - offset % BlobAlignment) % BlobAlignment);
+    }
+
+    std::string ReadString() {
+        const uint32_t length = Read<uint32_t>();
+        const char *chars = reinterpret_cast<const char *>(Take(length));
+        return std::string(chars, length);
+    }
+
+    template <typename T> const T *ReadBlob(size_t count) {
+        Align();
+        if (count > (size - offset) / sizeof(T)) {
+            throw std::runtime_error("Cooked model file is truncated");
+        }
+        return reinterpret_cast<const T *>(Take(count * sizeof(T)));
+    }
+
+    template <typename T> std::vector<T> ReadVector() {
+        const uint32_t count = Read<uint32_t>();
+        const T *values = ReadBlob<T>(count);
+        return std::vector<T>(values, values + count);
+    }
+};
+
+void Require(bool condition, const char *what) {
+    if (!condition) {
+        throw std::runtime_error(std::string("Cooked model file is inconsistent: ") + what);
+    }
+}
+
+bool IndexInRange(int index, size_t count, bool allowNone = false) {
+    return (allowNone && index == -1) || (index >= 0 && static_cast<size_t>(index) < count);
+}
+
+// Whether every one of `count` indices addresses one of a mesh's
+// `vertexCount` vertices. Mesh construction only asserts this before
+// narrowing indices to 16 bits.
+bool IndicesInRange(const uint32_t *indices, uint32_t count, uint32_t vertexCount) {
+    return std::all_of(
+        indices, indices + count, [vertexCount](uint32_t index) { return index < vertexCount; });
+}
+
+// Whether following `parentIndex` from every node reaches a root. The
+// parent indices themselves must already be in range.
+bool ParentChainsTerminate(const std::vector<NodeTemplate> &nodes) {
+    // 0: not yet seen, 1: on the current walk, 2: known to reach a root.
+    std::vector<uint8_t> state(nodes.size(), 0);
+    for (size_t i = 0; i < nodes.size(); i++) {
+        int n = static_cast<int>(i);
+        while (n >= 0 && state[n] == 0) {
+            state[n] = 1;
+            n = nodes[n].parentIndex;
+        }
+        if (n >= 0 && state[n] == 1) {
+            return false;
+        }
+        for (n = static_cast<int>(i); n >= 0 && state[n] == 1; n = nodes[n].parentIndex) {
+            state[n] = 2;
+        }
+    }
+    return true;
+}
+
+// Lays the meshes out the way MeshArena does, so the loader can upload
+// the blobs as they are.
+template <typename MeshDataType>
+void WriteArena(
+    Writer &writer, const std::vector<MeshDataType> &meshes, const std::vector<int> &materials) {
+    using VertexType = typename decltype(MeshDataType::vertices)::value_type;
+    if (materials.size() != meshes.size()) {
+        throw std::runtime_error("Cooked model needs one material index per mesh");
+    }
+
+    std::vector<VertexType> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<Meshlet> meshlets;
+    writer.Write(static_cast<uint32_t>(meshes.size()));
+    for (size_t i = 0; i < meshes.size(); i++) {
+        const MeshArenaRange range = AppendArenaMesh(meshes[i], vertices, indices, meshlets);
+        writer.Write(range.firstIndex);
+        writer.Write(range.indexCount);
+        writer.Write(range.baseVertex);
+        writer.Write(range.vertexCount);
+        writer.Write(range.bounds.min);
+        writer.Write(range.bounds.max);
+        writer.Write(static_cast<int32_t>(materials[i]));
+        writer.Write(range.lodCount);
+        for (uint32_t l = 0; l < range.lodCount; l++) {
+            writer.Write(range.lods[l]);
+        }
+        writer.Write(range.firstMeshlet);
+        writer.Write(range.meshletCount);
+    }
+
+    writer.Write(static_cast<uint32_t>(vertices.size()));
+    writer.Write(static_cast<uint32_t>(indices.size()));
+    writer.Write(static_cast<uint32_t>(meshlets.size()));
+    writer.Align();
+    writer.WriteBytes(vertices.data(), vertices.size() * sizeof(VertexType));
+    writer.Align();
+    writer.WriteBytes(indices.data(), indices.size() * sizeof(uint32_t));
+    writer.Align();
+    writer.WriteBytes(meshlets.data(), meshlets.size() * sizeof(Meshlet));
+}
+
+template <typename VertexType>
+void ReadArena(Reader &reader, CookedMeshArena<VertexType> &arena) {
+    const uint32_t rangeCount = reader.Read<uint32_t>();
+    arena.ranges.reserve(rangeCount);
+    arena.materials.reserve(rangeCount);
+    for (uint32_t i = 0; i < rangeCount; i++) {
+        MeshArenaRange range;
+        range.firstIndex = reader.Read<uint32_t>();
+        range.indexCount = reader.Read<uint32_t>();
+        range.baseVertex = reader.Read<uint32_t>();
+        range.vertexCount = reader.Read<uint32_t>();
+        range.bounds.min = reader.Read<glm::vec3>();
+        range.bounds.max = reader.Read<glm::vec3>();
+        const int material = reader.Read<int32_t>();
+        Require(range.indexCount > 0 && range.vertexCount > 0, "empty mesh");
+        range.lodCount = reader.Read<uint32_t>();
+        Require(range.lodCount < MaxMeshLods, "level of detail count");
+        for (uint32_t l = 0; l < range.lodCount; l++) {
+            range.lods[l] = reader.Read<MeshLod>();
+            Require(range.lods[l].indexCount > 0, "empty level of detail");
+        }
+        range.firstMeshlet = reader.Read<uint32_t>();
+        range.meshletCount = reader.Read<uint32_t>();
+        arena.ranges.push_back(range);
+        arena.materials.push_back(material);
+    }
+
+    arena.vertexCount = reader.Read<uint32_t>();
+    arena.indexCount = reader.Read<uint32_t>();
+    arena.meshletCount = reader.Read<uint32_t>();
+    arena.vertices = reader.ReadBlob<VertexType>(arena.vertexCount);
+    arena.indices = reader.ReadBlob<uint32_t>(arena.indexCount);
+    arena.meshlets = reader.ReadBlob<Meshlet>(arena.meshletCount);
+    for (const MeshArenaRange &range : arena.ranges) {
+        Require(range.baseVertex <= arena.vertexCount &&
+                    range.vertexCount <= arena.vertexCount - range.baseVertex,
+            "mesh vertex range");
+        Require(range.firstIndex <= arena.indexCount &&
+                    range.indexCount <= arena.indexCount - range.firstIndex,
+            "mesh index range");
+        Require(
+            IndicesInRange(arena.indices + range.firstIndex, range.indexCount, range.vertexCount),
+            "mesh vertex index");
+        for (uint32_t l = 0; l < range.lodCount; l++) {
+            const MeshLod &lod = range.lods[l];
+            Require(lod.firstIndex <= arena.indexCount &&
+                        lod.indexCount <= arena.indexCount - lod.firstIndex,
+                "level of detail index range");
+            Require(IndicesInRange(
+                        arena.indices + lod.firstIndex, lod.indexCount, range.vertexCount),
+                "level of detail vertex index");
+        }
+        Require(range.firstMeshlet <= arena.meshletCount &&
+                    range.meshletCount <= arena.meshletCount - range.firstMeshlet,
+            "meshlet range");
+        for (uint32_t m = 0; m < range.meshletCount; m++) {
+            const Meshlet &meshlet = arena.meshlets[range.firstMeshlet + m];
+            Require(meshlet.firstIndex <= range.indexCount &&
+                        meshlet.indexCount <= range.indexCount - meshlet.firstIndex,
+                "meshlet index range");
+        }
+    }
+}
+
+} // namespace
+
+void WriteCookedModel(const CookedModelData &model, const std::string &path) {
+    Writer writer;
+    writer.stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!writer.stream) {
+        spdlog::error("Failed to open '{}' for writing", path);
+        throw std::runtime_error("Failed to write cooked model: " + path);
+    }
+
+    writer.Write(CookedModelMagic);
+    writer.Write(CookedModelVersion);
+
+    WriteArena(writer, model.meshes, model.meshMaterials);
+    WriteArena(writer, model.skinnedMeshes, model.skinnedMeshMaterials);
+
+    writer.Write(static_cast<uint32_t>(model.materials.size()));
+    for (const CookedMaterial &material : model.materials) {
+        writer.Write(material.baseColorFactor);
+        writer.Write(material.metallicFactor);
+        writer.Write(material.roughnessFactor);
+        writer.Write(material.emissiveFactor);
+        writer.Write(material.normalScale);
+        writer.Write(static_cast<int32_t>(material.baseColorImage));
+        writer.Write(static_cast<int32_t>(material.metallicRoughnessImage));
+        writer.Write(static_cast<int32_t>(material.emissiveImage));
+        writer.Write(static_cast<int32_t>(material.normalImage));
+    }
+
+    writer.Write(static_cast<uint32_t>(model.images.size()));
+    for (const CookedImage &image : model.images) {
+        const size_t byteCount = static_cast<size_t>(image.width) * image.height * 4;
+        if (image.pixels.size() != byteCount) {
+            throw std::runtime_error("Cooked image pixels do not match its size");
+        }
+        writer.Write(image.width);
+        writer.Write(image.height);
+        writer.Align();
+        writer.WriteBytes(image.pixels.data(), byteCount);
+    }
+
+    writer.Write(static_cast<uint32_t>(model.nodes.size()));
+    for (const NodeTemplate &node : model.nodes) {
+        writer.WriteString(node.name);
+        writer.Write(node.restTranslation);
+        writer.Write(glm::vec4(node.restRotation.x,
+            node.restRotation.y,
+            node.restRotation.z,
+            node.restRotation.w));
+        writer.Write(node.restScale);
+        writer.Write(static_cast<int32_t>(node.parentIndex));
+        writer.Write(static_cast<int32_t>(node.skinIndex));
+        writer.WriteVector(node.meshIndices);
+        writer.WriteVector(node.skinnedMeshIndices);
+    }
+
+    writer.Write(static_cast<uint32_t>(model.skins.size()));
+    for (const Skin &skin : model.skins) {
+        writer.WriteString(skin.name);
+        writer.Write(static_cast<int32_t>(skin.skeletonRoot));
+        writer.WriteVector(skin.jointNodes);
+        writer.WriteVector(skin.inverseBindMatrices);
+    }
+
+    writer.Write(static_cast<uint32_t>(model.animations.size()));
+    for (const AnimationDef &animation : model.animations) {
+        writer.WriteString(animation.name);
+        writer.Write(animation.duration);
+        writer.Write(static_cast<uint32_t>(animation.channels.size()));
+        for (const AnimationChannel &channel : animation.channels) {
+            writer.Write(static_cast<int32_t>(channel.nodeIndex));
+            writer.Write(static_cast<uint32_t>(channel.path));
+            writer.Write(static_cast<uint32_t>(channel.interpolation));
+            writer.WriteVector(channel.keyframes);
+        }
+    }
+
+    writer.stream.flush();
+    if (!writer.stream) {
+        spdlog::error("Failed while writing '{}'", path);
+        throw std::runtime_error("Failed to write cooked model: " + path);
+    }
+}
+
+bool IsCookedModelFile(const std::string &path) {
+    std::ifstream stream(path, std::ios::in | std::ios::binary);
+    uint32_t magic = 0;
+    stream.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    return stream && magic == CookedModelMagic;
+}
+
+CookedModelFile::CookedModelFile(const std::string &path) {
+    file = std::make_unique<MappedFile>(path);
+
+    Reader reader;
+    reader.data = file->GetData();
+    reader.size = file->GetSize();
+    if (reader.size < 8 || reader.Read<uint32_t>() != CookedModelMagic) {
+        throw std::runtime_error("Not a cooked model file: " + path);
+    }
+    const uint32_t version = reader.Read<uint32_t>();
+    if (version != CookedModelVersion) {
+        spdlog::error("Cooked model '{}' is version {}, expected {}; re-cook it",
+            path,
+            version,
+            CookedModelVersion);
+        throw std::runtime_error("Cooked model version mismatch: " + path);
+    }
+
+    // The arenas come first but reference materials, which follow them,
+    // so their material indices are checked once the count is known.
+    ReadArena(reader, meshes);
+    ReadArena(reader, skinnedMeshes);
+
+    materials.resize(reader.Read<uint32_t>());
+    for (CookedMaterial &material : materials) {
+        material.baseColorFactor = reader.Read<glm::vec4>();
+        material.metallicFactor = reader.Read<float>();
+        material.roughnessFactor = reader.Read<float>();
+        material.emissiveFactor = reader.Read<glm::vec3>();
+        material.normalScale = reader.Read<float>();
+        material.baseColorImage = reader.Read<int32_t>();
+        material.metallicRoughnessImage = reader.Read<int32_t>();
+        material.emissiveImage = reader.Read<int32_t>();
+        material.normalImage = reader.Read<int32_t>();
+    }
+    for (int material : meshes.materials) {
+        Require(IndexInRange(material, materials.size(), true), "mesh material");
+    }
+    for (int material : skinnedMeshes.materials) {
+        Require(IndexInRange(material, materials.size(), true), "skinned mesh material");
+    }
+
+    images.resize(reader.Read<uint32_t>());
+    for (CookedImageView &image : images) {
+        image.width = reader.Read<uint32_t>();
+        image.height = reader.Read<uint32_t>();
+        const size_t byteCount = static_cast<size_t>(image.width) * image.height * 4;
+        const uint8_t *pixels = reader.ReadBlob<uint8_t>(byteCount);
+        image.pixels = image.width > 0 && image.height > 0 ? pixels : nullptr;
+    }
+    for (const CookedMaterial &material : materials) {
+        for (int image : {material.baseColorImage,
+                 material.metallicRoughnessImage,
+                 material.emissiveImage,
+                 material.normalImage}) {
+            Require(IndexInRange(image, images.size(), true), "material image");
+        }
+    }
+
+    nodes.resize(reader.Read<uint32_t>());
+    for (NodeTemplate &node : nodes) {
+        node.name = reader.ReadString();
+        node.restTranslation = reader.Read<glm::vec3>();
+        const glm::vec4 rotation = reader.Read<glm::vec4>();
+        node.restRotation = glm::quat(rotation.w, rotation.x, rotation.y, rotation.z);
+        node.restScale = reader.Read<glm::vec3>();
+        node.parentIndex = reader.Read<int32_t>();
+        node.skinIndex = reader.Read<int32_t>();
+        node.meshIndices = reader.ReadVector<int>();
+        node.skinnedMeshIndices = reader.ReadVector<int>();
+    }
+
+    skins.resize(reader.Read<uint32_t>());
+    for (Skin &skin : skins) {
+        skin.name = reader.ReadString();
+        skin.skeletonRoot = reader.Read<int32_t>();
+        skin.jointNodes = reader.ReadVector<int>();
+        skin.inverseBindMatrices = reader.ReadVector<glm::mat4>();
+        Require(skin.inverseBindMatrices.size() == skin.jointNodes.size(), "skin matrices");
+        Require(IndexInRange(skin.skeletonRoot, nodes.size(), true), "skeleton root");
+        for (int joint : skin.jointNodes) {
+            Require(IndexInRange(joint, nodes.size()), "skin joint");
+        }
+    }
+
+    for (const NodeTemplate &node : nodes) {
+        Require(IndexInRange(node.parentIndex, nodes.size(), true), "node parent");
+        Require(IndexInRange(node.skinIndex, skins.size(), true), "node skin");
+        for (int mesh : node.meshIndices) {
+            Require(IndexInRange(mesh, meshes.ranges.size()), "node mesh");
+        }
+        for (int mesh : node.skinnedMeshIndices) {
+            Require(IndexInRange(mesh, skinnedMeshes.ranges.size()), "node skinned mesh");
+        }
+    }
+    Require(ParentChainsTerminate(nodes), "node hierarchy cycle");
+
+    animations.resize(reader.Read<uint32_t>());
+    for (AnimationDef &animation : animations) {
+        animation.name = reader.ReadString();
+        animation.duration = reader.Read<float>();
+        animation.channels.resize(reader.Read<uint32_t>());
+        for (AnimationChannel &channel : animation.channels) {
+            channel.nodeIndex = reader.Read<int32_t>();
+            const uint32_t channelPath = reader.Read<uint32_t>();
+            const uint32_t interpolation = reader.Read<uint32_t>();
+            Require(IndexInRange(channel.nodeIndex, nodes.size()), "animation node");
+            Require(channelPath <= static_cast<uint32_t>(AnimationPath::Scale), "animation path");
+            Require(interpolation <= static_cast<uint32_t>(AnimationInterpolation::CubicSpline),
+                "animation interpolation");
+            channel.path = static_cast<AnimationPath>(channelPath);
+            channel.interpolation = static_cast<AnimationInterpolation>(interpolation);
+            channel.keyframes = reader.ReadVector<AnimationKeyframe>();
+        }
+    }
+
+    Require(reader.offset == reader.size, "trailing data");
+}
+
+CookedModelFile::~CookedModelFile() = default;
+
+} // namespace Lucky
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <cmath>
+
+#include <SDL3/SDL_assert.h>
+
+#include <Lucky/BatchRenderer.hpp>
+#include <Lucky/Color.hpp>
+#include <Lucky/DynamicResolution.hpp>
+#include <Lucky/GraphicsDevice.hpp>
+#include <Lucky/Texture.hpp>
+
+namespace Lucky {
+
+namespace {
+
+// Weight of the newest frame in the smoothed frame time. Low enough to
+// ride out a single hitch, high enough to react within a few frames.
+constexpr float SmoothingFactor = 0.25f;
+
+// Upper bound on the wait between probes, as a multiple of
+// framesToIncrease.
+constexpr int MaxIncreaseDelayFactor = 16;
+
+} // namespace
+
+DynamicResolutionController::DynamicResolutionController(const DynamicResolutionSettings &settings)
+    : settings(settings), scale(settings.maxScale), increaseDelay(settings.framesToIncrease) {
+    SDL_assert(settings.targetFrameSeconds > 0.0f);
+    SDL_assert(settings.minScale > 0.0f && settings.minScale <= settings.maxScale);
+    SDL_assert(settings.scaleStep > 0.0f);
+    SDL_assert(settings.framesToDecrease > 0 && settings.framesToIncrease > 0);
+}
+
+void DynamicResolutionController::Update(float frameSeconds) {
+    if (frameSeconds <= 0.0f) {
+        return;
+    }
+    if (hasSample) {
+        smoothedFrameSeconds += (frameSeconds - smoothedFrameSeconds) * SmoothingFactor;
+    } else {
+        smoothedFrameSeconds = frameSeconds;
+        hasSample = true;
+    }
+
+    // A probe that has held for the longest possible wait has settled;
+    // the next one can go back to waiting the minimum.
+    const int maxIncreaseDelay = settings.framesToIncrease * MaxIncreaseDelayFactor;
+    if (framesSinceIncrease >= 0 && ++framesSinceIncrease >= maxIncreaseDelay) {
+        increaseDelay = settings.framesToIncrease;
+        framesSinceIncrease = -1;
+    }
+
+    // Drops need consecutive slow frames, so one hitch resets the count
+    // instead of lingering in the average; rises go by the average,
+    // which jitters less than single frames.
+    const float target = settings.targetFrameSeconds;
+    const bool overBudget = frameSeconds > target * settings.overBudgetRatio;
+    const bool underBudget = smoothedFrameSeconds <= target * settings.underBudgetRatio;
+    overBudgetFrames = overBudget ? overBudgetFrames + 1 : 0;
+    underBudgetFrames = underBudget ? std::min(underBudgetFrames + 1, increaseDelay) : 0;
+
+    if (overBudgetFrames >= settings.framesToDecrease) {
+        // Pixel cost goes with the area, so the frame time shrinks with
+        // the square of the scale. Drop at least one step.
+        const float wanted = scale * std::sqrt(target / smoothedFrameSeconds);
+        const float stepped = std::floor(wanted / settings.scaleStep) * settings.scaleStep;
+        if (framesSinceIncrease >= 0) {
+            // The last rise didn't hold; wait longer before the next.
+            increaseDelay = std::min(increaseDelay * 2, maxIncreaseDelay);
+            framesSinceIncrease = -1;
+        }
+        SetScale(std::min(stepped, scale - settings.scaleStep));
+    } else if (underBudgetFrames >= increaseDelay && scale < settings.maxScale) {
+        const float stepped =
+            std::round((scale + settings.scaleStep) / settings.scaleStep) * settings.scaleStep;
+        SetScale(stepped);
+        framesSinceIncrease = 0;
+    }
+}
+
+void DynamicResolutionController::SetScale(float newScale) {
+    scale = std::clamp(newScale, settings.minScale, settings.maxScale);
+
+    // Frame times measured at the old scale say nothing about the new one.
+    hasSample = false;
+    overBudgetFrames = 0;
+    underBudgetFrames = 0;
+}
+
+DynamicResolution::DynamicResolution(
+    GraphicsDevice &graphicsDevice, const DynamicResolutionSettings &settings)
+    : graphicsDevice(&graphicsDevice), controller(settings) {
+}
+
+DynamicResolution::~DynamicResolution() = default;
+
+Rectangle DynamicResolution::Begin() {
+    SDL_assert(!active);
+    SDL_assert(graphicsDevice->GetCurrentRenderPass() == nullptr);
+    const int screenWidth = graphicsDevice->GetScreenWidth();
+    const int screenHeight = graphicsDevice->GetScreenHeight();
+    if (screenWidth <= 0 || screenHeight <= 0) {
+        return Rectangle();
+    }
+
+    const float maxScale = controller.GetSettings().maxScale;
+    const int targetWidth = std::max(1, static_cast<int>(std::ceil(screenWidth * maxScale)));
+    const int targetHeight = std::max(1, static_cast<int>(std::ceil(screenHeight * maxScale)));
+    if (!colorTarget || static_cast<int>(colorTarget->GetWidth()) != targetWidth ||
+        static_cast<int>(colorTarget->GetHeight()) != targetHeight) {
+        colorTarget = std::make_unique<Texture>(*graphicsDevice,
+            TextureType::RenderTarget,
+            targetWidth,
+            targetHeight,
+            TextureFormat::Normal);
+        depthTarget = std::make_unique<Texture>(*graphicsDevice,
+            TextureType::DepthTarget,
+            targetWidth,
+            targetHeight,
+            TextureFormat::Depth);
+    }
+
+    const float scale = controller.GetScale();
+    renderViewport = Rectangle(0,
+        0,
+        std::clamp(static_cast<int>(std::round(screenWidth * scale)), 1, targetWidth),
+        std::clamp(static_cast<int>(std::round(screenHeight * scale)), 1, targetHeight));
+    graphicsDevice->BindRenderTarget(*colorTarget, *depthTarget, false);
+    graphicsDevice->SetViewport(renderViewport);
+    active = true;
+    return renderViewport;
+}
+
+void DynamicResolution::End(BatchRenderer &batchRenderer) {
+    if (!active) {
+        return;
+    }
+    active = false;
+    graphicsDevice->UnbindDepthRenderTarget();
+    graphicsDevice->UnbindRenderTarget();
+
+    // Sample from the first to the last texel center of the rendered
+    // region, so bilinear filtering at the screen edges never blends in
+    // texels outside it. Rows are stored top-down while BatchRenderer is
+    // Y-up, so V runs from the region's bottom row to its top.
+    const float textureWidth = static_cast<float>(colorTarget->GetWidth());
+    const float textureHeight = static_cast<float>(colorTarget->GetHeight());
+    const float u0 = 0.5f / textureWidth;
+    const float u1 = (renderViewport.width - 0.5f) / textureWidth;
+    const float vTop = 0.5f / textureHeight;
+    const float vBottom = (renderViewport.height - 0.5f) / textureHeight;
+
+    batchRenderer.Begin(BlendMode::None, *colorTarget);
+    batchRenderer.BatchQuadUV({u0, vBottom},
+        {u1, vTop},
+        {0.0f, 0.0f},
+        {static_cast<float>(graphicsDevice->GetScreenWidth()),
+            static_cast<float>(graphicsDevice->GetScreenHeight())},
+        Color::White);
+    batchRenderer.End();
+}
+
+} // namespace Lucky
@@ -1,5 +1,17 @@
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_assert.h>
@@ -9,46 +21,128 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <spdlog/spdlog.h>
 
+#include <Lucky/Bounds.hpp>
 #include <Lucky/Camera.hpp>
 #include <Lucky/ForwardRenderer.hpp>
 #include <Lucky/GraphicsDevice.hpp>
+#include <Lucky/LightSelection.hpp>
 #include <Lucky/Material.hpp>
 #include <Lucky/Mesh.hpp>
+#include <Lucky/OcclusionCuller.hpp>
+#include <Lucky/RetainedScene.hpp>
 #include <Lucky/Sampler.hpp>
 #include <Lucky/Scene3D.hpp>
 #include <Lucky/Shader.hpp>
+#include <Lucky/ShadowAtlas.hpp>
 #include <Lucky/SkinnedMesh.hpp>
+#include <Lucky/StorageBuffer.hpp>
 #include <Lucky/Texture.hpp>
+#include <Lucky/ThreadPool.hpp>
 
 namespace Lucky {
 
-namespace {
-
-constexpr int MaxLights = 8;
-
-// Per-draw vertex UBO at slot 1, shared between the forward and shadow
-// pipelines so the per-object push is identical for both passes.
-struct ObjectUBO {
+// One entry of the persistent object buffer (t0, space0 in the vertex
+// stage), indexed by position in Scene3D::objects. Layout mirrors the
+// HLSL ObjectData struct in forward.vert.hlsl / shadow_depth.vert.hlsl;
+// do not reorder. Unused light index bytes stay zero so the bytewise
+// change detection in StorageBuffer stays deterministic.
+struct ForwardObjectData {
     glm::mat4 model;
     glm::vec4 colorTint;
+    uint32_t materialIndex;
+    uint32_t lightCount;
+    uint32_t lightIndices[2]; // byte indices into the lighting UBO, four per word
 };
+static_assert(sizeof(ForwardObjectData) == 96, "ForwardObjectData must match HLSL layout");
 
-// Per-draw fragment UBO at slot 1 (b1, space3). Layout mirrors the HLSL
-// cbuffer in forward.frag.hlsl exactly; do not reorder.
-struct MaterialUBO {
+// One entry of the material table (space2 in the fragment stage, after
+// the shadow atlas and the variant's material textures).
+// Layout mirrors the HLSL MaterialData struct in forward.frag.hlsl
+// exactly; do not reorder.
+struct ForwardMaterialData {
     glm::vec4 baseColorFactor;
     glm::vec3 emissiveFactor;
     float metallicFactor;
     float roughnessFactor;
-    int hasBaseColorTexture;
-    int hasMetallicRoughnessTexture;
-    int hasEmissiveTexture;
-    int hasNormalTexture;
     float normalScale;
     float pad0;
     float pad1;
 };
-static_assert(sizeof(MaterialUBO) == 64, "MaterialUBO must match HLSL cbuffer layout");
+static_assert(sizeof(ForwardMaterialData) == 48, "ForwardMaterialData must match HLSL layout");
+
+// One entry of the culling table read by forward_cull.comp (t1, space0
+// in the compute stage), parallel to the object buffer. Bounds are the
+// mesh's, in mesh space; `batch` indexes the frame's indirect batches,
+// or is NoIndirectBatch for objects without a mesh. Layout mirrors the
+// HLSL CullData struct; do not reorder.
+struct ForwardCullData {
+    glm::vec3 boundsCenter;
+    uint32_t batch;
+    glm::vec3 boundsExtents;
+    uint32_t firstVisible;
+};
+static_assert(sizeof(ForwardCullData) == 32, "ForwardCullData must match HLSL layout");
+
+// Rigid objects sharing a mesh and material, drawn with one instanced
+// indirect draw per view. Their visible indices occupy
+// `[firstVisible, firstVisible + objectCount)` of each view's run of the
+// visible list.
+struct ForwardIndirectBatch {
+    const Mesh *mesh;
+    const Material *material;
+    int lod;
+    uint32_t features;
+    MeshVertexFormat vertexFormat;
+    uint32_t objectCount;
+    uint32_t firstVisible;
+};
+
+// Shadow atlas bookkeeping for one entry of Scene3D::lights, carried
+// across frames. `tileSize` is the size the light currently asks the
+// atlas for; a different desired size replaces it only after being
+// wanted for ShadowTileResizeFrames frames in a row. `tiles` are the
+// light's placements last frame (one per cube face for point lights)
+// and the signatures fingerprint what those tiles hold in the live and
+// static atlases; zero means the tile must be redrawn.
+struct ForwardShadowLightState {
+    uint32_t tileSize = 0;
+    uint32_t pendingTileSize = 0;
+    uint32_t pendingFrames = 0;
+    ShadowAtlasTile tiles[6];
+    uint64_t signatures[6] = {};
+    uint64_t staticSignatures[6] = {};
+};
+
+namespace {
+
+constexpr int MaxLights = 64;
+static_assert(MaxLights <= MaxSelectableLights, "light indices must fit a byte");
+
+constexpr uint32_t NoIndirectBatch = 0xFFFFFFFFu;
+
+// Per-draw vertex UBO at slot 1 for the rigid forward and depth
+// pipelines. Direct draws name the object; indirect draws set
+// `useVisibleList` and look each instance's object up in the visible
+// list at `firstVisible + instance`. The position offset and scale
+// decode the mesh's stored positions; see Mesh::GetPositionOffset.
+struct DrawUBO {
+    uint32_t objectIndex;
+    uint32_t firstVisible;
+    uint32_t useVisibleList;
+    uint32_t pad;
+    glm::vec4 positionOffset;
+    glm::vec4 positionScale;
+};
+
+// Compute UBO for forward_cull.comp. Layout mirrors the HLSL Cull
+// cbuffer; `planes` holds six inward-facing planes per view.
+struct CullUBO {
+    glm::vec4 planes[ForwardRenderer::MaxViews * 6];
+    uint32_t objectCount;
+    uint32_t viewCount;
+    uint32_t batchCount;
+    uint32_t visiblePerView;
+};
 
 // Per-light entry in the fragment LightingUBO. Layout mirrors the HLSL
 // Light struct in forward.frag.hlsl exactly; do not reorder fields.
@@ -61,33 +155,44 @@ struct LightUBOEntry {
     int type; // 0=Directional, 1=Point, 2=Spot
     float innerCone;
     float outerCone;
-    int shadowIndex;
-    int shadowType; // 0 = 2D spot/directional (use ShadowVP[shadowIndex]),
-                    // 1 = point cube (use pointShadowMap[shadowIndex] + PointShadowNearFar)
+    int shadowIndex; // first entry in shadowTiles, or -1 for no shadow
+    int shadowType;  // 0 = one tile (spot/directional),
+                     // 1 = six consecutive cube-face tiles (point)
 };
 static_assert(sizeof(LightUBOEntry) == 64, "Light entry must match HLSL stride");
 
+// One shadow atlas tile: the view-projection it was rendered with and
+// where it sits in the atlas, as a UV offset (xy) and scale (zw).
+struct ShadowTileUBOEntry {
+    glm::mat4 viewProjection;
+    glm::vec4 uvRect;
+};
+static_assert(sizeof(ShadowTileUBOEntry) == 80, "Shadow tile entry must match HLSL stride");
+
 struct LightingUBO {
     glm::vec3 ambientColor;
     int lightCount;
     glm::vec3 cameraPosition;
     float pad;
     LightUBOEntry lights[MaxLights];
-    glm::mat4 shadowVP[ForwardRenderer::MaxShadowMaps];
-    // Per-point-shadow near/far packed (n0, f0, n1, f1) -- the cube
-    // shadow path stores hardware depth, so the fragment shader needs
-    // these to reverse-project the comparison value. Sized for
-    // MaxPointShadows = 2.
-    glm::vec4 pointShadowNearFar;
+    ShadowTileUBOEntry shadowTiles[ForwardRenderer::MaxShadowTiles];
+    float shadowAtlasTexelSize;
+    float shadowPad[3];
 };
-static_assert(sizeof(LightingUBO) == 32 + MaxLights * 64 + ForwardRenderer::MaxShadowMaps * 64 + 16,
+static_assert(sizeof(LightingUBO) ==
+                  32 + MaxLights * 64 + ForwardRenderer::MaxShadowTiles * 80 + 16,
     "LightingUBO must match HLSL cbuffer layout");
 
-// Per-draw vertex UBO for the skinned path: just ColorTint, since the
-// joint matrices already encode each vertex's world placement so the
-// shader doesn't need a Model matrix.
+// Per-draw vertex UBO for the skinned path: ColorTint and the material
+// table index, since the joint matrices already encode each vertex's
+// world placement so the shader doesn't need a Model matrix. Skinned
+// objects stay out of the object buffer -- their per-frame joint
+// palette is pushed per draw anyway.
 struct SkinnedObjectUBO {
     glm::vec4 colorTint;
+    uint32_t materialIndex;
+    uint32_t lightCount;
+    uint32_t lightIndices[2];
 };
 
 // Per-draw vertex UBO at slot 2 for the skinned path. Holds the full
@@ -112,6 +217,12 @@ int LightTypeToShader(LightType type) {
     return 0;
 }
 
+// Far plane for a local light's shadow views; lights without a range
+// fall back to a fixed distance.
+float ShadowRange(const Light &light) {
+    return (light.range > 0.0f) ? light.range : 25.0f;
+}
+
 // Build a light view-projection matrix appropriate for the light type.
 // Directional lights get an orthographic frustum centered on the origin;
 // spot lights get a perspective from the light's position with FOV
@@ -133,8 +244,8 @@ glm::mat4 BuildShadowViewProj(const Light &light) {
         // Fixed-size frustum sized to cover the typical demo scene.
         // A real scene wants this fitted to the camera frustum each
         // frame (cascaded shadow maps); the trade-off here is shadow
-        // texel density: ShadowMapSize / (2*halfExtent) world units
-        // per texel (currently 2048 / 24 ≈ 12mm/texel).
+        // texel density: (2*halfExtent) / tile size world units per
+        // texel (24 / 2048 ≈ 12mm/texel at MaxShadowTileSize).
         const float halfExtent = 12.0f;
         const glm::mat4 proj = glm::orthoRH_ZO(
             -halfExtent, halfExtent, -halfExtent, halfExtent, 0.1f, distance * 2.0f);
@@ -149,38 +260,180 @@ glm::mat4 BuildShadowViewProj(const Light &light) {
     }
     const float outerAngle = std::acos(glm::clamp(light.outerCone, -1.0f, 1.0f));
     const float fov = 2.0f * outerAngle;
-    const float range = (light.range > 0.0f) ? light.range : 25.0f;
+    const float range = ShadowRange(light);
     const float nearPlane = std::max(0.5f, range * 0.05f);
     const glm::mat4 view = glm::lookAt(light.position, light.position + dir, up);
     const glm::mat4 proj = glm::perspectiveRH_ZO(fov, 1.0f, nearPlane, range);
     return proj * view;
 }
 
-void DrawSceneGeometry(SDL_GPURenderPass *pass, SDL_GPUCommandBuffer *cmd, const Scene3D &scene) {
-    for (const SceneObject &object : scene.objects) {
-        if (!object.mesh) {
-            continue;
-        }
+// Bits of the forward.frag permutation mask: which optional material
+// textures a variant samples. Must match FEATURE_* in forward.frag.hlsl.
+enum MaterialFeature : uint32_t {
+    MaterialFeatureBaseColorTexture = 1u << 0,
+    MaterialFeatureMetallicRoughnessTexture = 1u << 1,
+    MaterialFeatureEmissiveTexture = 1u << 2,
+    MaterialFeatureNormalTexture = 1u << 3,
+};
+
+uint32_t MaterialFeaturesOf(const Material &material) {
+    uint32_t features = 0;
+    if (material.baseColorTexture) {
+        features |= MaterialFeatureBaseColorTexture;
+    }
+    if (material.metallicRoughnessTexture) {
+        features |= MaterialFeatureMetallicRoughnessTexture;
+    }
+    if (material.emissiveTexture) {
+        features |= MaterialFeatureEmissiveTexture;
+    }
+    if (material.normalTexture) {
+        features |= MaterialFeatureNormalTexture;
+    }
+    return features;
+}
 
-        ObjectUBO ubo;
-        ubo.model = object.transform;
-        ubo.colorTint = glm::vec4(object.color, 1.0f);
-        SDL_PushGPUVertexUniformData(cmd, 1, &ubo, sizeof(ubo));
+ForwardMaterialData PackMaterial(const Material &material) {
+    ForwardMaterialData data{};
+    data.baseColorFactor = material.baseColorFactor;
+    data.emissiveFactor = material.emissiveFactor;
+    data.metallicFactor = material.metallicFactor;
+    data.roughnessFactor = material.roughnessFactor;
+    data.normalScale = material.normalScale;
+    return data;
+}
 
+// Binds the rigid vertex shaders' storage buffers: the object buffer at
+// t0 and the GPU-culled visible list at t1.
+void BindObjectStorage(
+    SDL_GPURenderPass *pass, SDL_GPUBuffer *objectBuffer, SDL_GPUBuffer *visibleBuffer) {
+    SDL_GPUBuffer *buffers[2] = {objectBuffer, visibleBuffer};
+    SDL_BindGPUVertexStorageBuffers(pass, 0, buffers, 2);
+}
+
+// Starts a DrawUBO with `mesh`'s position decode filled in.
+DrawUBO MakeDrawUBO(const Mesh &mesh) {
+    DrawUBO ubo{};
+    ubo.positionOffset = glm::vec4(mesh.GetPositionOffset(), 0.0f);
+    ubo.positionScale = glm::vec4(mesh.GetPositionScale(), 0.0f);
+    return ubo;
+}
+
+// The vertex and index buffers last bound in a render pass. Meshes
+// that share a Model's MeshArena share buffers, so a run of draws from
+// one model binds them once. Reset after binding a pipeline, since
+// SDL_GPU doesn't promise that bindings survive it.
+struct GeometryBinding {
+    SDL_GPUBuffer *vertexBuffer = nullptr;
+    SDL_GPUBuffer *indexBuffer = nullptr;
+
+    void Reset() {
+        vertexBuffer = nullptr;
+        indexBuffer = nullptr;
+    }
+};
+
+template <typename MeshType>
+void BindMeshBuffers(SDL_GPURenderPass *pass, GeometryBinding &binding, const MeshType &mesh) {
+    if (mesh.GetVertexBuffer() != binding.vertexBuffer) {
         SDL_GPUBufferBinding vbufBinding;
         SDL_zero(vbufBinding);
-        vbufBinding.buffer = object.mesh->GetVertexBuffer();
+        vbufBinding.buffer = mesh.GetVertexBuffer();
         SDL_BindGPUVertexBuffers(pass, 0, &vbufBinding, 1);
-
+        binding.vertexBuffer = vbufBinding.buffer;
+    }
+    if (mesh.GetIndexBuffer() != binding.indexBuffer) {
         SDL_GPUBufferBinding ibufBinding;
         SDL_zero(ibufBinding);
-        ibufBinding.buffer = object.mesh->GetIndexBuffer();
-        SDL_BindGPUIndexBuffer(pass, &ibufBinding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+        ibufBinding.buffer = mesh.GetIndexBuffer();
+        SDL_BindGPUIndexBuffer(pass, &ibufBinding, mesh.GetIndexElementSize());
+        binding.indexBuffer = ibufBinding.buffer;
+    }
+}
+
+// Draws level of detail `lod` of a rigid object whose transform and
+// tint live in the object buffer at `objectIndex`. The caller binds the
+// object storage after binding the pipeline.
+void DrawObjectGeometry(SDL_GPURenderPass *pass, SDL_GPUCommandBuffer *cmd,
+    GeometryBinding &binding, const Mesh &mesh, uint32_t objectIndex, int lod) {
+    DrawUBO ubo = MakeDrawUBO(mesh);
+    ubo.objectIndex = objectIndex;
+    SDL_PushGPUVertexUniformData(cmd, 1, &ubo, sizeof(ubo));
+    BindMeshBuffers(pass, binding, mesh);
+    const MeshLod &level = mesh.GetLod(lod);
+    SDL_DrawGPUIndexedPrimitives(pass,
+        level.indexCount,
+        1,
+        level.firstIndex,
+        static_cast<int32_t>(mesh.GetBaseVertex()),
+        0);
+}
+
+// A run of consecutive indices in a mesh's index buffer, as left over
+// after culling its meshlets.
+struct IndexRun {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+};
 
-        SDL_DrawGPUIndexedPrimitives(pass, object.mesh->GetIndexCount(), 1, 0, 0, 0);
+// Appends the runs of `mesh`'s full detail that survive culling its
+// meshlets against `frustum` and, if `backfaceCulling`, against
+// `viewPosition`, both in mesh-local space. Neighboring survivors merge
+// into one run, so a mostly visible mesh still takes few draws.
+void CullMeshlets(const Mesh &mesh, const Frustum &frustum, const glm::vec3 &viewPosition,
+    bool backfaceCulling, std::vector<IndexRun> &runs) {
+    bool extending = false;
+    for (uint32_t m = 0; m < mesh.GetMeshletCount(); m++) {
+        const Meshlet &meshlet = mesh.GetMeshlet(m);
+        const bool visible = IntersectsFrustum(meshlet.center, meshlet.radius, frustum) &&
+                             !(backfaceCulling && IsMeshletBackfacing(meshlet, viewPosition));
+        if (!visible) {
+            extending = false;
+        } else if (extending) {
+            runs.back().indexCount += meshlet.indexCount;
+        } else {
+            runs.push_back({mesh.GetFirstIndex() + meshlet.firstIndex, meshlet.indexCount});
+            extending = true;
+        }
     }
 }
 
+// DrawObjectGeometry for the full detail of a mesh cut down to `runs`:
+// one set of uniforms and bindings, then a draw per run.
+void DrawObjectRuns(SDL_GPURenderPass *pass, SDL_GPUCommandBuffer *cmd,
+    GeometryBinding &binding, const Mesh &mesh, uint32_t objectIndex,
+    const std::vector<IndexRun> &runs) {
+    DrawUBO ubo = MakeDrawUBO(mesh);
+    ubo.objectIndex = objectIndex;
+    SDL_PushGPUVertexUniformData(cmd, 1, &ubo, sizeof(ubo));
+    BindMeshBuffers(pass, binding, mesh);
+    for (const IndexRun &run : runs) {
+        SDL_DrawGPUIndexedPrimitives(pass,
+            run.indexCount,
+            1,
+            run.firstIndex,
+            static_cast<int32_t>(mesh.GetBaseVertex()),
+            0);
+    }
+}
+
+// Draws the instances forward_cull.comp left in `batch` for one view,
+// using the arguments at `argsIndex` in `drawArgs`. `visibleBase` is the
+// start of the view's run of the visible list. The arguments keep
+// first_instance at zero, since SV_InstanceID doesn't include it on
+// every backend; the offset travels in the DrawUBO instead.
+void DrawIndirectBatch(SDL_GPURenderPass *pass, SDL_GPUCommandBuffer *cmd,
+    GeometryBinding &binding, SDL_GPUBuffer *drawArgs, const ForwardIndirectBatch &batch,
+    uint32_t argsIndex, uint32_t visibleBase) {
+    DrawUBO ubo = MakeDrawUBO(*batch.mesh);
+    ubo.firstVisible = visibleBase + batch.firstVisible;
+    ubo.useVisibleList = 1;
+    SDL_PushGPUVertexUniformData(cmd, 1, &ubo, sizeof(ubo));
+    BindMeshBuffers(pass, binding, *batch.mesh);
+    SDL_DrawGPUIndexedPrimitivesIndirect(
+        pass, drawArgs, argsIndex * sizeof(SDL_GPUIndexedIndirectDrawCommand), 1);
+}
+
 // Push the joint matrix array for a skinned draw. Pads beyond the
 // source skin's joint count out to MaxJoints because the cbuffer is a
 // fixed-size array; trailing slots are set to identity for safety
@@ -198,38 +451,654 @@ void PushJointMatrices(SDL_GPUCommandBuffer *cmd, const std::vector<glm::mat4> &
     SDL_PushGPUVertexUniformData(cmd, 2, &ubo, sizeof(ubo));
 }
 
-// Skinned variant of DrawSceneGeometry. Pushes per-draw joint
-// matrices at slot 2 and a small ColorTint UBO at slot 1, then binds
-// the SkinnedMesh's vertex/index buffers (Vertex3DSkinned format).
-// Slot 0 (Frame) is the caller's responsibility -- both the shadow
-// and main-pass call sites push it once before iterating objects.
-void DrawSkinnedSceneGeometry(
-    SDL_GPURenderPass *pass, SDL_GPUCommandBuffer *cmd, const Scene3D &scene) {
-    for (const SkinnedSceneObject &object : scene.skinnedObjects) {
-        if (!object.mesh || !object.jointMatrices) {
+// Skinned variant of DrawObjectGeometry. Pushes per-draw joint
+// matrices at slot 2 and a small ColorTint + material index + light
+// list UBO at slot 1, then binds the SkinnedMesh's vertex/index buffers
+// (Vertex3DSkinned format). Slot 0 (Frame) is the caller's
+// responsibility -- both the shadow and main-pass call sites push it
+// once before iterating objects. Depth-only passes ignore the
+// material index and lights and pass 0 and an empty list.
+void DrawSkinnedObjectGeometry(SDL_GPURenderPass *pass, SDL_GPUCommandBuffer *cmd,
+    GeometryBinding &binding, const SkinnedSceneObject &object, uint32_t materialIndex,
+    const ObjectLights &lights) {
+    SkinnedObjectUBO objectUbo{};
+    objectUbo.colorTint = glm::vec4(object.color, 1.0f);
+    objectUbo.materialIndex = materialIndex;
+    objectUbo.lightCount = lights.count;
+    objectUbo.lightIndices[0] = lights.indices[0];
+    objectUbo.lightIndices[1] = lights.indices[1];
+    SDL_PushGPUVertexUniformData(cmd, 1, &objectUbo, sizeof(objectUbo));
+
+    PushJointMatrices(cmd, *object.jointMatrices);
+
+    BindMeshBuffers(pass, binding, *object.mesh);
+    SDL_DrawGPUIndexedPrimitives(pass,
+        object.mesh->GetIndexCount(),
+        1,
+        object.mesh->GetFirstIndex(),
+        static_cast<int32_t>(object.mesh->GetBaseVertex()),
+        0);
+}
+
+// World-space bounds plus a fingerprint of everything about a caster
+// that affects the depth it writes (mesh identity and placement). Built
+// once per frame; each shadow view culls against the bounds and skips
+// re-rendering when the fingerprints of its casters are unchanged.
+// `lodScale` is the transform's largest axis scale, which converts the
+// mesh's level of detail errors to world units.
+struct ShadowCaster {
+    BoundingBox worldBounds;
+    uint64_t hash = 0;
+    float lodScale = 1.0f;
+    bool isStatic = false;
+};
+
+// Picks the coarsest level of `mesh` that stays within `maxPixelError`
+// pixels, where one world unit covers `pixelsPerUnit` pixels.
+int SelectObjectLod(
+    const Mesh &mesh, const ShadowCaster &caster, float pixelsPerUnit, float maxPixelError) {
+    if (mesh.GetLodCount() == 1) {
+        return 0;
+    }
+    return SelectMeshLod(
+        &mesh.GetLod(0), mesh.GetLodCount(), pixelsPerUnit * caster.lodScale, maxPixelError);
+}
+
+constexpr uint64_t FnvOffsetBasis = 14695981039346656037ull;
+constexpr uint64_t FnvPrime = 1099511628211ull;
+
+// Fingerprint of a shadow view with no casters. Its depth is just the
+// clear value regardless of which light owns it, so an empty view only
+// needs rendering (clearing) once.
+constexpr uint64_t EmptyViewSignature = 1;
+
+uint64_t HashBytes(uint64_t hash, const void *data, size_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FnvPrime;
+    }
+    return hash;
+}
+
+// Runs `body` over `[0, count)` in ranges of up to `grainSize`, spread
+// across `threadPool` when one is given and inline otherwise.
+void ForEachRange(ThreadPool *threadPool, uint32_t count, uint32_t grainSize,
+    const std::function<void(uint32_t begin, uint32_t end)> &body) {
+    if (threadPool) {
+        threadPool->ParallelFor(count, grainSize, body);
+    } else if (count > 0) {
+        body(0, count);
+    }
+}
+
+// Objects per ForEachRange chunk for the per-object loops: enough work
+// per chunk to amortize the hand-off to a worker.
+constexpr uint32_t ObjectGrainSize = 256;
+
+void BuildShadowCasters(ThreadPool *threadPool, const Scene3D &scene,
+    std::vector<ShadowCaster> &casters, std::vector<ShadowCaster> &skinnedCasters) {
+    casters.assign(scene.objects.size(), ShadowCaster{});
+    ForEachRange(threadPool,
+        static_cast<uint32_t>(scene.objects.size()),
+        ObjectGrainSize,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                const SceneObject &object = scene.objects[i];
+                if (!object.mesh) {
+                    continue;
+                }
+                ShadowCaster &caster = casters[i];
+                caster.worldBounds = TransformBounds(object.mesh->GetBounds(), object.transform);
+                caster.hash = HashBytes(FnvOffsetBasis, &object.mesh, sizeof(object.mesh));
+                caster.hash = HashBytes(caster.hash, &object.transform, sizeof(object.transform));
+                caster.lodScale = std::max(glm::length(glm::vec3(object.transform[0])),
+                    std::max(glm::length(glm::vec3(object.transform[1])),
+                        glm::length(glm::vec3(object.transform[2]))));
+                caster.isStatic = object.isStatic;
+            }
+        });
+
+    // A skinned vertex is a convex blend of its joints' transforms, so
+    // the union of the bind-pose bounds under every joint matrix
+    // encloses the posed mesh. Skinned casters are always dynamic.
+    skinnedCasters.assign(scene.skinnedObjects.size(), ShadowCaster{});
+    ForEachRange(threadPool,
+        static_cast<uint32_t>(scene.skinnedObjects.size()),
+        1,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                const SkinnedSceneObject &object = scene.skinnedObjects[i];
+                if (!object.mesh || !object.jointMatrices) {
+                    continue;
+                }
+                ShadowCaster &caster = skinnedCasters[i];
+                for (const glm::mat4 &joint : *object.jointMatrices) {
+                    caster.worldBounds = MergeBounds(
+                        caster.worldBounds, TransformBounds(object.mesh->GetBounds(), joint));
+                }
+                caster.hash = HashBytes(FnvOffsetBasis, &object.mesh, sizeof(object.mesh));
+                caster.hash = HashBytes(caster.hash,
+                    object.jointMatrices->data(),
+                    object.jointMatrices->size() * sizeof(glm::mat4));
+            }
+        });
+}
+
+// Frames a light must keep wanting a different shadow tile size before
+// its allocation changes. Keeps a light hovering at a size boundary from
+// reshuffling the atlas, and re-rendering every tile, frame to frame.
+constexpr uint32_t ShadowTileResizeFrames = 15;
+
+void UpdateShadowTileSize(ForwardShadowLightState &state, uint32_t desiredSize) {
+    if (state.tileSize == 0 || desiredSize == state.tileSize) {
+        // A light without tiles takes its size right away.
+        state.tileSize = desiredSize;
+        state.pendingFrames = 0;
+        return;
+    }
+    if (desiredSize != state.pendingTileSize) {
+        state.pendingTileSize = desiredSize;
+        state.pendingFrames = 0;
+    }
+    if (++state.pendingFrames >= ShadowTileResizeFrames) {
+        state.tileSize = desiredSize;
+        state.pendingFrames = 0;
+    }
+}
+
+// The atlas request for a shadow-casting light. Directional lights
+// always want the largest tile and outrank everything. Local lights are
+// sized by the on-screen diameter of their range sphere -- about one
+// shadow texel per pixel they can light, halved per face for point
+// lights -- and ranked by that coverage times intensity.
+ShadowTileRequest DesiredShadowTile(
+    const Light &light, const Camera &camera, float screenWidth, float screenHeight) {
+    ShadowTileRequest request;
+    if (light.type == LightType::Directional) {
+        request.size = ForwardRenderer::MaxShadowTileSize;
+        request.priority = std::numeric_limits<float>::max();
+        return request;
+    }
+
+    // With the camera inside the range sphere the light can reach the
+    // whole screen.
+    const float screenSize = std::max(screenWidth, screenHeight);
+    const float range = ShadowRange(light);
+    const float distance = glm::length(light.position - camera.position);
+    float coverage = screenSize;
+    if (distance > range) {
+        const float focalLength = screenHeight * 0.5f / std::tan(camera.fovY * 0.5f);
+        const float diameter =
+            2.0f * focalLength * range / std::sqrt(distance * distance - range * range);
+        coverage = std::min(screenSize, diameter);
+    }
+
+    request.priority = coverage * light.intensity;
+    if (light.type == LightType::Point) {
+        request.count = 6;
+        request.size = ShadowTileSizeForCoverage(coverage * 0.5f,
+            ForwardRenderer::MinShadowTileSize,
+            ForwardRenderer::MaxShadowTileSize / 2);
+    } else {
+        request.size = ShadowTileSizeForCoverage(
+            coverage, ForwardRenderer::MinShadowTileSize, ForwardRenderer::MaxShadowTileSize);
+    }
+    return request;
+}
+
+// Per-frame state shared by every shadow tile.
+struct ShadowPassContext {
+    GraphicsDevice *graphicsDevice = nullptr;
+    ThreadPool *threadPool = nullptr;
+    // Indexed by MeshVertexFormat; null for formats the scene doesn't use.
+    SDL_GPUGraphicsPipeline *pipelines[MeshVertexFormatCount] = {};
+    SDL_GPUGraphicsPipeline *skinnedPipeline = nullptr;
+    SDL_GPUGraphicsPipeline *clearPipeline = nullptr;
+    SDL_GPUGraphicsPipeline *copyPipeline = nullptr;
+    SDL_GPUBuffer *objectBuffer = nullptr;
+    SDL_GPUBuffer *visibleBuffer = nullptr;
+    SDL_GPUSampler *sampler = nullptr;
+    Texture *atlas = nullptr;
+    Texture *staticAtlas = nullptr;
+    const Scene3D *scene = nullptr;
+    const std::vector<ShadowCaster> *casters = nullptr;
+    const std::vector<ShadowCaster> *skinnedCasters = nullptr;
+    // Level of detail error allowed in a tile, in tile texels.
+    float lodPixelError = 0.0f;
+};
+
+// One depth view to keep current: a spot or directional light's tile,
+// or one face of a point light.
+//
+// `useStaticCache` is set for static lights; the two signatures record
+// what the tile currently holds in the live and static atlases.
+struct ShadowTileView {
+    glm::mat4 viewProjection;
+    glm::vec3 lightPosition;
+    float lightRange = 0.0f;
+    ShadowAtlasTile tile;
+    bool useStaticCache = false;
+    uint64_t *signature = nullptr;
+    uint64_t *staticSignature = nullptr;
+};
+
+// What a stale tile needs drawn this frame. The level of detail lists
+// run parallel to the object lists.
+struct ShadowTileWork {
+    const ShadowTileView *view = nullptr;
+    std::vector<uint32_t> staticObjects;
+    std::vector<uint32_t> dynamicObjects;
+    std::vector<uint32_t> skinnedObjects;
+    std::vector<uint8_t> staticLods;
+    std::vector<uint8_t> dynamicLods;
+    uint64_t signature = 0;
+    uint64_t staticSignature = 0;
+    bool redrawStatic = false;
+};
+
+uint64_t HashCasters(uint64_t hash, const std::vector<ShadowCaster> &casters,
+    const std::vector<uint32_t> &indices) {
+    for (uint32_t index : indices) {
+        hash = HashBytes(hash, &casters[index].hash, sizeof(uint64_t));
+    }
+    return hash;
+}
+
+// Culls the casters for `view`, picks their levels of detail for the
+// tile's resolution, and fingerprints the result. Casters outside the
+// view frustum or the light's range are dropped. Returns false, leaving
+// `work` unfinished, if the tile already holds exactly this light and
+// caster set at these levels.
+bool PlanShadowTile(
+    const ShadowPassContext &context, const ShadowTileView &view, ShadowTileWork &work) {
+    const Frustum frustum = MakeFrustum(view.viewProjection);
+
+    const std::vector<ShadowCaster> &casters = *context.casters;
+    for (size_t i = 0; i < casters.size(); i++) {
+        const BoundingBox &bounds = casters[i].worldBounds;
+        if (!IntersectsSphere(bounds, view.lightPosition, view.lightRange) ||
+            !IntersectsFrustum(bounds, frustum)) {
             continue;
         }
+        const float pixelsPerUnit = ProjectedPixelsPerUnit(
+            bounds, view.viewProjection, static_cast<float>(view.tile.size));
+        const uint8_t lod = static_cast<uint8_t>(SelectObjectLod(*context.scene->objects[i].mesh,
+            casters[i],
+            pixelsPerUnit,
+            context.lodPixelError));
+        if (view.useStaticCache && casters[i].isStatic) {
+            work.staticObjects.push_back(static_cast<uint32_t>(i));
+            work.staticLods.push_back(lod);
+        } else {
+            work.dynamicObjects.push_back(static_cast<uint32_t>(i));
+            work.dynamicLods.push_back(lod);
+        }
+    }
+    const std::vector<ShadowCaster> &skinnedCasters = *context.skinnedCasters;
+    for (size_t i = 0; i < skinnedCasters.size(); i++) {
+        const BoundingBox &bounds = skinnedCasters[i].worldBounds;
+        if (IntersectsSphere(bounds, view.lightPosition, view.lightRange) &&
+            IntersectsFrustum(bounds, frustum)) {
+            work.skinnedObjects.push_back(static_cast<uint32_t>(i));
+        }
+    }
 
-        SkinnedObjectUBO objectUbo;
-        objectUbo.colorTint = glm::vec4(object.color, 1.0f);
-        SDL_PushGPUVertexUniformData(cmd, 1, &objectUbo, sizeof(objectUbo));
+    uint64_t staticSignature = EmptyViewSignature;
+    if (!work.staticObjects.empty()) {
+        staticSignature =
+            HashBytes(FnvOffsetBasis, &view.viewProjection, sizeof(view.viewProjection));
+        staticSignature = HashCasters(staticSignature, casters, work.staticObjects);
+        staticSignature =
+            HashBytes(staticSignature, work.staticLods.data(), work.staticLods.size());
+    }
 
-        PushJointMatrices(cmd, *object.jointMatrices);
+    uint64_t signature = EmptyViewSignature;
+    if (!work.staticObjects.empty() || !work.dynamicObjects.empty() ||
+        !work.skinnedObjects.empty()) {
+        signature = HashBytes(staticSignature, &view.viewProjection, sizeof(view.viewProjection));
+        signature = HashCasters(signature, casters, work.dynamicObjects);
+        signature = HashBytes(signature, work.dynamicLods.data(), work.dynamicLods.size());
+        signature = HashCasters(signature, skinnedCasters, work.skinnedObjects);
+    }
+    if (signature == *view.signature) {
+        return false;
+    }
 
-        SDL_GPUBufferBinding vbufBinding;
-        SDL_zero(vbufBinding);
-        vbufBinding.buffer = object.mesh->GetVertexBuffer();
-        SDL_BindGPUVertexBuffers(pass, 0, &vbufBinding, 1);
+    work.view = &view;
+    work.signature = signature;
+    work.staticSignature = staticSignature;
+    work.redrawStatic =
+        !work.staticObjects.empty() && staticSignature != *view.staticSignature;
+    return true;
+}
 
-        SDL_GPUBufferBinding ibufBinding;
-        SDL_zero(ibufBinding);
-        ibufBinding.buffer = object.mesh->GetIndexBuffer();
-        SDL_BindGPUIndexBuffer(pass, &ibufBinding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+// Confines rasterization to one atlas tile.
+void SetTileViewport(SDL_GPURenderPass *pass, const ShadowAtlasTile &tile) {
+    SDL_GPUViewport viewport;
+    SDL_zero(viewport);
+    viewport.x = static_cast<float>(tile.x);
+    viewport.y = static_cast<float>(tile.y);
+    viewport.w = static_cast<float>(tile.size);
+    viewport.h = static_cast<float>(tile.size);
+    viewport.min_depth = 0.0f;
+    viewport.max_depth = 1.0f;
+    SDL_SetGPUViewport(pass, &viewport);
+
+    SDL_Rect scissor;
+    scissor.x = static_cast<int>(tile.x);
+    scissor.y = static_cast<int>(tile.y);
+    scissor.w = static_cast<int>(tile.size);
+    scissor.h = static_cast<int>(tile.size);
+    SDL_SetGPUScissor(pass, &scissor);
+}
+
+// Resets the current tile to the far plane.
+void ClearShadowTile(const ShadowPassContext &context, SDL_GPURenderPass *pass) {
+    SDL_BindGPUGraphicsPipeline(pass, context.clearPipeline);
+    SDL_DrawGPUPrimitives(pass, 3, 1, 0, 0);
+}
+
+// Fills the current tile with the same tile of the static atlas.
+void CopyStaticShadowTile(const ShadowPassContext &context, SDL_GPURenderPass *pass) {
+    SDL_BindGPUGraphicsPipeline(pass, context.copyPipeline);
+    SDL_GPUTextureSamplerBinding binding;
+    SDL_zero(binding);
+    binding.texture = context.staticAtlas->GetGPUTexture();
+    binding.sampler = context.sampler;
+    SDL_BindGPUFragmentSamplers(pass, 0, &binding, 1);
+    SDL_DrawGPUPrimitives(pass, 3, 1, 0, 0);
+}
+
+// Draws `objects`, at the levels of detail in `lods`, and
+// `skinnedObjects` into the current tile over whatever depth it already
+// holds.
+void DrawShadowCasters(const ShadowPassContext &context, SDL_GPUCommandBuffer *cmd,
+    SDL_GPURenderPass *pass, const glm::mat4 &lightVP, const std::vector<uint32_t> &objects,
+    const std::vector<uint8_t> &lods, const std::vector<uint32_t> &skinnedObjects) {
+    // One sweep per vertex format, so each pipeline is bound at most
+    // once per tile.
+    GeometryBinding geometry;
+    for (int format = 0; format < MeshVertexFormatCount; format++) {
+        bool bound = false;
+        for (size_t o = 0; o < objects.size(); o++) {
+            const uint32_t index = objects[o];
+            const Mesh &mesh = *context.scene->objects[index].mesh;
+            if (static_cast<int>(mesh.GetVertexFormat()) != format) {
+                continue;
+            }
+            if (!bound) {
+                SDL_BindGPUGraphicsPipeline(pass, context.pipelines[format]);
+                BindObjectStorage(pass, context.objectBuffer, context.visibleBuffer);
+                SDL_PushGPUVertexUniformData(cmd, 0, &lightVP, sizeof(lightVP));
+                geometry.Reset();
+                bound = true;
+            }
+            DrawObjectGeometry(pass, cmd, geometry, mesh, index, lods[o]);
+        }
+    }
+
+    if (context.skinnedPipeline && !skinnedObjects.empty()) {
+        SDL_BindGPUGraphicsPipeline(pass, context.skinnedPipeline);
+        SDL_PushGPUVertexUniformData(cmd, 0, &lightVP, sizeof(lightVP));
+        geometry.Reset();
+        for (uint32_t index : skinnedObjects) {
+            DrawSkinnedObjectGeometry(
+                pass, cmd, geometry, context.scene->skinnedObjects[index], 0, ObjectLights{});
+        }
+    }
+}
+
+// Re-renders a tile's static casters into the static atlas.
+void RecordStaticShadowTile(const ShadowPassContext &context, SDL_GPUCommandBuffer *cmd,
+    SDL_GPURenderPass *pass, const ShadowTileWork &work) {
+    static const std::vector<uint32_t> none;
+    SetTileViewport(pass, work.view->tile);
+    ClearShadowTile(context, pass);
+    DrawShadowCasters(context,
+        cmd,
+        pass,
+        work.view->viewProjection,
+        work.staticObjects,
+        work.staticLods,
+        none);
+}
+
+// Rebuilds a tile of the live atlas: from the static cache when the
+// tile has static casters, otherwise from the far plane, then draws the
+// dynamic casters on top.
+void RecordLiveShadowTile(const ShadowPassContext &context, SDL_GPUCommandBuffer *cmd,
+    SDL_GPURenderPass *pass, const ShadowTileWork &work) {
+    SetTileViewport(pass, work.view->tile);
+    if (work.staticObjects.empty()) {
+        ClearShadowTile(context, pass);
+    } else {
+        CopyStaticShadowTile(context, pass);
+    }
+    DrawShadowCasters(context,
+        cmd,
+        pass,
+        work.view->viewProjection,
+        work.dynamicObjects,
+        work.dynamicLods,
+        work.skinnedObjects);
+}
+
+// Submits command buffers in ticket order no matter which thread
+// finishes recording first, so the GPU sees the same sequence of
+// passes every frame.
+struct OrderedSubmitter {
+    std::mutex mutex;
+    std::condition_variable turn;
+    uint32_t nextTicket = 0;
+
+    // Waits for `ticket`'s turn, submits `cmd` if it isn't null, and
+    // passes the turn on.
+    void Submit(uint32_t ticket, SDL_GPUCommandBuffer *cmd) {
+        std::unique_lock<std::mutex> lock(mutex);
+        turn.wait(lock, [&] { return nextTicket == ticket; });
+        if (cmd && !SDL_SubmitGPUCommandBuffer(cmd)) {
+            spdlog::error("Failed to submit shadow command buffer: {}", SDL_GetError());
+        }
+        nextTicket++;
+        turn.notify_all();
+    }
+};
+
+// A run of consecutive tiles recorded into one command buffer.
+struct ShadowRecordChunk {
+    bool isStatic = false;
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    bool recorded = false;
+};
+
+// Appends `count` items split into at most `maxChunks` contiguous runs.
+void AppendShadowChunks(std::vector<ShadowRecordChunk> &chunks, bool isStatic, uint32_t count,
+    uint32_t maxChunks) {
+    const uint32_t chunkCount = std::min(count, maxChunks);
+    for (uint32_t c = 0; c < chunkCount; c++) {
+        ShadowRecordChunk chunk;
+        chunk.isStatic = isStatic;
+        chunk.begin = count * c / chunkCount;
+        chunk.end = count * (c + 1) / chunkCount;
+        chunks.push_back(chunk);
+    }
+}
+
+// Records `work` on the thread pool. Each chunk of tiles gets its own
+// command buffer and a depth-only render pass that loads the atlas, so
+// tiles recorded elsewhere survive. Static atlas chunks take the first
+// tickets, which puts every cache refresh on the GPU ahead of the live
+// tiles that copy from it.
+//
+// Signatures are only advanced for tiles whose chunk reached the GPU.
+// If any static chunk failed, live tiles that copy from the cache are
+// left stale too, so they're redrawn from a good cache next frame.
+void RecordShadowTilesParallel(const ShadowPassContext &context,
+    const std::vector<ShadowTileWork *> &staticWork, const std::vector<ShadowTileWork *> &work) {
+    const uint32_t maxChunks = context.threadPool->GetWorkerCount() + 1;
+    std::vector<ShadowRecordChunk> chunks;
+    AppendShadowChunks(chunks, true, static_cast<uint32_t>(staticWork.size()), maxChunks);
+    AppendShadowChunks(chunks, false, static_cast<uint32_t>(work.size()), maxChunks);
+
+    SDL_GPUDevice *device = context.graphicsDevice->GetDevice();
+    OrderedSubmitter submitter;
+    context.threadPool->ParallelFor(
+        static_cast<uint32_t>(chunks.size()), 1, [&](uint32_t ticket, uint32_t) {
+            ShadowRecordChunk &chunk = chunks[ticket];
+            SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(device);
+            if (!cmd) {
+                spdlog::error("Failed to acquire shadow command buffer: {}", SDL_GetError());
+                submitter.Submit(ticket, nullptr);
+                return;
+            }
+
+            SDL_GPUDepthStencilTargetInfo depthInfo;
+            SDL_zero(depthInfo);
+            depthInfo.texture = (chunk.isStatic ? context.staticAtlas : context.atlas)
+                                    ->GetGPUTexture();
+            depthInfo.load_op = SDL_GPU_LOADOP_LOAD;
+            depthInfo.store_op = SDL_GPU_STOREOP_STORE;
+            depthInfo.cycle = false;
+            SDL_GPURenderPass *pass = SDL_BeginGPURenderPass(cmd, nullptr, 0, &depthInfo);
+            if (pass) {
+                for (uint32_t i = chunk.begin; i < chunk.end; i++) {
+                    if (chunk.isStatic) {
+                        RecordStaticShadowTile(context, cmd, pass, *staticWork[i]);
+                    } else {
+                        RecordLiveShadowTile(context, cmd, pass, *work[i]);
+                    }
+                }
+                SDL_EndGPURenderPass(pass);
+                chunk.recorded = true;
+            } else {
+                spdlog::error("Failed to begin shadow render pass: {}", SDL_GetError());
+            }
+            submitter.Submit(ticket, cmd);
+        });
+
+    bool staticFailed = false;
+    for (const ShadowRecordChunk &chunk : chunks) {
+        if (chunk.isStatic) {
+            staticFailed = staticFailed || !chunk.recorded;
+            if (chunk.recorded) {
+                for (uint32_t i = chunk.begin; i < chunk.end; i++) {
+                    *staticWork[i]->view->staticSignature = staticWork[i]->staticSignature;
+                }
+            }
+        }
+    }
+    for (const ShadowRecordChunk &chunk : chunks) {
+        if (chunk.isStatic || !chunk.recorded) {
+            continue;
+        }
+        for (uint32_t i = chunk.begin; i < chunk.end; i++) {
+            if (!staticFailed || work[i]->staticObjects.empty()) {
+                *work[i]->view->signature = work[i]->signature;
+            }
+        }
+    }
+}
+
+// Brings every shadow tile up to date with the least work possible:
+//
+//   - Tiles whose light and culled casters match what they already
+//     hold are skipped.
+//   - For a static light, static casters live in the same tile of the
+//     static atlas, which is only re-rendered when one of them (or the
+//     light) changes. The cached tile is copied into the live atlas and
+//     dynamic casters are drawn on top, so a static light over static
+//     geometry costs one tile copy whenever a dynamic caster moves, and
+//     nothing otherwise.
+//   - Otherwise every caster is drawn into a freshly cleared tile.
+//
+// Tiles can't be cleared or copied individually by the render pass or
+// a copy pass -- load ops act on the whole texture and D3D12 only
+// copies depth textures whole -- so both are done with a full-tile
+// triangle under the tile's viewport and scissor. Without a thread
+// pool that keeps all stale tiles in at most two render passes on the
+// device's command buffer: one over the static atlas, then one over
+// the live atlas. With one, see RecordShadowTilesParallel.
+void RenderShadowTiles(const ShadowPassContext &context, const std::vector<ShadowTileView> &views) {
+    // Each view is culled into its own slot, then the stale ones are
+    // gathered in view order.
+    std::vector<ShadowTileWork> planned(views.size());
+    std::vector<char> stale(views.size(), 0);
+    ForEachRange(context.threadPool,
+        static_cast<uint32_t>(views.size()),
+        1,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                stale[i] = PlanShadowTile(context, views[i], planned[i]) ? 1 : 0;
+            }
+        });
+
+    std::vector<ShadowTileWork *> work;
+    std::vector<ShadowTileWork *> staticWork;
+    for (size_t i = 0; i < views.size(); i++) {
+        if (!stale[i]) {
+            continue;
+        }
+        work.push_back(&planned[i]);
+        if (planned[i].redrawStatic) {
+            staticWork.push_back(&planned[i]);
+        }
+    }
+    if (work.empty()) {
+        return;
+    }
 
-        SDL_DrawGPUIndexedPrimitives(pass, object.mesh->GetIndexCount(), 1, 0, 0, 0);
+    if (context.threadPool) {
+        RecordShadowTilesParallel(context, staticWork, work);
+        return;
+    }
+
+    SDL_GPUCommandBuffer *cmd = context.graphicsDevice->GetCommandBuffer();
+    if (!staticWork.empty()) {
+        context.graphicsDevice->BindDepthRenderTarget(*context.staticAtlas, 0, false);
+        context.graphicsDevice->BeginRenderPass();
+        SDL_GPURenderPass *staticPass = context.graphicsDevice->GetCurrentRenderPass();
+        if (!staticPass) {
+            // The live tiles would copy stale caches; retry next frame.
+            return;
+        }
+        for (const ShadowTileWork *tileWork : staticWork) {
+            RecordStaticShadowTile(context, cmd, staticPass, *tileWork);
+        }
+        context.graphicsDevice->EndRenderPass();
+        for (const ShadowTileWork *tileWork : staticWork) {
+            *tileWork->view->staticSignature = tileWork->staticSignature;
+        }
+    }
+
+    context.graphicsDevice->BindDepthRenderTarget(*context.atlas, 0, false);
+    context.graphicsDevice->BeginRenderPass();
+    SDL_GPURenderPass *shadowPass = context.graphicsDevice->GetCurrentRenderPass();
+    if (!shadowPass) {
+        return;
+    }
+    for (const ShadowTileWork *tileWork : work) {
+        RecordLiveShadowTile(context, cmd, shadowPass, *tileWork);
+    }
+    context.graphicsDevice->EndRenderPass();
+    for (const ShadowTileWork *tileWork : work) {
+        *tileWork->view->signature = tileWork->signature;
     }
 }
 
+// Waits for a future on scope exit, so a task borrowing locals can't
+// outlive them on an early return.
+struct FutureGuard {
+    std::future<void> &future;
+
+    ~FutureGuard() {
+        if (future.valid()) {
+            future.wait();
+        }
+    }
+};
+
 } // namespace
 
 ForwardRenderer::ForwardRenderer(GraphicsDevice &graphicsDevice) : graphicsDevice(&graphicsDevice) {
@@ -238,37 +1107,47 @@ ForwardRenderer::ForwardRenderer(GraphicsDevice &graphicsDevice) : graphicsDevic
     forwardVertexShader = std::make_unique<Shader>(graphicsDevice,
         (basePath / "Content/Shaders/forward.vert").generic_string(),
         SDL_GPU_SHADERSTAGE_VERTEX);
-    forwardFragmentShader = std::make_unique<Shader>(graphicsDevice,
-        (basePath / "Content/Shaders/forward.frag").generic_string(),
-        SDL_GPU_SHADERSTAGE_FRAGMENT);
+    // One forward.frag build per material feature mask; see
+    // MaterialFeature. All are loaded up front so a missing variant
+    // fails at construction rather than mid-frame.
+    for (uint32_t features = 0; features < MaterialVariantCount; features++) {
+        const std::string name = "Content/Shaders/forward_" + std::to_string(features) + ".frag";
+        forwardFragmentShaders[features] = std::make_unique<Shader>(graphicsDevice,
+            (basePath / name).generic_string(),
+            SDL_GPU_SHADERSTAGE_FRAGMENT);
+    }
+    // The COMPRESSED_VERTICES builds, shared by every MeshVertexFormat
+    // other than Standard.
+    forwardCompressedVertexShader = std::make_unique<Shader>(graphicsDevice,
+        (basePath / "Content/Shaders/forward_compressed.vert").generic_string(),
+        SDL_GPU_SHADERSTAGE_VERTEX);
     forwardSkinnedVertexShader = std::make_unique<Shader>(graphicsDevice,
         (basePath / "Content/Shaders/forward_skinned.vert").generic_string(),
         SDL_GPU_SHADERSTAGE_VERTEX);
     shadowVertexShader = std::make_unique<Shader>(graphicsDevice,
         (basePath / "Content/Shaders/shadow_depth.vert").generic_string(),
         SDL_GPU_SHADERSTAGE_VERTEX);
+    shadowCompressedVertexShader = std::make_unique<Shader>(graphicsDevice,
+        (basePath / "Content/Shaders/shadow_depth_compressed.vert").generic_string(),
+        SDL_GPU_SHADERSTAGE_VERTEX);
     shadowFragmentShader = std::make_unique<Shader>(graphicsDevice,
         (basePath / "Content/Shaders/shadow_depth.frag").generic_string(),
         SDL_GPU_SHADERSTAGE_FRAGMENT);
     shadowSkinnedVertexShader = std::make_unique<Shader>(graphicsDevice,
         (basePath / "Content/Shaders/shadow_depth_skinned.vert").generic_string(),
         SDL_GPU_SHADERSTAGE_VERTEX);
+    shadowTileVertexShader = std::make_unique<Shader>(graphicsDevice,
+        (basePath / "Content/Shaders/shadow_tile.vert").generic_string(),
+        SDL_GPU_SHADERSTAGE_VERTEX);
+    shadowTileCopyFragmentShader = std::make_unique<Shader>(graphicsDevice,
+        (basePath / "Content/Shaders/shadow_tile_copy.frag").generic_string(),
+        SDL_GPU_SHADERSTAGE_FRAGMENT);
 
-    for (int i = 0; i < MaxShadowMaps; i++) {
-        shadowMaps[i] = std::make_unique<Texture>(graphicsDevice,
-            TextureType::DepthTarget,
-            ShadowMapSize,
-            ShadowMapSize,
-            TextureFormat::Depth);
-    }
-
-    for (int i = 0; i < MaxPointShadows; i++) {
-        pointShadowMaps[i] = std::make_unique<Texture>(graphicsDevice,
-            TextureType::CubeDepthTarget,
-            PointShadowMapSize,
-            PointShadowMapSize,
-            TextureFormat::Depth);
-    }
+    shadowAtlas = std::make_unique<Texture>(graphicsDevice,
+        TextureType::DepthTarget,
+        ShadowAtlasSize,
+        ShadowAtlasSize,
+        TextureFormat::Depth);
 
     SamplerDescription shadowSampDesc;
     shadowSampDesc.filter = SamplerFilter::Point;
@@ -278,21 +1157,53 @@ ForwardRenderer::ForwardRenderer(GraphicsDevice &graphicsDevice) : graphicsDevic
     shadowSampDesc.addressW = SamplerAddressMode::ClampToEdge;
     shadowSampler = std::make_unique<Sampler>(graphicsDevice, shadowSampDesc);
 
-    // 1x1 white fallback, bound whenever a material doesn't supply
-    // its own base-color, metallic-roughness, or emissive texture.
-    // The texture-presence flags in the MaterialUBO tell the shader
-    // to ignore the sampled value in those cases, so the content
-    // only matters as a sentinel.
-    uint8_t whitePixel[4] = {255, 255, 255, 255};
-    whiteTexture = std::make_unique<Texture>(graphicsDevice,
-        TextureType::Default,
-        1u,
-        1u,
-        whitePixel,
-        static_cast<uint32_t>(sizeof(whitePixel)));
-
     SamplerDescription matSampDesc; // linear/repeat default for materials.
     defaultMaterialSampler = std::make_unique<Sampler>(graphicsDevice, matSampDesc);
+
+    objectBuffer = std::make_unique<StorageBuffer<ForwardObjectData>>(graphicsDevice,
+        64,
+        SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ);
+    materialBuffer = std::make_unique<StorageBuffer<ForwardMaterialData>>(graphicsDevice, 16);
+
+    // GPU culling. The cull pipeline has no format dependencies, so it
+    // is created up front with the shaders.
+    cullBuffer = std::make_unique<StorageBuffer<ForwardCullData>>(
+        graphicsDevice, 64, SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ);
+    drawArgsBuffer = std::make_unique<StorageBuffer<SDL_GPUIndexedIndirectDrawCommand>>(
+        graphicsDevice,
+        16,
+        SDL_GPU_BUFFERUSAGE_INDIRECT | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE);
+    visibleCapacity = 64;
+    SDL_GPUBufferCreateInfo visibleCI;
+    SDL_zero(visibleCI);
+    visibleCI.usage =
+        SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE | SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
+    visibleCI.size = visibleCapacity * sizeof(uint32_t);
+    visibleBuffer = SDL_CreateGPUBuffer(graphicsDevice.GetDevice(), &visibleCI);
+    if (!visibleBuffer) {
+        throw std::runtime_error(
+            std::string("Failed to create visible object buffer: ") + SDL_GetError());
+    }
+
+    Shader::ShaderBinary cullBinary = Shader::LoadBinary(graphicsDevice.GetDevice(),
+        (basePath / "Content/Shaders/forward_cull.comp").generic_string());
+    SDL_GPUComputePipelineCreateInfo cullCI;
+    SDL_zero(cullCI);
+    cullCI.code = cullBinary.code.data();
+    cullCI.code_size = cullBinary.code.size();
+    cullCI.entrypoint = "main";
+    cullCI.format = cullBinary.format;
+    cullCI.num_readonly_storage_buffers = cullBinary.numReadonlyStorageBuffers;
+    cullCI.num_readwrite_storage_buffers = cullBinary.numReadwriteStorageBuffers;
+    cullCI.num_uniform_buffers = cullBinary.numUniformBuffers;
+    cullCI.threadcount_x = 64;
+    cullCI.threadcount_y = 1;
+    cullCI.threadcount_z = 1;
+    cullPipeline = SDL_CreateGPUComputePipeline(graphicsDevice.GetDevice(), &cullCI);
+    if (!cullPipeline) {
+        throw std::runtime_error(
+            std::string("Failed to create cull compute pipeline: ") + SDL_GetError());
+    }
 }
 
 ForwardRenderer::~ForwardRenderer() {
@@ -303,125 +1214,311 @@ ForwardRenderer::~ForwardRenderer() {
     for (auto &[key, pipeline] : forwardSkinnedPipelines) {
         SDL_ReleaseGPUGraphicsPipeline(device, pipeline);
     }
-    if (shadowPipeline) {
-        SDL_ReleaseGPUGraphicsPipeline(device, shadowPipeline);
+    for (auto &[key, pipeline] : depthPrePassPipelines) {
+        SDL_ReleaseGPUGraphicsPipeline(device, pipeline);
+    }
+    for (auto &[key, pipeline] : depthPrePassSkinnedPipelines) {
+        SDL_ReleaseGPUGraphicsPipeline(device, pipeline);
+    }
+    for (SDL_GPUGraphicsPipeline *pipeline : shadowPipelines) {
+        if (pipeline) {
+            SDL_ReleaseGPUGraphicsPipeline(device, pipeline);
+        }
     }
     if (shadowSkinnedPipeline) {
         SDL_ReleaseGPUGraphicsPipeline(device, shadowSkinnedPipeline);
     }
+    if (shadowTileClearPipeline) {
+        SDL_ReleaseGPUGraphicsPipeline(device, shadowTileClearPipeline);
+    }
+    if (shadowTileCopyPipeline) {
+        SDL_ReleaseGPUGraphicsPipeline(device, shadowTileCopyPipeline);
+    }
+    if (cullPipeline) {
+        SDL_ReleaseGPUComputePipeline(device, cullPipeline);
+    }
+    if (visibleBuffer) {
+        SDL_ReleaseGPUBuffer(device, visibleBuffer);
+    }
+    if (retiredVisibleBuffer) {
+        SDL_ReleaseGPUBuffer(device, retiredVisibleBuffer);
+    }
+}
+
+void ForwardRenderer::Render(
+    const Scene3D &scene, const Camera &camera, const ForwardRenderOptions &options) {
+    ForwardView view;
+    view.camera = camera;
+    view.viewport =
+        Rectangle(0, 0, graphicsDevice->GetScreenWidth(), graphicsDevice->GetScreenHeight());
+    RenderViews(scene, nullptr, std::vector<ForwardView>{view}, options);
+}
+
+void ForwardRenderer::Render(const Scene3D &scene, const std::vector<ForwardView> &views,
+    const ForwardRenderOptions &options) {
+    RenderViews(scene, nullptr, views, options);
+}
+
+void ForwardRenderer::Render(
+    const RetainedScene &scene, const Camera &camera, const ForwardRenderOptions &options) {
+    ForwardView view;
+    view.camera = camera;
+    view.viewport =
+        Rectangle(0, 0, graphicsDevice->GetScreenWidth(), graphicsDevice->GetScreenHeight());
+    RenderViews(scene.GetScene(), &scene, std::vector<ForwardView>{view}, options);
 }
 
-void ForwardRenderer::Render(const Scene3D &scene, const Camera &camera) {
+void ForwardRenderer::Render(const RetainedScene &scene, const std::vector<ForwardView> &views,
+    const ForwardRenderOptions &options) {
+    RenderViews(scene.GetScene(), &scene, views, options);
+}
+
+void ForwardRenderer::RenderViews(const Scene3D &scene, const RetainedScene *retained,
+    const std::vector<ForwardView> &views, const ForwardRenderOptions &options) {
+    SDL_assert(!views.empty() && views.size() <= MaxViews);
+    if (views.empty()) {
+        return;
+    }
+    const uint32_t viewCount = std::min(static_cast<uint32_t>(views.size()), MaxViews);
     SDL_assert(graphicsDevice->GetCommandBuffer() != nullptr);
     SDL_assert(graphicsDevice->GetCurrentRenderPass() == nullptr);
     SDL_assert(graphicsDevice->IsDepthEnabled() || graphicsDevice->IsUsingDepthTarget());
 
+    // A frame that returns before packing leaves the object table behind
+    // the retained scene, so the cache is dropped up front and only
+    // re-established once this frame has packed.
+    const uint64_t lastPackedEpoch = packedChangeEpoch;
+    packedChangeEpoch = 0;
+
+    // The caller's targets and viewport. Serial shadow passes rebind the
+    // device to the atlas, so the main pass puts these back.
+    const Texture *colorTarget = graphicsDevice->GetRenderTarget();
+    const Texture *depthTarget = graphicsDevice->GetDepthRenderTarget();
+    Rectangle callerViewport;
+    graphicsDevice->GetViewport(callerViewport);
+
     const SDL_GPUTextureFormat colorFormat = graphicsDevice->IsUsingRenderTarget()
                                                  ? SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM
                                                  : graphicsDevice->GetSwapchainFormat();
     const SDL_GPUTextureFormat depthFormat = graphicsDevice->GetDepthFormat();
 
-    SDL_GPUGraphicsPipeline *forwardPipeline = GetOrCreateForwardPipeline(colorFormat, depthFormat);
-    SDL_GPUGraphicsPipeline *shadowPipe = GetOrCreateShadowPipeline(depthFormat);
-    if (!forwardPipeline || !shadowPipe) {
+    // Forward pipelines are looked up per draw, keyed by the material's
+    // feature mask and the mesh's vertex format; only the depth-only
+    // pipelines are fetched up front, one per vertex format in the
+    // scene. The shadow pass records on worker threads, so it can't
+    // create them lazily.
+    const bool depthPrePass = options.depthPrePass;
+    bool usesVertexFormat[MeshVertexFormatCount] = {true};
+    for (const SceneObject &object : scene.objects) {
+        if (object.mesh) {
+            usesVertexFormat[static_cast<int>(object.mesh->GetVertexFormat())] = true;
+        }
+    }
+    SDL_GPUGraphicsPipeline *shadowPipes[MeshVertexFormatCount] = {};
+    SDL_GPUGraphicsPipeline *prePassPipelines[MeshVertexFormatCount] = {};
+    for (int format = 0; format < MeshVertexFormatCount; format++) {
+        if (!usesVertexFormat[format]) {
+            continue;
+        }
+        const MeshVertexFormat vertexFormat = static_cast<MeshVertexFormat>(format);
+        shadowPipes[format] = GetOrCreateShadowPipeline(depthFormat, vertexFormat);
+        if (!shadowPipes[format]) {
+            return;
+        }
+        if (depthPrePass) {
+            prePassPipelines[format] =
+                GetOrCreateDepthPrePassPipeline(colorFormat, depthFormat, vertexFormat);
+            if (!prePassPipelines[format]) {
+                return;
+            }
+        }
+    }
+    SDL_GPUGraphicsPipeline *tileClearPipe = GetOrCreateShadowTileClearPipeline(depthFormat);
+    if (!tileClearPipe) {
         return;
     }
     // Skinned pipelines are only required if the scene actually has
     // skinned objects this frame; lazy creation keeps single-mesh
     // demos from paying the pipeline-creation cost.
-    SDL_GPUGraphicsPipeline *forwardSkinnedPipeline = nullptr;
     SDL_GPUGraphicsPipeline *shadowSkinnedPipe = nullptr;
+    SDL_GPUGraphicsPipeline *prePassSkinnedPipeline = nullptr;
     if (!scene.skinnedObjects.empty()) {
-        forwardSkinnedPipeline = GetOrCreateForwardSkinnedPipeline(colorFormat, depthFormat);
         shadowSkinnedPipe = GetOrCreateShadowSkinnedPipeline(depthFormat);
-        if (!forwardSkinnedPipeline || !shadowSkinnedPipe) {
+        if (!shadowSkinnedPipe) {
             return;
         }
+        if (depthPrePass) {
+            prePassSkinnedPipeline =
+                GetOrCreateDepthPrePassSkinnedPipeline(colorFormat, depthFormat);
+            if (!prePassSkinnedPipeline) {
+                return;
+            }
+        }
     }
 
     SDL_GPUCommandBuffer *cmd = graphicsDevice->GetCommandBuffer();
 
-    // Pre-pack the lighting UBO so we can fill in shadow VPs / per-cube
-    // near-far values as we render each shadow map below. Two
-    // independent slot pools: 2D (directional/spot) and cube (point);
-    // assignment follows scene.lights order, first-come-first-served
-    // within each pool. Anything past either cap is lit but unshadowed.
+    // Refresh the persistent object and material tables. Both are packed
+    // from scratch on the CPU every frame, but StorageBuffer diffs them
+    // against what the GPU already holds and uploads only the entries
+    // that changed -- typically just the objects that moved. Object
+    // indices are positions in scene.objects, so a scene rebuilt in the
+    // same order each frame re-uploads nothing for static objects.
+    Material defaultMaterial;
+    defaultMaterial.sampler = defaultMaterialSampler.get();
+
+    std::vector<ForwardMaterialData> materials;
+    std::unordered_map<const Material *, uint32_t> materialIndices;
+    materials.push_back(PackMaterial(defaultMaterial));
+    auto materialIndexOf = [&](const Material *material) -> uint32_t {
+        if (!material) {
+            return 0;
+        }
+        auto [it, inserted] =
+            materialIndices.emplace(material, static_cast<uint32_t>(materials.size()));
+        if (inserted) {
+            materials.push_back(PackMaterial(*material));
+        }
+        return it->second;
+    };
+
+    // World bounds and shadow fingerprints of every object. The bounds
+    // also pick each object's lights below, and the view and shadow
+    // culling further down reads them, so they're built even when no
+    // light casts shadows.
+    ThreadPool *threadPool = options.threadPool;
+    std::vector<ShadowCaster> casters;
+    std::vector<ShadowCaster> skinnedCasters;
+    BuildShadowCasters(threadPool, scene, casters, skinnedCasters);
+
+    // Transforms and light lists are packed across the pool, or for a
+    // retained scene already packed last frame under the same lights,
+    // only the changed ones are; material indices are handed out in
+    // scene order afterwards so they stay deterministic.
+    const int lightCount = static_cast<int>(std::min<size_t>(scene.lights.size(), MaxLights));
+    const uint64_t lightsSignature = HashLightsForSelection(scene.lights, lightCount);
+    const uint32_t objectCount = static_cast<uint32_t>(scene.objects.size());
+    std::vector<ForwardObjectData> &objects = packedObjects;
+    auto packObject = [&](uint32_t i) {
+        const SceneObject &object = scene.objects[i];
+        ForwardObjectData &data = objects[i];
+        data = ForwardObjectData{};
+        data.model = object.transform;
+        data.colorTint = glm::vec4(object.color, 1.0f);
+        const ObjectLights lights =
+            SelectObjectLights(scene.lights, lightCount, casters[i].worldBounds);
+        data.lightCount = lights.count;
+        data.lightIndices[0] = lights.indices[0];
+        data.lightIndices[1] = lights.indices[1];
+    };
+    objects.resize(objectCount);
+    const bool packedInSync = retained && lastPackedEpoch != 0 &&
+                              (retained->GetChangeEpoch() == lastPackedEpoch ||
+                                  retained->GetPreviousChangeEpoch() == lastPackedEpoch);
+    if (packedInSync && lightsSignature == packedLightsSignature) {
+        for (uint32_t i : retained->GetChangedObjects()) {
+            packObject(i);
+        }
+    } else {
+        ForEachRange(threadPool, objectCount, ObjectGrainSize, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                packObject(i);
+            }
+        });
+    }
+    packedChangeEpoch = retained ? retained->GetChangeEpoch() : 0;
+    packedLightsSignature = lightsSignature;
+    for (uint32_t i = 0; i < objectCount; i++) {
+        objects[i].materialIndex = materialIndexOf(scene.objects[i].material);
+    }
+    std::vector<uint32_t> skinnedMaterialIndices(scene.skinnedObjects.size());
+    std::vector<ObjectLights> skinnedLights(scene.skinnedObjects.size());
+    for (size_t i = 0; i < scene.skinnedObjects.size(); i++) {
+        skinnedMaterialIndices[i] = materialIndexOf(scene.skinnedObjects[i].material);
+        skinnedLights[i] =
+            SelectObjectLights(scene.lights, lightCount, skinnedCasters[i].worldBounds);
+    }
+
+    // Storage buffers can't be bound empty, so an empty scene still
+    // uploads one placeholder entry.
+    if (objects.empty()) {
+        objects.push_back(ForwardObjectData{});
+    }
+
+    // Shadow tiles recorded on the pool are submitted before the
+    // device's command buffer, so with a pool the uploads go in their own
+    // command buffer, submitted now, to reach the GPU ahead of them.
+    bool uploaded = false;
+    if (threadPool) {
+        SDL_GPUCommandBuffer *uploadCmd = SDL_AcquireGPUCommandBuffer(graphicsDevice->GetDevice());
+        SDL_GPUCopyPass *copyPass = uploadCmd ? SDL_BeginGPUCopyPass(uploadCmd) : nullptr;
+        if (copyPass) {
+            objectBuffer->SetData(copyPass, objects.data(), static_cast<uint32_t>(objects.size()));
+            materialBuffer->SetData(
+                copyPass, materials.data(), static_cast<uint32_t>(materials.size()));
+            SDL_EndGPUCopyPass(copyPass);
+            uploaded = SDL_SubmitGPUCommandBuffer(uploadCmd);
+        } else if (uploadCmd) {
+            SDL_CancelGPUCommandBuffer(uploadCmd);
+        }
+        if (!uploaded) {
+            // Fall back to recording everything on the device's command
+            // buffer; the tables then need a full upload there.
+            spdlog::error("Failed to submit storage buffer uploads: {}", SDL_GetError());
+            threadPool = nullptr;
+            objectBuffer->Invalidate();
+            materialBuffer->Invalidate();
+        }
+    }
+    if (!uploaded) {
+        objectBuffer->SetData(objects.data(), static_cast<uint32_t>(objects.size()));
+        materialBuffer->SetData(materials.data(), static_cast<uint32_t>(materials.size()));
+    }
+    SDL_GPUBuffer *objectGpuBuffer = objectBuffer->GetGPUBuffer();
+    SDL_GPUBuffer *materialGpuBuffer = materialBuffer->GetGPUBuffer();
+
+    // Fill the lighting UBO and lay out the shadow atlas. Each
+    // shadow-casting light asks for a tile size from its importance and
+    // screen coverage, smoothed over frames by UpdateShadowTileSize;
+    // PackShadowAtlas shrinks or drops the least important requests when
+    // they don't all fit. Lights that end up without tiles are lit but
+    // unshadowed. With several views a light is sized and ranked by the
+    // view it covers most of. The camera position is filled in per view.
     LightingUBO lightingUbo{};
     lightingUbo.ambientColor = scene.ambientColor;
-    lightingUbo.lightCount = static_cast<int>(std::min<size_t>(scene.lights.size(), MaxLights));
-    lightingUbo.cameraPosition = camera.position;
+    lightingUbo.lightCount = lightCount;
     lightingUbo.pad = 0.0f;
-    lightingUbo.pointShadowNearFar = glm::vec4(0.0f);
-    int shadowCount = 0;
-    int pointShadowCount = 0;
-
-    // Pass 1: assign shadow slots and render 2D shadow maps inline.
-    // Cube renders are deferred to a second pass below so we can keep
-    // the existing 2D loop structure unchanged when no point shadows
-    // are present.
+    lightingUbo.shadowAtlasTexelSize = 1.0f / static_cast<float>(ShadowAtlasSize);
+
+    shadowLightStates.resize(lightingUbo.lightCount);
+    std::vector<ShadowTileRequest> tileRequests(lightingUbo.lightCount);
     for (int i = 0; i < lightingUbo.lightCount; i++) {
         const Light &src = scene.lights[i];
-        LightUBOEntry &dst = lightingUbo.lights[i];
-        dst.position = src.position;
-        dst.range = src.range;
-        dst.color = src.color;
-        dst.intensity = src.intensity;
-        dst.direction = glm::normalize(src.direction);
-        dst.type = LightTypeToShader(src.type);
-        dst.innerCone = src.innerCone;
-        dst.outerCone = src.outerCone;
-        dst.shadowIndex = -1;
-        dst.shadowType = 0;
-
+        ForwardShadowLightState &state = shadowLightStates[i];
         if (!src.castsShadows) {
+            state = ForwardShadowLightState{};
+            tileRequests[i].size = 0;
             continue;
         }
+        for (uint32_t v = 0; v < viewCount; v++) {
+            const ShadowTileRequest request = DesiredShadowTile(src,
+                views[v].camera,
+                static_cast<float>(views[v].viewport.width),
+                static_cast<float>(views[v].viewport.height));
+            tileRequests[i].count = request.count;
+            tileRequests[i].size = std::max(tileRequests[i].size, request.size);
+            tileRequests[i].priority = std::max(tileRequests[i].priority, request.priority);
+        }
+        UpdateShadowTileSize(state, tileRequests[i].size);
+        tileRequests[i].size = state.tileSize;
+    }
+    const ShadowAtlasLayout atlasLayout =
+        PackShadowAtlas(tileRequests, ShadowAtlasSize, MinShadowTileSize, MaxShadowTiles);
 
-        const bool is2D = (src.type == LightType::Directional || src.type == LightType::Spot);
-        const bool isCube = (src.type == LightType::Point);
-
-        if (is2D && shadowCount < MaxShadowMaps) {
-            const glm::mat4 lightVP = BuildShadowViewProj(src);
-            lightingUbo.shadowVP[shadowCount] = lightVP;
-            dst.shadowIndex = shadowCount;
-            dst.shadowType = 0;
-
-            graphicsDevice->BindDepthRenderTarget(*shadowMaps[shadowCount]);
-            graphicsDevice->BeginRenderPass();
-            SDL_GPURenderPass *shadowPass = graphicsDevice->GetCurrentRenderPass();
-            if (shadowPass) {
-                SDL_BindGPUGraphicsPipeline(shadowPass, shadowPipe);
-                SDL_PushGPUVertexUniformData(cmd, 0, &lightVP, sizeof(lightVP));
-                DrawSceneGeometry(shadowPass, cmd, scene);
-
-                if (shadowSkinnedPipe && !scene.skinnedObjects.empty()) {
-                    SDL_BindGPUGraphicsPipeline(shadowPass, shadowSkinnedPipe);
-                    DrawSkinnedSceneGeometry(shadowPass, cmd, scene);
-                }
-            }
-            graphicsDevice->EndRenderPass();
-
-            shadowCount++;
-        } else if (isCube && pointShadowCount < MaxPointShadows) {
-            // Slot is reserved here; the actual six-face render runs in
-            // pass 2 below. Compute the near/far up front so the
-            // fragment shader's reverse-projection matches the proj
-            // we'll build then.
-            const float range = (src.range > 0.0f) ? src.range : 25.0f;
-            const float nearPlane = std::max(0.5f, range * 0.05f);
-            dst.shadowIndex = pointShadowCount;
-            dst.shadowType = 1;
-            lightingUbo.pointShadowNearFar[pointShadowCount * 2] = nearPlane;
-            lightingUbo.pointShadowNearFar[pointShadowCount * 2 + 1] = range;
-            pointShadowCount++;
-        }
-    }
-
-    // Pass 2: cube shadow maps. Six render passes per caster, each
-    // targeting one face of pointShadowMaps[si]. Same shadow pipeline
-    // as the 2D path -- the only thing that changes is the depth target
-    // (cube face via BindDepthRenderTarget's `layer` parameter) and the
-    // lightVP for that face.
+    // Point light face order, matching the face selection in
+    // forward.frag.hlsl: +X, -X, +Y, -Y, +Z, -Z. Each face is sampled
+    // through its own view-projection like any 2D tile, so the up
+    // vectors only need to be valid, not match a cubemap convention.
     static const glm::vec3 faceDirs[6] = {
         {1, 0, 0},
         {-1, 0, 0},
@@ -439,48 +1536,313 @@ void ForwardRenderer::Render(const Scene3D &scene, const Camera &camera) {
         {0, -1, 0},
     };
 
+    std::vector<ShadowTileView> shadowViews;
+    bool anyStaticLight = false;
     for (int i = 0; i < lightingUbo.lightCount; i++) {
-        const LightUBOEntry &dst = lightingUbo.lights[i];
-        if (dst.shadowType != 1 || dst.shadowIndex < 0) {
+        const Light &src = scene.lights[i];
+        LightUBOEntry &dst = lightingUbo.lights[i];
+        dst.position = src.position;
+        dst.range = src.range;
+        dst.color = src.color;
+        dst.intensity = src.intensity;
+        dst.direction = glm::normalize(src.direction);
+        dst.type = LightTypeToShader(src.type);
+        dst.innerCone = src.innerCone;
+        dst.outerCone = src.outerCone;
+        dst.shadowIndex = -1;
+        dst.shadowType = 0;
+
+        ForwardShadowLightState &state = shadowLightStates[i];
+        const int firstTile = atlasLayout.firstTile[i];
+        if (firstTile < 0) {
+            // Whatever the light's old tiles held is someone else's now.
+            std::fill(std::begin(state.signatures), std::end(state.signatures), 0);
+            std::fill(std::begin(state.staticSignatures), std::end(state.staticSignatures), 0);
             continue;
         }
-        const int si = dst.shadowIndex;
-        const float nearPlane = lightingUbo.pointShadowNearFar[si * 2];
-        const float farPlane = lightingUbo.pointShadowNearFar[si * 2 + 1];
-        // 90-degree FOV per face covers exactly one sixth of the sphere.
-        // Y-flip on the projection compensates for the difference
-        // between cubemap face orientation and the sampler's expected
-        // convention -- without it, side-face content samples upside-
-        // down when the fragment shader looks up via direction vector.
-        glm::mat4 proj = glm::perspectiveRH_ZO(glm::radians(90.0f), 1.0f, nearPlane, farPlane);
-        proj[1][1] *= -1.0f;
-
-        for (int face = 0; face < 6; face++) {
-            const glm::mat4 view =
-                glm::lookAt(dst.position, dst.position + faceDirs[face], faceUps[face]);
-            const glm::mat4 lightVP = proj * view;
-
-            graphicsDevice->BindDepthRenderTarget(
-                *pointShadowMaps[si], static_cast<uint32_t>(face));
-            graphicsDevice->BeginRenderPass();
-            SDL_GPURenderPass *shadowPass = graphicsDevice->GetCurrentRenderPass();
-            if (shadowPass) {
-                SDL_BindGPUGraphicsPipeline(shadowPass, shadowPipe);
-                SDL_PushGPUVertexUniformData(cmd, 0, &lightVP, sizeof(lightVP));
-                DrawSceneGeometry(shadowPass, cmd, scene);
 
-                if (shadowSkinnedPipe && !scene.skinnedObjects.empty()) {
-                    SDL_BindGPUGraphicsPipeline(shadowPass, shadowSkinnedPipe);
-                    DrawSkinnedSceneGeometry(shadowPass, cmd, scene);
+        const bool isPoint = (src.type == LightType::Point);
+        dst.shadowIndex = firstTile;
+        dst.shadowType = isPoint ? 1 : 0;
+        anyStaticLight = anyStaticLight || src.isStatic;
+
+        glm::mat4 viewProjections[6];
+        int viewCount = 1;
+        float lightRange = std::numeric_limits<float>::infinity();
+        if (isPoint) {
+            // 90-degree FOV per face covers exactly one sixth of the
+            // sphere.
+            lightRange = ShadowRange(src);
+            const float nearPlane = std::max(0.5f, lightRange * 0.05f);
+            const glm::mat4 proj =
+                glm::perspectiveRH_ZO(glm::radians(90.0f), 1.0f, nearPlane, lightRange);
+            for (int face = 0; face < 6; face++) {
+                viewProjections[face] =
+                    proj * glm::lookAt(src.position, src.position + faceDirs[face], faceUps[face]);
+            }
+            viewCount = 6;
+        } else {
+            viewProjections[0] = BuildShadowViewProj(src);
+            if (src.type == LightType::Spot) {
+                lightRange = ShadowRange(src);
+            }
+        }
+
+        for (int v = 0; v < viewCount; v++) {
+            const ShadowAtlasTile &tile = atlasLayout.tiles[firstTile + v];
+            ShadowAtlasTile &previous = state.tiles[v];
+            if (tile.x != previous.x || tile.y != previous.y || tile.size != previous.size) {
+                // A moved tile holds another light's depth, or nothing.
+                previous = tile;
+                state.signatures[v] = 0;
+                state.staticSignatures[v] = 0;
+            }
+
+            ShadowTileUBOEntry &entry = lightingUbo.shadowTiles[firstTile + v];
+            entry.viewProjection = viewProjections[v];
+            entry.uvRect = glm::vec4(static_cast<float>(tile.x),
+                               static_cast<float>(tile.y),
+                               static_cast<float>(tile.size),
+                               static_cast<float>(tile.size)) /
+                           static_cast<float>(ShadowAtlasSize);
+
+            ShadowTileView view;
+            view.viewProjection = viewProjections[v];
+            view.lightPosition = src.position;
+            view.lightRange = lightRange;
+            view.tile = tile;
+            view.useStaticCache = src.isStatic;
+            view.signature = &state.signatures[v];
+            view.staticSignature = &state.staticSignatures[v];
+            shadowViews.push_back(view);
+        }
+    }
+
+    // The caster bounds and fingerprints built above are shared by every
+    // tile this frame. With a thread pool the tiles are recorded by a pool task while
+    // this thread records the main pass below; everything the task
+    // borrows lives at function scope and the guard waits for it on
+    // every return path.
+    ShadowPassContext shadowContext;
+    std::future<void> shadowTask;
+    FutureGuard shadowTaskGuard{shadowTask};
+    if (!shadowViews.empty()) {
+        SDL_GPUGraphicsPipeline *tileCopyPipe = nullptr;
+        if (anyStaticLight) {
+            tileCopyPipe = GetOrCreateShadowTileCopyPipeline(depthFormat);
+            if (!tileCopyPipe) {
+                return;
+            }
+            if (!staticShadowAtlas) {
+                staticShadowAtlas = std::make_unique<Texture>(*graphicsDevice,
+                    TextureType::DepthTarget,
+                    ShadowAtlasSize,
+                    ShadowAtlasSize,
+                    TextureFormat::Depth);
+            }
+        }
+
+        shadowContext.graphicsDevice = graphicsDevice;
+        shadowContext.threadPool = threadPool;
+        std::copy(std::begin(shadowPipes), std::end(shadowPipes), shadowContext.pipelines);
+        shadowContext.skinnedPipeline = shadowSkinnedPipe;
+        shadowContext.clearPipeline = tileClearPipe;
+        shadowContext.copyPipeline = tileCopyPipe;
+        shadowContext.objectBuffer = objectGpuBuffer;
+        shadowContext.visibleBuffer = visibleBuffer;
+        shadowContext.sampler = shadowSampler->GetSampler();
+        shadowContext.atlas = shadowAtlas.get();
+        shadowContext.staticAtlas = staticShadowAtlas.get();
+        shadowContext.scene = &scene;
+        shadowContext.casters = &casters;
+        shadowContext.skinnedCasters = &skinnedCasters;
+        shadowContext.lodPixelError = options.lodPixelError * options.shadowLodBias;
+        if (threadPool) {
+            shadowTask =
+                threadPool->Submit([&] { RenderShadowTiles(shadowContext, shadowViews); });
+        } else {
+            // Shadow passes are depth-only; a bound color target would be
+            // paired with the atlas, whose size it doesn't share.
+            graphicsDevice->UnbindRenderTarget(false);
+            RenderShadowTiles(shadowContext, shadowViews);
+        }
+    }
+
+    // Cull every object against every view in one pass over the scene:
+    // bit v of an object's mask is set when view v can see it. Objects
+    // reuse the world bounds computed for the shadow casters.
+    Frustum viewFrusta[MaxViews];
+    glm::mat4 viewProjections[MaxViews];
+    for (uint32_t v = 0; v < viewCount; v++) {
+        const ForwardView &view = views[v];
+        const float aspect = static_cast<float>(std::max(view.viewport.width, 1)) /
+                             static_cast<float>(std::max(view.viewport.height, 1));
+        viewProjections[v] =
+            view.camera.GetProjectionMatrix(aspect) * view.camera.GetViewMatrix();
+        viewFrusta[v] = MakeFrustum(viewProjections[v]);
+    }
+    auto viewMask = [&](const BoundingBox &bounds) {
+        uint32_t mask = 0;
+        for (uint32_t v = 0; v < viewCount; v++) {
+            if (IntersectsFrustum(bounds, viewFrusta[v])) {
+                mask |= 1u << v;
+            }
+        }
+        return mask;
+    };
+
+    // Each rigid object draws at one level of detail in every view,
+    // picked for the view it covers the most pixels in.
+    std::vector<uint8_t> objectLods(scene.objects.size(), 0);
+    ForEachRange(threadPool,
+        static_cast<uint32_t>(scene.objects.size()),
+        ObjectGrainSize,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                const Mesh *mesh = scene.objects[i].mesh;
+                if (!mesh || mesh->GetLodCount() == 1) {
+                    continue;
+                }
+                float pixelsPerUnit = 0.0f;
+                for (uint32_t v = 0; v < viewCount; v++) {
+                    pixelsPerUnit = std::max(pixelsPerUnit,
+                        ProjectedPixelsPerUnit(casters[i].worldBounds,
+                            viewProjections[v],
+                            static_cast<float>(views[v].viewport.height)));
+                }
+                objectLods[i] = static_cast<uint8_t>(
+                    SelectObjectLod(*mesh, casters[i], pixelsPerUnit, options.lodPixelError));
+            }
+        });
+
+    // With GPU culling, forward_cull.comp decides rigid visibility
+    // instead; their masks stay zero so the direct draw loops skip them.
+    std::vector<ForwardIndirectBatch> indirectBatches;
+    const bool gpuCulled = options.gpuCulling && CullOnGpu(scene,
+                                                     defaultMaterial,
+                                                     viewProjections,
+                                                     viewCount,
+                                                     objectLods,
+                                                     indirectBatches);
+    const uint32_t batchCount = static_cast<uint32_t>(indirectBatches.size());
+    uint32_t visiblePerView = 0;
+    for (const ForwardIndirectBatch &batch : indirectBatches) {
+        visiblePerView += batch.objectCount;
+    }
+    SDL_GPUBuffer *drawArgsGpuBuffer = drawArgsBuffer->GetGPUBuffer();
+
+    std::vector<uint32_t> visibleViews(scene.objects.size(), 0);
+    if (!gpuCulled) {
+        ForEachRange(threadPool,
+            static_cast<uint32_t>(scene.objects.size()),
+            ObjectGrainSize,
+            [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; i++) {
+                    if (scene.objects[i].mesh) {
+                        visibleViews[i] = viewMask(casters[i].worldBounds);
+                    }
+                }
+            });
+    }
+    std::vector<uint32_t> skinnedVisibleViews(scene.skinnedObjects.size(), 0);
+    for (size_t i = 0; i < scene.skinnedObjects.size(); i++) {
+        const SkinnedSceneObject &object = scene.skinnedObjects[i];
+        if (object.mesh && object.jointMatrices) {
+            skinnedVisibleViews[i] = viewMask(skinnedCasters[i].worldBounds);
+        }
+    }
+
+    // Occlusion culling, per view: rasterize the occluders the view can
+    // see, then clear the view's bit on objects hidden behind them. The
+    // object tests run across the pool; each touches only its own mask.
+    if (options.occlusionCulling && !gpuCulled) {
+        occlusionCullers.resize(viewCount);
+        for (uint32_t v = 0; v < viewCount; v++) {
+            const uint32_t viewBit = 1u << v;
+            OcclusionCuller &culler = occlusionCullers[v];
+            culler.Begin(viewProjections[v]);
+            for (size_t i = 0; i < scene.objects.size(); i++) {
+                const SceneObject &object = scene.objects[i];
+                if ((visibleViews[i] & viewBit) && object.occluder) {
+                    culler.RasterizeOccluder(*object.occluder, object.transform);
+                }
+            }
+            ForEachRange(threadPool,
+                static_cast<uint32_t>(scene.objects.size()),
+                ObjectGrainSize,
+                [&](uint32_t begin, uint32_t end) {
+                    for (uint32_t i = begin; i < end; i++) {
+                        if ((visibleViews[i] & viewBit) && !scene.objects[i].occluder &&
+                            !culler.IsVisible(casters[i].worldBounds)) {
+                            visibleViews[i] &= ~viewBit;
+                        }
+                    }
+                });
+            for (size_t i = 0; i < scene.skinnedObjects.size(); i++) {
+                if ((skinnedVisibleViews[i] & viewBit) &&
+                    !culler.IsVisible(skinnedCasters[i].worldBounds)) {
+                    skinnedVisibleViews[i] &= ~viewBit;
                 }
             }
-            graphicsDevice->EndRenderPass();
         }
     }
 
-    // Shadow passes finished; switch back to the swapchain target for
-    // the main forward pass.
-    graphicsDevice->UnbindDepthRenderTarget();
+    // Cluster culling: objects drawn at full detail whose meshes carry
+    // meshlets keep, per view, only the index runs of the meshlets in
+    // view, and drop out of views where none are. The frustum and camera
+    // are moved into each object's space, so meshlet bounds are tested
+    // as stored. `clusterSlots` maps an object to its runs, one list per
+    // view, or is -1 for objects drawn whole.
+    std::vector<int32_t> clusterSlots(scene.objects.size(), -1);
+    std::vector<uint32_t> clusterObjects;
+    for (size_t i = 0; i < scene.objects.size(); i++) {
+        const Mesh *mesh = scene.objects[i].mesh;
+        if (visibleViews[i] && mesh->GetMeshletCount() > 0 && objectLods[i] == 0) {
+            clusterSlots[i] = static_cast<int32_t>(clusterObjects.size());
+            clusterObjects.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    std::vector<std::vector<IndexRun>> clusterRuns(clusterObjects.size() * viewCount);
+    ForEachRange(threadPool,
+        static_cast<uint32_t>(clusterObjects.size()),
+        1,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t c = begin; c < end; c++) {
+                const uint32_t i = clusterObjects[c];
+                const SceneObject &object = scene.objects[i];
+                const glm::mat4 worldToLocal = glm::inverse(object.transform);
+                for (uint32_t v = 0; v < viewCount; v++) {
+                    const uint32_t viewBit = 1u << v;
+                    if (!(visibleViews[i] & viewBit)) {
+                        continue;
+                    }
+                    std::vector<IndexRun> &runs = clusterRuns[c * viewCount + v];
+                    CullMeshlets(*object.mesh,
+                        MakeFrustum(viewProjections[v] * object.transform),
+                        glm::vec3(worldToLocal * glm::vec4(views[v].camera.position, 1.0f)),
+                        options.meshletBackfaceCulling,
+                        runs);
+                    if (runs.empty()) {
+                        visibleViews[i] &= ~viewBit;
+                    }
+                }
+            }
+        });
+
+    // Shadow passes finished; switch back to the caller's targets for the
+    // main forward pass. Both are cleared, as they would be after any
+    // target switch.
+    if (colorTarget) {
+        graphicsDevice->BindRenderTarget(*colorTarget, false);
+    } else {
+        graphicsDevice->UnbindRenderTarget(false);
+    }
+    if (depthTarget) {
+        graphicsDevice->BindDepthRenderTarget(*depthTarget);
+    } else {
+        graphicsDevice->UnbindDepthRenderTarget();
+    }
+    graphicsDevice->SetViewport(callerViewport);
 
     graphicsDevice->BeginRenderPass();
     SDL_GPURenderPass *renderPass = graphicsDevice->GetCurrentRenderPass();
@@ -488,191 +1850,503 @@ void ForwardRenderer::Render(const Scene3D &scene, const Camera &camera) {
         return;
     }
 
-    SDL_BindGPUGraphicsPipeline(renderPass, forwardPipeline);
+    // Per-object: pick the forward.frag variant for the material's
+    // texture set, bind the shadow atlas plus only the material textures
+    // that variant samples, then draw. Material parameters and
+    // transforms come from the storage buffers; only the textures still
+    // vary per draw. Draws are grouped by variant so each pipeline is
+    // bound once per view.
+    SDL_GPUSampler *defaultSampler = defaultMaterialSampler->GetSampler();
+    SDL_GPUSampler *shadowSamp = shadowSampler->GetSampler();
 
-    const float aspect = static_cast<float>(graphicsDevice->GetScreenWidth()) /
-                         static_cast<float>(graphicsDevice->GetScreenHeight());
-    const glm::mat4 viewProj = camera.GetProjectionMatrix(aspect) * camera.GetViewMatrix();
+    auto bindFragmentTextures = [&](const Material &mat, uint32_t features) {
+        SDL_GPUSampler *matSampler = (mat.sampler ? mat.sampler->GetSampler() : defaultSampler);
 
-    SDL_PushGPUVertexUniformData(cmd, 0, &viewProj, sizeof(viewProj));
-    SDL_PushGPUFragmentUniformData(cmd, 0, &lightingUbo, sizeof(lightingUbo));
+        // Bind every fragment texture+sampler pair in one call.
+        // Splitting these into separate range binds (e.g. material per
+        // object + shadows per frame) doesn't actually rebind on D3D12;
+        // each draw needs the complete set together. Slot 0 is the
+        // shadow atlas; the material textures present in `features`
+        // follow in bit order, matching the register layout in
+        // forward.frag.hlsl.
+        SDL_GPUTextureSamplerBinding bindings[1 + 4];
+        uint32_t count = 0;
+        auto add = [&](SDL_GPUTexture *texture, SDL_GPUSampler *sampler) {
+            SDL_zero(bindings[count]);
+            bindings[count].texture = texture;
+            bindings[count].sampler = sampler;
+            count++;
+        };
+        add(shadowAtlas->GetGPUTexture(), shadowSamp);
+        if (features & MaterialFeatureBaseColorTexture) {
+            add(mat.baseColorTexture->GetGPUTexture(), matSampler);
+        }
+        if (features & MaterialFeatureMetallicRoughnessTexture) {
+            add(mat.metallicRoughnessTexture->GetGPUTexture(), matSampler);
+        }
+        if (features & MaterialFeatureEmissiveTexture) {
+            add(mat.emissiveTexture->GetGPUTexture(), matSampler);
+        }
+        if (features & MaterialFeatureNormalTexture) {
+            add(mat.normalTexture->GetGPUTexture(), matSampler);
+        }
+        SDL_BindGPUFragmentSamplers(renderPass, 0, bindings, count);
+    };
 
-    // Per-object: bind material textures (base color, metallic-
-    // roughness, emissive) plus the four shadow maps, push the
-    // material UBO, push the per-object vertex UBO, then draw. We
-    // can't share with the shadow path's DrawSceneGeometry helper
-    // because shadow passes don't bind materials.
-    Material defaultMaterial;
-    defaultMaterial.sampler = defaultMaterialSampler.get();
+    // Switching pipelines keeps the pushed uniforms but the storage
+    // buffers are rebound alongside each new pipeline to be safe; it
+    // happens at most once per variant per view.
+    SDL_GPUGraphicsPipeline *boundPipeline = nullptr;
+    GeometryBinding geometry;
+    auto bindForwardPipeline = [&](SDL_GPUGraphicsPipeline *pipeline) {
+        if (pipeline == boundPipeline) {
+            return;
+        }
+        SDL_BindGPUGraphicsPipeline(renderPass, pipeline);
+        BindObjectStorage(renderPass, objectGpuBuffer, visibleBuffer);
+        SDL_BindGPUFragmentStorageBuffers(renderPass, 0, &materialGpuBuffer, 1);
+        boundPipeline = pipeline;
+        geometry.Reset();
+    };
 
-    SDL_GPUSampler *defaultSampler = defaultMaterialSampler->GetSampler();
-    SDL_GPUSampler *shadowSamp = shadowSampler->GetSampler();
-    SDL_GPUTexture *whiteGpuTex = whiteTexture->GetGPUTexture();
+    // Skinned draws leave `vertexFormat` at Standard; SkinnedMesh has
+    // only the one layout. Within a variant, draws sharing a vertex
+    // buffer (one Model's arena) are kept together so they bind it once.
+    struct ForwardDraw {
+        uint32_t features;
+        uint32_t index;
+        MeshVertexFormat vertexFormat = MeshVertexFormat::Standard;
+        SDL_GPUBuffer *vertexBuffer = nullptr;
+    };
+    auto byVariant = [](const ForwardDraw &a, const ForwardDraw &b) {
+        if (a.features != b.features) {
+            return a.features < b.features;
+        }
+        if (a.vertexFormat != b.vertexFormat) {
+            return a.vertexFormat < b.vertexFormat;
+        }
+        return std::less<SDL_GPUBuffer *>()(a.vertexBuffer, b.vertexBuffer);
+    };
+    std::vector<ForwardDraw> draws;
+    std::vector<ForwardDraw> skinnedDraws;
+
+    for (uint32_t v = 0; v < viewCount; v++) {
+        const ForwardView &view = views[v];
+        const uint32_t viewBit = 1u << v;
+
+        // Rigid objects draw their surviving clusters when they have
+        // them, and their selected level of detail otherwise.
+        auto drawRigidObject = [&](uint32_t i) {
+            const Mesh &mesh = *scene.objects[i].mesh;
+            if (clusterSlots[i] >= 0) {
+                DrawObjectRuns(renderPass,
+                    cmd,
+                    geometry,
+                    mesh,
+                    i,
+                    clusterRuns[static_cast<uint32_t>(clusterSlots[i]) * viewCount + v]);
+            } else {
+                DrawObjectGeometry(renderPass, cmd, geometry, mesh, i, objectLods[i]);
+            }
+        };
+
+        // Each view is its own viewport and scissor within the shared
+        // render pass, with its own camera uniforms.
+        SDL_GPUViewport viewport;
+        SDL_zero(viewport);
+        viewport.x = static_cast<float>(view.viewport.x);
+        viewport.y = static_cast<float>(view.viewport.y);
+        viewport.w = static_cast<float>(view.viewport.width);
+        viewport.h = static_cast<float>(view.viewport.height);
+        viewport.min_depth = 0.0f;
+        viewport.max_depth = 1.0f;
+        SDL_SetGPUViewport(renderPass, &viewport);
+        SDL_Rect scissor;
+        scissor.x = view.viewport.x;
+        scissor.y = view.viewport.y;
+        scissor.w = view.viewport.width;
+        scissor.h = view.viewport.height;
+        SDL_SetGPUScissor(renderPass, &scissor);
+
+        lightingUbo.cameraPosition = view.camera.position;
+        SDL_PushGPUVertexUniformData(cmd, 0, &viewProjections[v], sizeof(glm::mat4));
+        SDL_PushGPUFragmentUniformData(cmd, 0, &lightingUbo, sizeof(lightingUbo));
+
+        // Optional depth pre-pass, in the same render pass as the color
+        // draws. The pre-pass pipelines use the shadow-depth shaders,
+        // whose Frame and Object UBOs share slots and layout with the
+        // forward shaders, so the geometry helpers serve both. The rigid
+        // position math is `precise` in both vertex shaders so the
+        // forward pass reproduces the pre-pass depth bit for bit and the
+        // EQUAL test passes exactly on the visible surface.
+        if (depthPrePass) {
+            SDL_GPUGraphicsPipeline *boundPrePass = nullptr;
+            auto bindPrePassPipeline = [&](MeshVertexFormat vertexFormat) {
+                SDL_GPUGraphicsPipeline *pipeline =
+                    prePassPipelines[static_cast<int>(vertexFormat)];
+                if (pipeline != boundPrePass) {
+                    SDL_BindGPUGraphicsPipeline(renderPass, pipeline);
+                    BindObjectStorage(renderPass, objectGpuBuffer, visibleBuffer);
+                    boundPrePass = pipeline;
+                    geometry.Reset();
+                }
+            };
+            // Scene objects in scene order, which mixes vertex formats
+            // only when the scene does.
+            for (size_t i = 0; i < scene.objects.size(); i++) {
+                if (visibleViews[i] & viewBit) {
+                    bindPrePassPipeline(scene.objects[i].mesh->GetVertexFormat());
+                    drawRigidObject(static_cast<uint32_t>(i));
+                }
+            }
+            for (uint32_t b = 0; b < batchCount; b++) {
+                bindPrePassPipeline(indirectBatches[b].vertexFormat);
+                DrawIndirectBatch(renderPass,
+                    cmd,
+                    geometry,
+                    drawArgsGpuBuffer,
+                    indirectBatches[b],
+                    v * batchCount + b,
+                    v * visiblePerView);
+            }
+            if (prePassSkinnedPipeline) {
+                SDL_BindGPUGraphicsPipeline(renderPass, prePassSkinnedPipeline);
+                geometry.Reset();
+                for (size_t i = 0; i < scene.skinnedObjects.size(); i++) {
+                    if (skinnedVisibleViews[i] & viewBit) {
+                        DrawSkinnedObjectGeometry(renderPass,
+                            cmd,
+                            geometry,
+                            scene.skinnedObjects[i],
+                            0,
+                            ObjectLights{});
+                    }
+                }
+            }
+            boundPipeline = nullptr;
+            geometry.Reset();
+        }
 
-    for (const SceneObject &object : scene.objects) {
-        if (!object.mesh) {
-            continue;
+        draws.clear();
+        for (size_t i = 0; i < scene.objects.size(); i++) {
+            if (visibleViews[i] & viewBit) {
+                const Material *material = scene.objects[i].material;
+                const Mesh &mesh = *scene.objects[i].mesh;
+                draws.push_back({MaterialFeaturesOf(material ? *material : defaultMaterial),
+                    static_cast<uint32_t>(i),
+                    mesh.GetVertexFormat(),
+                    mesh.GetVertexBuffer()});
+            }
         }
+        std::stable_sort(draws.begin(), draws.end(), byVariant);
 
-        const Material *mat = object.material ? object.material : &defaultMaterial;
+        for (const ForwardDraw &draw : draws) {
+            SDL_GPUGraphicsPipeline *pipeline = GetOrCreateForwardPipeline(
+                colorFormat, depthFormat, depthPrePass, draw.features, draw.vertexFormat);
+            if (!pipeline) {
+                continue;
+            }
+            bindForwardPipeline(pipeline);
 
-        MaterialUBO matUbo{};
-        matUbo.baseColorFactor = mat->baseColorFactor;
-        matUbo.emissiveFactor = mat->emissiveFactor;
-        matUbo.metallicFactor = mat->metallicFactor;
-        matUbo.roughnessFactor = mat->roughnessFactor;
-        matUbo.hasBaseColorTexture = mat->baseColorTexture ? 1 : 0;
-        matUbo.hasMetallicRoughnessTexture = mat->metallicRoughnessTexture ? 1 : 0;
-        matUbo.hasEmissiveTexture = mat->emissiveTexture ? 1 : 0;
-        matUbo.hasNormalTexture = mat->normalTexture ? 1 : 0;
-        matUbo.normalScale = mat->normalScale;
-        SDL_PushGPUFragmentUniformData(cmd, 1, &matUbo, sizeof(matUbo));
+            const SceneObject &object = scene.objects[draw.index];
+            bindFragmentTextures(
+                object.material ? *object.material : defaultMaterial, draw.features);
+            drawRigidObject(draw.index);
+        }
 
-        SDL_GPUSampler *matSampler = (mat->sampler ? mat->sampler->GetSampler() : defaultSampler);
+        // GPU-culled batches, already ordered by variant.
+        for (uint32_t b = 0; b < batchCount; b++) {
+            const ForwardIndirectBatch &batch = indirectBatches[b];
+            SDL_GPUGraphicsPipeline *pipeline = GetOrCreateForwardPipeline(
+                colorFormat, depthFormat, depthPrePass, batch.features, batch.vertexFormat);
+            if (!pipeline) {
+                continue;
+            }
+            bindForwardPipeline(pipeline);
+            bindFragmentTextures(
+                batch.material ? *batch.material : defaultMaterial, batch.features);
+            DrawIndirectBatch(renderPass,
+                cmd,
+                geometry,
+                drawArgsGpuBuffer,
+                batch,
+                v * batchCount + b,
+                v * visiblePerView);
+        }
 
-        // Bind all ten fragment texture+sampler pairs in one call.
-        // Splitting these into separate range binds (e.g. material per
-        // object + shadows per frame) doesn't actually rebind on D3D12;
-        // each draw needs the complete set together. Slots 0..1 are
-        // material textures (base color, metallic-roughness); 2..5 are
-        // the four 2D shadow maps; 6 is the emissive texture; 7 is the
-        // normal map; 8..9 are the two point shadow cubemaps.
-        SDL_GPUTextureSamplerBinding bindings[4 + MaxShadowMaps + MaxPointShadows];
-        SDL_zero(bindings[0]);
-        bindings[0].texture =
-            mat->baseColorTexture ? mat->baseColorTexture->GetGPUTexture() : whiteGpuTex;
-        bindings[0].sampler = matSampler;
-        SDL_zero(bindings[1]);
-        bindings[1].texture = mat->metallicRoughnessTexture
-                                  ? mat->metallicRoughnessTexture->GetGPUTexture()
-                                  : whiteGpuTex;
-        bindings[1].sampler = matSampler;
-        for (int i = 0; i < MaxShadowMaps; i++) {
-            SDL_zero(bindings[2 + i]);
-            bindings[2 + i].texture = shadowMaps[i]->GetGPUTexture();
-            bindings[2 + i].sampler = shadowSamp;
-        }
-        SDL_zero(bindings[2 + MaxShadowMaps]);
-        bindings[2 + MaxShadowMaps].texture =
-            mat->emissiveTexture ? mat->emissiveTexture->GetGPUTexture() : whiteGpuTex;
-        bindings[2 + MaxShadowMaps].sampler = matSampler;
-        SDL_zero(bindings[3 + MaxShadowMaps]);
-        bindings[3 + MaxShadowMaps].texture =
-            mat->normalTexture ? mat->normalTexture->GetGPUTexture() : whiteGpuTex;
-        bindings[3 + MaxShadowMaps].sampler = matSampler;
-        for (int i = 0; i < MaxPointShadows; i++) {
-            SDL_zero(bindings[4 + MaxShadowMaps + i]);
-            bindings[4 + MaxShadowMaps + i].texture = pointShadowMaps[i]->GetGPUTexture();
-            bindings[4 + MaxShadowMaps + i].sampler = shadowSamp;
-        }
-        SDL_BindGPUFragmentSamplers(renderPass, 0, bindings, 4 + MaxShadowMaps + MaxPointShadows);
-
-        ObjectUBO ubo;
-        ubo.model = object.transform;
-        ubo.colorTint = glm::vec4(object.color, 1.0f);
-        SDL_PushGPUVertexUniformData(cmd, 1, &ubo, sizeof(ubo));
+        // Skinned forward draws. Same variant selection as the rigid
+        // path; the Frame UBO (slot 0) and lighting UBO persist across
+        // pipeline binds within the same render pass, and only the
+        // vertex inputs and per-draw vertex UBOs change.
+        skinnedDraws.clear();
+        for (size_t i = 0; i < scene.skinnedObjects.size(); i++) {
+            if (skinnedVisibleViews[i] & viewBit) {
+                const SkinnedSceneObject &object = scene.skinnedObjects[i];
+                const Material *material = object.material;
+                skinnedDraws.push_back({MaterialFeaturesOf(material ? *material : defaultMaterial),
+                    static_cast<uint32_t>(i),
+                    MeshVertexFormat::Standard,
+                    object.mesh->GetVertexBuffer()});
+            }
+        }
+        std::stable_sort(skinnedDraws.begin(), skinnedDraws.end(), byVariant);
 
-        SDL_GPUBufferBinding vbufBinding;
-        SDL_zero(vbufBinding);
-        vbufBinding.buffer = object.mesh->GetVertexBuffer();
-        SDL_BindGPUVertexBuffers(renderPass, 0, &vbufBinding, 1);
+        for (const ForwardDraw &draw : skinnedDraws) {
+            SDL_GPUGraphicsPipeline *pipeline = GetOrCreateForwardSkinnedPipeline(
+                colorFormat, depthFormat, depthPrePass, draw.features);
+            if (!pipeline) {
+                continue;
+            }
+            bindForwardPipeline(pipeline);
+
+            const SkinnedSceneObject &object = scene.skinnedObjects[draw.index];
+            bindFragmentTextures(
+                object.material ? *object.material : defaultMaterial, draw.features);
+            DrawSkinnedObjectGeometry(renderPass,
+                cmd,
+                geometry,
+                object,
+                skinnedMaterialIndices[draw.index],
+                skinnedLights[draw.index]);
+        }
+    }
 
-        SDL_GPUBufferBinding ibufBinding;
-        SDL_zero(ibufBinding);
-        ibufBinding.buffer = object.mesh->GetIndexBuffer();
-        SDL_BindGPUIndexBuffer(renderPass, &ibufBinding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+    graphicsDevice->EndRenderPass();
 
-        SDL_DrawGPUIndexedPrimitives(renderPass, object.mesh->GetIndexCount(), 1, 0, 0, 0);
+    if (shadowTask.valid()) {
+        shadowTask.get();
+    }
+    if (retiredVisibleBuffer) {
+        SDL_ReleaseGPUBuffer(graphicsDevice->GetDevice(), retiredVisibleBuffer);
+        retiredVisibleBuffer = nullptr;
     }
+}
 
-    // Skinned forward draws. Switch pipelines but keep the existing
-    // Frame UBO (slot 0) and per-draw fragment state -- those persist
-    // across pipeline binds within the same render pass. The skinned
-    // pipeline reads the same fragment cbuffers, sampler bindings, and
-    // ViewProjection slot as the rigid path; only the vertex inputs
-    // and per-draw vertex UBOs change.
-    if (forwardSkinnedPipeline && !scene.skinnedObjects.empty()) {
-        SDL_BindGPUGraphicsPipeline(renderPass, forwardSkinnedPipeline);
+bool ForwardRenderer::CullOnGpu(const Scene3D &scene, const Material &defaultMaterial,
+    const glm::mat4 *viewProjections, uint32_t viewCount, const std::vector<uint8_t> &objectLods,
+    std::vector<ForwardIndirectBatch> &batches) {
+    batches.clear();
+    const uint32_t objectCount = static_cast<uint32_t>(scene.objects.size());
+
+    // Batch objects by mesh, material and level of detail in order of
+    // first appearance, then order the batches by feature mask and
+    // vertex format so each forward pipeline is bound once per view, and
+    // by vertex buffer so batches from one Model's arena bind it once.
+    std::vector<uint32_t> objectBatches(objectCount, NoIndirectBatch);
+    std::map<std::tuple<const Mesh *, const Material *, int>, uint32_t> batchIndices;
+    for (uint32_t i = 0; i < objectCount; i++) {
+        const SceneObject &object = scene.objects[i];
+        if (!object.mesh) {
+            continue;
+        }
+        auto [it, inserted] =
+            batchIndices.emplace(std::make_tuple(object.mesh, object.material, objectLods[i]),
+                static_cast<uint32_t>(batches.size()));
+        if (inserted) {
+            ForwardIndirectBatch batch{};
+            batch.mesh = object.mesh;
+            batch.material = object.material;
+            batch.lod = objectLods[i];
+            batch.features =
+                MaterialFeaturesOf(object.material ? *object.material : defaultMaterial);
+            batch.vertexFormat = object.mesh->GetVertexFormat();
+            batches.push_back(batch);
+        }
+        batches[it->second].objectCount++;
+        objectBatches[i] = it->second;
+    }
+    if (batches.empty()) {
+        return true;
+    }
 
-        for (const SkinnedSceneObject &object : scene.skinnedObjects) {
-            if (!object.mesh || !object.jointMatrices) {
-                continue;
-            }
+    std::vector<uint32_t> order(batches.size());
+    for (uint32_t b = 0; b < order.size(); b++) {
+        order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        if (batches[a].features != batches[b].features) {
+            return batches[a].features < batches[b].features;
+        }
+        if (batches[a].vertexFormat != batches[b].vertexFormat) {
+            return batches[a].vertexFormat < batches[b].vertexFormat;
+        }
+        return std::less<SDL_GPUBuffer *>()(
+            batches[a].mesh->GetVertexBuffer(), batches[b].mesh->GetVertexBuffer());
+    });
+    std::vector<ForwardIndirectBatch> sorted(batches.size());
+    std::vector<uint32_t> remap(batches.size());
+    uint32_t visiblePerView = 0;
+    for (uint32_t b = 0; b < order.size(); b++) {
+        remap[order[b]] = b;
+        sorted[b] = batches[order[b]];
+        sorted[b].firstVisible = visiblePerView;
+        visiblePerView += sorted[b].objectCount;
+    }
+    batches = std::move(sorted);
+    const uint32_t batchCount = static_cast<uint32_t>(batches.size());
+
+    std::vector<ForwardCullData> records(objectCount);
+    for (uint32_t i = 0; i < objectCount; i++) {
+        ForwardCullData &record = records[i];
+        record = ForwardCullData{};
+        record.batch = NoIndirectBatch;
+        if (objectBatches[i] == NoIndirectBatch) {
+            continue;
+        }
+        const BoundingBox &bounds = scene.objects[i].mesh->GetBounds();
+        if (!bounds.IsEmpty()) {
+            record.boundsCenter = bounds.GetCenter();
+            record.boundsExtents = bounds.GetExtents();
+        }
+        record.batch = remap[objectBatches[i]];
+        record.firstVisible = batches[record.batch].firstVisible;
+    }
 
-            const Material *mat = object.material ? object.material : &defaultMaterial;
-
-            MaterialUBO matUbo{};
-            matUbo.baseColorFactor = mat->baseColorFactor;
-            matUbo.emissiveFactor = mat->emissiveFactor;
-            matUbo.metallicFactor = mat->metallicFactor;
-            matUbo.roughnessFactor = mat->roughnessFactor;
-            matUbo.hasBaseColorTexture = mat->baseColorTexture ? 1 : 0;
-            matUbo.hasMetallicRoughnessTexture = mat->metallicRoughnessTexture ? 1 : 0;
-            matUbo.hasEmissiveTexture = mat->emissiveTexture ? 1 : 0;
-            matUbo.hasNormalTexture = mat->normalTexture ? 1 : 0;
-            matUbo.normalScale = mat->normalScale;
-            SDL_PushGPUFragmentUniformData(cmd, 1, &matUbo, sizeof(matUbo));
-
-            SDL_GPUSampler *matSampler =
-                (mat->sampler ? mat->sampler->GetSampler() : defaultSampler);
-
-            SDL_GPUTextureSamplerBinding bindings[4 + MaxShadowMaps + MaxPointShadows];
-            SDL_zero(bindings[0]);
-            bindings[0].texture =
-                mat->baseColorTexture ? mat->baseColorTexture->GetGPUTexture() : whiteGpuTex;
-            bindings[0].sampler = matSampler;
-            SDL_zero(bindings[1]);
-            bindings[1].texture = mat->metallicRoughnessTexture
-                                      ? mat->metallicRoughnessTexture->GetGPUTexture()
-                                      : whiteGpuTex;
-            bindings[1].sampler = matSampler;
-            for (int i = 0; i < MaxShadowMaps; i++) {
-                SDL_zero(bindings[2 + i]);
-                bindings[2 + i].texture = shadowMaps[i]->GetGPUTexture();
-                bindings[2 + i].sampler = shadowSamp;
-            }
-            SDL_zero(bindings[2 + MaxShadowMaps]);
-            bindings[2 + MaxShadowMaps].texture =
-                mat->emissiveTexture ? mat->emissiveTexture->GetGPUTexture() : whiteGpuTex;
-            bindings[2 + MaxShadowMaps].sampler = matSampler;
-            SDL_zero(bindings[3 + MaxShadowMaps]);
-            bindings[3 + MaxShadowMaps].texture =
-                mat->normalTexture ? mat->normalTexture->GetGPUTexture() : whiteGpuTex;
-            bindings[3 + MaxShadowMaps].sampler = matSampler;
-            for (int i = 0; i < MaxPointShadows; i++) {
-                SDL_zero(bindings[4 + MaxShadowMaps + i]);
-                bindings[4 + MaxShadowMaps + i].texture = pointShadowMaps[i]->GetGPUTexture();
-                bindings[4 + MaxShadowMaps + i].sampler = shadowSamp;
-            }
-            SDL_BindGPUFragmentSamplers(
-                renderPass, 0, bindings, 4 + MaxShadowMaps + MaxPointShadows);
-
-            SkinnedObjectUBO objectUbo;
-            objectUbo.colorTint = glm::vec4(object.color, 1.0f);
-            SDL_PushGPUVertexUniformData(cmd, 1, &objectUbo, sizeof(objectUbo));
-
-            PushJointMatrices(cmd, *object.jointMatrices);
-
-            SDL_GPUBufferBinding vbufBinding;
-            SDL_zero(vbufBinding);
-            vbufBinding.buffer = object.mesh->GetVertexBuffer();
-            SDL_BindGPUVertexBuffers(renderPass, 0, &vbufBinding, 1);
-
-            SDL_GPUBufferBinding ibufBinding;
-            SDL_zero(ibufBinding);
-            ibufBinding.buffer = object.mesh->GetIndexBuffer();
-            SDL_BindGPUIndexBuffer(renderPass, &ibufBinding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
-
-            SDL_DrawGPUIndexedPrimitives(renderPass, object.mesh->GetIndexCount(), 1, 0, 0, 0);
+    // Instance counts start at zero each frame and are bumped by the
+    // shader, so the arguments are re-uploaded in full every time.
+    std::vector<SDL_GPUIndexedIndirectDrawCommand> args(viewCount * batchCount);
+    for (uint32_t v = 0; v < viewCount; v++) {
+        for (uint32_t b = 0; b < batchCount; b++) {
+            SDL_GPUIndexedIndirectDrawCommand &command = args[v * batchCount + b];
+            SDL_zero(command);
+            const MeshLod &lod = batches[b].mesh->GetLod(batches[b].lod);
+            command.num_indices = lod.indexCount;
+            command.first_index = lod.firstIndex;
+            command.vertex_offset = static_cast<Sint32>(batches[b].mesh->GetBaseVertex());
         }
     }
 
-    graphicsDevice->EndRenderPass();
+    const uint32_t visibleCount = viewCount * visiblePerView;
+    if (visibleCount > visibleCapacity) {
+        uint32_t capacity = visibleCapacity;
+        while (capacity < visibleCount) {
+            capacity *= 2;
+        }
+        SDL_GPUBufferCreateInfo visibleCI;
+        SDL_zero(visibleCI);
+        visibleCI.usage =
+            SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE | SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
+        visibleCI.size = capacity * sizeof(uint32_t);
+        SDL_GPUBuffer *grown = SDL_CreateGPUBuffer(graphicsDevice->GetDevice(), &visibleCI);
+        if (!grown) {
+            spdlog::error("Failed to grow visible object buffer: {}", SDL_GetError());
+            batches.clear();
+            return false;
+        }
+        // The shadow tiles may still be recording against the current
+        // buffer on the pool, so it is only retired here and released
+        // once they finish, in RenderViews. One retired on an earlier
+        // frame is no longer bound by anything.
+        if (retiredVisibleBuffer) {
+            SDL_ReleaseGPUBuffer(graphicsDevice->GetDevice(), retiredVisibleBuffer);
+        }
+        retiredVisibleBuffer = visibleBuffer;
+        visibleBuffer = grown;
+        visibleCapacity = capacity;
+    }
+
+    cullBuffer->SetData(records.data(), objectCount);
+    drawArgsBuffer->Invalidate();
+    if (drawArgsBuffer->SetData(args.data(), static_cast<uint32_t>(args.size())) == 0) {
+        batches.clear();
+        return false;
+    }
+
+    CullUBO ubo{};
+    for (uint32_t v = 0; v < viewCount; v++) {
+        const Frustum frustum = MakeFrustum(viewProjections[v]);
+        for (int p = 0; p < 6; p++) {
+            ubo.planes[v * 6 + p] = frustum.planes[p];
+        }
+    }
+    ubo.objectCount = objectCount;
+    ubo.viewCount = viewCount;
+    ubo.batchCount = batchCount;
+    ubo.visiblePerView = visiblePerView;
+
+    SDL_GPUStorageBufferReadWriteBinding writeBindings[2];
+    SDL_zero(writeBindings);
+    writeBindings[0].buffer = visibleBuffer;
+    writeBindings[1].buffer = drawArgsBuffer->GetGPUBuffer();
+    graphicsDevice->BeginComputePass(writeBindings, 2);
+    SDL_GPUComputePass *computePass = graphicsDevice->GetCurrentComputePass();
+    if (!computePass) {
+        batches.clear();
+        return false;
+    }
+    SDL_BindGPUComputePipeline(computePass, cullPipeline);
+    SDL_GPUBuffer *readBuffers[2] = {objectBuffer->GetGPUBuffer(), cullBuffer->GetGPUBuffer()};
+    SDL_BindGPUComputeStorageBuffers(computePass, 0, readBuffers, 2);
+    SDL_PushGPUComputeUniformData(graphicsDevice->GetCommandBuffer(), 0, &ubo, sizeof(ubo));
+    SDL_DispatchGPUCompute(computePass, (objectCount + 63) / 64, 1, 1);
+    graphicsDevice->EndComputePass();
+    return true;
 }
 
+namespace {
+
+// Vertex layout of the rigid pipelines for each MeshVertexFormat. Four
+// attributes: position, uv, normal and tangent. Both compressed
+// layouts feed the same COMPRESSED_VERTICES shader variant: the
+// attribute formats do the unpacking, so a quantized position arrives
+// as [0, 1] and a packed normal as its octahedral pair. The shadow and
+// depth pre-pass pipelines use count=3 to skip the tangent.
+void FillRigidVertexInput(MeshVertexFormat vertexFormat,
+    SDL_GPUVertexBufferDescription &vbufDesc, SDL_GPUVertexAttribute attrs[4]) {
+    SDL_zero(vbufDesc);
+    vbufDesc.slot = 0;
+    vbufDesc.input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX;
+    for (int i = 0; i < 4; i++) {
+        SDL_zero(attrs[i]);
+        attrs[i].location = i;
+    }
+
+    switch (vertexFormat) {
+    case MeshVertexFormat::Standard:
+        vbufDesc.pitch = sizeof(Vertex3D);
+        attrs[0].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3;
+        attrs[0].offset = offsetof(Vertex3D, x);
+        attrs[1].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2;
+        attrs[1].offset = offsetof(Vertex3D, u);
+        attrs[2].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3;
+        attrs[2].offset = offsetof(Vertex3D, nx);
+        attrs[3].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4;
+        attrs[3].offset = offsetof(Vertex3D, tx);
+        break;
+    case MeshVertexFormat::Compressed:
+        vbufDesc.pitch = sizeof(CompressedVertex3D);
+        attrs[0].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3;
+        attrs[0].offset = offsetof(CompressedVertex3D, x);
+        attrs[1].format = SDL_GPU_VERTEXELEMENTFORMAT_HALF2;
+        attrs[1].offset = offsetof(CompressedVertex3D, u);
+        attrs[2].format = SDL_GPU_VERTEXELEMENTFORMAT_SHORT2_NORM;
+        attrs[2].offset = offsetof(CompressedVertex3D, nx);
+        attrs[3].format = SDL_GPU_VERTEXELEMENTFORMAT_SHORT4_NORM;
+        attrs[3].offset = offsetof(CompressedVertex3D, tx);
+        break;
+    case MeshVertexFormat::Quantized:
+        // USHORT4_NORM rather than a three-component format, which
+        // SDL_GPU doesn't offer for 16-bit elements; the shader reads xyz.
+        vbufDesc.pitch = sizeof(QuantizedVertex3D);
+        attrs[0].format = SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM;
+        attrs[0].offset = offsetof(QuantizedVertex3D, x);
+        attrs[1].format = SDL_GPU_VERTEXELEMENTFORMAT_HALF2;
+        attrs[1].offset = offsetof(QuantizedVertex3D, u);
+        attrs[2].format = SDL_GPU_VERTEXELEMENTFORMAT_SHORT2_NORM;
+        attrs[2].offset = offsetof(QuantizedVertex3D, nx);
+        attrs[3].format = SDL_GPU_VERTEXELEMENTFORMAT_SHORT4_NORM;
+        attrs[3].offset = offsetof(QuantizedVertex3D, tx);
+        break;
+    }
+}
+
+} // namespace
+
 SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateForwardPipeline(
-    SDL_GPUTextureFormat colorFormat, SDL_GPUTextureFormat depthFormat) {
-    ForwardPipelineKey key{colorFormat, depthFormat};
+    SDL_GPUTextureFormat colorFormat, SDL_GPUTextureFormat depthFormat, bool depthEqual,
+    uint32_t features, MeshVertexFormat vertexFormat) {
+    SDL_assert(features < MaterialVariantCount);
+    ForwardPipelineKey key{colorFormat, depthFormat, depthEqual, features, vertexFormat};
     if (auto it = forwardPipelines.find(key); it != forwardPipelines.end()) {
         return it->second;
     }
@@ -680,25 +2354,8 @@ SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateForwardPipeline(
     SDL_GPUDevice *device = graphicsDevice->GetDevice();
 
     SDL_GPUVertexBufferDescription vbufDesc;
-    SDL_zero(vbufDesc);
-    vbufDesc.slot = 0;
-    vbufDesc.input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX;
-    vbufDesc.pitch = sizeof(Vertex3D);
-
     SDL_GPUVertexAttribute attrs[4];
-    SDL_zero(attrs);
-    attrs[0].location = 0;
-    attrs[0].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3;
-    attrs[0].offset = offsetof(Vertex3D, x);
-    attrs[1].location = 1;
-    attrs[1].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2;
-    attrs[1].offset = offsetof(Vertex3D, u);
-    attrs[2].location = 2;
-    attrs[2].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3;
-    attrs[2].offset = offsetof(Vertex3D, nx);
-    attrs[3].location = 3;
-    attrs[3].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4;
-    attrs[3].offset = offsetof(Vertex3D, tx);
+    FillRigidVertexInput(vertexFormat, vbufDesc, attrs);
 
     SDL_GPUColorTargetDescription colorTarget;
     SDL_zero(colorTarget);
@@ -706,16 +2363,19 @@ SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateForwardPipeline(
 
     SDL_GPUGraphicsPipelineCreateInfo ci;
     SDL_zero(ci);
-    ci.vertex_shader = forwardVertexShader->GetHandle();
-    ci.fragment_shader = forwardFragmentShader->GetHandle();
+    ci.vertex_shader = vertexFormat == MeshVertexFormat::Standard
+                           ? forwardVertexShader->GetHandle()
+                           : forwardCompressedVertexShader->GetHandle();
+    ci.fragment_shader = forwardFragmentShaders[features]->GetHandle();
     ci.vertex_input_state.num_vertex_buffers = 1;
     ci.vertex_input_state.vertex_buffer_descriptions = &vbufDesc;
     ci.vertex_input_state.num_vertex_attributes = 4;
     ci.vertex_input_state.vertex_attributes = attrs;
     ci.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
     ci.depth_stencil_state.enable_depth_test = true;
-    ci.depth_stencil_state.enable_depth_write = true;
-    ci.depth_stencil_state.compare_op = SDL_GPU_COMPAREOP_LESS_OR_EQUAL;
+    ci.depth_stencil_state.enable_depth_write = !depthEqual;
+    ci.depth_stencil_state.compare_op =
+        depthEqual ? SDL_GPU_COMPAREOP_EQUAL : SDL_GPU_COMPAREOP_LESS_OR_EQUAL;
     ci.target_info.num_color_targets = 1;
     ci.target_info.color_target_descriptions = &colorTarget;
     ci.target_info.has_depth_stencil_target = true;
@@ -732,36 +2392,32 @@ SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateForwardPipeline(
 }
 
 SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateShadowPipeline(
-    SDL_GPUTextureFormat depthFormat) {
-    if (shadowPipeline && shadowPipelineDepthFormat == depthFormat) {
-        return shadowPipeline;
+    SDL_GPUTextureFormat depthFormat, MeshVertexFormat vertexFormat) {
+    // The per-format pipelines share one depth format; a new one
+    // invalidates all of them.
+    if (shadowPipelineDepthFormat != depthFormat) {
+        for (SDL_GPUGraphicsPipeline *&pipeline : shadowPipelines) {
+            if (pipeline) {
+                SDL_ReleaseGPUGraphicsPipeline(graphicsDevice->GetDevice(), pipeline);
+                pipeline = nullptr;
+            }
+        }
+        shadowPipelineDepthFormat = depthFormat;
     }
+    SDL_GPUGraphicsPipeline *&shadowPipeline = shadowPipelines[static_cast<int>(vertexFormat)];
     if (shadowPipeline) {
-        SDL_ReleaseGPUGraphicsPipeline(graphicsDevice->GetDevice(), shadowPipeline);
-        shadowPipeline = nullptr;
+        return shadowPipeline;
     }
 
     SDL_GPUVertexBufferDescription vbufDesc;
-    SDL_zero(vbufDesc);
-    vbufDesc.slot = 0;
-    vbufDesc.input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX;
-    vbufDesc.pitch = sizeof(Vertex3D);
-
-    SDL_GPUVertexAttribute attrs[3];
-    SDL_zero(attrs);
-    attrs[0].location = 0;
-    attrs[0].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3;
-    attrs[0].offset = offsetof(Vertex3D, x);
-    attrs[1].location = 1;
-    attrs[1].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2;
-    attrs[1].offset = offsetof(Vertex3D, u);
-    attrs[2].location = 2;
-    attrs[2].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3;
-    attrs[2].offset = offsetof(Vertex3D, nx);
+    SDL_GPUVertexAttribute attrs[4];
+    FillRigidVertexInput(vertexFormat, vbufDesc, attrs);
 
     SDL_GPUGraphicsPipelineCreateInfo ci;
     SDL_zero(ci);
-    ci.vertex_shader = shadowVertexShader->GetHandle();
+    ci.vertex_shader = vertexFormat == MeshVertexFormat::Standard
+                           ? shadowVertexShader->GetHandle()
+                           : shadowCompressedVertexShader->GetHandle();
     ci.fragment_shader = shadowFragmentShader->GetHandle();
     ci.vertex_input_state.num_vertex_buffers = 1;
     ci.vertex_input_state.vertex_buffer_descriptions = &vbufDesc;
@@ -798,7 +2454,6 @@ SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateShadowPipeline(
     }
 
     shadowPipeline = pipeline;
-    shadowPipelineDepthFormat = depthFormat;
     return shadowPipeline;
 }
 
@@ -846,8 +2501,10 @@ void FillSkinnedVertexInput(
 } // namespace
 
 SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateForwardSkinnedPipeline(
-    SDL_GPUTextureFormat colorFormat, SDL_GPUTextureFormat depthFormat) {
-    ForwardPipelineKey key{colorFormat, depthFormat};
+    SDL_GPUTextureFormat colorFormat, SDL_GPUTextureFormat depthFormat, bool depthEqual,
+    uint32_t features) {
+    SDL_assert(features < MaterialVariantCount);
+    ForwardPipelineKey key{colorFormat, depthFormat, depthEqual, features};
     if (auto it = forwardSkinnedPipelines.find(key); it != forwardSkinnedPipelines.end()) {
         return it->second;
     }
@@ -865,15 +2522,16 @@ SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateForwardSkinnedPipeline(
     SDL_GPUGraphicsPipelineCreateInfo ci;
     SDL_zero(ci);
     ci.vertex_shader = forwardSkinnedVertexShader->GetHandle();
-    ci.fragment_shader = forwardFragmentShader->GetHandle();
+    ci.fragment_shader = forwardFragmentShaders[features]->GetHandle();
     ci.vertex_input_state.num_vertex_buffers = 1;
     ci.vertex_input_state.vertex_buffer_descriptions = &vbufDesc;
     ci.vertex_input_state.num_vertex_attributes = 6;
     ci.vertex_input_state.vertex_attributes = attrs;
     ci.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
     ci.depth_stencil_state.enable_depth_test = true;
-    ci.depth_stencil_state.enable_depth_write = true;
-    ci.depth_stencil_state.compare_op = SDL_GPU_COMPAREOP_LESS_OR_EQUAL;
+    ci.depth_stencil_state.enable_depth_write = !depthEqual;
+    ci.depth_stencil_state.compare_op =
+        depthEqual ? SDL_GPU_COMPAREOP_EQUAL : SDL_GPU_COMPAREOP_LESS_OR_EQUAL;
     ci.target_info.num_color_targets = 1;
     ci.target_info.color_target_descriptions = &colorTarget;
     ci.target_info.has_depth_stencil_target = true;
@@ -945,4 +2603,189 @@ SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateShadowSkinnedPipeline(
     return shadowSkinnedPipeline;
 }
 
+namespace {
+
+// Pipeline for the full-tile triangle of shadow_tile.vert.hlsl. Depth
+// is overwritten unconditionally (compare ALWAYS, no bias) so the tile
+// ends up holding exactly what the fragment stage produces.
+SDL_GPUGraphicsPipeline *CreateShadowTilePipeline(SDL_GPUDevice *device,
+    SDL_GPUShader *vertexShader, SDL_GPUShader *fragmentShader,
+    SDL_GPUTextureFormat depthFormat) {
+    SDL_GPUGraphicsPipelineCreateInfo ci;
+    SDL_zero(ci);
+    ci.vertex_shader = vertexShader;
+    ci.fragment_shader = fragmentShader;
+    ci.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+
+    ci.rasterizer_state.fill_mode = SDL_GPU_FILLMODE_FILL;
+    ci.rasterizer_state.cull_mode = SDL_GPU_CULLMODE_NONE;
+    ci.rasterizer_state.front_face = SDL_GPU_FRONTFACE_COUNTER_CLOCKWISE;
+
+    ci.depth_stencil_state.enable_depth_test = true;
+    ci.depth_stencil_state.enable_depth_write = true;
+    ci.depth_stencil_state.compare_op = SDL_GPU_COMPAREOP_ALWAYS;
+
+    ci.target_info.num_color_targets = 0;
+    ci.target_info.has_depth_stencil_target = true;
+    ci.target_info.depth_stencil_format = depthFormat;
+
+    return SDL_CreateGPUGraphicsPipeline(device, &ci);
+}
+
+} // namespace
+
+SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateShadowTileClearPipeline(
+    SDL_GPUTextureFormat depthFormat) {
+    if (shadowTileClearPipeline && shadowTileClearPipelineDepthFormat == depthFormat) {
+        return shadowTileClearPipeline;
+    }
+    if (shadowTileClearPipeline) {
+        SDL_ReleaseGPUGraphicsPipeline(graphicsDevice->GetDevice(), shadowTileClearPipeline);
+        shadowTileClearPipeline = nullptr;
+    }
+
+    // The vertex shader places the triangle on the far plane; the
+    // depth-only fragment shader adds nothing.
+    SDL_GPUGraphicsPipeline *pipeline = CreateShadowTilePipeline(graphicsDevice->GetDevice(),
+        shadowTileVertexShader->GetHandle(),
+        shadowFragmentShader->GetHandle(),
+        depthFormat);
+    if (!pipeline) {
+        spdlog::error("Failed to create shadow tile clear pipeline: {}", SDL_GetError());
+        return nullptr;
+    }
+
+    shadowTileClearPipeline = pipeline;
+    shadowTileClearPipelineDepthFormat = depthFormat;
+    return shadowTileClearPipeline;
+}
+
+SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateShadowTileCopyPipeline(
+    SDL_GPUTextureFormat depthFormat) {
+    if (shadowTileCopyPipeline && shadowTileCopyPipelineDepthFormat == depthFormat) {
+        return shadowTileCopyPipeline;
+    }
+    if (shadowTileCopyPipeline) {
+        SDL_ReleaseGPUGraphicsPipeline(graphicsDevice->GetDevice(), shadowTileCopyPipeline);
+        shadowTileCopyPipeline = nullptr;
+    }
+
+    SDL_GPUGraphicsPipeline *pipeline = CreateShadowTilePipeline(graphicsDevice->GetDevice(),
+        shadowTileVertexShader->GetHandle(),
+        shadowTileCopyFragmentShader->GetHandle(),
+        depthFormat);
+    if (!pipeline) {
+        spdlog::error("Failed to create shadow tile copy pipeline: {}", SDL_GetError());
+        return nullptr;
+    }
+
+    shadowTileCopyPipeline = pipeline;
+    shadowTileCopyPipelineDepthFormat = depthFormat;
+    return shadowTileCopyPipeline;
+}
+
+namespace {
+
+// Shared setup for the depth pre-pass pipelines: depth test and write
+// as the regular forward pass, no depth bias (unlike the shadow
+// pipelines, whose bias would push pre-pass depth off the forward
+// pass's and fail every EQUAL test), and a color target declared to
+// match the forward render pass but with every channel masked off.
+void FillDepthPrePassState(SDL_GPUGraphicsPipelineCreateInfo &ci,
+    SDL_GPUColorTargetDescription &colorTarget, SDL_GPUTextureFormat colorFormat,
+    SDL_GPUTextureFormat depthFormat) {
+    SDL_zero(colorTarget);
+    colorTarget.format = colorFormat;
+    colorTarget.blend_state.enable_color_write_mask = true;
+    colorTarget.blend_state.color_write_mask = 0;
+
+    ci.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+    ci.depth_stencil_state.enable_depth_test = true;
+    ci.depth_stencil_state.enable_depth_write = true;
+    ci.depth_stencil_state.compare_op = SDL_GPU_COMPAREOP_LESS_OR_EQUAL;
+    ci.target_info.num_color_targets = 1;
+    ci.target_info.color_target_descriptions = &colorTarget;
+    ci.target_info.has_depth_stencil_target = true;
+    ci.target_info.depth_stencil_format = depthFormat;
+}
+
+} // namespace
+
+SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateDepthPrePassPipeline(
+    SDL_GPUTextureFormat colorFormat, SDL_GPUTextureFormat depthFormat,
+    MeshVertexFormat vertexFormat) {
+    ForwardPipelineKey key{colorFormat, depthFormat};
+    key.vertexFormat = vertexFormat;
+    if (auto it = depthPrePassPipelines.find(key); it != depthPrePassPipelines.end()) {
+        return it->second;
+    }
+
+    SDL_GPUVertexBufferDescription vbufDesc;
+    SDL_GPUVertexAttribute attrs[4];
+    FillRigidVertexInput(vertexFormat, vbufDesc, attrs);
+
+    SDL_GPUColorTargetDescription colorTarget;
+    SDL_GPUGraphicsPipelineCreateInfo ci;
+    SDL_zero(ci);
+    ci.vertex_shader = vertexFormat == MeshVertexFormat::Standard
+                           ? shadowVertexShader->GetHandle()
+                           : shadowCompressedVertexShader->GetHandle();
+    ci.fragment_shader = shadowFragmentShader->GetHandle();
+    ci.vertex_input_state.num_vertex_buffers = 1;
+    ci.vertex_input_state.vertex_buffer_descriptions = &vbufDesc;
+    ci.vertex_input_state.num_vertex_attributes = 3;
+    ci.vertex_input_state.vertex_attributes = attrs;
+    FillDepthPrePassState(ci, colorTarget, colorFormat, depthFormat);
+
+    SDL_GPUGraphicsPipeline *pipeline =
+        SDL_CreateGPUGraphicsPipeline(graphicsDevice->GetDevice(), &ci);
+    if (!pipeline) {
+        spdlog::error("Failed to create depth pre-pass pipeline: {}", SDL_GetError());
+        return nullptr;
+    }
+
+    depthPrePassPipelines[key] = pipeline;
+    return pipeline;
+}
+
+SDL_GPUGraphicsPipeline *ForwardRenderer::GetOrCreateDepthPrePassSkinnedPipeline(
+    SDL_GPUTextureFormat colorFormat, SDL_GPUTextureFormat depthFormat) {
+    ForwardPipelineKey key{colorFormat, depthFormat};
+    if (auto it = depthPrePassSkinnedPipelines.find(key);
+        it != depthPrePassSkinnedPipelines.end()) {
+        return it->second;
+    }
+
+    SDL_GPUVertexBufferDescription vbufDesc;
+    SDL_GPUVertexAttribute attrs[6];
+    FillSkinnedVertexInput(vbufDesc, attrs);
+
+    SDL_GPUColorTargetDescription colorTarget;
+    SDL_GPUGraphicsPipelineCreateInfo ci;
+    SDL_zero(ci);
+    // The skinned shadow vertex shader nudges its output by a tiny
+    // multiple of an unused uniform to keep that uniform alive, which
+    // would break EQUAL against the forward pass. Reuse the forward
+    // skinned vertex shader instead: identical position math by
+    // construction, and the depth fragment shader ignores the extra
+    // outputs.
+    ci.vertex_shader = forwardSkinnedVertexShader->GetHandle();
+    ci.fragment_shader = shadowFragmentShader->GetHandle();
+    ci.vertex_input_state.num_vertex_buffers = 1;
+    ci.vertex_input_state.vertex_buffer_descriptions = &vbufDesc;
+    ci.vertex_input_state.num_vertex_attributes = 6;
+    ci.vertex_input_state.vertex_attributes = attrs;
+    FillDepthPrePassState(ci, colorTarget, colorFormat, depthFormat);
+
+    SDL_GPUGraphicsPipeline *pipeline =
+        SDL_CreateGPUGraphicsPipeline(graphicsDevice->GetDevice(), &ci);
+    if (!pipeline) {
+        spdlog::error("Failed to create skinned depth pre-pass pipeline: {}", SDL_GetError());
+        return nullptr;
+    }
+
+    depthPrePassSkinnedPipelines[key] = pipeline;
+    return pipeline;
+}
+
 } // namespace Lucky
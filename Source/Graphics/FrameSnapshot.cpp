@@ -0,0 +1,84 @@
+#include <SDL3/SDL_assert.h>
+
+#include <Lucky/FrameSnapshot.hpp>
+#include <Lucky/SlugFont.hpp>
+#include <Lucky/SlugRenderer.hpp>
+#include <Lucky/Texture.hpp>
+
+namespace Lucky {
+
+void FrameSnapshot::CaptureScene(const Scene3D &source) {
+    scene.objects.assign(source.objects.begin(), source.objects.end());
+    scene.skinnedObjects.assign(source.skinnedObjects.begin(), source.skinnedObjects.end());
+    scene.lights.assign(source.lights.begin(), source.lights.end());
+    scene.ambientColor = source.ambientColor;
+
+    // Palettes are reused by position, so a character keeps landing in
+    // the same already-sized vector frame after frame.
+    jointPaletteCount = 0;
+    for (SkinnedSceneObject &object : scene.skinnedObjects) {
+        if (!object.jointMatrices) {
+            continue;
+        }
+        if (jointPaletteCount == jointPalettes.size()) {
+            jointPalettes.emplace_back();
+        }
+        std::vector<glm::mat4> &palette = jointPalettes[jointPaletteCount++];
+        palette.assign(object.jointMatrices->begin(), object.jointMatrices->end());
+        object.jointMatrices = &palette;
+    }
+}
+
+void FrameSnapshot::Clear() {
+    scene.objects.clear();
+    scene.skinnedObjects.clear();
+    scene.lights.clear();
+    views.clear();
+    spriteBatches.clear();
+    textBatches.clear();
+    jointPaletteCount = 0;
+}
+
+void FrameSnapshot::DrawSpriteBatches(BatchRenderer &renderer) const {
+    for (const SpriteBatchSnapshot &batch : spriteBatches) {
+        if (batch.sprites.empty() && batch.triangles.empty()) {
+            continue;
+        }
+        if (batch.texture) {
+            renderer.Begin(batch.blendMode, *batch.texture, batch.transform);
+        } else {
+            renderer.Begin(batch.blendMode, batch.transform);
+        }
+        for (const SpriteSnapshot &sprite : batch.sprites) {
+            renderer.BatchSprite(sprite.hasSourceRectangle ? &sprite.sourceRectangle : nullptr,
+                sprite.position,
+                sprite.rotation,
+                sprite.scale,
+                sprite.origin,
+                sprite.uvMode,
+                sprite.color);
+        }
+        SDL_assert(batch.triangles.size() % 3 == 0);
+        const int triangleCount = static_cast<int>(batch.triangles.size() / 3);
+        if (triangleCount > 0) {
+            renderer.BatchTriangles(batch.triangles.data(), triangleCount);
+        }
+        renderer.End();
+    }
+}
+
+void FrameSnapshot::DrawTextBatches(SlugRenderer &renderer) const {
+    for (const TextBatchSnapshot &batch : textBatches) {
+        SDL_assert(batch.font);
+        if (!batch.font || batch.lines.empty()) {
+            continue;
+        }
+        renderer.Begin(batch.blendMode, *batch.font, batch.mvpMatrix);
+        for (const TextLineSnapshot &line : batch.lines) {
+            batch.font->DrawString(renderer, line.text, line.x, line.y, line.fontSize, line.color);
+        }
+        renderer.End();
+    }
+}
+
+} // namespace Lucky
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include <Lucky/GltfAccessors.hpp>
+#include <Lucky/SkinnedMesh.hpp>
+
+namespace Lucky {
+
+namespace {
+
+template <typename T>
+void CopyIndices(const uint8_t *src, size_t stride, std::vector<uint32_t> &out) {
+    for (size_t i = 0; i < out.size(); i++) {
+        T index;
+        std::memcpy(&index, src + i * stride, sizeof(T));
+        out[i] = index;
+    }
+}
+
+} // namespace
+
+const uint8_t *DirectAccessorData(
+    const cgltf_accessor *accessor, cgltf_component_type componentType) {
+    if (accessor->component_type != componentType || accessor->normalized ||
+        accessor->is_sparse || !accessor->buffer_view) {
+        return nullptr;
+    }
+    const uint8_t *data = cgltf_buffer_view_data(accessor->buffer_view);
+    return data ? data + accessor->offset : nullptr;
+}
+
+void ReadAttribute(const cgltf_accessor *accessor, size_t vertexCount, int components,
+    float *dst, size_t dstStride) {
+    const size_t count = std::min(static_cast<size_t>(accessor->count), vertexCount);
+    const size_t accessorComponents = cgltf_num_components(accessor->type);
+    const size_t copyBytes =
+        std::min(static_cast<size_t>(components), accessorComponents) * sizeof(float);
+    uint8_t *out = reinterpret_cast<uint8_t *>(dst);
+
+    if (const uint8_t *src = DirectAccessorData(accessor, cgltf_component_type_r_32f)) {
+        const size_t srcStride = accessor->stride;
+        for (size_t i = 0; i < count; i++) {
+            std::memcpy(out + i * dstStride, src + i * srcStride, copyBytes);
+        }
+        return;
+    }
+
+    std::vector<float> unpacked(accessor->count * accessorComponents);
+    cgltf_accessor_unpack_floats(accessor, unpacked.data(), unpacked.size());
+    for (size_t i = 0; i < count; i++) {
+        std::memcpy(out + i * dstStride, &unpacked[i * accessorComponents], copyBytes);
+    }
+}
+
+void ReadIndices(const cgltf_accessor *accessor, std::vector<uint32_t> &out) {
+    out.resize(accessor->count);
+    const size_t stride = accessor->stride;
+    if (const uint8_t *src = DirectAccessorData(accessor, cgltf_component_type_r_16u)) {
+        CopyIndices<uint16_t>(src, stride, out);
+    } else if (const uint8_t *src = DirectAccessorData(accessor, cgltf_component_type_r_32u)) {
+        CopyIndices<uint32_t>(src, stride, out);
+    } else if (const uint8_t *src = DirectAccessorData(accessor, cgltf_component_type_r_8u)) {
+        CopyIndices<uint8_t>(src, stride, out);
+    } else {
+        for (size_t i = 0; i < out.size(); i++) {
+            out[i] = static_cast<uint32_t>(cgltf_accessor_read_index(accessor, i));
+        }
+    }
+}
+
+void ReadJoints(const cgltf_accessor *accessor, std::vector<Vertex3DSkinned> &vertices) {
+    const size_t count = std::min(static_cast<size_t>(accessor->count), vertices.size());
+    const size_t stride = accessor->stride;
+    const uint8_t *bytes = DirectAccessorData(accessor, cgltf_component_type_r_8u);
+    const uint8_t *shorts = DirectAccessorData(accessor, cgltf_component_type_r_16u);
+    for (size_t i = 0; i < count; i++) {
+        cgltf_uint joints[4] = {0, 0, 0, 0};
+        if (bytes) {
+            std::copy(bytes + i * stride, bytes + i * stride + 4, joints);
+        } else if (shorts) {
+            uint16_t values[4];
+            std::memcpy(values, shorts + i * stride, sizeof(values));
+            std::copy(std::begin(values), std::end(values), joints);
+        } else {
+            cgltf_accessor_read_uint(accessor, i, joints, 4);
+        }
+        Vertex3DSkinned &v = vertices[i];
+        v.j0 = static_cast<uint32_t>(joints[0]);
+        v.j1 = static_cast<uint32_t>(joints[1]);
+        v.j2 = static_cast<uint32_t>(joints[2]);
+        v.j3 = static_cast<uint32_t>(joints[3]);
+    }
+}
+
+} // namespace Lucky
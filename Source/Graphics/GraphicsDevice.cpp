@@ -213,7 +213,7 @@ void GraphicsDevice::BindRenderTarget(
     BindDepthRenderTarget(depth, 0);
 }
 
-void GraphicsDevice::BindDepthRenderTarget(const Texture &depth, uint32_t layer) {
+void GraphicsDevice::BindDepthRenderTarget(const Texture &depth, uint32_t layer, bool clear) {
     SDL_assert(IsDepthTextureType(depth.GetTextureType()));
     if (IsCubeTextureType(depth.GetTextureType())) {
         SDL_assert(layer < 6);
@@ -227,7 +227,7 @@ void GraphicsDevice::BindDepthRenderTarget(const Texture &depth, uint32_t layer)
 
     currentDepthTarget = &depth;
     currentDepthLayer = layer;
-    needsClear = true;
+    needsClear = clear;
 
     if (!currentRenderTarget) {
         viewport = {0, 0, static_cast<int>(depth.GetWidth()), static_cast<int>(depth.GetHeight())};
@@ -278,6 +278,14 @@ bool GraphicsDevice::IsUsingDepthTarget() const {
     return currentDepthTarget != nullptr;
 }
 
+const Texture *GraphicsDevice::GetRenderTarget() const {
+    return currentRenderTarget;
+}
+
+const Texture *GraphicsDevice::GetDepthRenderTarget() const {
+    return currentDepthTarget;
+}
+
 void GraphicsDevice::BeginFrame() {
     SDL_assert(commandBuffer == nullptr);
 
@@ -0,0 +1,92 @@
+#include <algorithm>
+
+#include <SDL3/SDL_assert.h>
+#include <glm/glm.hpp>
+
+#include <Lucky/Bounds.hpp>
+#include <Lucky/LightSelection.hpp>
+#include <Lucky/Scene3D.hpp>
+
+namespace Lucky {
+
+namespace {
+
+constexpr uint64_t FnvOffsetBasis = 14695981039346656037ull;
+constexpr uint64_t FnvPrime = 1099511628211ull;
+
+uint64_t HashBytes(uint64_t hash, const void *data, size_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FnvPrime;
+    }
+    return hash;
+}
+
+} // namespace
+
+float LightInfluence(const Light &light, const BoundingBox &bounds) {
+    const float brightness =
+        light.intensity * std::max(light.color.x, std::max(light.color.y, light.color.z));
+    if (light.type == LightType::Directional || bounds.IsEmpty()) {
+        return brightness;
+    }
+    const glm::vec3 nearest = glm::clamp(light.position, bounds.min, bounds.max);
+    const float falloff = glm::length(nearest - light.position) / std::max(light.range, 1e-4f);
+    return brightness / (1.0f + falloff * falloff);
+}
+
+ObjectLights SelectObjectLights(
+    const std::vector<Light> &lights, int lightCount, const BoundingBox &bounds) {
+    SDL_assert(lightCount <= MaxSelectableLights);
+    SDL_assert(static_cast<size_t>(lightCount) <= lights.size());
+
+    struct Candidate {
+        float influence;
+        uint32_t index;
+    };
+    Candidate candidates[MaxSelectableLights];
+    int candidateCount = 0;
+    for (int i = 0; i < lightCount; i++) {
+        const float influence = LightInfluence(lights[i], bounds);
+        if (influence >= MinLightInfluence) {
+            candidates[candidateCount++] = {influence, static_cast<uint32_t>(i)};
+        }
+    }
+    if (candidateCount > MaxObjectLights) {
+        std::partial_sort(candidates,
+            candidates + MaxObjectLights,
+            candidates + candidateCount,
+            [](const Candidate &a, const Candidate &b) {
+                return a.influence > b.influence ||
+                       (a.influence == b.influence && a.index < b.index);
+            });
+        candidateCount = MaxObjectLights;
+        std::sort(candidates,
+            candidates + candidateCount,
+            [](const Candidate &a, const Candidate &b) { return a.index < b.index; });
+    }
+
+    ObjectLights selected;
+    selected.count = static_cast<uint32_t>(candidateCount);
+    for (int n = 0; n < candidateCount; n++) {
+        selected.indices[n / 4] |= candidates[n].index << ((n % 4) * 8);
+    }
+    return selected;
+}
+
+uint64_t HashLightsForSelection(const std::vector<Light> &lights, int lightCount) {
+    // Hashed field by field to stay clear of padding.
+    uint64_t hash = HashBytes(FnvOffsetBasis, &lightCount, sizeof(lightCount));
+    for (int i = 0; i < lightCount; i++) {
+        const Light &light = lights[i];
+        hash = HashBytes(hash, &light.type, sizeof(light.type));
+        hash = HashBytes(hash, &light.position, sizeof(light.position));
+        hash = HashBytes(hash, &light.color, sizeof(light.color));
+        hash = HashBytes(hash, &light.intensity, sizeof(light.intensity));
+        hash = HashBytes(hash, &light.range, sizeof(light.range));
+    }
+    return hash;
+}
+
+} // namespace Lucky
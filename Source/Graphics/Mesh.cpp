@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cmath>
+
 #include <SDL3/SDL_assert.h>
 
 #include <glm/glm.hpp>
@@ -6,18 +9,154 @@
 
 namespace Lucky {
 
+namespace {
+
+// A MeshData's indices followed by those of each of its levels of
+// detail, as the Mesh stores them.
+std::vector<uint32_t> IndicesWithLods(const MeshData &data) {
+    std::vector<uint32_t> indices = data.indices;
+    for (const MeshLodData &lod : data.lods) {
+        indices.insert(indices.end(), lod.indices.begin(), lod.indices.end());
+    }
+    return indices;
+}
+
+uint32_t IndexCountWithLods(const MeshData &data) {
+    size_t count = data.indices.size();
+    for (const MeshLodData &lod : data.lods) {
+        count += lod.indices.size();
+    }
+    return static_cast<uint32_t>(count);
+}
+
+} // namespace
+
 Mesh::Mesh(GraphicsDevice &graphicsDevice, const Vertex3D *vertices, uint32_t vertexCount,
-    const uint32_t *indices, uint32_t indexCount)
-    : vertexBuffer(graphicsDevice, vertices, vertexCount),
-      indexBuffer(graphicsDevice, indices, indexCount), vertexCount(vertexCount),
-      indexCount(indexCount) {
+    const uint32_t *indices, uint32_t indexCount, MeshVertexFormat vertexFormat)
+    : indexBuffer(
+          std::make_unique<CompactIndexBuffer>(graphicsDevice, indices, indexCount, vertexCount)),
+      indexGpuBuffer(indexBuffer->GetGPUBuffer()), indexElementSize(indexBuffer->GetElementSize()),
+      vertexCount(vertexCount), indexCount(indexCount), vertexFormat(vertexFormat) {
+    SDL_assert(vertices != nullptr);
+    lods[0].indexCount = indexCount;
+    for (uint32_t i = 0; i < vertexCount; i++) {
+        ExpandBounds(bounds, glm::vec3(vertices[i].x, vertices[i].y, vertices[i].z));
+    }
+
+    switch (vertexFormat) {
+    case MeshVertexFormat::Standard:
+        standardVertexBuffer =
+            std::make_unique<VertexBuffer<Vertex3D>>(graphicsDevice, vertices, vertexCount);
+        vertexGpuBuffer = standardVertexBuffer->GetGPUBuffer();
+        break;
+    case MeshVertexFormat::Compressed: {
+        std::vector<CompressedVertex3D> packed(vertexCount);
+        for (uint32_t i = 0; i < vertexCount; i++) {
+            packed[i] = CompressVertex(vertices[i]);
+        }
+        compressedVertexBuffer = std::make_unique<VertexBuffer<CompressedVertex3D>>(
+            graphicsDevice, packed.data(), vertexCount);
+        vertexGpuBuffer = compressedVertexBuffer->GetGPUBuffer();
+        break;
+    }
+    case MeshVertexFormat::Quantized: {
+        std::vector<QuantizedVertex3D> packed(vertexCount);
+        for (uint32_t i = 0; i < vertexCount; i++) {
+            packed[i] = QuantizeVertex(vertices[i], bounds);
+        }
+        quantizedVertexBuffer = std::make_unique<VertexBuffer<QuantizedVertex3D>>(
+            graphicsDevice, packed.data(), vertexCount);
+        vertexGpuBuffer = quantizedVertexBuffer->GetGPUBuffer();
+        positionOffset = bounds.min;
+        positionScale = bounds.max - bounds.min;
+        break;
+    }
+    }
 }
 
-Mesh::Mesh(GraphicsDevice &graphicsDevice, const MeshData &data)
+Mesh::Mesh(GraphicsDevice &graphicsDevice, const MeshData &data, MeshVertexFormat vertexFormat)
     : Mesh(graphicsDevice, data.vertices.data(), static_cast<uint32_t>(data.vertices.size()),
-          data.indices.data(), static_cast<uint32_t>(data.indices.size())) {
+          IndicesWithLods(data).data(), IndexCountWithLods(data), vertexFormat) {
     SDL_assert(!data.vertices.empty());
     SDL_assert(!data.indices.empty());
+    SDL_assert(data.lods.size() < MaxMeshLods);
+
+    // The levels of detail follow the full mesh in the index buffer.
+    indexCount = static_cast<uint32_t>(data.indices.size());
+    lods[0].indexCount = indexCount;
+    uint32_t nextIndex = indexCount;
+    for (const MeshLodData &lod : data.lods) {
+        MeshLod &entry = lods[lodCount++];
+        entry.firstIndex = nextIndex;
+        entry.indexCount = static_cast<uint32_t>(lod.indices.size());
+        entry.error = lod.error;
+        nextIndex += entry.indexCount;
+    }
+
+    ownedMeshlets = data.meshlets;
+    meshlets = ownedMeshlets.empty() ? nullptr : ownedMeshlets.data();
+    meshletCount = static_cast<uint32_t>(ownedMeshlets.size());
+}
+
+Mesh::Mesh(const MeshArena<Vertex3D> &arena, int rangeIndex)
+    : vertexFormat(arena.GetVertexFormat()) {
+    const MeshArenaRange &range = arena.GetRange(rangeIndex);
+    vertexGpuBuffer = arena.GetVertexBuffer();
+    indexGpuBuffer = arena.GetIndexBuffer();
+    indexElementSize = arena.GetIndexElementSize();
+    firstIndex = range.firstIndex;
+    baseVertex = range.baseVertex;
+    vertexCount = range.vertexCount;
+    indexCount = range.indexCount;
+    bounds = range.bounds;
+    if (vertexFormat == MeshVertexFormat::Quantized) {
+        positionOffset = bounds.min;
+        positionScale = bounds.max - bounds.min;
+    }
+    lods[0].firstIndex = firstIndex;
+    lods[0].indexCount = indexCount;
+    for (uint32_t i = 0; i < range.lodCount; i++) {
+        lods[lodCount++] = range.lods[i];
+    }
+    if (range.meshletCount > 0) {
+        meshlets = arena.GetMeshlets() + range.firstMeshlet;
+        meshletCount = range.meshletCount;
+    }
+}
+
+int SelectMeshLod(const MeshLod *lods, int lodCount, float pixelsPerUnit, float maxPixelError) {
+    SDL_assert(lodCount > 0);
+    if (maxPixelError <= 0.0f) {
+        return 0;
+    }
+    int selected = 0;
+    for (int i = 1; i < lodCount; i++) {
+        if (lods[i].error * pixelsPerUnit > maxPixelError) {
+            break;
+        }
+        selected = i;
+    }
+    return selected;
+}
+
+bool IsMeshletBackfacing(const Meshlet &meshlet, const glm::vec3 &viewPosition) {
+    if (meshlet.coneCutoff <= 0.0f) {
+        return false;
+    }
+    const glm::vec3 toMeshlet = meshlet.center - viewPosition;
+    const float distance = glm::length(toMeshlet);
+    if (distance <= meshlet.radius) {
+        return false;
+    }
+
+    // Every point of the sphere is seen within asin(radius / distance)
+    // of the direction to its center, and every normal is within
+    // acos(coneCutoff) of the axis. If the axis points away from the
+    // viewer by more than both angles combined, so does every triangle.
+    const float cosAxis = glm::dot(toMeshlet, meshlet.coneAxis) / distance;
+    const float sinCutoff = std::sqrt(1.0f - meshlet.coneCutoff * meshlet.coneCutoff);
+    const float sinAxis = std::sqrt(std::max(0.0f, 1.0f - cosAxis * cosAxis));
+    return cosAxis * meshlet.coneCutoff - sinAxis * sinCutoff > meshlet.radius / distance;
 }
 
 MeshData MakeBoxMeshData(float width, float height, float depth) {
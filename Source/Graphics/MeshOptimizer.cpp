@@ -0,0 +1,1081 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+#include <SDL3/SDL_assert.h>
+
+#include <glm/glm.hpp>
+
+#include <Lucky/Mesh.hpp>
+#include <Lucky/MeshOptimizer.hpp>
+#include <Lucky/SkinnedMesh.hpp>
+
+namespace Lucky {
+
+namespace {
+
+// Forsyth's tuning: the cache the scores model, how fast a vertex's score
+// decays as it ages out of it, the flat score of the last triangle's
+// vertices, and the boost for vertices with few triangles left.
+constexpr int ScoringCacheSize = 32;
+constexpr float CacheDecayPower = 1.5f;
+constexpr float LastTriangleScore = 0.75f;
+constexpr float ValenceBoostScale = 2.0f;
+constexpr float ValenceBoostPower = 0.5f;
+
+// Cache size used to measure clusters for the overdraw pass, and the
+// smallest cluster worth sorting on its own.
+constexpr int OverdrawCacheSize = 16;
+constexpr size_t MinClusterTriangles = 16;
+
+constexpr size_t NoTriangle = static_cast<size_t>(-1);
+constexpr uint32_t NoVertex = static_cast<uint32_t>(-1);
+
+// Simplification rejects a collapse that turns a triangle's normal more
+// than about 75 degrees (this is the cosine). Level of detail generation
+// skips meshes under LodMinTriangles, which cost little at full detail,
+// and keeps a level only if it removes at least LodMinReduction of the
+// triangles of the one before.
+constexpr float MaxCollapseTurnCosine = 0.25f;
+constexpr size_t LodMinTriangles = 64;
+constexpr float LodMinReduction = 0.25f;
+
+// Meshlet growth prefers triangles that add few new vertices. A triangle
+// turned fully away from the meshlet's average normal costs as much as
+// MeshletNormalWeight extra vertices, which keeps normal cones narrow,
+// and each average edge length its center lies from the meshlet's costs
+// MeshletSpreadWeight, which keeps meshlets round and bounds tight.
+constexpr float MeshletNormalWeight = 2.0f;
+constexpr float MeshletSpreadWeight = 1.0f;
+
+float VertexScore(int cachePosition, uint32_t remainingTriangles) {
+    if (remainingTriangles == 0) {
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // The vertices of the triangle just emitted score the same,
+            // whatever their order, so the next triangle doesn't favor
+            // one of its edges over the others.
+            score = LastTriangleScore;
+        } else {
+            const float age = static_cast<float>(cachePosition - 3) / (ScoringCacheSize - 3);
+            score = std::pow(1.0f - age, CacheDecayPower);
+        }
+    }
+
+    // Finishing off vertices with few triangles left keeps them from
+    // turning into isolated triangles that cost a full miss later.
+    score +=
+        ValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -ValenceBoostPower);
+    return score;
+}
+
+template <typename Vertex>
+size_t Deduplicate(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) {
+    // Every vertex field is four bytes wide, so there is no padding and
+    // comparing bytes compares attributes.
+    static_assert(sizeof(Vertex) % 4 == 0, "vertex layout must not contain padding");
+
+    const auto hash = [&vertices](uint32_t index) {
+        // FNV-1a over the vertex's bytes.
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&vertices[index]);
+        size_t h = 14695981039346656037ull;
+        for (size_t i = 0; i < sizeof(Vertex); i++) {
+            h = (h ^ bytes[i]) * 1099511628211ull;
+        }
+        return h;
+    };
+    const auto equal = [&vertices](uint32_t a, uint32_t b) {
+        return std::memcmp(&vertices[a], &vertices[b], sizeof(Vertex)) == 0;
+    };
+
+    // Maps each distinct vertex, by its first index, to its new index.
+    std::unordered_map<uint32_t, uint32_t, decltype(hash), decltype(equal)> unique(
+        vertices.size(), hash, equal);
+    std::vector<uint32_t> remap(vertices.size());
+    std::vector<Vertex> merged;
+    merged.reserve(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const auto inserted =
+            unique.emplace(static_cast<uint32_t>(i), static_cast<uint32_t>(merged.size()));
+        if (inserted.second) {
+            merged.push_back(vertices[i]);
+        }
+        remap[i] = inserted.first->second;
+    }
+
+    for (uint32_t &index : indices) {
+        SDL_assert(index < remap.size());
+        index = remap[index];
+    }
+    vertices.swap(merged);
+    return vertices.size();
+}
+
+template <typename Vertex>
+glm::vec3 Position(const Vertex &vertex) {
+    return glm::vec3(vertex.x, vertex.y, vertex.z);
+}
+
+template <typename Vertex>
+void SortClusters(
+    const std::vector<Vertex> &vertices, std::vector<uint32_t> &indices, float threshold) {
+    SDL_assert(indices.size() % 3 == 0);
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < MinClusterTriangles * 2) {
+        return;
+    }
+
+    // Cut a cluster wherever its miss ratio, counted from a cold cache,
+    // has come within the threshold of the whole mesh's. Reordering the
+    // clusters breaks the cache between them, so this bounds what the
+    // sort can cost.
+    const float maxAcmr =
+        AnalyzeVertexCache(indices, vertices.size(), OverdrawCacheSize).acmr * threshold;
+    std::vector<size_t> clusterStarts;
+    std::vector<uint32_t> timestamps(vertices.size(), 0);
+    uint32_t time = OverdrawCacheSize + 1;
+    size_t clusterStart = 0;
+    uint32_t clusterMisses = 0;
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (t == clusterStart) {
+            clusterStarts.push_back(t);
+        }
+        for (size_t k = 0; k < 3; k++) {
+            const uint32_t index = indices[t * 3 + k];
+            if (time - timestamps[index] > OverdrawCacheSize) {
+                timestamps[index] = time++;
+                clusterMisses++;
+            }
+        }
+        const size_t clusterTriangles = t + 1 - clusterStart;
+        if (clusterTriangles >= MinClusterTriangles &&
+            clusterMisses <= maxAcmr * static_cast<float>(clusterTriangles)) {
+            clusterStart = t + 1;
+            clusterMisses = 0;
+            // Ages everything out, so the next cluster starts cold.
+            time += OverdrawCacheSize + 1;
+        }
+    }
+    if (clusterStarts.size() < 2) {
+        return;
+    }
+
+    // Area-weighted centroid and summed normal of each cluster, and the
+    // centroid of the whole mesh.
+    const size_t clusterCount = clusterStarts.size();
+    std::vector<glm::vec3> centroids(clusterCount, glm::vec3(0.0f));
+    std::vector<glm::vec3> normals(clusterCount, glm::vec3(0.0f));
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusterCount; c++) {
+        const size_t end = c + 1 < clusterCount ? clusterStarts[c + 1] : triangleCount;
+        float clusterArea = 0.0f;
+        for (size_t t = clusterStarts[c]; t < end; t++) {
+            const glm::vec3 p0 = Position(vertices[indices[t * 3 + 0]]);
+            const glm::vec3 p1 = Position(vertices[indices[t * 3 + 1]]);
+            const glm::vec3 p2 = Position(vertices[indices[t * 3 + 2]]);
+            const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            const float area = glm::length(normal) * 0.5f;
+            centroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+            normals[c] += normal;
+            clusterArea += area;
+        }
+        meshCentroid += centroids[c];
+        meshArea += clusterArea;
+        if (clusterArea > 0.0f) {
+            centroids[c] /= clusterArea;
+        }
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+
+    // Clusters facing away from the center are on the outside of the
+    // mesh and tend to cover the rest, so they draw first.
+    std::vector<float> facing(clusterCount, 0.0f);
+    for (size_t c = 0; c < clusterCount; c++) {
+        const float length = glm::length(normals[c]);
+        if (length > 0.0f) {
+            facing[c] = glm::dot(centroids[c] - meshCentroid, normals[c] / length);
+        }
+    }
+    std::vector<size_t> order(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++) {
+        order[c] = c;
+    }
+    std::stable_sort(order.begin(), order.end(), [&facing](size_t a, size_t b) {
+        return facing[a] > facing[b];
+    });
+
+    std::vector<uint32_t> sorted;
+    sorted.reserve(indices.size());
+    for (size_t c : order) {
+        const size_t end = c + 1 < clusterCount ? clusterStarts[c + 1] : triangleCount;
+        sorted.insert(
+            sorted.end(), indices.begin() + clusterStarts[c] * 3, indices.begin() + end * 3);
+    }
+    indices.swap(sorted);
+}
+
+template <typename Vertex>
+size_t RemapForFetch(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) {
+    std::vector<uint32_t> remap(vertices.size(), NoVertex);
+    std::vector<Vertex> ordered;
+    ordered.reserve(vertices.size());
+    for (uint32_t &index : indices) {
+        SDL_assert(index < remap.size());
+        if (remap[index] == NoVertex) {
+            remap[index] = static_cast<uint32_t>(ordered.size());
+            ordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(ordered);
+    return vertices.size();
+}
+
+template <typename MeshDataType>
+void OptimizeAll(MeshDataType &meshData) {
+    Deduplicate(meshData.vertices, meshData.indices);
+    OptimizeVertexCache(meshData.indices, meshData.vertices.size());
+    SortClusters(meshData.vertices, meshData.indices, 1.05f);
+    RemapForFetch(meshData.vertices, meshData.indices);
+}
+
+// Sum of weighted squared distances to a set of planes, as the upper
+// triangle of a symmetric 4x4 matrix, plus the total weight. Doubles
+// keep large, flat meshes from cancelling to noise.
+struct Quadric {
+    double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+    double b2 = 0.0, bc = 0.0, bd = 0.0;
+    double c2 = 0.0, cd = 0.0;
+    double d2 = 0.0;
+    double weight = 0.0;
+
+    void AddPlane(const glm::vec3 &normal, float distance, float planeWeight) {
+        const double a = normal.x, b = normal.y, c = normal.z, d = distance, w = planeWeight;
+        a2 += w * a * a;
+        ab += w * a * b;
+        ac += w * a * c;
+        ad += w * a * d;
+        b2 += w * b * b;
+        bc += w * b * c;
+        bd += w * b * d;
+        c2 += w * c * c;
+        cd += w * c * d;
+        d2 += w * d * d;
+        weight += w;
+    }
+
+    void Add(const Quadric &other) {
+        a2 += other.a2;
+        ab += other.ab;
+        ac += other.ac;
+        ad += other.ad;
+        b2 += other.b2;
+        bc += other.bc;
+        bd += other.bd;
+        c2 += other.c2;
+        cd += other.cd;
+        d2 += other.d2;
+        weight += other.weight;
+    }
+
+    double Evaluate(const glm::vec3 &point) const {
+        const double x = point.x, y = point.y, z = point.z;
+        return a2 * x * x + b2 * y * y + c2 * z * z + d2 +
+               2.0 * (ab * x * y + ac * x * z + bc * y * z + ad * x + bd * y + cd * z);
+    }
+};
+
+// Moving the vertex at `position` onto vertex `target`, at a cost of
+// `error` mesh-local units. Stale once the position's version moves on.
+struct Collapse {
+    float error;
+    uint32_t position;
+    uint32_t target;
+    uint32_t version;
+
+    bool operator>(const Collapse &other) const {
+        return error > other.error;
+    }
+};
+
+// Half-edge collapse simplification over welded positions. Vertices
+// with the same position are one position here, so the surface is
+// connected across attribute seams, but a collapse only ever moves a
+// position with a single vertex onto a neighboring vertex: the indices
+// are rewritten and the vertices stay as they are.
+class Simplifier {
+  public:
+    Simplifier(const std::vector<Vertex3D> &vertices, const std::vector<uint32_t> &indices)
+        : corners(indices) {
+        SDL_assert(indices.size() % 3 == 0);
+        WeldPositions(vertices);
+        BuildTriangles();
+        LockBorders();
+    }
+
+    std::vector<uint32_t> Run(size_t targetIndexCount, float maxError, float *resultError) {
+        std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+        for (uint32_t p = 0; p < positions.size(); p++) {
+            Collapse collapse;
+            if (Evaluate(p, collapse)) {
+                heap.push(collapse);
+            }
+        }
+
+        float largestError = 0.0f;
+        std::vector<uint32_t> touched;
+        while (liveTriangles * 3 > targetIndexCount && !heap.empty()) {
+            const Collapse queued = heap.top();
+            heap.pop();
+            if (queued.version != versions[queued.position]) {
+                continue;
+            }
+            if (queued.error > maxError) {
+                break;
+            }
+
+            // Neighboring collapses may have changed what this one would
+            // do; re-check it, and put it back if it got more expensive.
+            Collapse collapse;
+            if (!Evaluate(queued.position, collapse)) {
+                continue;
+            }
+            if (collapse.error > queued.error) {
+                heap.push(collapse);
+                continue;
+            }
+
+            Apply(collapse);
+            largestError = std::max(largestError, collapse.error);
+
+            // Everything around the merged position has new quadrics or
+            // new triangles, so its best collapse may have changed.
+            const uint32_t merged = positionIds[collapse.target];
+            touched.clear();
+            for (uint32_t t : positionTriangles[merged]) {
+                for (int k = 0; k < 3; k++) {
+                    touched.push_back(positionIds[corners[t * 3 + k]]);
+                }
+            }
+            std::sort(touched.begin(), touched.end());
+            touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+            for (uint32_t p : touched) {
+                Collapse updated;
+                if (Evaluate(p, updated)) {
+                    heap.push(updated);
+                }
+            }
+        }
+
+        if (resultError) {
+            *resultError = largestError;
+        }
+        std::vector<uint32_t> result;
+        result.reserve(liveTriangles * 3);
+        for (size_t t = 0; t < removed.size(); t++) {
+            if (!removed[t]) {
+                result.insert(result.end(), &corners[t * 3], &corners[t * 3] + 3);
+            }
+        }
+        return result;
+    }
+
+  private:
+    std::vector<uint32_t> corners;
+    std::vector<uint32_t> positionIds; // per vertex
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> wedges; // per position: its only vertex, if unlocked
+    std::vector<bool> locked;
+    std::vector<Quadric> quadrics;
+    std::vector<std::vector<uint32_t>> positionTriangles;
+    std::vector<uint32_t> versions;
+    std::vector<bool> removed;
+    size_t liveTriangles = 0;
+    std::vector<uint32_t> neighbors;
+    std::vector<uint32_t> targetNeighbors;
+
+    void WeldPositions(const std::vector<Vertex3D> &vertices) {
+        std::vector<uint32_t> order(vertices.size());
+        for (uint32_t v = 0; v < order.size(); v++) {
+            order[v] = v;
+        }
+        const auto less = [&vertices](uint32_t a, uint32_t b) {
+            const Vertex3D &va = vertices[a];
+            const Vertex3D &vb = vertices[b];
+            if (va.x != vb.x) {
+                return va.x < vb.x;
+            }
+            if (va.y != vb.y) {
+                return va.y < vb.y;
+            }
+            return va.z < vb.z;
+        };
+        std::sort(order.begin(), order.end(), less);
+
+        positionIds.resize(vertices.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            if (i == 0 || less(order[i - 1], order[i])) {
+                positions.push_back(Position(vertices[order[i]]));
+            }
+            positionIds[order[i]] = static_cast<uint32_t>(positions.size() - 1);
+        }
+
+        // A position used by more than one vertex is an attribute seam.
+        wedges.assign(positions.size(), NoVertex);
+        locked.assign(positions.size(), false);
+        for (uint32_t index : corners) {
+            SDL_assert(index < vertices.size());
+            uint32_t &wedge = wedges[positionIds[index]];
+            if (wedge == NoVertex) {
+                wedge = index;
+            } else if (wedge != index) {
+                locked[positionIds[index]] = true;
+            }
+        }
+        versions.assign(positions.size(), 0);
+    }
+
+    void BuildTriangles() {
+        const size_t triangleCount = corners.size() / 3;
+        removed.assign(triangleCount, false);
+        quadrics.resize(positions.size());
+        positionTriangles.resize(positions.size());
+        for (size_t t = 0; t < triangleCount; t++) {
+            const uint32_t p0 = positionIds[corners[t * 3 + 0]];
+            const uint32_t p1 = positionIds[corners[t * 3 + 1]];
+            const uint32_t p2 = positionIds[corners[t * 3 + 2]];
+            if (p0 == p1 || p1 == p2 || p2 == p0) {
+                // Already degenerate; nothing to draw.
+                removed[t] = true;
+                continue;
+            }
+            liveTriangles++;
+            positionTriangles[p0].push_back(static_cast<uint32_t>(t));
+            positionTriangles[p1].push_back(static_cast<uint32_t>(t));
+            positionTriangles[p2].push_back(static_cast<uint32_t>(t));
+
+            // Area-weighted, so the error measures how much surface moves.
+            const glm::vec3 normal =
+                glm::cross(positions[p1] - positions[p0], positions[p2] - positions[p0]);
+            const float length = glm::length(normal);
+            if (length > 0.0f) {
+                const glm::vec3 unit = normal / length;
+                const float distance = -glm::dot(unit, positions[p0]);
+                quadrics[p0].AddPlane(unit, distance, length * 0.5f);
+                quadrics[p1].AddPlane(unit, distance, length * 0.5f);
+                quadrics[p2].AddPlane(unit, distance, length * 0.5f);
+            }
+        }
+    }
+
+    // An edge that isn't matched by exactly one edge running the other
+    // way is on an open border or joins more than two triangles; moving
+    // its ends would tear or tangle the surface.
+    void LockBorders() {
+        std::unordered_map<uint64_t, uint32_t> edges;
+        const auto key = [](uint32_t from, uint32_t to) {
+            return (static_cast<uint64_t>(from) << 32) | to;
+        };
+        for (size_t t = 0; t < removed.size(); t++) {
+            if (removed[t]) {
+                continue;
+            }
+            for (int k = 0; k < 3; k++) {
+                const uint32_t from = positionIds[corners[t * 3 + k]];
+                const uint32_t to = positionIds[corners[t * 3 + (k + 1) % 3]];
+                edges[key(from, to)]++;
+            }
+        }
+        for (const auto &edge : edges) {
+            const uint32_t from = static_cast<uint32_t>(edge.first >> 32);
+            const uint32_t to = static_cast<uint32_t>(edge.first);
+            const auto reverse = edges.find(key(to, from));
+            if (edge.second != 1 || reverse == edges.end() || reverse->second != 1) {
+                locked[from] = true;
+                locked[to] = true;
+            }
+        }
+    }
+
+    bool HasPosition(uint32_t t, uint32_t position) const {
+        return positionIds[corners[t * 3 + 0]] == position ||
+               positionIds[corners[t * 3 + 1]] == position ||
+               positionIds[corners[t * 3 + 2]] == position;
+    }
+
+    // The other positions of the live triangles around `position`,
+    // sorted and unique.
+    void GatherNeighbors(uint32_t position, std::vector<uint32_t> &out) const {
+        out.clear();
+        for (uint32_t t : positionTriangles[position]) {
+            if (removed[t]) {
+                continue;
+            }
+            for (int k = 0; k < 3; k++) {
+                const uint32_t p = positionIds[corners[t * 3 + k]];
+                if (p != position) {
+                    out.push_back(p);
+                }
+            }
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    // Finds the cheapest valid collapse of `position` onto a neighbor.
+    // Bumps the position's version either way, which retires whatever
+    // the heap held for it.
+    bool Evaluate(uint32_t position, Collapse &best) {
+        const uint32_t version = ++versions[position];
+        if (locked[position] || wedges[position] == NoVertex) {
+            return false;
+        }
+        GatherNeighbors(position, neighbors);
+        bool found = false;
+        for (uint32_t targetPosition : neighbors) {
+            uint32_t target = NoVertex;
+            float error = 0.0f;
+            if (CheckCollapse(position, targetPosition, target, error) &&
+                (!found || error < best.error)) {
+                best = Collapse{error, position, target, version};
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    bool CheckCollapse(
+        uint32_t position, uint32_t targetPosition, uint32_t &target, float &error) {
+        // The triangles on the edge must all use the same vertex at the
+        // target, or the collapse would mix attributes across a seam.
+        uint32_t sharedTriangles = 0;
+        for (uint32_t t : positionTriangles[position]) {
+            if (removed[t] || !HasPosition(t, targetPosition)) {
+                continue;
+            }
+            sharedTriangles++;
+            for (int k = 0; k < 3; k++) {
+                const uint32_t index = corners[t * 3 + k];
+                if (positionIds[index] == targetPosition) {
+                    if (target != NoVertex && target != index) {
+                        return false;
+                    }
+                    target = index;
+                }
+            }
+        }
+        if (target == NoVertex) {
+            return false;
+        }
+
+        // Link condition: the two ends may only share the neighbors
+        // across the edge, or the collapse pinches the surface.
+        GatherNeighbors(targetPosition, targetNeighbors);
+        uint32_t common = 0;
+        for (uint32_t p : neighbors) {
+            if (p != targetPosition &&
+                std::binary_search(targetNeighbors.begin(), targetNeighbors.end(), p)) {
+                common++;
+            }
+        }
+        if (common != sharedTriangles) {
+            return false;
+        }
+
+        // No triangle that survives may turn too far.
+        const glm::vec3 &destination = positions[targetPosition];
+        for (uint32_t t : positionTriangles[position]) {
+            if (removed[t] || HasPosition(t, targetPosition)) {
+                continue;
+            }
+            glm::vec3 before[3];
+            glm::vec3 after[3];
+            for (int k = 0; k < 3; k++) {
+                const uint32_t p = positionIds[corners[t * 3 + k]];
+                before[k] = positions[p];
+                after[k] = p == position ? destination : positions[p];
+            }
+            const glm::vec3 oldNormal = glm::cross(before[1] - before[0], before[2] - before[0]);
+            const glm::vec3 newNormal = glm::cross(after[1] - after[0], after[2] - after[0]);
+            if (glm::dot(oldNormal, newNormal) <=
+                MaxCollapseTurnCosine * glm::length(oldNormal) * glm::length(newNormal)) {
+                return false;
+            }
+        }
+
+        Quadric quadric = quadrics[position];
+        quadric.Add(quadrics[targetPosition]);
+        const double squared = quadric.weight > 0.0
+                                   ? std::max(quadric.Evaluate(destination), 0.0) / quadric.weight
+                                   : 0.0;
+        error = static_cast<float>(std::sqrt(squared));
+        return true;
+    }
+
+    void Apply(const Collapse &collapse) {
+        const uint32_t position = collapse.position;
+        const uint32_t targetPosition = positionIds[collapse.target];
+        std::vector<uint32_t> &targetTriangles = positionTriangles[targetPosition];
+        for (uint32_t t : positionTriangles[position]) {
+            if (removed[t]) {
+                continue;
+            }
+            if (HasPosition(t, targetPosition)) {
+                removed[t] = true;
+                liveTriangles--;
+                continue;
+            }
+            for (int k = 0; k < 3; k++) {
+                if (positionIds[corners[t * 3 + k]] == position) {
+                    corners[t * 3 + k] = collapse.target;
+                }
+            }
+            targetTriangles.push_back(t);
+        }
+        targetTriangles.erase(
+            std::remove_if(targetTriangles.begin(),
+                targetTriangles.end(),
+                [this](uint32_t t) { return static_cast<bool>(removed[t]); }),
+            targetTriangles.end());
+
+        quadrics[targetPosition].Add(quadrics[position]);
+        positionTriangles[position].clear();
+        wedges[position] = NoVertex;
+        versions[position]++;
+    }
+};
+
+} // namespace
+
+VertexCacheStatistics AnalyzeVertexCache(
+    const std::vector<uint32_t> &indices, size_t vertexCount, int cacheSize) {
+    SDL_assert(cacheSize > 0);
+    VertexCacheStatistics statistics;
+
+    // A vertex is cached while fewer than cacheSize misses have happened
+    // since its own, which is exactly a FIFO of that size.
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    uint32_t time = static_cast<uint32_t>(cacheSize) + 1;
+    for (uint32_t index : indices) {
+        SDL_assert(index < vertexCount);
+        if (time - timestamps[index] > static_cast<uint32_t>(cacheSize)) {
+            timestamps[index] = time++;
+            statistics.vertexTransforms++;
+        }
+    }
+
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount > 0) {
+        statistics.acmr = static_cast<float>(statistics.vertexTransforms) / triangleCount;
+    }
+    if (vertexCount > 0) {
+        statistics.atvr = static_cast<float>(statistics.vertexTransforms) / vertexCount;
+    }
+    return statistics;
+}
+
+size_t DeduplicateVertices(MeshData &meshData) {
+    SDL_assert(meshData.lods.empty());
+    return Deduplicate(meshData.vertices, meshData.indices);
+}
+
+size_t DeduplicateVertices(SkinnedMeshData &meshData) {
+    return Deduplicate(meshData.vertices, meshData.indices);
+}
+
+void OptimizeVertexCache(std::vector<uint32_t> &indices, size_t vertexCount) {
+    SDL_assert(indices.size() % 3 == 0);
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) {
+        return;
+    }
+
+    // Each vertex's triangles, as a range of one shared array. The first
+    // remainingTriangles[v] entries of the range are the ones not yet
+    // emitted.
+    std::vector<uint32_t> remainingTriangles(vertexCount, 0);
+    for (uint32_t index : indices) {
+        SDL_assert(index < vertexCount);
+        remainingTriangles[index]++;
+    }
+    std::vector<uint32_t> firstTriangle(vertexCount);
+    uint32_t offset = 0;
+    for (size_t v = 0; v < vertexCount; v++) {
+        firstTriangle[v] = offset;
+        offset += remainingTriangles[v];
+    }
+    std::vector<uint32_t> vertexTriangles(indices.size());
+    {
+        std::vector<uint32_t> filled(vertexCount, 0);
+        for (size_t i = 0; i < indices.size(); i++) {
+            const uint32_t v = indices[i];
+            vertexTriangles[firstTriangle[v] + filled[v]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) {
+        vertexScores[v] = VertexScore(-1, remainingTriangles[v]);
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(ScoringCacheSize + 3);
+    nextCache.reserve(ScoringCacheSize + 3);
+    std::vector<uint32_t> ordered;
+    ordered.reserve(indices.size());
+    size_t scanStart = 0;
+    size_t best = NoTriangle;
+
+    while (ordered.size() < indices.size()) {
+        if (best == NoTriangle) {
+            // Nothing in the cache has triangles left; carry on from the
+            // first triangle not yet emitted.
+            while (emitted[scanStart]) {
+                scanStart++;
+            }
+            best = scanStart;
+        }
+        emitted[best] = true;
+
+        // Emit the triangle and put its vertices at the front of the
+        // cache. A degenerate triangle lists a vertex twice, and so
+        // appears twice in that vertex's range; each pass removes one.
+        const uint32_t *triangle = &indices[best * 3];
+        nextCache.clear();
+        for (size_t k = 0; k < 3; k++) {
+            const uint32_t v = triangle[k];
+            ordered.push_back(v);
+
+            uint32_t *triangles = &vertexTriangles[firstTriangle[v]];
+            uint32_t &count = remainingTriangles[v];
+            for (uint32_t i = 0; i < count; i++) {
+                if (triangles[i] == best) {
+                    triangles[i] = triangles[count - 1];
+                    count--;
+                    break;
+                }
+            }
+            if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end()) {
+                nextCache.push_back(v);
+            }
+        }
+        for (uint32_t v : cache) {
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                nextCache.push_back(v);
+            }
+        }
+        cache.swap(nextCache);
+
+        // Rescore everything that moved, including the vertices that just
+        // fell out, then pick the best triangle they touch.
+        for (size_t i = 0; i < cache.size(); i++) {
+            const uint32_t v = cache[i];
+            cachePositions[v] = i < ScoringCacheSize ? static_cast<int>(i) : -1;
+            vertexScores[v] = VertexScore(cachePositions[v], remainingTriangles[v]);
+        }
+        best = NoTriangle;
+        float bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            const uint32_t *triangles = &vertexTriangles[firstTriangle[v]];
+            for (uint32_t i = 0; i < remainingTriangles[v]; i++) {
+                const uint32_t t = triangles[i];
+                const float score = vertexScores[indices[t * 3 + 0]] +
+                                    vertexScores[indices[t * 3 + 1]] +
+                                    vertexScores[indices[t * 3 + 2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+        if (cache.size() > ScoringCacheSize) {
+            cache.resize(ScoringCacheSize);
+        }
+    }
+    indices.swap(ordered);
+}
+
+void OptimizeOverdraw(MeshData &meshData, float threshold) {
+    meshData.meshlets.clear();
+    SortClusters(meshData.vertices, meshData.indices, threshold);
+}
+
+void OptimizeOverdraw(SkinnedMeshData &meshData, float threshold) {
+    SortClusters(meshData.vertices, meshData.indices, threshold);
+}
+
+size_t OptimizeVertexFetch(MeshData &meshData) {
+    SDL_assert(meshData.lods.empty());
+    return RemapForFetch(meshData.vertices, meshData.indices);
+}
+
+size_t OptimizeVertexFetch(SkinnedMeshData &meshData) {
+    return RemapForFetch(meshData.vertices, meshData.indices);
+}
+
+void OptimizeMeshData(MeshData &meshData) {
+    SDL_assert(meshData.lods.empty());
+    meshData.meshlets.clear();
+    OptimizeAll(meshData);
+}
+
+void OptimizeMeshData(SkinnedMeshData &meshData) {
+    OptimizeAll(meshData);
+}
+
+std::vector<uint32_t> SimplifyIndices(const std::vector<Vertex3D> &vertices,
+    const std::vector<uint32_t> &indices, size_t targetIndexCount, float maxError,
+    float *resultError) {
+    Simplifier simplifier(vertices, indices);
+    return simplifier.Run(targetIndexCount, maxError, resultError);
+}
+
+void GenerateMeshLods(MeshData &meshData, float maxError) {
+    meshData.lods.clear();
+    if (meshData.indices.size() / 3 < LodMinTriangles) {
+        return;
+    }
+    BoundingBox bounds;
+    for (const Vertex3D &vertex : meshData.vertices) {
+        ExpandBounds(bounds, Position(vertex));
+    }
+    const float errorLimit = maxError * glm::length(bounds.max - bounds.min);
+
+    // Each level starts from the previous one, which is cheaper than
+    // starting over and keeps the levels nested; the errors add up.
+    meshData.lods.reserve(MaxMeshLods - 1);
+    const std::vector<uint32_t> *source = &meshData.indices;
+    float totalError = 0.0f;
+    while (meshData.lods.size() < MaxMeshLods - 1 && totalError < errorLimit) {
+        const size_t targetIndexCount = source->size() / 6 * 3;
+        float levelError = 0.0f;
+        std::vector<uint32_t> simplified = SimplifyIndices(
+            meshData.vertices, *source, targetIndexCount, errorLimit - totalError, &levelError);
+        const float kept = static_cast<float>(simplified.size()) / source->size();
+        if (simplified.empty() || kept > 1.0f - LodMinReduction) {
+            break;
+        }
+        OptimizeVertexCache(simplified, meshData.vertices.size());
+        totalError += levelError;
+        meshData.lods.push_back(MeshLodData{std::move(simplified), totalError});
+        source = &meshData.lods.back().indices;
+    }
+}
+
+void BuildMeshlets(MeshData &meshData, size_t maxTriangles, size_t maxVertices) {
+    SDL_assert(meshData.indices.size() % 3 == 0);
+    SDL_assert(maxTriangles > 0);
+    SDL_assert(maxVertices >= 3);
+    meshData.meshlets.clear();
+    const std::vector<Vertex3D> &vertices = meshData.vertices;
+    const std::vector<uint32_t> &indices = meshData.indices;
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // Unit face normals (zero for degenerate triangles), centers, and for
+    // each vertex, the triangles using it.
+    std::vector<glm::vec3> normals(triangleCount);
+    std::vector<glm::vec3> centroids(triangleCount);
+    std::vector<uint32_t> adjacencyStarts(vertices.size() + 1, 0);
+    float edgeLengthSum = 0.0f;
+    for (size_t t = 0; t < triangleCount; t++) {
+        const glm::vec3 a = Position(vertices[indices[t * 3]]);
+        const glm::vec3 b = Position(vertices[indices[t * 3 + 1]]);
+        const glm::vec3 c = Position(vertices[indices[t * 3 + 2]]);
+        const glm::vec3 normal = glm::cross(b - a, c - a);
+        const float length = glm::length(normal);
+        normals[t] = length > 0.0f ? normal / length : glm::vec3(0.0f);
+        centroids[t] = (a + b + c) / 3.0f;
+        edgeLengthSum += glm::length(b - a) + glm::length(c - b) + glm::length(a - c);
+        for (int corner = 0; corner < 3; corner++) {
+            adjacencyStarts[indices[t * 3 + corner] + 1]++;
+        }
+    }
+    for (size_t v = 0; v < vertices.size(); v++) {
+        adjacencyStarts[v + 1] += adjacencyStarts[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> cursor(adjacencyStarts.begin(), adjacencyStarts.end() - 1);
+        for (size_t t = 0; t < triangleCount; t++) {
+            for (int corner = 0; corner < 3; corner++) {
+                adjacency[cursor[indices[t * 3 + corner]]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    // Grow each meshlet from a seed through triangles sharing its
+    // vertices, until it is full or nothing connected fits. The seed is
+    // the triangle left over by the previous meshlet with the fewest
+    // unused neighbors, so meshlets pack against each other instead of
+    // stranding slivers, or else the first unused triangle in the current
+    // order.
+    const float averageEdgeLength = edgeLengthSum / static_cast<float>(triangleCount * 3);
+    const float spreadScale =
+        averageEdgeLength > 0.0f ? MeshletSpreadWeight / averageEdgeLength : 0.0f;
+    std::vector<bool> used(triangleCount, false);
+    std::vector<uint32_t> vertexStamps(vertices.size(), 0);
+    std::vector<uint32_t> candidateStamps(triangleCount, 0);
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> members;
+    std::vector<uint32_t> reordered;
+    reordered.reserve(indices.size());
+    std::vector<uint32_t> localStamps(vertices.size(), 0);
+    std::vector<uint32_t> localIndices(vertices.size());
+    std::vector<uint32_t> meshletVertices;
+    std::vector<uint32_t> meshletIndices;
+    std::vector<uint32_t> liveTriangles(vertices.size());
+    for (size_t v = 0; v < vertices.size(); v++) {
+        liveTriangles[v] = adjacencyStarts[v + 1] - adjacencyStarts[v];
+    }
+    uint32_t stamp = 0;
+    size_t nextSeed = 0;
+    while (true) {
+        size_t seed = NoTriangle;
+        uint32_t seedLive = 0;
+        for (const uint32_t t : candidates) {
+            if (used[t]) {
+                continue;
+            }
+            const uint32_t live = liveTriangles[indices[t * 3]] +
+                liveTriangles[indices[t * 3 + 1]] + liveTriangles[indices[t * 3 + 2]];
+            if (seed == NoTriangle || live < seedLive) {
+                seed = t;
+                seedLive = live;
+            }
+        }
+        if (seed == NoTriangle) {
+            while (nextSeed < triangleCount && used[nextSeed]) {
+                nextSeed++;
+            }
+            if (nextSeed == triangleCount) {
+                break;
+            }
+            seed = nextSeed;
+        }
+        stamp++;
+        candidates.assign(1, static_cast<uint32_t>(seed));
+        candidateStamps[seed] = stamp;
+        members.clear();
+        size_t vertexCount = 0;
+        glm::vec3 normalSum(0.0f);
+        glm::vec3 centroidSum(0.0f);
+
+        while (members.size() < maxTriangles) {
+            const glm::vec3 averageNormal =
+                glm::length(normalSum) > 0.0f ? glm::normalize(normalSum) : glm::vec3(0.0f);
+            const glm::vec3 averageCentroid = members.empty()
+                ? centroids[seed]
+                : centroidSum / static_cast<float>(members.size());
+            size_t best = NoTriangle;
+            float bestScore = 0.0f;
+            for (size_t c = 0; c < candidates.size(); c++) {
+                const uint32_t t = candidates[c];
+                if (used[t]) {
+                    continue;
+                }
+                int newVertices = 0;
+                for (int corner = 0; corner < 3; corner++) {
+                    newVertices += vertexStamps[indices[t * 3 + corner]] != stamp;
+                }
+                if (vertexCount + newVertices > maxVertices) {
+                    continue;
+                }
+                const float score = static_cast<float>(newVertices) +
+                    (1.0f - glm::dot(normals[t], averageNormal)) * MeshletNormalWeight +
+                    glm::length(centroids[t] - averageCentroid) * spreadScale;
+                if (best == NoTriangle || score < bestScore) {
+                    best = t;
+                    bestScore = score;
+                }
+            }
+            if (best == NoTriangle) {
+                break;
+            }
+
+            used[best] = true;
+            members.push_back(static_cast<uint32_t>(best));
+            normalSum += normals[best];
+            centroidSum += centroids[best];
+            for (int corner = 0; corner < 3; corner++) {
+                const uint32_t vertex = indices[best * 3 + corner];
+                liveTriangles[vertex]--;
+                if (vertexStamps[vertex] == stamp) {
+                    continue;
+                }
+                vertexStamps[vertex] = stamp;
+                vertexCount++;
+                for (uint32_t a = adjacencyStarts[vertex]; a < adjacencyStarts[vertex + 1]; a++) {
+                    const uint32_t neighbor = adjacency[a];
+                    if (!used[neighbor] && candidateStamps[neighbor] != stamp) {
+                        candidateStamps[neighbor] = stamp;
+                        candidates.push_back(neighbor);
+                    }
+                }
+            }
+        }
+
+        // Growth order ignores the vertex cache, so reorder the
+        // meshlet's triangles for it again. Renumbering its vertices
+        // from zero keeps the pass's per-vertex tables meshlet-sized.
+        meshletVertices.clear();
+        meshletIndices.clear();
+        for (const uint32_t t : members) {
+            for (int corner = 0; corner < 3; corner++) {
+                const uint32_t vertex = indices[t * 3 + corner];
+                if (localStamps[vertex] != stamp) {
+                    localStamps[vertex] = stamp;
+                    localIndices[vertex] = static_cast<uint32_t>(meshletVertices.size());
+                    meshletVertices.push_back(vertex);
+                }
+                meshletIndices.push_back(localIndices[vertex]);
+            }
+        }
+        OptimizeVertexCache(meshletIndices, meshletVertices.size());
+
+        Meshlet meshlet;
+        meshlet.firstIndex = static_cast<uint32_t>(reordered.size());
+        meshlet.indexCount = static_cast<uint32_t>(meshletIndices.size());
+        BoundingBox bounds;
+        for (const uint32_t local : meshletIndices) {
+            reordered.push_back(meshletVertices[local]);
+            ExpandBounds(bounds, Position(vertices[meshletVertices[local]]));
+        }
+        meshlet.center = bounds.GetCenter();
+        for (uint32_t i = meshlet.firstIndex; i < reordered.size(); i++) {
+            meshlet.radius = std::max(
+                meshlet.radius, glm::length(Position(vertices[reordered[i]]) - meshlet.center));
+        }
+
+        // Degenerate triangles cover no pixels, so they don't widen the
+        // cone. A cone wider than a hemisphere is useless for culling.
+        if (glm::length(normalSum) > 0.0f) {
+            meshlet.coneAxis = glm::normalize(normalSum);
+            meshlet.coneCutoff = 1.0f;
+            for (const uint32_t t : members) {
+                if (normals[t] != glm::vec3(0.0f)) {
+                    meshlet.coneCutoff =
+                        std::min(meshlet.coneCutoff, glm::dot(normals[t], meshlet.coneAxis));
+                }
+            }
+        }
+        meshData.meshlets.push_back(meshlet);
+    }
+    meshData.indices.swap(reordered);
+}
+
+} // namespace Lucky
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <stdexcept>
 
 #include <SDL3/SDL_assert.h>
@@ -5,16 +6,27 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <spdlog/spdlog.h>
+#include <stb_image.h>
 
+#include <Lucky/CookedModel.hpp>
+#include <Lucky/GltfAccessors.hpp>
+#include <Lucky/MeshOptimizer.hpp>
 #include <Lucky/Model.hpp>
+#include <Lucky/RetainedScene.hpp>
 #include <Lucky/Sampler.hpp>
 #include <Lucky/Scene3D.hpp>
 #include <Lucky/Texture.hpp>
+#include <Lucky/ThreadPool.hpp>
 
 namespace Lucky {
 
 namespace {
 
+// Rigid primitives with at least this many triangles are split into
+// meshlets so the renderer can cull parts of them; smaller ones cost
+// less to draw whole than to cull piece by piece.
+constexpr size_t MeshletMinTriangles = 2048;
+
 struct CgltfDataDeleter {
     void operator()(cgltf_data *p) const {
         if (p) {
@@ -24,6 +36,11 @@ struct CgltfDataDeleter {
 };
 using CgltfDataPtr = std::unique_ptr<cgltf_data, CgltfDataDeleter>;
 
+glm::mat4 RestLocalTransform(const NodeTemplate &node) {
+    return glm::translate(glm::mat4(1.0f), node.restTranslation) *
+           glm::mat4_cast(node.restRotation) * glm::scale(glm::mat4(1.0f), node.restScale);
+}
+
 void DecomposeNodeTransform(const cgltf_node &node, NodeTemplate &dst) {
     if (node.has_matrix) {
         glm::mat4 m = glm::make_mat4(node.matrix);
@@ -69,51 +86,31 @@ bool BuildPrimitiveData(const cgltf_primitive &prim, MeshData &out) {
         }
     }
 
-    if (!posAccessor || !prim.indices) {
+    if (!posAccessor || posAccessor->count == 0 || !prim.indices) {
         return false;
     }
 
+    // Missing attributes keep these defaults. Tangent absent -> zero.
+    // The forward shader's HasNormalTexture flag gates the read, so an
+    // unread zero is harmless. If a model ever ships a normal-mapped
+    // material without TANGENT, MikkTSpace generation would land here.
+    Vertex3D defaults{};
+    defaults.ny = 1.0f;
     const size_t vertexCount = posAccessor->count;
-    out.vertices.resize(vertexCount);
-    for (size_t i = 0; i < vertexCount; i++) {
-        float pos[3] = {0, 0, 0};
-        float uv[2] = {0, 0};
-        float nrm[3] = {0, 1, 0};
-        // Tangent absent -> zero. The forward shader's HasNormalTexture
-        // flag gates the read, so an unread zero is harmless. If a model
-        // ever ships a normal-mapped material without TANGENT, MikkTSpace
-        // generation would land here.
-        float tan[4] = {0, 0, 0, 0};
-        cgltf_accessor_read_float(posAccessor, i, pos, 3);
-        if (uvAccessor) {
-            cgltf_accessor_read_float(uvAccessor, i, uv, 2);
-        }
-        if (normalAccessor) {
-            cgltf_accessor_read_float(normalAccessor, i, nrm, 3);
-        }
-        if (tangentAccessor) {
-            cgltf_accessor_read_float(tangentAccessor, i, tan, 4);
-        }
-        Vertex3D &v = out.vertices[i];
-        v.x = pos[0];
-        v.y = pos[1];
-        v.z = pos[2];
-        v.u = uv[0];
-        v.v = uv[1];
-        v.nx = nrm[0];
-        v.ny = nrm[1];
-        v.nz = nrm[2];
-        v.tx = tan[0];
-        v.ty = tan[1];
-        v.tz = tan[2];
-        v.tw = tan[3];
-    }
-
-    const size_t indexCount = prim.indices->count;
-    out.indices.resize(indexCount);
-    for (size_t i = 0; i < indexCount; i++) {
-        out.indices[i] = static_cast<uint32_t>(cgltf_accessor_read_index(prim.indices, i));
+    out.vertices.assign(vertexCount, defaults);
+    const size_t stride = sizeof(Vertex3D);
+    ReadAttribute(posAccessor, vertexCount, 3, &out.vertices[0].x, stride);
+    if (uvAccessor) {
+        ReadAttribute(uvAccessor, vertexCount, 2, &out.vertices[0].u, stride);
+    }
+    if (normalAccessor) {
+        ReadAttribute(normalAccessor, vertexCount, 3, &out.vertices[0].nx, stride);
     }
+    if (tangentAccessor) {
+        ReadAttribute(tangentAccessor, vertexCount, 4, &out.vertices[0].tx, stride);
+    }
+
+    ReadIndices(prim.indices, out.indices);
     return true;
 }
 
@@ -159,95 +156,74 @@ bool BuildSkinnedPrimitiveData(const cgltf_primitive &prim, SkinnedMeshData &out
         }
     }
 
-    if (!posAccessor || !prim.indices || !jointsAccessor || !weightsAccessor) {
+    if (!posAccessor || posAccessor->count == 0 || !prim.indices || !jointsAccessor ||
+        !weightsAccessor) {
         return false;
     }
 
+    Vertex3DSkinned defaults{};
+    defaults.ny = 1.0f;
     const size_t vertexCount = posAccessor->count;
-    out.vertices.resize(vertexCount);
-    for (size_t i = 0; i < vertexCount; i++) {
-        float pos[3] = {0, 0, 0};
-        float uv[2] = {0, 0};
-        float nrm[3] = {0, 1, 0};
-        float tan[4] = {0, 0, 0, 0};
-        cgltf_uint joints[4] = {0, 0, 0, 0};
-        float weights[4] = {0, 0, 0, 0};
-        cgltf_accessor_read_float(posAccessor, i, pos, 3);
-        if (uvAccessor) {
-            cgltf_accessor_read_float(uvAccessor, i, uv, 2);
-        }
-        if (normalAccessor) {
-            cgltf_accessor_read_float(normalAccessor, i, nrm, 3);
-        }
-        if (tangentAccessor) {
-            cgltf_accessor_read_float(tangentAccessor, i, tan, 4);
-        }
-        cgltf_accessor_read_uint(jointsAccessor, i, joints, 4);
-        cgltf_accessor_read_float(weightsAccessor, i, weights, 4);
-
-        Vertex3DSkinned &v = out.vertices[i];
-        v.x = pos[0];
-        v.y = pos[1];
-        v.z = pos[2];
-        v.u = uv[0];
-        v.v = uv[1];
-        v.nx = nrm[0];
-        v.ny = nrm[1];
-        v.nz = nrm[2];
-        v.j0 = static_cast<uint32_t>(joints[0]);
-        v.j1 = static_cast<uint32_t>(joints[1]);
-        v.j2 = static_cast<uint32_t>(joints[2]);
-        v.j3 = static_cast<uint32_t>(joints[3]);
-        v.w0 = weights[0];
-        v.w1 = weights[1];
-        v.w2 = weights[2];
-        v.w3 = weights[3];
-        v.tx = tan[0];
-        v.ty = tan[1];
-        v.tz = tan[2];
-        v.tw = tan[3];
-    }
-
-    const size_t indexCount = prim.indices->count;
-    out.indices.resize(indexCount);
-    for (size_t i = 0; i < indexCount; i++) {
-        out.indices[i] = static_cast<uint32_t>(cgltf_accessor_read_index(prim.indices, i));
+    out.vertices.assign(vertexCount, defaults);
+    const size_t stride = sizeof(Vertex3DSkinned);
+    ReadAttribute(posAccessor, vertexCount, 3, &out.vertices[0].x, stride);
+    if (uvAccessor) {
+        ReadAttribute(uvAccessor, vertexCount, 2, &out.vertices[0].u, stride);
+    }
+    if (normalAccessor) {
+        ReadAttribute(normalAccessor, vertexCount, 3, &out.vertices[0].nx, stride);
     }
+    if (tangentAccessor) {
+        ReadAttribute(tangentAccessor, vertexCount, 4, &out.vertices[0].tx, stride);
+    }
+    ReadJoints(jointsAccessor, out.vertices);
+    ReadAttribute(weightsAccessor, vertexCount, 4, &out.vertices[0].w0, stride);
+
+    ReadIndices(prim.indices, out.indices);
     return true;
 }
 
-// Decode a glTF embedded image into a sampleable Lucky::Texture. Returns
-// nullptr if the image has no buffer view (external URI -- not
-// supported yet) or stb_image rejects the encoded bytes.
-std::unique_ptr<Texture> LoadEmbeddedImage(
-    GraphicsDevice &graphicsDevice, const cgltf_image &image) {
+// Decode a glTF embedded image to RGBA8. Leaves `out` empty if the image
+// has no buffer view (external URI -- not supported yet) or stb_image
+// rejects the encoded bytes; materials then get no texture for it.
+void DecodeEmbeddedImage(const cgltf_image &image, CookedImage &out) {
     if (!image.buffer_view) {
         spdlog::warn("glTF image '{}' has no buffer view (external URI not supported)",
             image.name ? image.name : "(unnamed)");
-        return nullptr;
-    }
-    const void *imgPtr = cgltf_buffer_view_data(image.buffer_view);
-    const auto byteCount = static_cast<uint32_t>(image.buffer_view->size);
-    try {
-        // Lucky::Texture's memory ctor takes a non-const pointer; stb_image
-        // reads but does not write the source bytes, so the const_cast is
-        // safe in practice.
-        return std::make_unique<Texture>(graphicsDevice,
-            const_cast<uint8_t *>(static_cast<const uint8_t *>(imgPtr)),
-            byteCount,
-            TextureFilter::Linear,
-            TextureFormat::Normal);
-    } catch (const std::exception &e) {
+        return;
+    }
+    const auto *encoded = static_cast<const uint8_t *>(cgltf_buffer_view_data(image.buffer_view));
+    int width, height, channels;
+    uint8_t *pixels = stbi_load_from_memory(encoded,
+        static_cast<int>(image.buffer_view->size),
+        &width,
+        &height,
+        &channels,
+        4);
+    if (!pixels) {
         spdlog::warn("Failed to decode glTF image '{}': {}",
             image.name ? image.name : "(unnamed)",
-            e.what());
-        return nullptr;
+            stbi_failure_reason());
+        return;
     }
+    out.width = static_cast<uint32_t>(width);
+    out.height = static_cast<uint32_t>(height);
+    out.pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+    stbi_image_free(pixels);
 }
 
-} // namespace
+// Index of the image a material texture slot samples, or -1.
+int ImageIndex(const cgltf_texture_view &view, const cgltf_data &data) {
+    if (!view.texture || !view.texture->image) {
+        return -1;
+    }
+    const int idx = static_cast<int>(view.texture->image - data.images);
+    return (idx >= 0 && idx < static_cast<int>(data.images_count)) ? idx : -1;
+}
 
-Model::Model(GraphicsDevice &graphicsDevice, const std::string &path) {
+// Everything the Model constructor needs from a glTF file, without
+// touching the GPU. Shared by the constructor and Model::Cook.
+CookedModelData ImportGltf(const std::string &path, ThreadPool *threadPool) {
     cgltf_options options{};
     cgltf_data *raw = nullptr;
     cgltf_result result = cgltf_parse_file(&options, path.c_str(), &raw);
@@ -263,32 +239,13 @@ Model::Model(GraphicsDevice &graphicsDevice, const std::string &path) {
         throw std::runtime_error("Failed to load glTF buffers: " + path);
     }
 
-    // One sampler shared by every material in this model. Linear/repeat
-    // matches the typical glTF authoring assumption; per-sampler glTF
-    // attributes are ignored for now.
-    SamplerDescription sampDesc;
-    sampDesc.filter = SamplerFilter::Linear;
-    sampDesc.mipmapFilter = SamplerFilter::Linear;
-    sampDesc.addressU = SamplerAddressMode::Repeat;
-    sampDesc.addressV = SamplerAddressMode::Repeat;
-    sampDesc.addressW = SamplerAddressMode::Repeat;
-    materialSampler = std::make_unique<Sampler>(graphicsDevice, sampDesc);
-
-    // Decode embedded images into Lucky::Texture instances. textures[i]
-    // may be nullptr if the source image had no buffer view or failed
-    // to decode; materials skip texture pointers in that case.
-    textures.reserve(data->images_count);
-    for (cgltf_size i = 0; i < data->images_count; i++) {
-        textures.push_back(LoadEmbeddedImage(graphicsDevice, data->images[i]));
-    }
+    CookedModelData model;
 
-    // Materials. Reserve to final size so &materials[i] stays stable
-    // through pushes (the SceneObject::material pointer relies on this).
-    materials.reserve(data->materials_count);
+    // Materials.
+    model.materials.reserve(data->materials_count);
     for (cgltf_size m = 0; m < data->materials_count; m++) {
         const cgltf_material &mat = data->materials[m];
-        Material material;
-        material.sampler = materialSampler.get();
+        CookedMaterial material;
 
         if (mat.has_pbr_metallic_roughness) {
             const auto &pbr = mat.pbr_metallic_roughness;
@@ -298,22 +255,8 @@ Model::Model(GraphicsDevice &graphicsDevice, const std::string &path) {
                 pbr.base_color_factor[3]);
             material.metallicFactor = pbr.metallic_factor;
             material.roughnessFactor = pbr.roughness_factor;
-
-            if (pbr.base_color_texture.texture && pbr.base_color_texture.texture->image) {
-                const int idx =
-                    static_cast<int>(pbr.base_color_texture.texture->image - data->images);
-                if (idx >= 0 && idx < static_cast<int>(textures.size())) {
-                    material.baseColorTexture = textures[idx].get();
-                }
-            }
-            if (pbr.metallic_roughness_texture.texture &&
-                pbr.metallic_roughness_texture.texture->image) {
-                const int idx =
-                    static_cast<int>(pbr.metallic_roughness_texture.texture->image - data->images);
-                if (idx >= 0 && idx < static_cast<int>(textures.size())) {
-                    material.metallicRoughnessTexture = textures[idx].get();
-                }
-            }
+            material.baseColorImage = ImageIndex(pbr.base_color_texture, *data);
+            material.metallicRoughnessImage = ImageIndex(pbr.metallic_roughness_texture, *data);
         }
 
         // glTF semantics: emissive_factor is multiplied by the
@@ -323,31 +266,88 @@ Model::Model(GraphicsDevice &graphicsDevice, const std::string &path) {
         // (0,0,0) unless the asset wants uniform glow.)
         material.emissiveFactor =
             glm::vec3(mat.emissive_factor[0], mat.emissive_factor[1], mat.emissive_factor[2]);
-        if (mat.emissive_texture.texture && mat.emissive_texture.texture->image) {
-            const int idx = static_cast<int>(mat.emissive_texture.texture->image - data->images);
-            if (idx >= 0 && idx < static_cast<int>(textures.size())) {
-                material.emissiveTexture = textures[idx].get();
-            }
-        }
+        material.emissiveImage = ImageIndex(mat.emissive_texture, *data);
 
         // Normal map. glTF stores the per-texel scale in
         // normal_texture.scale (default 1); the shader applies it to
         // the xy components of the unpacked normal before perturbing N.
-        if (mat.normal_texture.texture && mat.normal_texture.texture->image) {
-            const int idx = static_cast<int>(mat.normal_texture.texture->image - data->images);
-            if (idx >= 0 && idx < static_cast<int>(textures.size())) {
-                material.normalTexture = textures[idx].get();
-                material.normalScale = mat.normal_texture.scale;
-            }
+        material.normalImage = ImageIndex(mat.normal_texture, *data);
+        if (material.normalImage >= 0) {
+            material.normalScale = mat.normal_texture.scale;
         }
 
-        materials.push_back(material);
+        model.materials.push_back(material);
     }
 
     // One Lucky Mesh / SkinnedMesh per primitive; remember which
     // cgltf_mesh maps to which set so node-mesh references resolve to
     // the correct GPU buffers, and record each primitive's material
-    // index in parallel.
+    // index in parallel. Each primitive's geometry is reordered for the
+    // vertex cache before upload; exporters write it in whatever order
+    // their modeling tool kept it.
+    //
+    // Decoding and optimizing touch only the primitive's own accessors
+    // and output, so they run on `threadPool` one primitive per task,
+    // alongside the image decodes below. The results are gathered on
+    // this thread, in source order, so mesh indices don't depend on
+    // which task finished first.
+    struct PrimitiveBuild {
+        const cgltf_primitive *prim;
+        bool skinned;
+        bool built = false;
+        MeshData meshData;
+        SkinnedMeshData skinnedMeshData;
+    };
+    std::vector<PrimitiveBuild> builds;
+    for (cgltf_size m = 0; m < data->meshes_count; m++) {
+        const cgltf_mesh &cgMesh = data->meshes[m];
+        for (cgltf_size p = 0; p < cgMesh.primitives_count; p++) {
+            PrimitiveBuild build;
+            build.prim = &cgMesh.primitives[p];
+            build.skinned = PrimitiveIsSkinned(*build.prim);
+            builds.push_back(std::move(build));
+        }
+    }
+
+    // Decode embedded images. model.images[i] is left empty if the
+    // source image had no buffer view or failed to decode; materials
+    // skip texture pointers in that case. Images and primitives share
+    // one parallel loop, images first: a large image is usually the
+    // longest single task, so starting them early keeps one from
+    // finishing alone after everything else is done.
+    model.images.resize(data->images_count);
+    const uint32_t imageCount = static_cast<uint32_t>(data->images_count);
+    auto buildPrimitives = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            if (i < imageCount) {
+                DecodeEmbeddedImage(data->images[i], model.images[i]);
+                continue;
+            }
+            PrimitiveBuild &build = builds[i - imageCount];
+            if (build.skinned) {
+                build.built = BuildSkinnedPrimitiveData(*build.prim, build.skinnedMeshData);
+                if (build.built) {
+                    OptimizeMeshData(build.skinnedMeshData);
+                }
+            } else {
+                build.built = BuildPrimitiveData(*build.prim, build.meshData);
+                if (build.built) {
+                    OptimizeMeshData(build.meshData);
+                    GenerateMeshLods(build.meshData);
+                    if (build.meshData.indices.size() / 3 >= MeshletMinTriangles) {
+                        BuildMeshlets(build.meshData);
+                    }
+                }
+            }
+        }
+    };
+    const uint32_t buildCount = imageCount + static_cast<uint32_t>(builds.size());
+    if (threadPool) {
+        threadPool->ParallelFor(buildCount, 1, buildPrimitives);
+    } else {
+        buildPrimitives(0, buildCount);
+    }
+
     struct PrimitiveMapping {
         bool skinned;
         int index; // into meshes if !skinned, else into skinnedMeshes
@@ -359,6 +359,7 @@ Model::Model(GraphicsDevice &graphicsDevice, const std::string &path) {
     std::vector<MeshMapping> meshMap;
     meshMap.reserve(data->meshes_count);
 
+    size_t nextBuild = 0;
     for (cgltf_size m = 0; m < data->meshes_count; m++) {
         const cgltf_mesh &cgMesh = data->meshes[m];
         MeshMapping mapping;
@@ -366,36 +367,33 @@ Model::Model(GraphicsDevice &graphicsDevice, const std::string &path) {
         mapping.primitives.reserve(cgMesh.primitives_count);
 
         for (cgltf_size p = 0; p < cgMesh.primitives_count; p++) {
-            const cgltf_primitive &prim = cgMesh.primitives[p];
+            PrimitiveBuild &build = builds[nextBuild++];
+            if (!build.built) {
+                continue;
+            }
+            const cgltf_primitive &prim = *build.prim;
             const int matIndex =
                 prim.material ? static_cast<int>(prim.material - data->materials) : -1;
 
-            if (PrimitiveIsSkinned(prim)) {
-                SkinnedMeshData meshData;
-                if (!BuildSkinnedPrimitiveData(prim, meshData)) {
-                    continue;
-                }
-                const int idx = static_cast<int>(skinnedMeshes.size());
-                skinnedMeshes.push_back(std::make_unique<SkinnedMesh>(graphicsDevice, meshData));
-                skinnedMeshMaterialIndices.push_back(matIndex);
+            if (build.skinned) {
+                const int idx = static_cast<int>(model.skinnedMeshes.size());
+                model.skinnedMeshes.push_back(std::move(build.skinnedMeshData));
+                model.skinnedMeshMaterials.push_back(matIndex);
                 mapping.primitives.push_back({true, idx});
             } else {
-                MeshData meshData;
-                if (!BuildPrimitiveData(prim, meshData)) {
-                    continue;
-                }
-                const int idx = static_cast<int>(meshes.size());
-                meshes.push_back(std::make_unique<Mesh>(graphicsDevice, meshData));
-                meshMaterialIndices.push_back(matIndex);
+                const int idx = static_cast<int>(model.meshes.size());
+                model.meshes.push_back(std::move(build.meshData));
+                model.meshMaterials.push_back(matIndex);
                 mapping.primitives.push_back({false, idx});
             }
         }
         meshMap.push_back(std::move(mapping));
     }
+    builds.clear();
 
     // Skins. Joint indices reference data->nodes, which is parallel to
     // our `nodes` array, so the indices are interchangeable.
-    skins.reserve(data->skins_count);
+    model.skins.reserve(data->skins_count);
     for (cgltf_size s = 0; s < data->skins_count; s++) {
         const cgltf_skin &cgSkin = data->skins[s];
         Skin skin;
@@ -413,14 +411,14 @@ Model::Model(GraphicsDevice &graphicsDevice, const std::string &path) {
                 skin.inverseBindMatrices[j] = glm::make_mat4(m);
             }
         }
-        skins.push_back(std::move(skin));
+        model.skins.push_back(std::move(skin));
     }
 
     // Node hierarchy.
-    nodes.resize(data->nodes_count);
+    model.nodes.resize(data->nodes_count);
     for (cgltf_size n = 0; n < data->nodes_count; n++) {
         const cgltf_node &cgNode = data->nodes[n];
-        NodeTemplate &dst = nodes[n];
+        NodeTemplate &dst = model.nodes[n];
 
         dst.name = cgNode.name ? cgNode.name : ("node_" + std::to_string(n));
         DecomposeNodeTransform(cgNode, dst);
@@ -444,7 +442,7 @@ Model::Model(GraphicsDevice &graphicsDevice, const std::string &path) {
     }
 
     // Animations.
-    animations.reserve(data->animations_count);
+    model.animations.reserve(data->animations_count);
     for (cgltf_size a = 0; a < data->animations_count; a++) {
         const cgltf_animation &cgAnim = data->animations[a];
         AnimationDef anim;
@@ -508,10 +506,88 @@ Model::Model(GraphicsDevice &graphicsDevice, const std::string &path) {
             anim.channels.push_back(std::move(channel));
         }
 
-        animations.push_back(std::move(anim));
+        model.animations.push_back(std::move(anim));
     }
 
-    spdlog::info("Loaded glTF '{}': {} mesh(es), {} skinned mesh(es), {} skin(s), "
+    return model;
+}
+
+} // namespace
+
+Model::Model(GraphicsDevice &graphicsDevice, const std::string &path, ThreadPool *threadPool,
+    MeshVertexFormat vertexFormat) {
+    // Rigid and skinned primitives are each packed into one MeshArena,
+    // and the meshes are views into it, so the renderer can draw a whole
+    // model with one vertex and index buffer binding. A cooked file
+    // already stores the arenas' contents, so its blobs go to the GPU
+    // straight out of the mapping.
+    if (IsCookedModelFile(path)) {
+        CookedModelFile cooked(path);
+        LoadMaterials(graphicsDevice, cooked.materials, cooked.images);
+        if (!cooked.meshes.ranges.empty()) {
+            meshArena = std::make_unique<MeshArena<Vertex3D>>(graphicsDevice,
+                cooked.meshes.vertices,
+                cooked.meshes.vertexCount,
+                cooked.meshes.indices,
+                cooked.meshes.indexCount,
+                std::move(cooked.meshes.ranges),
+                cooked.meshes.meshlets,
+                cooked.meshes.meshletCount,
+                vertexFormat);
+        }
+        if (!cooked.skinnedMeshes.ranges.empty()) {
+            skinnedMeshArena = std::make_unique<MeshArena<Vertex3DSkinned>>(graphicsDevice,
+                cooked.skinnedMeshes.vertices,
+                cooked.skinnedMeshes.vertexCount,
+                cooked.skinnedMeshes.indices,
+                cooked.skinnedMeshes.indexCount,
+                std::move(cooked.skinnedMeshes.ranges));
+        }
+        meshMaterialIndices = std::move(cooked.meshes.materials);
+        skinnedMeshMaterialIndices = std::move(cooked.skinnedMeshes.materials);
+        nodes = std::move(cooked.nodes);
+        skins = std::move(cooked.skins);
+        animations = std::move(cooked.animations);
+    } else {
+        CookedModelData data = ImportGltf(path, threadPool);
+        std::vector<CookedImageView> images(data.images.size());
+        for (size_t i = 0; i < images.size(); i++) {
+            const CookedImage &image = data.images[i];
+            images[i].width = image.width;
+            images[i].height = image.height;
+            images[i].pixels = image.pixels.empty() ? nullptr : image.pixels.data();
+        }
+        LoadMaterials(graphicsDevice, data.materials, images);
+        if (!data.meshes.empty()) {
+            meshArena =
+                std::make_unique<MeshArena<Vertex3D>>(graphicsDevice, data.meshes, vertexFormat);
+        }
+        if (!data.skinnedMeshes.empty()) {
+            skinnedMeshArena =
+                std::make_unique<MeshArena<Vertex3DSkinned>>(graphicsDevice, data.skinnedMeshes);
+        }
+        meshMaterialIndices = std::move(data.meshMaterials);
+        skinnedMeshMaterialIndices = std::move(data.skinnedMeshMaterials);
+        nodes = std::move(data.nodes);
+        skins = std::move(data.skins);
+        animations = std::move(data.animations);
+    }
+
+    if (meshArena) {
+        meshes.reserve(meshArena->GetRangeCount());
+        for (int i = 0; i < meshArena->GetRangeCount(); i++) {
+            meshes.push_back(std::make_unique<Mesh>(*meshArena, i));
+        }
+    }
+    if (skinnedMeshArena) {
+        skinnedMeshes.reserve(skinnedMeshArena->GetRangeCount());
+        for (int i = 0; i < skinnedMeshArena->GetRangeCount(); i++) {
+            skinnedMeshes.push_back(std::make_unique<SkinnedMesh>(*skinnedMeshArena, i));
+        }
+    }
+    BuildRestPose();
+
+    spdlog::info("Loaded model '{}': {} mesh(es), {} skinned mesh(es), {} skin(s), "
                  "{} material(s), {} texture(s), {} node(s), {} animation(s)",
         path,
         meshes.size(),
@@ -523,6 +599,74 @@ Model::Model(GraphicsDevice &graphicsDevice, const std::string &path) {
         animations.size());
 }
 
+void Model::Cook(
+    const std::string &sourcePath, const std::string &cookedPath, ThreadPool *threadPool) {
+    WriteCookedModel(ImportGltf(sourcePath, threadPool), cookedPath);
+    spdlog::info("Cooked '{}' to '{}'", sourcePath, cookedPath);
+}
+
+void Model::LoadMaterials(GraphicsDevice &graphicsDevice,
+    const std::vector<CookedMaterial> &cookedMaterials,
+    const std::vector<CookedImageView> &images) {
+    // One sampler shared by every material in this model. Linear/repeat
+    // matches the typical glTF authoring assumption; per-sampler glTF
+    // attributes are ignored for now.
+    SamplerDescription sampDesc;
+    sampDesc.filter = SamplerFilter::Linear;
+    sampDesc.mipmapFilter = SamplerFilter::Linear;
+    sampDesc.addressU = SamplerAddressMode::Repeat;
+    sampDesc.addressV = SamplerAddressMode::Repeat;
+    sampDesc.addressW = SamplerAddressMode::Repeat;
+    materialSampler = std::make_unique<Sampler>(graphicsDevice, sampDesc);
+
+    // textures[i] is nullptr for an image that failed to load. The
+    // textures are created empty and filled in one batched upload rather
+    // than one submission each.
+    textures.reserve(images.size());
+    std::vector<TextureUpload> uploads;
+    uploads.reserve(images.size());
+    for (const CookedImageView &image : images) {
+        if (!image.pixels) {
+            textures.push_back(nullptr);
+            continue;
+        }
+        textures.push_back(std::make_unique<Texture>(graphicsDevice,
+            TextureType::Default,
+            image.width,
+            image.height,
+            nullptr,
+            0,
+            TextureFilter::Linear,
+            TextureFormat::Normal));
+        uploads.push_back({textures.back().get(), image.pixels, image.width * image.height * 4});
+    }
+    UploadTextures(graphicsDevice, uploads);
+
+    auto texture = [&](int image) -> Texture * {
+        return image >= 0 ? textures[image].get() : nullptr;
+    };
+
+    // Reserve to final size so &materials[i] stays stable through
+    // pushes (the SceneObject::material pointer relies on this).
+    materials.reserve(cookedMaterials.size());
+    for (const CookedMaterial &cooked : cookedMaterials) {
+        Material material;
+        material.sampler = materialSampler.get();
+        material.baseColorFactor = cooked.baseColorFactor;
+        material.metallicFactor = cooked.metallicFactor;
+        material.roughnessFactor = cooked.roughnessFactor;
+        material.emissiveFactor = cooked.emissiveFactor;
+        material.baseColorTexture = texture(cooked.baseColorImage);
+        material.metallicRoughnessTexture = texture(cooked.metallicRoughnessImage);
+        material.emissiveTexture = texture(cooked.emissiveImage);
+        material.normalTexture = texture(cooked.normalImage);
+        if (material.normalTexture) {
+            material.normalScale = cooked.normalScale;
+        }
+        materials.push_back(material);
+    }
+}
+
 Model::~Model() = default;
 
 int Model::FindAnimation(const std::string &name) const {
@@ -543,46 +687,91 @@ int Model::FindNode(const std::string &name) const {
     return -1;
 }
 
+void Model::BuildRestPose() {
+    restWorldTransforms.assign(nodes.size(), glm::mat4(1.0f));
+    restMeshNodes.clear();
+    restMeshIndices.clear();
+    for (const int i : SortNodesParentFirst(nodes)) {
+        const NodeTemplate &node = nodes[i];
+        const glm::mat4 local = RestLocalTransform(node);
+        restWorldTransforms[i] =
+            node.parentIndex < 0 ? local : restWorldTransforms[node.parentIndex] * local;
+        if (!node.meshIndices.empty()) {
+            RestMeshNode entry;
+            entry.worldTransform = restWorldTransforms[i];
+            entry.firstMesh = static_cast<uint32_t>(restMeshIndices.size());
+            entry.meshCount = static_cast<uint32_t>(node.meshIndices.size());
+            restMeshNodes.push_back(entry);
+            restMeshIndices.insert(
+                restMeshIndices.end(), node.meshIndices.begin(), node.meshIndices.end());
+        }
+    }
+}
+
 void Model::ComputeRestWorldTransforms(
     std::vector<glm::mat4> &out, const glm::mat4 &rootTransform) const {
-    out.assign(nodes.size(), glm::mat4(1.0f));
-    std::vector<bool> computed(nodes.size(), false);
-    auto compute = [&](auto &self, int i) -> void {
-        if (computed[i]) {
-            return;
-        }
-        const NodeTemplate &n = nodes[i];
-        const glm::mat4 local = glm::translate(glm::mat4(1.0f), n.restTranslation) *
-                                glm::mat4_cast(n.restRotation) *
-                                glm::scale(glm::mat4(1.0f), n.restScale);
-        if (n.parentIndex < 0) {
-            out[i] = rootTransform * local;
-        } else {
-            self(self, n.parentIndex);
-            out[i] = out[n.parentIndex] * local;
-        }
-        computed[i] = true;
-    };
-    for (size_t i = 0; i < nodes.size(); i++) {
-        compute(compute, static_cast<int>(i));
+    out.resize(restWorldTransforms.size());
+    for (size_t i = 0; i < restWorldTransforms.size(); i++) {
+        out[i] = rootTransform * restWorldTransforms[i];
     }
 }
 
 void Model::AppendToScene(
     Scene3D &scene, const glm::mat4 &rootTransform, const glm::vec3 &colorTint) {
-    std::vector<glm::mat4> world;
-    ComputeRestWorldTransforms(world, rootTransform);
-    for (size_t i = 0; i < nodes.size(); i++) {
-        const NodeTemplate &node = nodes[i];
-        for (int meshIdx : node.meshIndices) {
-            SceneObject obj;
+    for (const RestMeshNode &node : restMeshNodes) {
+        SceneObject obj;
+        obj.transform = rootTransform * node.worldTransform;
+        obj.color = colorTint;
+        for (uint32_t m = node.firstMesh; m < node.firstMesh + node.meshCount; m++) {
+            const int meshIdx = restMeshIndices[m];
             obj.mesh = meshes[meshIdx].get();
             obj.material = GetMaterialForMesh(meshIdx);
-            obj.transform = world[i];
-            obj.color = colorTint;
             scene.objects.push_back(obj);
         }
     }
 }
 
+void Model::AppendInstancesToScene(
+    Scene3D &scene, const std::vector<glm::mat4> &rootTransforms, const glm::vec3 &colorTint) {
+    scene.objects.reserve(scene.objects.size() + rootTransforms.size() * restMeshIndices.size());
+    for (const glm::mat4 &rootTransform : rootTransforms) {
+        AppendToScene(scene, rootTransform, colorTint);
+    }
+}
+
+void Model::AddToScene(RetainedScene &scene, std::vector<SceneObjectHandle> &handles,
+    const glm::mat4 &rootTransform, const glm::vec3 &colorTint) {
+    for (const RestMeshNode &node : restMeshNodes) {
+        SceneObject obj;
+        obj.transform = rootTransform * node.worldTransform;
+        obj.color = colorTint;
+        for (uint32_t m = node.firstMesh; m < node.firstMesh + node.meshCount; m++) {
+            const int meshIdx = restMeshIndices[m];
+            obj.mesh = meshes[meshIdx].get();
+            obj.material = GetMaterialForMesh(meshIdx);
+            handles.push_back(scene.AddObject(obj));
+        }
+    }
+}
+
+std::vector<int> SortNodesParentFirst(const std::vector<NodeTemplate> &nodes) {
+    std::vector<int> order;
+    order.reserve(nodes.size());
+    std::vector<bool> placed(nodes.size(), false);
+    std::vector<int> chain;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        // Place the node's unplaced ancestors first, root-most first.
+        // Nodes are marked as they join the chain, so a walk around a
+        // cycle stops where it comes back to itself.
+        chain.clear();
+        for (int n = static_cast<int>(i); n >= 0 && !placed[n]; n = nodes[n].parentIndex) {
+            SDL_assert(n < static_cast<int>(nodes.size()));
+            placed[n] = true;
+            chain.push_back(n);
+        }
+        order.insert(order.end(), chain.rbegin(), chain.rend());
+    }
+    return order;
+}
+
 } // namespace Lucky
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <SDL3/SDL_assert.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LUCKY_OCCLUSION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include <Lucky/Mesh.hpp>
+#include <Lucky/OcclusionCuller.hpp>
+
+namespace Lucky {
+
+namespace {
+
+// Clip-space w below which a point counts as on or behind the eye.
+constexpr float MinClipW = 1e-5f;
+
+bool InFrontOfNearPlane(const glm::vec4 &clip) {
+    return clip.w > MinClipW && clip.z >= 0.0f;
+}
+
+// Edge function of the directed edge `a` -> `b` as `A x + B y + C`;
+// positive on the left in a Y-down buffer's counterclockwise sense.
+struct EdgeFunction {
+    float a;
+    float b;
+    float c;
+};
+
+EdgeFunction MakeEdge(const glm::vec3 &from, const glm::vec3 &to) {
+    EdgeFunction edge;
+    edge.a = from.y - to.y;
+    edge.b = to.x - from.x;
+    edge.c = from.x * to.y - from.y * to.x;
+    return edge;
+}
+
+// Returns the last pixel column or row that `coordinate` touches,
+// clamped to `size - 1`. The clamp happens in float so coordinates too
+// large for uint32_t never reach the conversion; std::min returns its
+// first argument for NaN, which clamps that too.
+uint32_t LastPixel(float coordinate, uint32_t size) {
+    return static_cast<uint32_t>(
+        std::max(0.0f, std::min(static_cast<float>(size - 1), coordinate)));
+}
+
+} // namespace
+
+OccluderMesh MakeOccluderMesh(const MeshData &meshData) {
+    OccluderMesh occluder;
+    occluder.positions.reserve(meshData.vertices.size());
+    for (const Vertex3D &vertex : meshData.vertices) {
+        occluder.positions.emplace_back(vertex.x, vertex.y, vertex.z);
+    }
+    occluder.indices = meshData.indices;
+    return occluder;
+}
+
+OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height)
+    : width((width + 3) & ~3u), height(height) {
+    SDL_assert(width > 0 && height > 0);
+    depth.assign(static_cast<size_t>(this->width) * this->height, 1.0f);
+}
+
+void OcclusionCuller::Begin(const glm::mat4 &viewProjection) {
+    this->viewProjection = viewProjection;
+    std::fill(depth.begin(), depth.end(), 1.0f);
+}
+
+void OcclusionCuller::RasterizeOccluder(const OccluderMesh &occluder, const glm::mat4 &transform) {
+    const glm::mat4 toClip = viewProjection * transform;
+    clipPositions.resize(occluder.positions.size());
+    for (size_t i = 0; i < occluder.positions.size(); i++) {
+        clipPositions[i] = toClip * glm::vec4(occluder.positions[i], 1.0f);
+    }
+
+    // Pixel centers sit at half-integer coordinates; y grows downward.
+    const float halfWidth = static_cast<float>(width) * 0.5f;
+    const float halfHeight = static_cast<float>(height) * 0.5f;
+    auto toScreen = [&](const glm::vec4 &clip) {
+        const float invW = 1.0f / clip.w;
+        return glm::vec3((clip.x * invW + 1.0f) * halfWidth,
+            (1.0f - clip.y * invW) * halfHeight,
+            clip.z * invW);
+    };
+
+    SDL_assert(occluder.indices.size() % 3 == 0);
+    for (size_t i = 0; i + 2 < occluder.indices.size(); i += 3) {
+        const glm::vec4 &a = clipPositions[occluder.indices[i]];
+        const glm::vec4 &b = clipPositions[occluder.indices[i + 1]];
+        const glm::vec4 &c = clipPositions[occluder.indices[i + 2]];
+        if (!InFrontOfNearPlane(a) || !InFrontOfNearPlane(b) || !InFrontOfNearPlane(c)) {
+            continue;
+        }
+        RasterizeTriangle(toScreen(a), toScreen(b), toScreen(c));
+    }
+}
+
+void OcclusionCuller::RasterizeTriangle(
+    const glm::vec3 &v0, const glm::vec3 &v1, const glm::vec3 &v2) {
+    // e0 is opposite v0, and so on, so each is that vertex's barycentric
+    // weight scaled by the doubled area. Both windings are drawn.
+    EdgeFunction e0 = MakeEdge(v1, v2);
+    EdgeFunction e1 = MakeEdge(v2, v0);
+    EdgeFunction e2 = MakeEdge(v0, v1);
+    float area = e2.a * v2.x + e2.b * v2.y + e2.c;
+    if (area == 0.0f || !std::isfinite(area)) {
+        return;
+    }
+    if (area < 0.0f) {
+        for (EdgeFunction *edge : {&e0, &e1, &e2}) {
+            edge->a = -edge->a;
+            edge->b = -edge->b;
+            edge->c = -edge->c;
+        }
+        area = -area;
+    }
+    const float invArea = 1.0f / area;
+
+    // Depth as a plane over the screen: z = zA x + zB y + zC.
+    const float zA = (e0.a * v0.z + e1.a * v1.z + e2.a * v2.z) * invArea;
+    const float zB = (e0.b * v0.z + e1.b * v1.z + e2.b * v2.z) * invArea;
+    const float zC = (e0.c * v0.z + e1.c * v1.z + e2.c * v2.z) * invArea;
+
+    const float minX = std::min({v0.x, v1.x, v2.x});
+    const float maxX = std::max({v0.x, v1.x, v2.x});
+    const float minY = std::min({v0.y, v1.y, v2.y});
+    const float maxY = std::max({v0.y, v1.y, v2.y});
+    if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(width) ||
+        minY >= static_cast<float>(height)) {
+        return;
+    }
+    // Columns start on a multiple of four so SIMD groups never straddle
+    // a row end.
+    const uint32_t x0 = static_cast<uint32_t>(std::max(0.0f, std::floor(minX))) & ~3u;
+    const uint32_t x1 = LastPixel(maxX, width);
+    const uint32_t y0 = static_cast<uint32_t>(std::max(0.0f, std::floor(minY)));
+    const uint32_t y1 = LastPixel(maxY, height);
+
+    for (uint32_t y = y0; y <= y1; y++) {
+        const float py = static_cast<float>(y) + 0.5f;
+        const float row0 = e0.b * py + e0.c;
+        const float row1 = e1.b * py + e1.c;
+        const float row2 = e2.b * py + e2.c;
+        const float rowZ = zB * py + zC;
+        float *depthRow = &depth[static_cast<size_t>(y) * width];
+
+#if LUCKY_OCCLUSION_SSE2
+        const __m128 laneOffsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+        const __m128 zero = _mm_setzero_ps();
+        for (uint32_t x = x0; x <= x1; x += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+            const __m128 w0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e0.a), px), _mm_set1_ps(row0));
+            const __m128 w1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e1.a), px), _mm_set1_ps(row1));
+            const __m128 w2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e2.a), px), _mm_set1_ps(row2));
+            const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(w0, zero),
+                                                 _mm_cmpge_ps(w1, zero)),
+                _mm_cmpge_ps(w2, zero));
+            if (_mm_movemask_ps(inside) == 0) {
+                continue;
+            }
+            const __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(zA), px), _mm_set1_ps(rowZ));
+            const __m128 stored = _mm_loadu_ps(depthRow + x);
+            const __m128 nearer = _mm_min_ps(stored, z);
+            _mm_storeu_ps(depthRow + x,
+                _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, stored)));
+        }
+#else
+        for (uint32_t x = x0; x <= x1; x++) {
+            const float px = static_cast<float>(x) + 0.5f;
+            if (e0.a * px + row0 >= 0.0f && e1.a * px + row1 >= 0.0f &&
+                e2.a * px + row2 >= 0.0f) {
+                const float z = zA * px + rowZ;
+                depthRow[x] = std::min(depthRow[x], z);
+            }
+        }
+#endif
+    }
+}
+
+bool OcclusionCuller::IsVisible(const BoundingBox &worldBounds) const {
+    if (worldBounds.IsEmpty()) {
+        return false;
+    }
+
+    // Screen rectangle and nearest depth of the eight corners.
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxY = std::numeric_limits<float>::lowest();
+    float nearestZ = std::numeric_limits<float>::max();
+    for (int corner = 0; corner < 8; corner++) {
+        const glm::vec3 point((corner & 1) ? worldBounds.max.x : worldBounds.min.x,
+            (corner & 2) ? worldBounds.max.y : worldBounds.min.y,
+            (corner & 4) ? worldBounds.max.z : worldBounds.min.z);
+        const glm::vec4 clip = viewProjection * glm::vec4(point, 1.0f);
+        if (!InFrontOfNearPlane(clip)) {
+            return true;
+        }
+        const float invW = 1.0f / clip.w;
+        const float x = (clip.x * invW + 1.0f) * static_cast<float>(width) * 0.5f;
+        const float y = (1.0f - clip.y * invW) * static_cast<float>(height) * 0.5f;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        nearestZ = std::min(nearestZ, clip.z * invW);
+    }
+    if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(width) ||
+        minY >= static_cast<float>(height)) {
+        // Off the buffer entirely; frustum culling is the caller's job.
+        return true;
+    }
+
+    // Every pixel the rectangle touches, not just covered centers.
+    const uint32_t x0 = static_cast<uint32_t>(std::max(0.0f, std::floor(minX)));
+    const uint32_t x1 = LastPixel(maxX, width);
+    const uint32_t y0 = static_cast<uint32_t>(std::max(0.0f, std::floor(minY)));
+    const uint32_t y1 = LastPixel(maxY, height);
+
+    for (uint32_t y = y0; y <= y1; y++) {
+        const float *depthRow = &depth[static_cast<size_t>(y) * width];
+#if LUCKY_OCCLUSION_SSE2
+        const __m128 boxZ = _mm_set1_ps(nearestZ);
+        for (uint32_t x = x0 & ~3u; x <= x1; x += 4) {
+            int lanes = _mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(depthRow + x), boxZ));
+            // Ignore lanes left of x0 or right of x1.
+            if (x < x0) {
+                lanes &= ~((1 << (x0 - x)) - 1);
+            }
+            if (x + 3 > x1) {
+                lanes &= (1 << (x1 - x + 1)) - 1;
+            }
+            if (lanes != 0) {
+                return true;
+            }
+        }
+#else
+        for (uint32_t x = x0; x <= x1; x++) {
+            if (depthRow[x] >= nearestZ) {
+                return true;
+            }
+        }
+#endif
+    }
+    return false;
+}
+
+} // namespace Lucky
@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <atomic>
+
+#include <SDL3/SDL_assert.h>
+
+#include <Lucky/RetainedScene.hpp>
+
+namespace Lucky {
+
+namespace {
+
+constexpr uint32_t NoIndex = 0xFFFFFFFFu;
+
+// Swap-removes `vector[index]`, keeping the vector dense.
+template <typename T> void SwapRemove(std::vector<T> &vector, uint32_t index) {
+    if (index + 1 != vector.size()) {
+        vector[index] = std::move(vector.back());
+    }
+    vector.pop_back();
+}
+
+} // namespace
+
+uint32_t RetainedScene::SlotTable::Add(uint32_t &generation) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(indices.size());
+        indices.push_back(NoIndex);
+        generations.push_back(1);
+    }
+    indices[slot] = static_cast<uint32_t>(slotsByIndex.size());
+    slotsByIndex.push_back(slot);
+    generation = generations[slot];
+    return slot;
+}
+
+uint32_t RetainedScene::SlotTable::Find(uint32_t slot, uint32_t generation) const {
+    if (slot >= indices.size() || generations[slot] != generation) {
+        return NoIndex;
+    }
+    return indices[slot];
+}
+
+uint32_t RetainedScene::SlotTable::Remove(uint32_t slot) {
+    const uint32_t index = indices[slot];
+    const uint32_t last = static_cast<uint32_t>(slotsByIndex.size() - 1);
+    if (index != last) {
+        const uint32_t movedSlot = slotsByIndex[last];
+        indices[movedSlot] = index;
+        slotsByIndex[index] = movedSlot;
+    }
+    slotsByIndex.pop_back();
+
+    indices[slot] = NoIndex;
+    generations[slot]++;
+    freeSlots.push_back(slot);
+    return index;
+}
+
+void RetainedScene::SlotTable::Clear() {
+    for (uint32_t slot : slotsByIndex) {
+        indices[slot] = NoIndex;
+        generations[slot]++;
+        freeSlots.push_back(slot);
+    }
+    slotsByIndex.clear();
+}
+
+SceneObjectHandle RetainedScene::AddObject(const SceneObject &object) {
+    SceneObjectHandle handle;
+    handle.slot = objectSlots.Add(handle.generation);
+    scene.objects.push_back(object);
+    objectChanged.push_back(false);
+    MarkChanged(static_cast<uint32_t>(scene.objects.size() - 1));
+    return handle;
+}
+
+bool RetainedScene::RemoveObject(SceneObjectHandle handle) {
+    if (!Contains(handle)) {
+        return false;
+    }
+    const uint32_t index = objectSlots.Remove(handle.slot);
+    const uint32_t last = static_cast<uint32_t>(scene.objects.size() - 1);
+
+    // The last position disappears; drop it from the change list before
+    // the moved object marks its new position.
+    if (objectChanged[last]) {
+        changedObjects.erase(std::find(changedObjects.begin(), changedObjects.end(), last));
+    }
+    SwapRemove(scene.objects, index);
+    objectChanged.pop_back();
+    if (index != last) {
+        MarkChanged(index);
+    }
+    return true;
+}
+
+bool RetainedScene::Contains(SceneObjectHandle handle) const {
+    return objectSlots.Find(handle.slot, handle.generation) != NoIndex;
+}
+
+const SceneObject &RetainedScene::GetObject(SceneObjectHandle handle) const {
+    SDL_assert(Contains(handle));
+    return scene.objects[GetObjectIndex(handle)];
+}
+
+void RetainedScene::UpdateObject(SceneObjectHandle handle, const SceneObject &object) {
+    const uint32_t index = objectSlots.Find(handle.slot, handle.generation);
+    SDL_assert(index != NoIndex);
+    if (index == NoIndex) {
+        return;
+    }
+    scene.objects[index] = object;
+    MarkChanged(index);
+}
+
+void RetainedScene::SetObjectTransform(SceneObjectHandle handle, const glm::mat4 &transform) {
+    const uint32_t index = objectSlots.Find(handle.slot, handle.generation);
+    SDL_assert(index != NoIndex);
+    if (index == NoIndex) {
+        return;
+    }
+    scene.objects[index].transform = transform;
+    MarkChanged(index);
+}
+
+uint32_t RetainedScene::GetObjectIndex(SceneObjectHandle handle) const {
+    const uint32_t index = objectSlots.Find(handle.slot, handle.generation);
+    SDL_assert(index != NoIndex);
+    return index;
+}
+
+SkinnedSceneObjectHandle RetainedScene::AddSkinnedObject(const SkinnedSceneObject &object) {
+    SkinnedSceneObjectHandle handle;
+    handle.slot = skinnedSlots.Add(handle.generation);
+    scene.skinnedObjects.push_back(object);
+    return handle;
+}
+
+bool RetainedScene::RemoveSkinnedObject(SkinnedSceneObjectHandle handle) {
+    if (!Contains(handle)) {
+        return false;
+    }
+    SwapRemove(scene.skinnedObjects, skinnedSlots.Remove(handle.slot));
+    return true;
+}
+
+bool RetainedScene::Contains(SkinnedSceneObjectHandle handle) const {
+    return skinnedSlots.Find(handle.slot, handle.generation) != NoIndex;
+}
+
+void RetainedScene::UpdateSkinnedObject(
+    SkinnedSceneObjectHandle handle, const SkinnedSceneObject &object) {
+    const uint32_t index = skinnedSlots.Find(handle.slot, handle.generation);
+    SDL_assert(index != NoIndex);
+    if (index == NoIndex) {
+        return;
+    }
+    scene.skinnedObjects[index] = object;
+}
+
+void RetainedScene::Clear() {
+    objectSlots.Clear();
+    skinnedSlots.Clear();
+    scene.objects.clear();
+    scene.skinnedObjects.clear();
+    changedObjects.clear();
+    objectChanged.clear();
+    previousChangeEpoch = 0;
+    changeEpoch = NextChangeEpoch();
+}
+
+void RetainedScene::ClearChanges() {
+    for (uint32_t index : changedObjects) {
+        objectChanged[index] = false;
+    }
+    changedObjects.clear();
+    previousChangeEpoch = changeEpoch;
+    changeEpoch = NextChangeEpoch();
+}
+
+uint64_t RetainedScene::NextChangeEpoch() {
+    // Shared by every scene, so a consumer can't mistake a new scene for
+    // one it saw before, even at the same address.
+    static std::atomic<uint64_t> nextEpoch{1};
+    return nextEpoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RetainedScene::MarkChanged(uint32_t index) {
+    if (!objectChanged[index]) {
+        objectChanged[index] = true;
+        changedObjects.push_back(index);
+    }
+}
+
+} // namespace Lucky
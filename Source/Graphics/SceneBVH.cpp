@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <functional>
+
+#include <SDL3/SDL_assert.h>
+
+#include <Lucky/Mesh.hpp>
+#include <Lucky/Scene3D.hpp>
+#include <Lucky/SceneBVH.hpp>
+
+namespace Lucky {
+
+namespace {
+
+// Median splits halve the item count at every level, so even 2^32 items
+// stay well inside this.
+constexpr int MaxDepth = 64;
+
+BoundingBox ObjectWorldBounds(const SceneObject &object) {
+    return object.mesh ? TransformBounds(object.mesh->GetBounds(), object.transform)
+                       : BoundingBox{};
+}
+
+bool SameBounds(const BoundingBox &a, const BoundingBox &b) {
+    return a.min == b.min && a.max == b.max;
+}
+
+// Slab test. Axes the ray runs parallel to are handled separately so an
+// origin lying exactly on a slab plane can't produce 0 * inf.
+bool IntersectRay(const BoundingBox &box, const Ray &ray, float maxDistance, float &entry) {
+    if (box.IsEmpty()) {
+        return false;
+    }
+    float tNear = 0.0f;
+    float tFar = maxDistance;
+    for (int axis = 0; axis < 3; axis++) {
+        const float origin = ray.origin[axis];
+        const float direction = ray.direction[axis];
+        if (direction == 0.0f) {
+            if (origin < box.min[axis] || origin > box.max[axis]) {
+                return false;
+            }
+            continue;
+        }
+        const float inverse = 1.0f / direction;
+        float t0 = (box.min[axis] - origin) * inverse;
+        float t1 = (box.max[axis] - origin) * inverse;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        tNear = std::max(tNear, t0);
+        tFar = std::min(tFar, t1);
+        if (tNear > tFar) {
+            return false;
+        }
+    }
+    entry = tNear;
+    return true;
+}
+
+} // namespace
+
+void SceneBVH::Build(const std::vector<BoundingBox> &itemBounds) {
+    this->itemBounds = itemBounds;
+    const uint32_t itemCount = static_cast<uint32_t>(itemBounds.size());
+
+    nodes.clear();
+    dirtyNodes.clear();
+    items.resize(itemCount);
+    itemLeaves.assign(itemCount, 0);
+    centers.resize(itemCount);
+    for (uint32_t i = 0; i < itemCount; i++) {
+        items[i] = i;
+        centers[i] = itemBounds[i].IsEmpty() ? glm::vec3(0.0f) : itemBounds[i].GetCenter();
+    }
+    if (itemCount == 0) {
+        return;
+    }
+
+    nodes.emplace_back();
+    BuildNode(0, 0, itemCount);
+}
+
+void SceneBVH::Build(const Scene3D &scene) {
+    std::vector<BoundingBox> bounds(scene.objects.size());
+    for (size_t i = 0; i < scene.objects.size(); i++) {
+        bounds[i] = ObjectWorldBounds(scene.objects[i]);
+    }
+    Build(bounds);
+}
+
+void SceneBVH::BuildNode(uint32_t node, uint32_t begin, uint32_t end) {
+    const uint32_t count = end - begin;
+    if (count <= MaxLeafItems) {
+        nodes[node].first = begin;
+        nodes[node].count = count;
+        for (uint32_t i = begin; i < end; i++) {
+            itemLeaves[items[i]] = node;
+        }
+        RefitNode(nodes[node]);
+        return;
+    }
+
+    // Split at the median center along the axis the centers spread
+    // furthest on; halving the count keeps the depth logarithmic no
+    // matter how the items are distributed.
+    BoundingBox centerBounds;
+    for (uint32_t i = begin; i < end; i++) {
+        ExpandBounds(centerBounds, centers[items[i]]);
+    }
+    const glm::vec3 spread = centerBounds.max - centerBounds.min;
+    int axis = 0;
+    if (spread.y > spread[axis]) {
+        axis = 1;
+    }
+    if (spread.z > spread[axis]) {
+        axis = 2;
+    }
+    const uint32_t middle = begin + count / 2;
+    std::nth_element(items.begin() + begin,
+        items.begin() + middle,
+        items.begin() + end,
+        [&](uint32_t a, uint32_t b) { return centers[a][axis] < centers[b][axis]; });
+
+    const uint32_t left = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+    nodes.emplace_back();
+    nodes[node].first = left;
+    nodes[node].count = 0;
+    nodes[left].parent = node;
+    nodes[left + 1].parent = node;
+    BuildNode(left, begin, middle);
+    BuildNode(left + 1, middle, end);
+    RefitNode(nodes[node]);
+}
+
+void SceneBVH::SetItemBounds(uint32_t item, const BoundingBox &bounds) {
+    SDL_assert(item < itemBounds.size());
+    itemBounds[item] = bounds;
+
+    // Mark the path to the root; a marked node's ancestors already are.
+    uint32_t node = itemLeaves[item];
+    while (!nodes[node].dirty) {
+        nodes[node].dirty = true;
+        dirtyNodes.push_back(node);
+        if (node == 0) {
+            break;
+        }
+        node = nodes[node].parent;
+    }
+}
+
+void SceneBVH::UpdateItemBounds(const Scene3D &scene) {
+    SDL_assert(scene.objects.size() == itemBounds.size());
+    const uint32_t count =
+        std::min(static_cast<uint32_t>(scene.objects.size()), GetItemCount());
+    for (uint32_t i = 0; i < count; i++) {
+        const BoundingBox bounds = ObjectWorldBounds(scene.objects[i]);
+        if (!SameBounds(bounds, itemBounds[i])) {
+            SetItemBounds(i, bounds);
+        }
+    }
+}
+
+void SceneBVH::Refit() {
+    // Children always sit after their parents, so refitting in
+    // decreasing index order updates every child before its parent.
+    std::sort(dirtyNodes.begin(), dirtyNodes.end(), std::greater<uint32_t>());
+    for (uint32_t node : dirtyNodes) {
+        RefitNode(nodes[node]);
+        nodes[node].dirty = false;
+    }
+    dirtyNodes.clear();
+}
+
+void SceneBVH::RefitNode(Node &node) const {
+    BoundingBox bounds;
+    if (node.IsLeaf()) {
+        for (uint32_t i = node.first; i < node.first + node.count; i++) {
+            bounds = MergeBounds(bounds, itemBounds[items[i]]);
+        }
+    } else {
+        bounds = MergeBounds(nodes[node.first].bounds, nodes[node.first + 1].bounds);
+    }
+    node.bounds = bounds;
+}
+
+template <typename Overlaps>
+void SceneBVH::Query(const Overlaps &overlaps, std::vector<uint32_t> &results) const {
+    if (nodes.empty()) {
+        return;
+    }
+    uint32_t stack[MaxDepth * 2];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node &node = nodes[stack[--top]];
+        if (node.bounds.IsEmpty() || !overlaps(node.bounds)) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                const uint32_t item = items[i];
+                if (!itemBounds[item].IsEmpty() && overlaps(itemBounds[item])) {
+                    results.push_back(item);
+                }
+            }
+        } else {
+            SDL_assert(top + 2 <= MaxDepth * 2);
+            stack[top++] = node.first;
+            stack[top++] = node.first + 1;
+        }
+    }
+}
+
+void SceneBVH::QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &results) const {
+    Query([&](const BoundingBox &box) { return IntersectsFrustum(box, frustum); }, results);
+}
+
+void SceneBVH::QuerySphere(
+    const glm::vec3 &center, float radius, std::vector<uint32_t> &results) const {
+    Query([&](const BoundingBox &box) { return IntersectsSphere(box, center, radius); },
+        results);
+}
+
+void SceneBVH::QueryRay(const Ray &ray, float maxDistance, std::vector<uint32_t> &results) const {
+    Query(
+        [&](const BoundingBox &box) {
+            float entry;
+            return IntersectRay(box, ray, maxDistance, entry);
+        },
+        results);
+}
+
+bool SceneBVH::Raycast(const Ray &ray, float maxDistance, SceneBVHHit &hit) const {
+    if (nodes.empty()) {
+        return false;
+    }
+
+    // Nearest-first: the closer child is visited first, and anything
+    // entered beyond the best hit so far is skipped.
+    bool found = false;
+    float nearest = maxDistance;
+    struct Entry {
+        uint32_t node;
+        float distance;
+    };
+    Entry stack[MaxDepth * 2];
+    int top = 0;
+    float rootEntry;
+    if (!IntersectRay(nodes[0].bounds, ray, nearest, rootEntry)) {
+        return false;
+    }
+    stack[top++] = {0, rootEntry};
+    while (top > 0) {
+        const Entry entry = stack[--top];
+        if (entry.distance > nearest) {
+            continue;
+        }
+        const Node &node = nodes[entry.node];
+        if (node.IsLeaf()) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                float distance;
+                if (IntersectRay(itemBounds[items[i]], ray, nearest, distance) &&
+                    (!found || distance < nearest)) {
+                    found = true;
+                    nearest = distance;
+                    hit.item = items[i];
+                    hit.distance = distance;
+                }
+            }
+            continue;
+        }
+
+        Entry children[2];
+        int childCount = 0;
+        for (uint32_t child = node.first; child < node.first + 2; child++) {
+            float distance;
+            if (IntersectRay(nodes[child].bounds, ray, nearest, distance)) {
+                children[childCount++] = {child, distance};
+            }
+        }
+        if (childCount == 2 && children[0].distance < children[1].distance) {
+            std::swap(children[0], children[1]);
+        }
+        SDL_assert(top + childCount <= MaxDepth * 2);
+        for (int c = 0; c < childCount; c++) {
+            stack[top++] = children[c];
+        }
+    }
+    return found;
+}
+
+} // namespace Lucky
@@ -0,0 +1,141 @@
+#include <algorithm>
+
+#include <SDL3/SDL_assert.h>
+
+#include <Lucky/ShadowAtlas.hpp>
+
+namespace Lucky {
+
+namespace {
+
+bool IsPowerOfTwo(uint32_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+// Gathers the even bits of `code` into the low half: the x (or, shifted
+// by one, the y) coordinate of a Morton code.
+uint32_t CompactBits(uint32_t code) {
+    code &= 0x55555555u;
+    code = (code | (code >> 1)) & 0x33333333u;
+    code = (code | (code >> 2)) & 0x0F0F0F0Fu;
+    code = (code | (code >> 4)) & 0x00FF00FFu;
+    code = (code | (code >> 8)) & 0x0000FFFFu;
+    return code;
+}
+
+// Index of the least important surviving request, optionally only among
+// those that can still be halved. Later requests lose ties. Returns -1
+// if there is none.
+int FindLeastImportant(const std::vector<ShadowTileRequest> &requests,
+    const std::vector<uint32_t> &sizes, uint32_t minTileSize, bool shrinkableOnly) {
+    int result = -1;
+    for (size_t i = 0; i < requests.size(); i++) {
+        if (sizes[i] == 0 || (shrinkableOnly && sizes[i] <= minTileSize)) {
+            continue;
+        }
+        if (result < 0 || requests[i].priority <= requests[result].priority) {
+            result = static_cast<int>(i);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+ShadowAtlasLayout PackShadowAtlas(const std::vector<ShadowTileRequest> &requests,
+    uint32_t atlasSize, uint32_t minTileSize, uint32_t maxTiles) {
+    SDL_assert(IsPowerOfTwo(atlasSize));
+    SDL_assert(IsPowerOfTwo(minTileSize) && minTileSize <= atlasSize);
+
+    // Clamp each request into range; zero marks a dropped request.
+    std::vector<uint32_t> sizes(requests.size(), 0);
+    for (size_t i = 0; i < requests.size(); i++) {
+        const ShadowTileRequest &request = requests[i];
+        if (request.size == 0 || request.count == 0) {
+            continue;
+        }
+        SDL_assert(IsPowerOfTwo(request.size));
+        sizes[i] = std::clamp(request.size, minTileSize, atlasSize);
+    }
+
+    // Shrink, then drop, the least important requests until everything
+    // fits. Areas are counted in minimum-size cells.
+    const uint64_t atlasEdge = atlasSize / minTileSize;
+    const uint64_t atlasCells = atlasEdge * atlasEdge;
+    for (;;) {
+        uint64_t cells = 0;
+        uint32_t tileCount = 0;
+        for (size_t i = 0; i < requests.size(); i++) {
+            if (sizes[i] != 0) {
+                const uint64_t edge = sizes[i] / minTileSize;
+                cells += edge * edge * requests[i].count;
+                tileCount += requests[i].count;
+            }
+        }
+        if (cells <= atlasCells && tileCount <= maxTiles) {
+            break;
+        }
+
+        int victim = -1;
+        if (tileCount <= maxTiles) {
+            victim = FindLeastImportant(requests, sizes, minTileSize, true);
+            if (victim >= 0) {
+                sizes[victim] /= 2;
+                continue;
+            }
+        }
+        victim = FindLeastImportant(requests, sizes, minTileSize, false);
+        SDL_assert(victim >= 0);
+        sizes[victim] = 0;
+    }
+
+    // Place the survivors largest first, walking the Morton cursor.
+    std::vector<uint32_t> order;
+    for (size_t i = 0; i < requests.size(); i++) {
+        if (sizes[i] != 0) {
+            order.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return sizes[a] > sizes[b];
+    });
+
+    std::vector<std::vector<ShadowAtlasTile>> placed(requests.size());
+    uint32_t cursor = 0;
+    for (uint32_t index : order) {
+        const uint32_t edge = sizes[index] / minTileSize;
+        for (uint32_t t = 0; t < requests[index].count; t++) {
+            ShadowAtlasTile tile;
+            tile.x = CompactBits(cursor) * minTileSize;
+            tile.y = CompactBits(cursor >> 1) * minTileSize;
+            tile.size = sizes[index];
+            placed[index].push_back(tile);
+            cursor += edge * edge;
+        }
+    }
+
+    ShadowAtlasLayout layout;
+    layout.firstTile.assign(requests.size(), -1);
+    for (size_t i = 0; i < requests.size(); i++) {
+        if (placed[i].empty()) {
+            continue;
+        }
+        layout.firstTile[i] = static_cast<int>(layout.tiles.size());
+        layout.tiles.insert(layout.tiles.end(), placed[i].begin(), placed[i].end());
+    }
+    return layout;
+}
+
+uint32_t ShadowTileSizeForCoverage(
+    float coveragePixels, uint32_t minTileSize, uint32_t maxTileSize) {
+    SDL_assert(IsPowerOfTwo(minTileSize) && IsPowerOfTwo(maxTileSize));
+    SDL_assert(minTileSize <= maxTileSize);
+
+    uint32_t size = minTileSize;
+    while (size < maxTileSize && static_cast<float>(size) < coveragePixels) {
+        size *= 2;
+    }
+    return size;
+}
+
+} // namespace Lucky
@@ -1,14 +1,23 @@
 #include <SDL3/SDL_assert.h>
 
+#include <glm/glm.hpp>
+
 #include <Lucky/SkinnedMesh.hpp>
 
 namespace Lucky {
 
 SkinnedMesh::SkinnedMesh(GraphicsDevice &graphicsDevice, const Vertex3DSkinned *vertices,
     uint32_t vertexCount, const uint32_t *indices, uint32_t indexCount)
-    : vertexBuffer(graphicsDevice, vertices, vertexCount),
-      indexBuffer(graphicsDevice, indices, indexCount), vertexCount(vertexCount),
+    : vertexBuffer(std::make_unique<VertexBuffer<Vertex3DSkinned>>(
+          graphicsDevice, vertices, vertexCount)),
+      indexBuffer(
+          std::make_unique<CompactIndexBuffer>(graphicsDevice, indices, indexCount, vertexCount)),
+      vertexGpuBuffer(vertexBuffer->GetGPUBuffer()), indexGpuBuffer(indexBuffer->GetGPUBuffer()),
+      indexElementSize(indexBuffer->GetElementSize()), vertexCount(vertexCount),
       indexCount(indexCount) {
+    for (uint32_t i = 0; i < vertexCount; i++) {
+        ExpandBounds(bounds, glm::vec3(vertices[i].x, vertices[i].y, vertices[i].z));
+    }
 }
 
 SkinnedMesh::SkinnedMesh(GraphicsDevice &graphicsDevice, const SkinnedMeshData &data)
@@ -18,4 +27,16 @@ SkinnedMesh::SkinnedMesh(GraphicsDevice &graphicsDevice, const SkinnedMeshData &
     SDL_assert(!data.indices.empty());
 }
 
+SkinnedMesh::SkinnedMesh(const MeshArena<Vertex3DSkinned> &arena, int rangeIndex) {
+    const MeshArenaRange &range = arena.GetRange(rangeIndex);
+    vertexGpuBuffer = arena.GetVertexBuffer();
+    indexGpuBuffer = arena.GetIndexBuffer();
+    indexElementSize = arena.GetIndexElementSize();
+    firstIndex = range.firstIndex;
+    baseVertex = range.baseVertex;
+    vertexCount = range.vertexCount;
+    indexCount = range.indexCount;
+    bounds = range.bounds;
+}
+
 } // namespace Lucky
@@ -32,6 +32,18 @@ uint32_t ExpectedByteSize(uint32_t width, uint32_t height, TextureFormat format)
     return static_cast<uint32_t>(bytes);
 }
 
+// Staging memory per UploadTextures batch.
+constexpr uint64_t MaxUploadBatchBytes = 64ull << 20;
+
+// Each texture's data starts on this boundary in a shared transfer
+// buffer, which satisfies D3D12's placement alignment without SDL
+// having to copy it to an aligned buffer first.
+constexpr uint64_t UploadOffsetAlignment = 512;
+
+uint64_t AlignUploadOffset(uint64_t offset) {
+    return (offset + UploadOffsetAlignment - 1) & ~(UploadOffsetAlignment - 1);
+}
+
 } // namespace
 
 Texture::Texture(GraphicsDevice &graphicsDevice, const std::string &filename,
@@ -294,4 +306,100 @@ void Texture::SetTextureFilter(TextureFilter filter) {
     CreateSampler(filter);
 }
 
+void UploadTextures(GraphicsDevice &graphicsDevice, const std::vector<TextureUpload> &uploads) {
+    SDL_GPUDevice *device = graphicsDevice.GetDevice();
+
+    size_t begin = 0;
+    while (begin < uploads.size()) {
+        // Fill the batch up to the cap, but always take at least one
+        // upload so an oversized texture still goes through.
+        uint64_t batchBytes = 0;
+        size_t end = begin;
+        while (end < uploads.size()) {
+            const TextureUpload &upload = uploads[end];
+            SDL_assert(upload.texture != nullptr);
+            SDL_assert(upload.pixelData != nullptr);
+            SDL_assert(upload.dataLength == ExpectedByteSize(upload.texture->GetWidth(),
+                                                upload.texture->GetHeight(),
+                                                upload.texture->GetTextureFormat()));
+            const uint64_t nextBytes = AlignUploadOffset(batchBytes) + upload.dataLength;
+            if (end > begin && nextBytes > MaxUploadBatchBytes) {
+                break;
+            }
+            batchBytes = nextBytes;
+            end++;
+        }
+        if (batchBytes > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Texture upload exceeds 4 GiB transfer limit");
+        }
+
+        SDL_GPUTransferBufferCreateInfo tbCI;
+        SDL_zero(tbCI);
+        tbCI.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+        tbCI.size = static_cast<uint32_t>(batchBytes);
+
+        SDL_GPUTransferBuffer *transferBuffer = SDL_CreateGPUTransferBuffer(device, &tbCI);
+        if (!transferBuffer) {
+            spdlog::error("Failed to create transfer buffer: {}", SDL_GetError());
+            throw std::runtime_error("Failed to create transfer buffer for texture upload");
+        }
+
+        auto *mapped =
+            static_cast<uint8_t *>(SDL_MapGPUTransferBuffer(device, transferBuffer, false));
+        if (!mapped) {
+            SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+            spdlog::error("Failed to map transfer buffer: {}", SDL_GetError());
+            throw std::runtime_error("Failed to map transfer buffer for texture upload");
+        }
+        uint64_t offset = 0;
+        for (size_t i = begin; i < end; i++) {
+            offset = AlignUploadOffset(offset);
+            memcpy(mapped + offset, uploads[i].pixelData, uploads[i].dataLength);
+            offset += uploads[i].dataLength;
+        }
+        SDL_UnmapGPUTransferBuffer(device, transferBuffer);
+
+        SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(device);
+        if (!cmd) {
+            SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+            spdlog::error("Failed to acquire command buffer: {}", SDL_GetError());
+            throw std::runtime_error("Failed to acquire command buffer for texture upload");
+        }
+
+        SDL_GPUCopyPass *copyPass = SDL_BeginGPUCopyPass(cmd);
+        if (!copyPass) {
+            SDL_SubmitGPUCommandBuffer(cmd);
+            SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+            spdlog::error("Failed to begin copy pass: {}", SDL_GetError());
+            throw std::runtime_error("Failed to begin copy pass for texture upload");
+        }
+
+        offset = 0;
+        for (size_t i = begin; i < end; i++) {
+            const Texture &texture = *uploads[i].texture;
+            offset = AlignUploadOffset(offset);
+
+            SDL_GPUTextureTransferInfo src;
+            SDL_zero(src);
+            src.transfer_buffer = transferBuffer;
+            src.offset = static_cast<uint32_t>(offset);
+
+            SDL_GPUTextureRegion dst;
+            SDL_zero(dst);
+            dst.texture = texture.GetGPUTexture();
+            dst.w = texture.GetWidth();
+            dst.h = texture.GetHeight();
+            dst.d = 1;
+
+            SDL_UploadToGPUTexture(copyPass, &src, &dst, false);
+            offset += uploads[i].dataLength;
+        }
+        SDL_EndGPUCopyPass(copyPass);
+        SDL_SubmitGPUCommandBuffer(cmd);
+
+        SDL_ReleaseGPUTransferBuffer(device, transferBuffer);
+        begin = end;
+    }
+}
+
 } // namespace Lucky
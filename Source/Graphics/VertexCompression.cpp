@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <SDL3/SDL_assert.h>
+
+#include <Lucky/Mesh.hpp>
+#include <Lucky/VertexCompression.hpp>
+
+namespace Lucky {
+
+namespace {
+
+int16_t ToSnorm16(float value) {
+    return static_cast<int16_t>(std::round(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+float FromSnorm16(int16_t value) {
+    return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+}
+
+uint16_t ToUnorm16(float value) {
+    return static_cast<uint16_t>(std::round(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+
+float SignNotZero(float value) {
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+// Packs everything but the position, which is the only part the two
+// compressed layouts store differently.
+template <typename PackedVertex>
+void PackAttributes(const Vertex3D &vertex, PackedVertex &packed) {
+    packed.u = FloatToHalf(vertex.u);
+    packed.v = FloatToHalf(vertex.v);
+    EncodeOctahedral(glm::vec3(vertex.nx, vertex.ny, vertex.nz), packed.nx, packed.ny);
+    EncodeOctahedral(glm::vec3(vertex.tx, vertex.ty, vertex.tz), packed.tx, packed.ty);
+    packed.tw = vertex.tw < 0.0f ? -32767 : 32767;
+    packed.tangentPad = 0;
+}
+
+} // namespace
+
+uint16_t FloatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const int exponent = static_cast<int>((bits >> 23) & 0xFF);
+    uint32_t mantissa = bits & 0x7FFFFF;
+
+    if (exponent == 0xFF) {
+        // Infinity, or NaN with a quiet bit set so it can't turn into
+        // infinity when the low mantissa bits are dropped.
+        return sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0);
+    }
+
+    const int halfExponent = exponent - 127 + 15;
+    if (halfExponent >= 31) {
+        return sign | 0x7C00;
+    }
+    if (halfExponent <= 0) {
+        // Subnormal half, or too small even for that.
+        if (halfExponent < -10) {
+            return sign;
+        }
+        mantissa |= 0x800000;
+        const int shift = 14 - halfExponent;
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1))) {
+            half++;
+        }
+        return sign | static_cast<uint16_t>(half);
+    }
+
+    // Rounding up may carry into the exponent, which is still correct,
+    // up to and including overflow to infinity.
+    uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+        half++;
+    }
+    return sign | static_cast<uint16_t>(half);
+}
+
+float HalfToFloat(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    uint32_t mantissa = value & 0x3FF;
+
+    uint32_t bits;
+    if (exponent == 0x1F) {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        bits = sign;
+    } else {
+        // Subnormal: shift the mantissa up until its leading bit becomes
+        // the implicit one, lowering the exponent to match.
+        uint32_t shifts = 0;
+        while ((mantissa & 0x400) == 0) {
+            mantissa <<= 1;
+            shifts++;
+        }
+        bits = sign | ((127 - 15 + 1 - shifts) << 23) | ((mantissa & 0x3FF) << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+void EncodeOctahedral(const glm::vec3 &direction, int16_t &x, int16_t &y) {
+    const float sum = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+    if (!(sum > 0.0f)) {
+        x = 0;
+        y = 0;
+        return;
+    }
+
+    // Project onto the octahedron |x| + |y| + |z| = 1, then fold the
+    // lower half over the upper one along the diagonals.
+    glm::vec2 encoded(direction.x / sum, direction.y / sum);
+    if (direction.z < 0.0f) {
+        encoded = glm::vec2((1.0f - std::abs(encoded.y)) * SignNotZero(encoded.x),
+            (1.0f - std::abs(encoded.x)) * SignNotZero(encoded.y));
+    }
+    x = ToSnorm16(encoded.x);
+    y = ToSnorm16(encoded.y);
+}
+
+glm::vec3 DecodeOctahedral(int16_t x, int16_t y) {
+    // Mirrors DecodeOctahedral in forward.vert.hlsl.
+    glm::vec3 direction(FromSnorm16(x), FromSnorm16(y), 0.0f);
+    direction.z = 1.0f - std::abs(direction.x) - std::abs(direction.y);
+    const float fold = std::max(-direction.z, 0.0f);
+    direction.x += direction.x >= 0.0f ? -fold : fold;
+    direction.y += direction.y >= 0.0f ? -fold : fold;
+    return glm::normalize(direction);
+}
+
+CompressedVertex3D CompressVertex(const Vertex3D &vertex) {
+    CompressedVertex3D packed;
+    packed.x = vertex.x;
+    packed.y = vertex.y;
+    packed.z = vertex.z;
+    PackAttributes(vertex, packed);
+    return packed;
+}
+
+QuantizedVertex3D QuantizeVertex(const Vertex3D &vertex, const BoundingBox &bounds) {
+    SDL_assert(!bounds.IsEmpty());
+    const glm::vec3 extent = bounds.max - bounds.min;
+    const glm::vec3 position(vertex.x, vertex.y, vertex.z);
+    uint16_t quantized[3];
+    for (int axis = 0; axis < 3; axis++) {
+        // A flat axis has nothing to quantize; every vertex sits at min.
+        quantized[axis] = extent[axis] > 0.0f
+                              ? ToUnorm16((position[axis] - bounds.min[axis]) / extent[axis])
+                              : 0;
+    }
+
+    QuantizedVertex3D packed;
+    packed.x = quantized[0];
+    packed.y = quantized[1];
+    packed.z = quantized[2];
+    packed.positionPad = 0;
+    PackAttributes(vertex, packed);
+    return packed;
+}
+
+} // namespace Lucky
@@ -0,0 +1,129 @@
+#include <cfloat>
+#include <cmath>
+
+#include <Lucky/Bounds.hpp>
+
+namespace Lucky {
+
+void ExpandBounds(BoundingBox &box, const glm::vec3 &point) {
+    box.min = glm::min(box.min, point);
+    box.max = glm::max(box.max, point);
+}
+
+BoundingBox MergeBounds(const BoundingBox &a, const BoundingBox &b) {
+    BoundingBox result;
+    result.min = glm::min(a.min, b.min);
+    result.max = glm::max(a.max, b.max);
+    return result;
+}
+
+BoundingBox TransformBounds(const BoundingBox &box, const glm::mat4 &transform) {
+    if (box.IsEmpty()) {
+        return box;
+    }
+
+    // Transform the center, then project the extents onto each world
+    // axis through the absolute value of the upper 3x3 (Arvo's method).
+    // Cheaper than transforming all eight corners and gives the same box.
+    const glm::vec3 center = box.GetCenter();
+    const glm::vec3 extents = box.GetExtents();
+    const glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+
+    glm::vec3 worldExtents(0.0f);
+    for (int column = 0; column < 3; column++) {
+        worldExtents += glm::abs(glm::vec3(transform[column])) * extents[column];
+    }
+
+    BoundingBox result;
+    result.min = worldCenter - worldExtents;
+    result.max = worldCenter + worldExtents;
+    return result;
+}
+
+Frustum MakeFrustum(const glm::mat4 &viewProjection) {
+    // Gribb/Hartmann plane extraction. glm is column-major, so row r of
+    // the matrix is (m[0][r], m[1][r], m[2][r], m[3][r]).
+    auto row = [&](int r) {
+        return glm::vec4(
+            viewProjection[0][r], viewProjection[1][r], viewProjection[2][r], viewProjection[3][r]);
+    };
+    const glm::vec4 r0 = row(0);
+    const glm::vec4 r1 = row(1);
+    const glm::vec4 r2 = row(2);
+    const glm::vec4 r3 = row(3);
+
+    Frustum frustum;
+    frustum.planes[0] = r3 + r0; // left
+    frustum.planes[1] = r3 - r0; // right
+    frustum.planes[2] = r3 + r1; // bottom
+    frustum.planes[3] = r3 - r1; // top
+    frustum.planes[4] = r2;      // near (clip z >= 0)
+    frustum.planes[5] = r3 - r2; // far
+
+    for (glm::vec4 &plane : frustum.planes) {
+        const float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+    return frustum;
+}
+
+bool IntersectsFrustum(const BoundingBox &box, const Frustum &frustum) {
+    if (box.IsEmpty()) {
+        return false;
+    }
+
+    for (const glm::vec4 &plane : frustum.planes) {
+        // The corner furthest along the plane normal; if even that one is
+        // behind the plane, the whole box is.
+        const glm::vec3 farthest(plane.x >= 0.0f ? box.max.x : box.min.x,
+            plane.y >= 0.0f ? box.max.y : box.min.y,
+            plane.z >= 0.0f ? box.max.z : box.min.z);
+        if (glm::dot(glm::vec3(plane), farthest) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IntersectsFrustum(const glm::vec3 &center, float radius, const Frustum &frustum) {
+    for (const glm::vec4 &plane : frustum.planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IntersectsSphere(const BoundingBox &box, const glm::vec3 &center, float radius) {
+    if (box.IsEmpty()) {
+        return false;
+    }
+
+    const glm::vec3 closest = glm::clamp(center, box.min, box.max);
+    const glm::vec3 delta = closest - center;
+    return glm::dot(delta, delta) <= radius * radius;
+}
+
+float ProjectedPixelsPerUnit(
+    const BoundingBox &box, const glm::mat4 &viewProjection, float viewportHeight) {
+    if (box.IsEmpty()) {
+        return 0.0f;
+    }
+
+    // Clip y changes by the length of the projection's y row per world
+    // unit (the view's rotation keeps lengths), and clip w is the depth
+    // perspective divides by. Orthographic projections have a constant
+    // w of 1. Take the smallest w anywhere in the box.
+    const glm::vec3 yRow(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1]);
+    const glm::vec3 wRow(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3]);
+    const float centerW = glm::dot(wRow, box.GetCenter()) + viewProjection[3][3];
+    const float nearestW = centerW - glm::dot(glm::abs(wRow), box.GetExtents());
+    if (nearestW <= 0.0f) {
+        return FLT_MAX;
+    }
+    return 0.5f * viewportHeight * glm::length(yRow) / nearestW;
+}
+
+} // namespace Lucky
@@ -0,0 +1,113 @@
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include <Lucky/MappedFile.hpp>
+
+namespace Lucky {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string &path) {
+    const int wideLength = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring widePath(wideLength > 0 ? wideLength : 1, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, widePath.data(), wideLength);
+
+    HANDLE file = CreateFileW(widePath.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        spdlog::error("Failed to open '{}' for mapping: error {}", path, GetLastError());
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw std::runtime_error("Failed to read file size: " + path);
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+    if (size == 0) {
+        // Windows refuses to map an empty file; there is nothing to map.
+        CloseHandle(file);
+        return;
+    }
+
+    // The view keeps the file and the mapping object alive on its own,
+    // so both handles can be closed as soon as it exists.
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        spdlog::error("Failed to map '{}': error {}", path, GetLastError());
+        throw std::runtime_error("Failed to map file: " + path);
+    }
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        spdlog::error("Failed to map '{}': error {}", path, GetLastError());
+        throw std::runtime_error("Failed to map file: " + path);
+    }
+    data = static_cast<const uint8_t *>(view);
+}
+
+MappedFile::~MappedFile() {
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &path) {
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        spdlog::error("Failed to open '{}' for mapping", path);
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0) {
+        close(file);
+        throw std::runtime_error("Failed to read file size: " + path);
+    }
+    size = static_cast<size_t>(status.st_size);
+    if (size == 0) {
+        // mmap rejects a zero length; there is nothing to map.
+        close(file);
+        return;
+    }
+
+    // The mapping holds its own reference to the file.
+    void *view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED) {
+        spdlog::error("Failed to map '{}'", path);
+        throw std::runtime_error("Failed to map file: " + path);
+    }
+    data = static_cast<const uint8_t *>(view);
+}
+
+MappedFile::~MappedFile() {
+    if (data) {
+        munmap(const_cast<uint8_t *>(data), size);
+    }
+}
+
+#endif
+
+} // namespace Lucky
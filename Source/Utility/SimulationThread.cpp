@@ -0,0 +1,86 @@
+#include <utility>
+
+#include <SDL3/SDL_assert.h>
+
+#include <Lucky/SimulationThread.hpp>
+
+namespace Lucky {
+
+SimulationThread::SimulationThread(SimulateFunction simulate) : simulate(std::move(simulate)) {
+    SDL_assert(this->simulate);
+    thread = std::thread([this] { ThreadLoop(); });
+}
+
+SimulationThread::~SimulationThread() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+void SimulationThread::Step(float deltaSeconds) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return !stepPending; });
+        if (error) {
+            std::exception_ptr pending = std::move(error);
+            error = nullptr;
+            std::rethrow_exception(pending);
+        }
+
+        // The finished snapshot becomes the one to draw, and the step
+        // starts over in the one drawn last frame, which the caller is
+        // done with by now.
+        if (stepFinished) {
+            renderSnapshot = &snapshots[simulatingIndex];
+            simulatingIndex ^= 1;
+            stepFinished = false;
+        }
+        pendingDeltaSeconds = deltaSeconds;
+        stepPending = true;
+    }
+    wake.notify_one();
+}
+
+void SimulationThread::Wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return !stepPending; });
+}
+
+void SimulationThread::ThreadLoop() {
+    for (;;) {
+        FrameSnapshot *snapshot;
+        float deltaSeconds;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || stepPending; });
+            if (!stepPending) {
+                return;
+            }
+            snapshot = &snapshots[simulatingIndex];
+            deltaSeconds = pendingDeltaSeconds;
+        }
+
+        std::exception_ptr stepError;
+        try {
+            simulate(deltaSeconds, *snapshot);
+        } catch (...) {
+            stepError = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stepPending = false;
+            if (stepError) {
+                error = stepError;
+            } else {
+                stepFinished = true;
+            }
+        }
+        idle.notify_all();
+    }
+}
+
+} // namespace Lucky
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+#include <SDL3/SDL_assert.h>
+
+#include <Lucky/ThreadPool.hpp>
+
+namespace Lucky {
+
+namespace {
+
+// Shared by the caller of ParallelFor and the helper tasks it queues.
+// Helpers may still be sitting in the queue after the caller returns,
+// so the state is reference counted rather than living on its stack.
+struct ParallelForState {
+    std::function<void(uint32_t, uint32_t)> body;
+    uint32_t count = 0;
+    uint32_t grainSize = 1;
+    uint32_t chunkCount = 0;
+    std::atomic<uint32_t> nextChunk{0};
+    std::atomic<uint32_t> finishedChunks{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+};
+
+// Claims and runs chunks until none are left.
+void RunChunks(ParallelForState &state) {
+    for (;;) {
+        const uint32_t chunk = state.nextChunk.fetch_add(1);
+        if (chunk >= state.chunkCount) {
+            return;
+        }
+        const uint32_t begin = chunk * state.grainSize;
+        const uint32_t end = std::min(state.count, begin + state.grainSize);
+        try {
+            state.body(begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (!state.error) {
+                state.error = std::current_exception();
+            }
+        }
+        if (state.finishedChunks.fetch_add(1) + 1 == state.chunkCount) {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.finished.notify_all();
+        }
+    }
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(uint32_t workerCount) {
+    if (workerCount == 0) {
+        const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = (hardwareThreads > 1) ? hardwareThreads - 1 : 1;
+    }
+    workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; i++) {
+        workers.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::ParallelFor(uint32_t count, uint32_t grainSize,
+    const std::function<void(uint32_t begin, uint32_t end)> &body) {
+    SDL_assert(grainSize > 0);
+    if (count == 0) {
+        return;
+    }
+
+    const uint32_t chunkCount = (count + grainSize - 1) / grainSize;
+    if (chunkCount == 1) {
+        body(0, count);
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>();
+    state->body = body;
+    state->count = count;
+    state->grainSize = grainSize;
+    state->chunkCount = chunkCount;
+
+    // One helper per worker that could usefully join in; the caller
+    // takes chunks too.
+    const uint32_t helperCount = std::min(GetWorkerCount(), chunkCount - 1);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (uint32_t i = 0; i < helperCount; i++) {
+            tasks.emplace_back([state] { RunChunks(*state); });
+        }
+    }
+    wake.notify_all();
+
+    RunChunks(*state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&] { return state->finishedChunks.load() == chunkCount; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+std::future<void> ThreadPool::Submit(std::function<void()> task) {
+    auto packaged = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    std::future<void> future = packaged->get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.emplace_back([packaged] { (*packaged)(); });
+    }
+    wake.notify_one();
+    return future;
+}
+
+void ThreadPool::WorkerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace Lucky
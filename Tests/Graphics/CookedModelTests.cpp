@@ -0,0 +1,245 @@
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <doctest/doctest.h>
+
+#include <Lucky/CookedModel.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+std::string TempPath(const char *name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+MeshData MakeTriangle(float offset) {
+    MeshData meshData;
+    for (int i = 0; i < 3; i++) {
+        Vertex3D vertex{};
+        vertex.x = offset + static_cast<float>(i);
+        vertex.y = static_cast<float>(i % 2);
+        vertex.nz = 1.0f;
+        meshData.vertices.push_back(vertex);
+    }
+    meshData.indices = {0, 1, 2};
+    return meshData;
+}
+
+CookedModelData MakeModel() {
+    CookedModelData model;
+    model.meshes.push_back(MakeTriangle(0.0f));
+    model.meshes.push_back(MakeTriangle(10.0f));
+    model.meshes[0].lods.push_back(MeshLodData{{2, 0, 1}, 0.5f});
+    Meshlet meshlet;
+    meshlet.indexCount = 3;
+    meshlet.center = glm::vec3(11.0f, 0.5f, 0.0f);
+    meshlet.radius = 1.25f;
+    meshlet.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+    meshlet.coneCutoff = 1.0f;
+    model.meshes[1].meshlets.push_back(meshlet);
+    model.meshMaterials = {0, -1};
+
+    SkinnedMeshData skinned;
+    Vertex3DSkinned vertex{};
+    vertex.w0 = 1.0f;
+    skinned.vertices = {vertex, vertex, vertex};
+    skinned.vertices[1].j0 = 1;
+    skinned.indices = {0, 1, 2};
+    model.skinnedMeshes.push_back(skinned);
+    model.skinnedMeshMaterials = {0};
+
+    CookedImage image;
+    image.width = 2;
+    image.height = 1;
+    image.pixels = {1, 2, 3, 4, 5, 6, 7, 8};
+    model.images.push_back(image);
+    model.images.push_back(CookedImage{});
+
+    CookedMaterial material;
+    material.baseColorFactor = glm::vec4(0.5f, 0.25f, 1.0f, 1.0f);
+    material.normalScale = 0.75f;
+    material.baseColorImage = 0;
+    material.normalImage = 1;
+    model.materials.push_back(material);
+
+    NodeTemplate root;
+    root.name = "root";
+    root.restTranslation = glm::vec3(1.0f, 2.0f, 3.0f);
+    root.meshIndices = {0, 1};
+    NodeTemplate child;
+    child.name = "child";
+    child.parentIndex = 0;
+    child.restRotation = glm::quat(0.0f, 0.0f, 1.0f, 0.0f);
+    child.skinnedMeshIndices = {0};
+    child.skinIndex = 0;
+    model.nodes = {root, child};
+
+    Skin skin;
+    skin.name = "skin";
+    skin.jointNodes = {0, 1};
+    skin.inverseBindMatrices = {glm::mat4(1.0f), glm::mat4(2.0f)};
+    model.skins.push_back(skin);
+
+    AnimationDef animation;
+    animation.name = "spin";
+    animation.duration = 2.0f;
+    AnimationChannel channel;
+    channel.nodeIndex = 1;
+    channel.path = AnimationPath::Rotation;
+    channel.interpolation = AnimationInterpolation::Step;
+    channel.keyframes = {{0.0f, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)},
+        {2.0f, glm::vec4(0.0f, 1.0f, 0.0f, 0.0f)}};
+    animation.channels.push_back(channel);
+    model.animations.push_back(animation);
+    return model;
+}
+
+} // namespace
+
+TEST_CASE("Cooked models round trip through the mapped loader") {
+    const std::string path = TempPath("lucky_cooked_round_trip.lkm");
+    WriteCookedModel(MakeModel(), path);
+    CHECK(IsCookedModelFile(path));
+
+    {
+        CookedModelFile cooked(path);
+
+        // Both rigid meshes share one arena, with indices kept relative
+        // to each mesh and the first mesh's level of detail after its
+        // own indices.
+        REQUIRE(cooked.meshes.ranges.size() == 2);
+        CHECK(cooked.meshes.vertexCount == 6);
+        CHECK(cooked.meshes.indexCount == 9);
+        REQUIRE(cooked.meshes.ranges[0].lodCount == 1);
+        CHECK(cooked.meshes.ranges[0].lods[0].firstIndex == 3);
+        CHECK(cooked.meshes.ranges[0].lods[0].indexCount == 3);
+        CHECK(cooked.meshes.ranges[0].lods[0].error == 0.5f);
+        CHECK(cooked.meshes.indices[3] == 2);
+        CHECK(cooked.meshes.ranges[1].lodCount == 0);
+        CHECK(cooked.meshes.ranges[1].firstIndex == 6);
+        CHECK(cooked.meshes.ranges[1].baseVertex == 3);
+        CHECK(cooked.meshes.ranges[1].bounds.min.x == 10.0f);
+        CHECK(cooked.meshes.ranges[1].bounds.max.x == 12.0f);
+        CHECK(cooked.meshes.vertices[4].x == 11.0f);
+        CHECK(cooked.meshes.indices[8] == 2);
+        CHECK(cooked.meshes.ranges[0].meshletCount == 0);
+        REQUIRE(cooked.meshes.meshletCount == 1);
+        CHECK(cooked.meshes.ranges[1].firstMeshlet == 0);
+        CHECK(cooked.meshes.ranges[1].meshletCount == 1);
+        CHECK(cooked.meshes.meshlets[0].indexCount == 3);
+        CHECK(cooked.meshes.meshlets[0].center.x == 11.0f);
+        CHECK(cooked.meshes.meshlets[0].radius == 1.25f);
+        CHECK(cooked.meshes.meshlets[0].coneCutoff == 1.0f);
+        CHECK(cooked.meshes.materials == std::vector<int>{0, -1});
+        CHECK(reinterpret_cast<uintptr_t>(cooked.meshes.vertices) % 16 == 0);
+
+        REQUIRE(cooked.skinnedMeshes.ranges.size() == 1);
+        CHECK(cooked.skinnedMeshes.vertices[1].j0 == 1);
+        CHECK(cooked.skinnedMeshes.vertices[1].w0 == 1.0f);
+
+        REQUIRE(cooked.images.size() == 2);
+        CHECK(cooked.images[0].width == 2);
+        CHECK(cooked.images[0].pixels[7] == 8);
+        CHECK(cooked.images[1].pixels == nullptr);
+
+        REQUIRE(cooked.materials.size() == 1);
+        CHECK(cooked.materials[0].baseColorFactor.y == 0.25f);
+        CHECK(cooked.materials[0].normalScale == 0.75f);
+        CHECK(cooked.materials[0].normalImage == 1);
+        CHECK(cooked.materials[0].emissiveImage == -1);
+
+        REQUIRE(cooked.nodes.size() == 2);
+        CHECK(cooked.nodes[0].name == "root");
+        CHECK(cooked.nodes[0].restTranslation.z == 3.0f);
+        CHECK(cooked.nodes[0].meshIndices == std::vector<int>{0, 1});
+        CHECK(cooked.nodes[1].parentIndex == 0);
+        CHECK(cooked.nodes[1].restRotation.y == 1.0f);
+        CHECK(cooked.nodes[1].restRotation.w == 0.0f);
+        CHECK(cooked.nodes[1].skinIndex == 0);
+
+        REQUIRE(cooked.skins.size() == 1);
+        CHECK(cooked.skins[0].jointNodes == std::vector<int>{0, 1});
+        CHECK(cooked.skins[0].inverseBindMatrices[1][2][2] == 2.0f);
+
+        REQUIRE(cooked.animations.size() == 1);
+        const AnimationChannel &channel = cooked.animations[0].channels.at(0);
+        CHECK(cooked.animations[0].name == "spin");
+        CHECK(channel.path == AnimationPath::Rotation);
+        CHECK(channel.interpolation == AnimationInterpolation::Step);
+        REQUIRE(channel.keyframes.size() == 2);
+        CHECK(channel.keyframes[1].time == 2.0f);
+        CHECK(channel.keyframes[1].value.y == 1.0f);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Cooked model loading rejects other versions and damaged files") {
+    const std::string path = TempPath("lucky_cooked_damaged.lkm");
+    WriteCookedModel(MakeModel(), path);
+    const auto size = std::filesystem::file_size(path);
+
+    // A different version, as an older build would have written.
+    {
+        std::fstream stream(path, std::ios::in | std::ios::out | std::ios::binary);
+        stream.seekp(4);
+        const uint32_t version = CookedModelVersion + 1;
+        stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    }
+    CHECK(IsCookedModelFile(path));
+    CHECK_THROWS_AS(CookedModelFile{path}, std::runtime_error);
+
+    // Cut short partway through.
+    WriteCookedModel(MakeModel(), path);
+    std::filesystem::resize_file(path, size - 10);
+    CHECK_THROWS_AS(CookedModelFile{path}, std::runtime_error);
+
+    // Not a cooked model at all.
+    {
+        std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        stream << "glTF";
+    }
+    CHECK_FALSE(IsCookedModelFile(path));
+    CHECK_THROWS_AS(CookedModelFile{path}, std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Cooked model loading rejects node hierarchies with cycles") {
+    const std::string path = TempPath("lucky_cooked_cycle.lkm");
+    CookedModelData model = MakeModel();
+    model.nodes[0].parentIndex = 1;
+    WriteCookedModel(model, path);
+    CHECK_THROWS_AS(CookedModelFile{path}, std::runtime_error);
+
+    // A node can't be its own parent either.
+    model = MakeModel();
+    model.nodes[1].parentIndex = 1;
+    WriteCookedModel(model, path);
+    CHECK_THROWS_AS(CookedModelFile{path}, std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Cooked model loading rejects indices past their mesh's vertices") {
+    const std::string path = TempPath("lucky_cooked_indices.lkm");
+    // In range of the arena, which holds both triangles, but not of the
+    // first mesh.
+    CookedModelData model = MakeModel();
+    model.meshes[0].indices[2] = 3;
+    WriteCookedModel(model, path);
+    CHECK_THROWS_AS(CookedModelFile{path}, std::runtime_error);
+
+    model = MakeModel();
+    model.meshes[0].lods[0].indices[0] = 3;
+    WriteCookedModel(model, path);
+    CHECK_THROWS_AS(CookedModelFile{path}, std::runtime_error);
+
+    model = MakeModel();
+    model.skinnedMeshes[0].indices[1] = 100;
+    WriteCookedModel(model, path);
+    CHECK_THROWS_AS(CookedModelFile{path}, std::runtime_error);
+    std::remove(path.c_str());
+}
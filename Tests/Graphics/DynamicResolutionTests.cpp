@@ -0,0 +1,82 @@
+#include <doctest/doctest.h>
+
+#include <Lucky/DynamicResolution.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+constexpr float Target = 1.0f / 60.0f;
+
+void RunFrames(DynamicResolutionController &controller, float frameSeconds, int count) {
+    for (int i = 0; i < count; i++) {
+        controller.Update(frameSeconds);
+    }
+}
+
+} // namespace
+
+TEST_CASE("DynamicResolutionController drops the scale in proportion to the overload") {
+    DynamicResolutionController controller;
+    CHECK(controller.GetScale() == 1.0f);
+
+    // Twice the target frame time: half the pixels, so ~0.7 per axis.
+    RunFrames(controller, Target * 2.0f, 4);
+    CHECK(controller.GetScale() == doctest::Approx(0.70f));
+
+    // A single hitch at the new scale is smoothed away.
+    controller.Update(Target * 3.0f);
+    RunFrames(controller, Target, 10);
+    CHECK(controller.GetScale() == doctest::Approx(0.70f));
+
+    // Sustained heavy load bottoms out at the minimum.
+    RunFrames(controller, Target * 10.0f, 40);
+    CHECK(controller.GetScale() == doctest::Approx(0.5f));
+}
+
+TEST_CASE("DynamicResolutionController raises the scale a step at a time") {
+    DynamicResolutionController controller;
+    RunFrames(controller, Target * 2.0f, 4);
+    const float lowered = controller.GetScale();
+
+    RunFrames(controller, Target, 59);
+    CHECK(controller.GetScale() == lowered);
+    controller.Update(Target);
+    CHECK(controller.GetScale() == doctest::Approx(lowered + 0.05f));
+
+    RunFrames(controller, Target, 60 * 10);
+    CHECK(controller.GetScale() == 1.0f);
+}
+
+TEST_CASE("DynamicResolutionController backs off probes that fail") {
+    DynamicResolutionSettings settings;
+    settings.framesToIncrease = 10;
+    DynamicResolutionController controller(settings);
+    RunFrames(controller, Target * 1.5f, 4);
+    const float settled = controller.GetScale();
+    CHECK(settled < 1.0f);
+
+    // The rise overloads the frame and is undone.
+    RunFrames(controller, Target, 10);
+    CHECK(controller.GetScale() > settled);
+    RunFrames(controller, Target * 1.5f, 4);
+    CHECK(controller.GetScale() <= settled);
+    const float dropped = controller.GetScale();
+
+    // The next probe waits twice as long.
+    RunFrames(controller, Target, 19);
+    CHECK(controller.GetScale() == dropped);
+    controller.Update(Target);
+    CHECK(controller.GetScale() > dropped);
+}
+
+TEST_CASE("DynamicResolutionController holds steady inside the hysteresis band") {
+    DynamicResolutionSettings settings;
+    settings.maxScale = 0.8f;
+    DynamicResolutionController controller(settings);
+    CHECK(controller.GetScale() == doctest::Approx(0.8f));
+
+    // Slightly over the target but under the over-budget ratio.
+    RunFrames(controller, Target * 1.05f, 500);
+    CHECK(controller.GetScale() == doctest::Approx(0.8f));
+}
@@ -0,0 +1,293 @@
+#include <cstring>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <Lucky/GltfAccessors.hpp>
+#include <Lucky/Mesh.hpp>
+#include <Lucky/SkinnedMesh.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+// An in-memory glTF buffer with a single view over all of it, standing
+// in for what cgltf_load_buffers produces.
+struct TestBuffer {
+    std::vector<uint8_t> bytes;
+    cgltf_buffer buffer{};
+    cgltf_buffer_view view{};
+
+    template <typename T>
+    void Append(const T &value) {
+        const size_t at = bytes.size();
+        bytes.resize(at + sizeof(T));
+        std::memcpy(bytes.data() + at, &value, sizeof(T));
+    }
+
+    // Points the buffer and view at `bytes`; call after the last Append.
+    void Finish() {
+        buffer.size = bytes.size();
+        buffer.data = bytes.data();
+        view.buffer = &buffer;
+        view.size = bytes.size();
+    }
+};
+
+cgltf_accessor MakeAccessor(TestBuffer &buffer, cgltf_component_type componentType,
+    cgltf_type type, size_t count, size_t stride, size_t offset = 0) {
+    cgltf_accessor accessor{};
+    accessor.component_type = componentType;
+    accessor.type = type;
+    accessor.count = count;
+    accessor.stride = stride;
+    accessor.offset = offset;
+    accessor.buffer_view = &buffer.view;
+    return accessor;
+}
+
+} // namespace
+
+TEST_CASE("DirectAccessorData only accepts plain accessors of the asked type") {
+    TestBuffer buffer;
+    for (uint16_t i = 0; i < 4; i++) {
+        buffer.Append(i);
+    }
+    buffer.Finish();
+    cgltf_accessor accessor =
+        MakeAccessor(buffer, cgltf_component_type_r_16u, cgltf_type_scalar, 2, 2, 4);
+
+    CHECK(DirectAccessorData(&accessor, cgltf_component_type_r_16u) == buffer.bytes.data() + 4);
+    CHECK(DirectAccessorData(&accessor, cgltf_component_type_r_32u) == nullptr);
+
+    accessor.normalized = true;
+    CHECK(DirectAccessorData(&accessor, cgltf_component_type_r_16u) == nullptr);
+    accessor.normalized = false;
+    accessor.is_sparse = true;
+    CHECK(DirectAccessorData(&accessor, cgltf_component_type_r_16u) == nullptr);
+    accessor.is_sparse = false;
+    accessor.buffer_view = nullptr;
+    CHECK(DirectAccessorData(&accessor, cgltf_component_type_r_16u) == nullptr);
+}
+
+TEST_CASE("ReadIndices widens 8-bit indices") {
+    TestBuffer buffer;
+    for (uint8_t i : {uint8_t{0}, uint8_t{7}, uint8_t{255}}) {
+        buffer.Append(i);
+    }
+    buffer.Finish();
+    const cgltf_accessor accessor =
+        MakeAccessor(buffer, cgltf_component_type_r_8u, cgltf_type_scalar, 3, 1);
+    std::vector<uint32_t> indices;
+    ReadIndices(&accessor, indices);
+    CHECK(indices == std::vector<uint32_t>{0, 7, 255});
+}
+
+TEST_CASE("ReadIndices widens 16-bit indices") {
+    TestBuffer buffer;
+    for (uint16_t i : {uint16_t{1}, uint16_t{300}, uint16_t{65535}}) {
+        buffer.Append(i);
+    }
+    buffer.Finish();
+    const cgltf_accessor accessor =
+        MakeAccessor(buffer, cgltf_component_type_r_16u, cgltf_type_scalar, 3, 2);
+    std::vector<uint32_t> indices;
+    ReadIndices(&accessor, indices);
+    CHECK(indices == std::vector<uint32_t>{1, 300, 65535});
+}
+
+TEST_CASE("ReadIndices copies 32-bit indices") {
+    TestBuffer buffer;
+    for (uint32_t i : {2u, 70000u, 0xFFFFFFF0u}) {
+        buffer.Append(i);
+    }
+    buffer.Finish();
+    const cgltf_accessor accessor =
+        MakeAccessor(buffer, cgltf_component_type_r_32u, cgltf_type_scalar, 3, 4);
+    std::vector<uint32_t> indices;
+    ReadIndices(&accessor, indices);
+    CHECK(indices == std::vector<uint32_t>{2, 70000, 0xFFFFFFF0u});
+}
+
+TEST_CASE("ReadIndices honors the accessor's stride and offset") {
+    // 16-bit indices interleaved with 16 bits of padding, after a
+    // 4-byte header the accessor skips.
+    TestBuffer buffer;
+    buffer.Append(uint32_t{0xDEADBEEF});
+    for (uint16_t i : {uint16_t{5}, uint16_t{6}, uint16_t{7}}) {
+        buffer.Append(i);
+        buffer.Append(uint16_t{0xFFFF});
+    }
+    buffer.Finish();
+    const cgltf_accessor accessor =
+        MakeAccessor(buffer, cgltf_component_type_r_16u, cgltf_type_scalar, 3, 4, 4);
+    std::vector<uint32_t> indices;
+    ReadIndices(&accessor, indices);
+    CHECK(indices == std::vector<uint32_t>{5, 6, 7});
+}
+
+TEST_CASE("ReadAttribute copies interleaved floats into the vertex array") {
+    // Position and UV interleaved in one view, as exporters commonly do.
+    TestBuffer buffer;
+    for (int i = 0; i < 3; i++) {
+        const float f = static_cast<float>(i);
+        for (float value : {f, f + 0.1f, f + 0.2f, f * 0.5f, 1.0f - f * 0.5f}) {
+            buffer.Append(value);
+        }
+    }
+    buffer.Finish();
+    const size_t stride = 5 * sizeof(float);
+    const cgltf_accessor positions =
+        MakeAccessor(buffer, cgltf_component_type_r_32f, cgltf_type_vec3, 3, stride);
+    const cgltf_accessor uvs = MakeAccessor(
+        buffer, cgltf_component_type_r_32f, cgltf_type_vec2, 3, stride, 3 * sizeof(float));
+
+    std::vector<Vertex3D> vertices(3);
+    ReadAttribute(&positions, vertices.size(), 3, &vertices[0].x, sizeof(Vertex3D));
+    ReadAttribute(&uvs, vertices.size(), 2, &vertices[0].u, sizeof(Vertex3D));
+    for (int i = 0; i < 3; i++) {
+        const float f = static_cast<float>(i);
+        CHECK(vertices[i].x == f);
+        CHECK(vertices[i].y == f + 0.1f);
+        CHECK(vertices[i].z == f + 0.2f);
+        CHECK(vertices[i].u == f * 0.5f);
+        CHECK(vertices[i].v == 1.0f - f * 0.5f);
+        CHECK(vertices[i].nx == 0.0f);
+    }
+}
+
+TEST_CASE("ReadAttribute leaves components and vertices the accessor lacks") {
+    TestBuffer buffer;
+    for (float value : {1.0f, 2.0f, 3.0f, 4.0f}) {
+        buffer.Append(value);
+    }
+    buffer.Finish();
+    // Two vec2 elements written into vec3 slots of three vertices.
+    const cgltf_accessor accessor =
+        MakeAccessor(buffer, cgltf_component_type_r_32f, cgltf_type_vec2, 2, 8);
+    Vertex3D defaults{};
+    defaults.z = 9.0f;
+    std::vector<Vertex3D> vertices(3, defaults);
+    ReadAttribute(&accessor, vertices.size(), 3, &vertices[0].x, sizeof(Vertex3D));
+    CHECK(vertices[0].x == 1.0f);
+    CHECK(vertices[0].y == 2.0f);
+    CHECK(vertices[0].z == 9.0f);
+    CHECK(vertices[1].x == 3.0f);
+    CHECK(vertices[1].y == 4.0f);
+    CHECK(vertices[2].x == 0.0f);
+}
+
+TEST_CASE("ReadAttribute converts normalized UVs through the slow path") {
+    TestBuffer buffer;
+    for (uint16_t value : {uint16_t{0}, uint16_t{65535}, uint16_t{65535}, uint16_t{0}}) {
+        buffer.Append(value);
+    }
+    buffer.Finish();
+    cgltf_accessor accessor =
+        MakeAccessor(buffer, cgltf_component_type_r_16u, cgltf_type_vec2, 2, 4);
+    accessor.normalized = true;
+    std::vector<Vertex3D> vertices(2);
+    ReadAttribute(&accessor, vertices.size(), 2, &vertices[0].u, sizeof(Vertex3D));
+    CHECK(vertices[0].u == doctest::Approx(0.0f));
+    CHECK(vertices[0].v == doctest::Approx(1.0f));
+    CHECK(vertices[1].u == doctest::Approx(1.0f));
+    CHECK(vertices[1].v == doctest::Approx(0.0f));
+}
+
+TEST_CASE("ReadAttribute converts normalized byte weights through the slow path") {
+    TestBuffer buffer;
+    for (uint8_t value : {uint8_t{255}, uint8_t{0}, uint8_t{0}, uint8_t{0}}) {
+        buffer.Append(value);
+    }
+    for (uint8_t value : {uint8_t{51}, uint8_t{102}, uint8_t{102}, uint8_t{0}}) {
+        buffer.Append(value);
+    }
+    buffer.Finish();
+    cgltf_accessor accessor =
+        MakeAccessor(buffer, cgltf_component_type_r_8u, cgltf_type_vec4, 2, 4);
+    accessor.normalized = true;
+    std::vector<Vertex3DSkinned> vertices(2);
+    ReadAttribute(&accessor, vertices.size(), 4, &vertices[0].w0, sizeof(Vertex3DSkinned));
+    CHECK(vertices[0].w0 == doctest::Approx(1.0f));
+    CHECK(vertices[0].w1 == doctest::Approx(0.0f));
+    CHECK(vertices[1].w0 == doctest::Approx(0.2f));
+    CHECK(vertices[1].w1 == doctest::Approx(0.4f));
+    CHECK(vertices[1].w2 == doctest::Approx(0.4f));
+    CHECK(vertices[1].w3 == doctest::Approx(0.0f));
+}
+
+TEST_CASE("ReadAttribute applies sparse substitutions") {
+    // Dense positions x = 0, 1, 2 with a sparse override of element 1.
+    TestBuffer buffer;
+    for (int i = 0; i < 3; i++) {
+        for (float value : {static_cast<float>(i), 0.0f, 0.0f}) {
+            buffer.Append(value);
+        }
+    }
+    const size_t indicesOffset = buffer.bytes.size();
+    buffer.Append(uint16_t{1});
+    buffer.Append(uint16_t{0});
+    const size_t valuesOffset = buffer.bytes.size();
+    for (float value : {10.0f, 20.0f, 30.0f}) {
+        buffer.Append(value);
+    }
+    buffer.Finish();
+
+    cgltf_accessor accessor =
+        MakeAccessor(buffer, cgltf_component_type_r_32f, cgltf_type_vec3, 3, 12);
+    accessor.is_sparse = true;
+    accessor.sparse.count = 1;
+    accessor.sparse.indices_buffer_view = &buffer.view;
+    accessor.sparse.indices_byte_offset = indicesOffset;
+    accessor.sparse.indices_component_type = cgltf_component_type_r_16u;
+    accessor.sparse.values_buffer_view = &buffer.view;
+    accessor.sparse.values_byte_offset = valuesOffset;
+
+    std::vector<Vertex3D> vertices(3);
+    ReadAttribute(&accessor, vertices.size(), 3, &vertices[0].x, sizeof(Vertex3D));
+    CHECK(vertices[0].x == 0.0f);
+    CHECK(vertices[1].x == 10.0f);
+    CHECK(vertices[1].y == 20.0f);
+    CHECK(vertices[1].z == 30.0f);
+    CHECK(vertices[2].x == 2.0f);
+}
+
+TEST_CASE("ReadJoints reads byte joint indices") {
+    TestBuffer buffer;
+    for (uint8_t value : {uint8_t{1}, uint8_t{2}, uint8_t{3}, uint8_t{255}}) {
+        buffer.Append(value);
+    }
+    buffer.Finish();
+    const cgltf_accessor accessor =
+        MakeAccessor(buffer, cgltf_component_type_r_8u, cgltf_type_vec4, 1, 4);
+    std::vector<Vertex3DSkinned> vertices(1);
+    ReadJoints(&accessor, vertices);
+    CHECK(vertices[0].j0 == 1);
+    CHECK(vertices[0].j1 == 2);
+    CHECK(vertices[0].j2 == 3);
+    CHECK(vertices[0].j3 == 255);
+}
+
+TEST_CASE("ReadJoints reads interleaved short joint indices") {
+    // Each element is followed by four unrelated shorts.
+    TestBuffer buffer;
+    for (uint16_t base : {uint16_t{0}, uint16_t{1000}}) {
+        for (uint16_t i = 0; i < 4; i++) {
+            buffer.Append(static_cast<uint16_t>(base + i));
+        }
+        for (int i = 0; i < 4; i++) {
+            buffer.Append(uint16_t{0xFFFF});
+        }
+    }
+    buffer.Finish();
+    const cgltf_accessor accessor =
+        MakeAccessor(buffer, cgltf_component_type_r_16u, cgltf_type_vec4, 2, 16);
+    std::vector<Vertex3DSkinned> vertices(2);
+    ReadJoints(&accessor, vertices);
+    CHECK(vertices[0].j0 == 0);
+    CHECK(vertices[0].j3 == 3);
+    CHECK(vertices[1].j0 == 1000);
+    CHECK(vertices[1].j1 == 1001);
+    CHECK(vertices[1].j2 == 1002);
+    CHECK(vertices[1].j3 == 1003);
+}
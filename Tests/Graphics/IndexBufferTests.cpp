@@ -13,3 +13,10 @@ TEST_CASE("IndexElementSizeOf maps uint16_t to 16-bit indices") {
 TEST_CASE("IndexElementSizeOf maps uint32_t to 32-bit indices") {
     CHECK(IndexElementSizeOf<uint32_t>() == SDL_GPU_INDEXELEMENTSIZE_32BIT);
 }
+
+TEST_CASE("IndexElementSizeFor uses 16-bit indices while every index fits") {
+    CHECK(IndexElementSizeFor(1) == SDL_GPU_INDEXELEMENTSIZE_16BIT);
+    CHECK(IndexElementSizeFor(65534) == SDL_GPU_INDEXELEMENTSIZE_16BIT);
+    CHECK(IndexElementSizeFor(65535) == SDL_GPU_INDEXELEMENTSIZE_16BIT);
+    CHECK(IndexElementSizeFor(65536) == SDL_GPU_INDEXELEMENTSIZE_32BIT);
+}
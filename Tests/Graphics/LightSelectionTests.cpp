@@ -0,0 +1,187 @@
+#include <cstdint>
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <glm/glm.hpp>
+
+#include <Lucky/Bounds.hpp>
+#include <Lucky/LightSelection.hpp>
+#include <Lucky/Scene3D.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+Light MakePointLight(const glm::vec3 &position, float intensity, float range = 10.0f) {
+    Light light;
+    light.type = LightType::Point;
+    light.position = position;
+    light.intensity = intensity;
+    light.range = range;
+    return light;
+}
+
+BoundingBox UnitBox() {
+    BoundingBox bounds;
+    bounds.min = glm::vec3(0.0f);
+    bounds.max = glm::vec3(1.0f);
+    return bounds;
+}
+
+std::vector<uint32_t> SelectedIndices(const ObjectLights &selected) {
+    std::vector<uint32_t> indices;
+    for (uint32_t n = 0; n < selected.count; n++) {
+        indices.push_back(selected.GetIndex(n));
+    }
+    return indices;
+}
+
+} // namespace
+
+TEST_CASE("SelectObjectLights keeps the strongest lights in index order") {
+    // Twelve lights touching the box; the odd ones plus light 0 and 2 are
+    // the eight brightest.
+    std::vector<Light> lights;
+    for (int i = 0; i < 12; i++) {
+        const float intensity = (i % 2 == 1 || i == 0 || i == 2) ? 2.0f + i : 1.0f;
+        lights.push_back(MakePointLight(glm::vec3(0.5f), intensity));
+    }
+    const ObjectLights selected =
+        SelectObjectLights(lights, static_cast<int>(lights.size()), UnitBox());
+
+    REQUIRE(selected.count == MaxObjectLights);
+    CHECK(SelectedIndices(selected) == std::vector<uint32_t>{0, 1, 2, 3, 5, 7, 9, 11});
+}
+
+TEST_CASE("SelectObjectLights keeps every light when there are few enough") {
+    const std::vector<Light> lights = {
+        MakePointLight(glm::vec3(0.5f), 1.0f),
+        MakePointLight(glm::vec3(0.5f), 3.0f),
+        MakePointLight(glm::vec3(0.5f), 2.0f),
+    };
+    const ObjectLights selected = SelectObjectLights(lights, 3, UnitBox());
+
+    CHECK(SelectedIndices(selected) == std::vector<uint32_t>{0, 1, 2});
+}
+
+TEST_CASE("SelectObjectLights only considers the first lightCount lights") {
+    const std::vector<Light> lights = {
+        MakePointLight(glm::vec3(0.5f), 1.0f),
+        MakePointLight(glm::vec3(0.5f), 1.0f),
+        MakePointLight(glm::vec3(0.5f), 1.0f),
+    };
+    const ObjectLights selected = SelectObjectLights(lights, 2, UnitBox());
+
+    CHECK(SelectedIndices(selected) == std::vector<uint32_t>{0, 1});
+}
+
+TEST_CASE("SelectObjectLights drops lights under MinLightInfluence") {
+    const std::vector<Light> lights = {
+        // Dim, but inside the box.
+        MakePointLight(glm::vec3(0.5f), MinLightInfluence * 0.5f),
+        MakePointLight(glm::vec3(0.5f), 1.0f),
+        // Bright, but a thousand ranges away.
+        MakePointLight(glm::vec3(10000.0f, 0.0f, 0.0f), 5.0f, 10.0f),
+        // Exactly at the threshold.
+        MakePointLight(glm::vec3(0.5f), MinLightInfluence),
+    };
+    const ObjectLights selected = SelectObjectLights(lights, 4, UnitBox());
+
+    CHECK(SelectedIndices(selected) == std::vector<uint32_t>{1, 3});
+}
+
+TEST_CASE("SelectObjectLights returns nothing without lights") {
+    const ObjectLights selected = SelectObjectLights({}, 0, UnitBox());
+
+    CHECK(selected.count == 0);
+    CHECK(selected.indices[0] == 0);
+    CHECK(selected.indices[1] == 0);
+}
+
+TEST_CASE("LightInfluence ignores distance for directional lights") {
+    Light light;
+    light.type = LightType::Directional;
+    light.color = glm::vec3(0.25f, 0.5f, 0.125f);
+    light.intensity = 2.0f;
+    light.position = glm::vec3(10000.0f);
+    light.range = 1.0f;
+
+    CHECK(LightInfluence(light, UnitBox()) == doctest::Approx(1.0f));
+
+    light.position = glm::vec3(0.5f);
+    CHECK(LightInfluence(light, UnitBox()) == doctest::Approx(1.0f));
+}
+
+TEST_CASE("LightInfluence falls off with distance to the nearest point of the box") {
+    // Inside the box there is no falloff.
+    CHECK(LightInfluence(MakePointLight(glm::vec3(0.5f), 2.0f), UnitBox()) ==
+          doctest::Approx(2.0f));
+
+    // One range from the nearest face halves the influence.
+    const Light light = MakePointLight(glm::vec3(1.0f + 4.0f, 0.5f, 0.5f), 2.0f, 4.0f);
+    CHECK(LightInfluence(light, UnitBox()) == doctest::Approx(1.0f));
+
+    // An empty box can't place the light, so it isn't attenuated.
+    CHECK(LightInfluence(light, BoundingBox{}) == doctest::Approx(2.0f));
+}
+
+TEST_CASE("ObjectLights packs each selected index into its own byte") {
+    // Every slot gets an index with a distinct bit pattern, including the
+    // largest that fits a byte.
+    std::vector<Light> lights(MaxSelectableLights, MakePointLight(glm::vec3(0.5f), 0.0f));
+    const uint32_t expected[MaxObjectLights] = {0, 1, 0x7F, 0x80, 0xAA, 0xC3, 0xFE, 0xFF};
+    for (uint32_t index : expected) {
+        lights[index].intensity = 1.0f;
+    }
+    const ObjectLights selected = SelectObjectLights(lights, MaxSelectableLights, UnitBox());
+
+    REQUIRE(selected.count == MaxObjectLights);
+    for (uint32_t n = 0; n < selected.count; n++) {
+        CHECK(selected.GetIndex(n) == expected[n]);
+    }
+    CHECK(selected.indices[0] == 0x807F0100u);
+    CHECK(selected.indices[1] == 0xFFFEC3AAu);
+}
+
+TEST_CASE("HashLightsForSelection changes when any field it reads changes") {
+    const std::vector<Light> lights = {
+        MakePointLight(glm::vec3(1.0f, 2.0f, 3.0f), 1.0f),
+        MakePointLight(glm::vec3(4.0f, 5.0f, 6.0f), 2.0f),
+    };
+    const uint64_t hash = HashLightsForSelection(lights, 2);
+    CHECK(HashLightsForSelection(lights, 2) == hash);
+    CHECK(HashLightsForSelection(lights, 1) != hash);
+
+    std::vector<Light> changed = lights;
+    changed[1].type = LightType::Spot;
+    CHECK(HashLightsForSelection(changed, 2) != hash);
+
+    changed = lights;
+    changed[1].position.z += 0.5f;
+    CHECK(HashLightsForSelection(changed, 2) != hash);
+
+    changed = lights;
+    changed[1].color.y = 0.5f;
+    CHECK(HashLightsForSelection(changed, 2) != hash);
+
+    changed = lights;
+    changed[1].intensity = 3.0f;
+    CHECK(HashLightsForSelection(changed, 2) != hash);
+
+    changed = lights;
+    changed[1].range = 20.0f;
+    CHECK(HashLightsForSelection(changed, 2) != hash);
+}
+
+TEST_CASE("HashLightsForSelection ignores fields selection doesn't read") {
+    const std::vector<Light> lights = {MakePointLight(glm::vec3(1.0f, 2.0f, 3.0f), 1.0f)};
+    const uint64_t hash = HashLightsForSelection(lights, 1);
+
+    std::vector<Light> changed = lights;
+    changed[0].direction = glm::vec3(1.0f, 0.0f, 0.0f);
+    changed[0].innerCone = 0.5f;
+    changed[0].outerCone = 0.25f;
+    changed[0].castsShadows = true;
+    changed[0].isStatic = true;
+    CHECK(HashLightsForSelection(changed, 1) == hash);
+}
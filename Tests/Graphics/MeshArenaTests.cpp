@@ -0,0 +1,149 @@
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <Lucky/IndexBuffer.hpp>
+#include <Lucky/Mesh.hpp>
+#include <Lucky/MeshArena.hpp>
+#include <Lucky/SkinnedMesh.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+// A strip of `vertexCount` vertices along x, with one triangle per
+// consecutive triple so every index is used.
+MeshData MakeStrip(uint32_t vertexCount, float y = 0.0f) {
+    MeshData data;
+    for (uint32_t i = 0; i < vertexCount; i++) {
+        Vertex3D vertex{};
+        vertex.x = static_cast<float>(i);
+        vertex.y = y;
+        data.vertices.push_back(vertex);
+    }
+    for (uint32_t i = 0; i + 2 < vertexCount; i++) {
+        data.indices.insert(data.indices.end(), {i, i + 1, i + 2});
+    }
+    return data;
+}
+
+} // namespace
+
+TEST_CASE("AppendArenaMesh places meshes back to back") {
+    std::vector<Vertex3D> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<Meshlet> meshlets;
+    const MeshData first = MakeStrip(4);
+    const MeshData second = MakeStrip(5, 2.0f);
+
+    const MeshArenaRange a = AppendArenaMesh(first, vertices, indices, meshlets);
+    const MeshArenaRange b = AppendArenaMesh(second, vertices, indices, meshlets);
+
+    CHECK(a.firstIndex == 0);
+    CHECK(a.indexCount == 6);
+    CHECK(a.baseVertex == 0);
+    CHECK(a.vertexCount == 4);
+    CHECK(b.firstIndex == 6);
+    CHECK(b.indexCount == 9);
+    CHECK(b.baseVertex == 4);
+    CHECK(b.vertexCount == 5);
+    CHECK(vertices.size() == 9);
+    CHECK(indices.size() == 15);
+    CHECK(meshlets.empty());
+
+    // Indices stay relative to each mesh's own first vertex.
+    CHECK(indices[b.firstIndex] == 0);
+    CHECK(vertices[b.baseVertex].y == 2.0f);
+
+    CHECK(a.bounds.min == glm::vec3(0.0f));
+    CHECK(a.bounds.max == glm::vec3(3.0f, 0.0f, 0.0f));
+    CHECK(b.bounds.min == glm::vec3(0.0f, 2.0f, 0.0f));
+    CHECK(b.bounds.max == glm::vec3(4.0f, 2.0f, 0.0f));
+}
+
+TEST_CASE("AppendArenaMesh puts levels of detail after their mesh's indices") {
+    std::vector<Vertex3D> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<Meshlet> meshlets;
+    MeshData mesh = MakeStrip(6);
+    mesh.lods.push_back({{0, 2, 4, 2, 3, 4}, 0.5f});
+    mesh.lods.push_back({{0, 2, 4}, 1.5f});
+
+    AppendArenaMesh(MakeStrip(3), vertices, indices, meshlets);
+    const MeshArenaRange range = AppendArenaMesh(mesh, vertices, indices, meshlets);
+    const MeshArenaRange after = AppendArenaMesh(MakeStrip(3), vertices, indices, meshlets);
+
+    CHECK(range.firstIndex == 3);
+    CHECK(range.indexCount == 12);
+    REQUIRE(range.lodCount == 2);
+    CHECK(range.lods[0].firstIndex == 15);
+    CHECK(range.lods[0].indexCount == 6);
+    CHECK(range.lods[0].error == 0.5f);
+    CHECK(range.lods[1].firstIndex == 21);
+    CHECK(range.lods[1].indexCount == 3);
+    CHECK(range.lods[1].error == 1.5f);
+    CHECK(indices[range.lods[1].firstIndex + 1] == 2);
+
+    // The next mesh starts after the last level of detail.
+    CHECK(after.firstIndex == 24);
+    CHECK(after.baseVertex == 9);
+}
+
+TEST_CASE("AppendArenaMesh gathers every mesh's meshlets into one array") {
+    std::vector<Vertex3D> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<Meshlet> meshlets;
+    MeshData first = MakeStrip(5);
+    first.meshlets.resize(2);
+    first.meshlets[1].firstIndex = 3;
+    MeshData second = MakeStrip(4);
+    second.meshlets.resize(1);
+    second.meshlets[0].indexCount = 6;
+
+    const MeshArenaRange a = AppendArenaMesh(first, vertices, indices, meshlets);
+    const MeshArenaRange unsplit = AppendArenaMesh(MakeStrip(3), vertices, indices, meshlets);
+    const MeshArenaRange b = AppendArenaMesh(second, vertices, indices, meshlets);
+
+    CHECK(a.firstMeshlet == 0);
+    CHECK(a.meshletCount == 2);
+    CHECK(unsplit.meshletCount == 0);
+    CHECK(b.firstMeshlet == 2);
+    CHECK(b.meshletCount == 1);
+    REQUIRE(meshlets.size() == 3);
+    // Meshlet indices stay relative to their mesh's first index.
+    CHECK(meshlets[1].firstIndex == 3);
+    CHECK(meshlets[2].indexCount == 6);
+}
+
+TEST_CASE("AppendArenaMesh lays out skinned meshes without lods or meshlets") {
+    std::vector<Vertex3DSkinned> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<Meshlet> meshlets;
+    SkinnedMeshData mesh;
+    mesh.vertices.resize(3);
+    mesh.vertices[2].x = 1.0f;
+    mesh.indices = {0, 1, 2};
+
+    AppendArenaMesh(mesh, vertices, indices, meshlets);
+    const MeshArenaRange range = AppendArenaMesh(mesh, vertices, indices, meshlets);
+
+    CHECK(range.firstIndex == 3);
+    CHECK(range.baseVertex == 3);
+    CHECK(range.lodCount == 0);
+    CHECK(range.meshletCount == 0);
+    CHECK(range.bounds.max.x == 1.0f);
+    CHECK(meshlets.empty());
+}
+
+TEST_CASE("LargestArenaMesh picks the index size by mesh, not arena, size") {
+    std::vector<MeshArenaRange> ranges(3);
+    ranges[0].vertexCount = 40000;
+    ranges[1].vertexCount = MaxShortIndexedVertices;
+    ranges[2].baseVertex = 40000 + MaxShortIndexedVertices;
+    ranges[2].vertexCount = 40000;
+    CHECK(LargestArenaMesh(ranges) == MaxShortIndexedVertices);
+    CHECK(IndexElementSizeFor(LargestArenaMesh(ranges)) == SDL_GPU_INDEXELEMENTSIZE_16BIT);
+
+    ranges[1].vertexCount = MaxShortIndexedVertices + 1;
+    CHECK(IndexElementSizeFor(LargestArenaMesh(ranges)) == SDL_GPU_INDEXELEMENTSIZE_32BIT);
+}
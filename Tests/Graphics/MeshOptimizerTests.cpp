@@ -0,0 +1,350 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <Lucky/Mesh.hpp>
+#include <Lucky/MeshOptimizer.hpp>
+#include <Lucky/SkinnedMesh.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+// A `side` x `side` grid of quads in the XY plane, facing +Z, with its
+// triangles shuffled the way a careless exporter might write them.
+MeshData MakeShuffledGrid(int side) {
+    MeshData meshData;
+    for (int y = 0; y <= side; y++) {
+        for (int x = 0; x <= side; x++) {
+            Vertex3D vertex{};
+            vertex.x = static_cast<float>(x);
+            vertex.y = static_cast<float>(y);
+            vertex.nz = 1.0f;
+            meshData.vertices.push_back(vertex);
+        }
+    }
+
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (int y = 0; y < side; y++) {
+        for (int x = 0; x < side; x++) {
+            const uint32_t i0 = y * (side + 1) + x;
+            const uint32_t i1 = i0 + 1;
+            const uint32_t i2 = i0 + side + 1;
+            const uint32_t i3 = i2 + 1;
+            triangles.push_back({i0, i1, i3});
+            triangles.push_back({i0, i3, i2});
+        }
+    }
+    std::mt19937 random(1234);
+    std::shuffle(triangles.begin(), triangles.end(), random);
+    for (const auto &triangle : triangles) {
+        meshData.indices.insert(meshData.indices.end(), triangle.begin(), triangle.end());
+    }
+    return meshData;
+}
+
+// The mesh as a sorted list of triangles spelled out by position, each
+// rotated to start at its smallest corner so the winding is kept but the
+// starting vertex doesn't matter.
+std::vector<std::array<float, 9>> TrianglePositions(const MeshData &meshData) {
+    std::vector<std::array<float, 9>> triangles;
+    for (size_t i = 0; i < meshData.indices.size(); i += 3) {
+        std::array<std::array<float, 3>, 3> corners;
+        for (size_t k = 0; k < 3; k++) {
+            const Vertex3D &v = meshData.vertices[meshData.indices[i + k]];
+            corners[k] = {v.x, v.y, v.z};
+        }
+        const auto first = std::min_element(corners.begin(), corners.end());
+        std::rotate(corners.begin(), first, corners.end());
+        std::array<float, 9> triangle;
+        for (size_t k = 0; k < 3; k++) {
+            std::copy(corners[k].begin(), corners[k].end(), triangle.begin() + k * 3);
+        }
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// A closed UV sphere of unit radius with one vertex per position, so it
+// has no borders or seams for the simplifier to keep.
+MeshData MakeWeldedSphere(int rings, int segments) {
+    MeshData meshData;
+    const auto addVertex = [&meshData](float theta, float phi) {
+        Vertex3D vertex{};
+        vertex.x = std::sin(theta) * std::cos(phi);
+        vertex.y = std::cos(theta);
+        vertex.z = std::sin(theta) * std::sin(phi);
+        vertex.nx = vertex.x;
+        vertex.ny = vertex.y;
+        vertex.nz = vertex.z;
+        meshData.vertices.push_back(vertex);
+    };
+    const float pi = 3.14159265f;
+    addVertex(0.0f, 0.0f);
+    for (int r = 1; r < rings; r++) {
+        for (int s = 0; s < segments; s++) {
+            addVertex(pi * r / rings, 2.0f * pi * s / segments);
+        }
+    }
+    addVertex(pi, 0.0f);
+
+    const uint32_t bottom = static_cast<uint32_t>(meshData.vertices.size() - 1);
+    const auto ringVertex = [segments](int r, int s) {
+        return static_cast<uint32_t>(1 + (r - 1) * segments + s % segments);
+    };
+    for (int s = 0; s < segments; s++) {
+        meshData.indices.insert(
+            meshData.indices.end(), {0, ringVertex(1, s + 1), ringVertex(1, s)});
+        meshData.indices.insert(meshData.indices.end(),
+            {bottom, ringVertex(rings - 1, s), ringVertex(rings - 1, s + 1)});
+    }
+    for (int r = 1; r < rings - 1; r++) {
+        for (int s = 0; s < segments; s++) {
+            const uint32_t i0 = ringVertex(r, s);
+            const uint32_t i1 = ringVertex(r, s + 1);
+            const uint32_t i2 = ringVertex(r + 1, s);
+            const uint32_t i3 = ringVertex(r + 1, s + 1);
+            meshData.indices.insert(meshData.indices.end(), {i0, i1, i3});
+            meshData.indices.insert(meshData.indices.end(), {i0, i3, i2});
+        }
+    }
+    return meshData;
+}
+
+// Twice the signed area of each triangle, seen from +Z.
+std::vector<float> FacingZ(const MeshData &meshData, const std::vector<uint32_t> &indices) {
+    std::vector<float> areas;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        const Vertex3D &a = meshData.vertices[indices[i + 0]];
+        const Vertex3D &b = meshData.vertices[indices[i + 1]];
+        const Vertex3D &c = meshData.vertices[indices[i + 2]];
+        areas.push_back((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x));
+    }
+    return areas;
+}
+
+} // namespace
+
+TEST_CASE("OptimizeVertexCache lowers the miss ratio of a shuffled grid") {
+    MeshData meshData = MakeShuffledGrid(32);
+    const VertexCacheStatistics before =
+        AnalyzeVertexCache(meshData.indices, meshData.vertices.size());
+
+    OptimizeVertexCache(meshData.indices, meshData.vertices.size());
+    const VertexCacheStatistics after =
+        AnalyzeVertexCache(meshData.indices, meshData.vertices.size());
+
+    MESSAGE("ACMR " << before.acmr << " -> " << after.acmr << ", ATVR " << before.atvr << " -> "
+                    << after.atvr);
+    CHECK(before.acmr > 2.0f);
+    CHECK(after.acmr < 0.8f);
+    CHECK(after.atvr < 1.5f);
+}
+
+TEST_CASE("OptimizeMeshData keeps every triangle and its winding") {
+    MeshData meshData = MakeShuffledGrid(32);
+    const auto expected = TrianglePositions(meshData);
+    const float beforeAcmr = AnalyzeVertexCache(meshData.indices, meshData.vertices.size()).acmr;
+
+    OptimizeMeshData(meshData);
+    const float afterAcmr = AnalyzeVertexCache(meshData.indices, meshData.vertices.size()).acmr;
+
+    MESSAGE("ACMR with every stage " << beforeAcmr << " -> " << afterAcmr);
+    CHECK(afterAcmr < 0.8f);
+    CHECK(meshData.vertices.size() == 33 * 33);
+    CHECK(TrianglePositions(meshData) == expected);
+}
+
+TEST_CASE("OptimizeOverdraw costs the vertex cache no more than its threshold") {
+    // A closed box whose faces are finely tessellated, so it splits into
+    // many clusters.
+    MeshData meshData;
+    for (int face = 0; face < 6; face++) {
+        MeshData grid = MakeShuffledGrid(8);
+        const uint32_t base = static_cast<uint32_t>(meshData.vertices.size());
+        for (Vertex3D vertex : grid.vertices) {
+            const float a = vertex.x - 4.0f;
+            const float b = vertex.y - 4.0f;
+            const float sign = face % 2 == 0 ? 1.0f : -1.0f;
+            const float p[3] = {face < 2 ? 4.0f * sign : a,
+                face < 2 ? a : (face < 4 ? 4.0f * sign : b),
+                face < 4 ? b : 4.0f * sign};
+            vertex.x = p[0];
+            vertex.y = p[1];
+            vertex.z = p[2];
+            meshData.vertices.push_back(vertex);
+        }
+        for (uint32_t index : grid.indices) {
+            meshData.indices.push_back(base + index);
+        }
+    }
+    OptimizeVertexCache(meshData.indices, meshData.vertices.size());
+    const auto expected = TrianglePositions(meshData);
+    const float beforeAcmr =
+        AnalyzeVertexCache(meshData.indices, meshData.vertices.size(), 16).acmr;
+
+    OptimizeOverdraw(meshData, 1.05f);
+    const float afterAcmr =
+        AnalyzeVertexCache(meshData.indices, meshData.vertices.size(), 16).acmr;
+
+    MESSAGE("ACMR after overdraw ordering " << beforeAcmr << " -> " << afterAcmr);
+    CHECK(afterAcmr <= beforeAcmr * 1.1f);
+    CHECK(TrianglePositions(meshData) == expected);
+}
+
+TEST_CASE("DeduplicateVertices merges identical vertices only") {
+    // Unindexed triangles, as some exporters write them.
+    MeshData source = MakeShuffledGrid(4);
+    MeshData meshData;
+    for (uint32_t index : source.indices) {
+        meshData.indices.push_back(static_cast<uint32_t>(meshData.vertices.size()));
+        meshData.vertices.push_back(source.vertices[index]);
+    }
+    const auto expected = TrianglePositions(meshData);
+
+    CHECK(DeduplicateVertices(meshData) == 25);
+    CHECK(meshData.vertices.size() == 25);
+    CHECK(TrianglePositions(meshData) == expected);
+
+    // Skinned vertices at the same place but bound to different joints
+    // stay apart.
+    SkinnedMeshData skinned;
+    Vertex3DSkinned vertex{};
+    vertex.w0 = 1.0f;
+    skinned.vertices = {vertex, vertex, vertex};
+    skinned.vertices[2].j0 = 1;
+    skinned.indices = {0, 1, 2};
+    CHECK(DeduplicateVertices(skinned) == 2);
+    CHECK(skinned.indices == std::vector<uint32_t>{0, 0, 1});
+}
+
+TEST_CASE("OptimizeVertexFetch orders vertices by first use and drops unused ones") {
+    MeshData meshData;
+    for (int i = 0; i < 5; i++) {
+        Vertex3D vertex{};
+        vertex.x = static_cast<float>(i);
+        meshData.vertices.push_back(vertex);
+    }
+    meshData.indices = {3, 1, 4, 4, 1, 0};
+
+    CHECK(OptimizeVertexFetch(meshData) == 4);
+    CHECK(meshData.indices == std::vector<uint32_t>{0, 1, 2, 2, 1, 3});
+    REQUIRE(meshData.vertices.size() == 4);
+    CHECK(meshData.vertices[0].x == 3.0f);
+    CHECK(meshData.vertices[1].x == 1.0f);
+    CHECK(meshData.vertices[2].x == 4.0f);
+    CHECK(meshData.vertices[3].x == 0.0f);
+}
+
+TEST_CASE("SimplifyIndices flattens a grid without moving its surface or border") {
+    const MeshData grid = MakeShuffledGrid(16);
+    float error = -1.0f;
+    const std::vector<uint32_t> simplified =
+        SimplifyIndices(grid.vertices, grid.indices, 0, 0.01f, &error);
+
+    // Only the 64 border vertices are locked, and a fan over them needs
+    // 62 triangles; every interior vertex can go.
+    CHECK(simplified.size() < grid.indices.size() / 4);
+    CHECK(error == doctest::Approx(0.0f));
+    float area = 0.0f;
+    for (float facing : FacingZ(grid, simplified)) {
+        CHECK(facing > 0.0f);
+        area += facing * 0.5f;
+    }
+    CHECK(area == doctest::Approx(256.0f));
+}
+
+TEST_CASE("SimplifyIndices keeps vertices on attribute seams") {
+    // Every corner of the cube is three vertices with different normals.
+    const MeshData cube = MakeCubeMeshData();
+    const std::vector<uint32_t> simplified =
+        SimplifyIndices(cube.vertices, cube.indices, 0, 1.0f);
+    CHECK(simplified == cube.indices);
+}
+
+TEST_CASE("GenerateMeshLods builds coarser levels within the error budget") {
+    MeshData sphere = MakeWeldedSphere(24, 48);
+    GenerateMeshLods(sphere, 0.05f);
+
+    REQUIRE(sphere.lods.size() >= 2);
+    CHECK(sphere.lods.size() <= MaxMeshLods - 1);
+    size_t previousCount = sphere.indices.size();
+    float previousError = 0.0f;
+    for (const MeshLodData &lod : sphere.lods) {
+        CHECK(lod.indices.size() % 3 == 0);
+        CHECK(lod.indices.size() <= previousCount * 3 / 4);
+        CHECK(lod.error >= previousError);
+        // The sphere's bounding diagonal is 2 * sqrt(3).
+        CHECK(lod.error <= 0.05f * 2.0f * std::sqrt(3.0f));
+        for (uint32_t index : lod.indices) {
+            CHECK(index < sphere.vertices.size());
+        }
+        previousCount = lod.indices.size();
+        previousError = lod.error;
+    }
+
+    // A mesh this small stays as it is.
+    MeshData cube = MakeCubeMeshData();
+    GenerateMeshLods(cube);
+    CHECK(cube.lods.empty());
+}
+
+TEST_CASE("BuildMeshlets covers every triangle once within the meshlet limits") {
+    MeshData sphere = MakeWeldedSphere(24, 48);
+    OptimizeMeshData(sphere);
+    const std::vector<std::array<float, 9>> before = TrianglePositions(sphere);
+    BuildMeshlets(sphere, 64, 48);
+
+    // The same triangles, each meshlet a contiguous run.
+    CHECK(TrianglePositions(sphere) == before);
+    REQUIRE(sphere.meshlets.size() >= sphere.indices.size() / 3 / 64);
+    uint32_t nextIndex = 0;
+    for (const Meshlet &meshlet : sphere.meshlets) {
+        CHECK(meshlet.firstIndex == nextIndex);
+        CHECK(meshlet.indexCount > 0);
+        CHECK(meshlet.indexCount <= 64 * 3);
+        nextIndex += meshlet.indexCount;
+
+        std::vector<uint32_t> used(sphere.indices.begin() + meshlet.firstIndex,
+            sphere.indices.begin() + meshlet.firstIndex + meshlet.indexCount);
+        std::sort(used.begin(), used.end());
+        CHECK(std::unique(used.begin(), used.end()) - used.begin() <= 48);
+
+        // The sphere holds every vertex, and the cone every face normal.
+        for (const uint32_t index : used) {
+            const Vertex3D &vertex = sphere.vertices[index];
+            const glm::vec3 position(vertex.x, vertex.y, vertex.z);
+            CHECK(glm::length(position - meshlet.center) <= meshlet.radius + 1e-5f);
+        }
+        for (uint32_t i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount;
+             i += 3) {
+            const auto position = [&sphere](uint32_t index) {
+                const Vertex3D &vertex = sphere.vertices[index];
+                return glm::vec3(vertex.x, vertex.y, vertex.z);
+            };
+            const glm::vec3 a = position(sphere.indices[i]);
+            const glm::vec3 normal = glm::normalize(glm::cross(
+                position(sphere.indices[i + 1]) - a, position(sphere.indices[i + 2]) - a));
+            CHECK(glm::dot(normal, meshlet.coneAxis) >= meshlet.coneCutoff - 1e-5f);
+        }
+
+        // Small patches of a sphere face one way, so most can be culled.
+        CHECK(meshlet.coneCutoff > 0.5f);
+    }
+    CHECK(nextIndex == sphere.indices.size());
+}
+
+TEST_CASE("BuildMeshlets keeps each meshlet ordered for the vertex cache") {
+    MeshData sphere = MakeWeldedSphere(48, 96);
+    OptimizeMeshData(sphere);
+    const float beforeAcmr = AnalyzeVertexCache(sphere.indices, sphere.vertices.size()).acmr;
+    BuildMeshlets(sphere);
+    const float afterAcmr = AnalyzeVertexCache(sphere.indices, sphere.vertices.size()).acmr;
+    CHECK(afterAcmr < beforeAcmr * 1.1f);
+}
@@ -64,3 +64,32 @@ TEST_CASE("MakePlaneMeshData returns 4 vertices and 6 indices, all +Y normal") {
         CHECK(v.nz == doctest::Approx(0.0f));
     }
 }
+
+TEST_CASE("SelectMeshLod picks the coarsest level within the pixel error") {
+    const MeshLod lods[3] = {{0, 300, 0.0f}, {300, 150, 0.01f}, {450, 75, 0.1f}};
+    CHECK(SelectMeshLod(lods, 3, 1000.0f, 1.0f) == 0);
+    CHECK(SelectMeshLod(lods, 3, 100.0f, 1.0f) == 1);
+    CHECK(SelectMeshLod(lods, 3, 5.0f, 1.0f) == 2);
+    CHECK(SelectMeshLod(lods, 3, 5.0f, 0.0f) == 0);
+    CHECK(SelectMeshLod(lods, 1, 0.0f, 1.0f) == 0);
+}
+
+TEST_CASE("IsMeshletBackfacing culls only clusters facing wholly away from the viewer") {
+    // A flat-ish patch at the origin facing +Z, normals within 30 degrees.
+    Meshlet meshlet;
+    meshlet.center = glm::vec3(0.0f);
+    meshlet.radius = 1.0f;
+    meshlet.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+    meshlet.coneCutoff = 0.866f;
+
+    CHECK_FALSE(IsMeshletBackfacing(meshlet, glm::vec3(0.0f, 0.0f, 10.0f)));
+    CHECK(IsMeshletBackfacing(meshlet, glm::vec3(0.0f, 0.0f, -10.0f)));
+
+    // Seen edge-on, some triangles may still face the viewer.
+    CHECK_FALSE(IsMeshletBackfacing(meshlet, glm::vec3(10.0f, 0.0f, -1.0f)));
+
+    // Too close, or too curved, to decide.
+    CHECK_FALSE(IsMeshletBackfacing(meshlet, glm::vec3(0.0f, 0.0f, -0.5f)));
+    meshlet.coneCutoff = 0.0f;
+    CHECK_FALSE(IsMeshletBackfacing(meshlet, glm::vec3(0.0f, 0.0f, -10.0f)));
+}
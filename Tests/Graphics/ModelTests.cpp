@@ -0,0 +1,47 @@
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <Lucky/Model.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+std::vector<NodeTemplate> MakeNodes(const std::vector<int> &parents) {
+    std::vector<NodeTemplate> nodes(parents.size());
+    for (size_t i = 0; i < parents.size(); i++) {
+        nodes[i].parentIndex = parents[i];
+    }
+    return nodes;
+}
+
+} // namespace
+
+TEST_CASE("SortNodesParentFirst keeps an already ordered hierarchy as it is") {
+    const std::vector<NodeTemplate> nodes = MakeNodes({-1, 0, 1, 0, -1});
+    CHECK(SortNodesParentFirst(nodes) == std::vector<int>{0, 1, 2, 3, 4});
+}
+
+TEST_CASE("SortNodesParentFirst moves parents ahead of their children") {
+    // 0 is a child of 3, which is a child of 2; 1 is a root.
+    const std::vector<NodeTemplate> nodes = MakeNodes({3, -1, -1, 2, 0});
+    const std::vector<int> order = SortNodesParentFirst(nodes);
+    CHECK(order == std::vector<int>{2, 3, 0, 1, 4});
+
+    std::vector<int> position(nodes.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        position[order[i]] = static_cast<int>(i);
+    }
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i].parentIndex >= 0) {
+            CHECK(position[nodes[i].parentIndex] < position[i]);
+        }
+    }
+}
+
+TEST_CASE("SortNodesParentFirst returns every node once despite a cycle") {
+    // 0 -> 1 -> 2 -> 0 loops; 3 hangs off the loop and 4 is a root.
+    const std::vector<NodeTemplate> nodes = MakeNodes({1, 2, 0, 2, -1});
+    CHECK(SortNodesParentFirst(nodes) == std::vector<int>{2, 1, 0, 3, 4});
+}
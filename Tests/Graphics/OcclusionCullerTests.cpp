@@ -0,0 +1,116 @@
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Lucky/OcclusionCuller.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+// Camera at the origin looking down -Z.
+glm::mat4 TestViewProjection() {
+    const glm::mat4 projection =
+        glm::perspectiveRH_ZO(glm::radians(90.0f), 2.0f, 0.1f, 100.0f);
+    const glm::mat4 view =
+        glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+
+// A square in the XY plane, `halfSize` across, facing +Z.
+OccluderMesh MakeQuad(float halfSize) {
+    OccluderMesh quad;
+    quad.positions = {
+        {-halfSize, -halfSize, 0.0f},
+        {halfSize, -halfSize, 0.0f},
+        {halfSize, halfSize, 0.0f},
+        {-halfSize, halfSize, 0.0f},
+    };
+    quad.indices = {0, 1, 2, 0, 2, 3};
+    return quad;
+}
+
+BoundingBox MakeBox(const glm::vec3 &center, float halfSize) {
+    BoundingBox box;
+    box.min = center - glm::vec3(halfSize);
+    box.max = center + glm::vec3(halfSize);
+    return box;
+}
+
+} // namespace
+
+TEST_CASE("OcclusionCuller reports everything visible with no occluders") {
+    OcclusionCuller culler(64, 32);
+    culler.Begin(TestViewProjection());
+    CHECK(culler.IsVisible(MakeBox({0.0f, 0.0f, -10.0f}, 1.0f)));
+    CHECK_FALSE(culler.IsVisible(BoundingBox{}));
+}
+
+TEST_CASE("OcclusionCuller hides boxes fully behind an occluder") {
+    OcclusionCuller culler(64, 32);
+    culler.Begin(TestViewProjection());
+    culler.RasterizeOccluder(
+        MakeQuad(2.0f), glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -5.0f)));
+
+    CHECK(culler.GetDepth(32, 16) < 1.0f);
+    CHECK(culler.GetDepth(0, 0) == 1.0f);
+
+    // Behind the wall and within its silhouette.
+    CHECK_FALSE(culler.IsVisible(MakeBox({0.0f, 0.0f, -10.0f}, 1.0f)));
+    // In front of it.
+    CHECK(culler.IsVisible(MakeBox({0.0f, 0.0f, -3.0f}, 0.5f)));
+    // Behind it but poking out past its edge.
+    CHECK(culler.IsVisible(MakeBox({4.0f, 0.0f, -10.0f}, 1.0f)));
+    // Behind it and off to the side.
+    CHECK(culler.IsVisible(MakeBox({12.0f, 0.0f, -10.0f}, 1.0f)));
+}
+
+TEST_CASE("OcclusionCuller keeps objects when the geometry crosses the near plane") {
+    OcclusionCuller culler(64, 32);
+    culler.Begin(TestViewProjection());
+
+    // A wall rotated to run from behind the camera into the scene is
+    // skipped rather than clipped.
+    const glm::mat4 throughEye = glm::rotate(
+        glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -2.0f)),
+        glm::radians(80.0f),
+        glm::vec3(1.0f, 0.0f, 0.0f));
+    culler.RasterizeOccluder(MakeQuad(4.0f), throughEye);
+    CHECK(culler.IsVisible(MakeBox({0.0f, 0.0f, -10.0f}, 1.0f)));
+
+    // A box around the eye is always visible.
+    culler.RasterizeOccluder(
+        MakeQuad(2.0f), glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -5.0f)));
+    CHECK(culler.IsVisible(MakeBox({0.0f, 0.0f, 0.0f}, 1.0f)));
+}
+
+TEST_CASE("OcclusionCuller::Begin clears the previous frame's occluders") {
+    OcclusionCuller culler(64, 32);
+    culler.Begin(TestViewProjection());
+    culler.RasterizeOccluder(
+        MakeQuad(2.0f), glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -5.0f)));
+    REQUIRE_FALSE(culler.IsVisible(MakeBox({0.0f, 0.0f, -10.0f}, 1.0f)));
+
+    culler.Begin(TestViewProjection());
+    CHECK(culler.IsVisible(MakeBox({0.0f, 0.0f, -10.0f}, 1.0f)));
+    CHECK(culler.GetWidth() == 64);
+    CHECK(culler.GetHeight() == 32);
+}
+
+TEST_CASE("OcclusionCuller clamps screen coordinates too large for 32 bits") {
+    // Both project billions of pixels past the buffer's right and bottom
+    // edges, so only a clamp done before the integer conversion keeps
+    // the last column and row in range.
+    OcclusionCuller culler(64, 32);
+    culler.Begin(TestViewProjection());
+    culler.RasterizeOccluder(
+        MakeQuad(1e12f), glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -5.0f)));
+    CHECK(culler.GetDepth(0, 0) < 1.0f);
+    CHECK(culler.GetDepth(63, 31) < 1.0f);
+
+    BoundingBox wide;
+    wide.min = glm::vec3(-1e12f, -1e12f, -20.0f);
+    wide.max = glm::vec3(1e12f, 1e12f, -10.0f);
+    CHECK_FALSE(culler.IsVisible(wide));
+}
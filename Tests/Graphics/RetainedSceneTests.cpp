@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Lucky/RetainedScene.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+SceneObject MakeObject(float x) {
+    SceneObject object;
+    object.transform = glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, 0.0f));
+    return object;
+}
+
+float PositionOf(const SceneObject &object) {
+    return object.transform[3].x;
+}
+
+std::vector<uint32_t> SortedChanges(const RetainedScene &scene) {
+    std::vector<uint32_t> changes = scene.GetChangedObjects();
+    std::sort(changes.begin(), changes.end());
+    return changes;
+}
+
+} // namespace
+
+TEST_CASE("RetainedScene handles survive removals of other objects") {
+    RetainedScene scene;
+    const SceneObjectHandle a = scene.AddObject(MakeObject(1.0f));
+    const SceneObjectHandle b = scene.AddObject(MakeObject(2.0f));
+    const SceneObjectHandle c = scene.AddObject(MakeObject(3.0f));
+    CHECK(scene.GetScene().objects.size() == 3);
+
+    CHECK(scene.RemoveObject(a));
+    CHECK_FALSE(scene.Contains(a));
+    CHECK_FALSE(scene.RemoveObject(a));
+    CHECK(scene.GetScene().objects.size() == 2);
+
+    // The last object moved into the hole; its handle follows it.
+    CHECK(scene.GetObjectIndex(c) == 0);
+    CHECK(PositionOf(scene.GetObject(b)) == 2.0f);
+    CHECK(PositionOf(scene.GetObject(c)) == 3.0f);
+}
+
+TEST_CASE("RetainedScene never resolves a stale handle to a reused slot") {
+    RetainedScene scene;
+    const SceneObjectHandle old = scene.AddObject(MakeObject(1.0f));
+    scene.RemoveObject(old);
+    const SceneObjectHandle reused = scene.AddObject(MakeObject(2.0f));
+    CHECK(reused.slot == old.slot);
+    CHECK_FALSE(scene.Contains(old));
+    CHECK(scene.Contains(reused));
+    CHECK_FALSE(scene.Contains(SceneObjectHandle{}));
+}
+
+TEST_CASE("RetainedScene lists each changed position once") {
+    RetainedScene scene;
+    const SceneObjectHandle a = scene.AddObject(MakeObject(1.0f));
+    const SceneObjectHandle b = scene.AddObject(MakeObject(2.0f));
+    const SceneObjectHandle c = scene.AddObject(MakeObject(3.0f));
+    CHECK(SortedChanges(scene) == std::vector<uint32_t>{0, 1, 2});
+
+    scene.ClearChanges();
+    CHECK(scene.GetChangedObjects().empty());
+
+    scene.SetObjectTransform(b, glm::mat4(1.0f));
+    scene.SetObjectTransform(b, glm::translate(glm::mat4(1.0f), glm::vec3(5.0f)));
+    CHECK(SortedChanges(scene) == std::vector<uint32_t>{1});
+    CHECK(PositionOf(scene.GetObject(b)) == 5.0f);
+
+    // Removing `a` moves `c` to position 0; position 2 no longer exists.
+    scene.ClearChanges();
+    scene.SetObjectTransform(c, glm::mat4(1.0f));
+    scene.RemoveObject(a);
+    CHECK(SortedChanges(scene) == std::vector<uint32_t>{0});
+
+    // Removing the last object leaves nothing to refresh.
+    scene.ClearChanges();
+    scene.RemoveObject(b);
+    CHECK(scene.GetChangedObjects().empty());
+    CHECK(scene.GetScene().objects.size() == 1);
+}
+
+TEST_CASE("RetainedScene tracks skinned objects by handle and clears everything") {
+    RetainedScene scene;
+    scene.GetLights().push_back(Light{});
+    SkinnedSceneObject skinned;
+    skinned.color = {1.0f, 0.0f, 0.0f};
+    const SkinnedSceneObjectHandle first = scene.AddSkinnedObject(skinned);
+    skinned.color = {0.0f, 1.0f, 0.0f};
+    const SkinnedSceneObjectHandle second = scene.AddSkinnedObject(skinned);
+
+    CHECK(scene.RemoveSkinnedObject(first));
+    CHECK(scene.Contains(second));
+    CHECK(scene.GetScene().skinnedObjects.size() == 1);
+    CHECK(scene.GetScene().skinnedObjects[0].color.y == 1.0f);
+
+    const SceneObjectHandle object = scene.AddObject(MakeObject(1.0f));
+    scene.Clear();
+    CHECK_FALSE(scene.Contains(object));
+    CHECK_FALSE(scene.Contains(second));
+    CHECK(scene.GetScene().objects.empty());
+    CHECK(scene.GetChangedObjects().empty());
+    CHECK(scene.GetScene().lights.size() == 1);
+}
+
+TEST_CASE("RetainedScene change epochs are unique and chain through ClearChanges") {
+    RetainedScene a;
+    RetainedScene b;
+    CHECK(a.GetChangeEpoch() != 0);
+    CHECK(a.GetChangeEpoch() != b.GetChangeEpoch());
+    CHECK(a.GetPreviousChangeEpoch() == 0);
+
+    const uint64_t first = a.GetChangeEpoch();
+    a.AddObject(MakeObject(1.0f));
+    CHECK(a.GetChangeEpoch() == first);
+
+    a.ClearChanges();
+    CHECK(a.GetPreviousChangeEpoch() == first);
+    const uint64_t second = a.GetChangeEpoch();
+    CHECK(second != first);
+    CHECK(second != b.GetChangeEpoch());
+
+    // Two clears leave a consumer at `first` with no way to catch up.
+    a.ClearChanges();
+    CHECK(a.GetPreviousChangeEpoch() == second);
+    CHECK(a.GetChangeEpoch() != first);
+}
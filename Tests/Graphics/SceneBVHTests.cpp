@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Lucky/Bounds.hpp>
+#include <Lucky/SceneBVH.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+BoundingBox MakeBox(const glm::vec3 &min, const glm::vec3 &max) {
+    BoundingBox box;
+    box.min = min;
+    box.max = max;
+    return box;
+}
+
+// Unit cubes on a `side` x `side` grid in the XZ plane, two units apart.
+std::vector<BoundingBox> MakeGrid(int side) {
+    std::vector<BoundingBox> boxes;
+    for (int z = 0; z < side; z++) {
+        for (int x = 0; x < side; x++) {
+            const glm::vec3 center(x * 2.0f, 0.0f, z * 2.0f);
+            boxes.push_back(MakeBox(center - glm::vec3(0.5f), center + glm::vec3(0.5f)));
+        }
+    }
+    return boxes;
+}
+
+Frustum MakeTestFrustum() {
+    const glm::mat4 view = glm::lookAt(
+        glm::vec3(10.0f, 5.0f, -5.0f), glm::vec3(10.0f, 0.0f, 10.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 proj = glm::perspectiveRH_ZO(glm::radians(60.0f), 1.0f, 0.1f, 30.0f);
+    return MakeFrustum(proj * view);
+}
+
+std::vector<uint32_t> Sorted(std::vector<uint32_t> items) {
+    std::sort(items.begin(), items.end());
+    return items;
+}
+
+template <typename Overlaps>
+std::vector<uint32_t> BruteForce(const std::vector<BoundingBox> &boxes, const Overlaps &overlaps) {
+    std::vector<uint32_t> items;
+    for (uint32_t i = 0; i < boxes.size(); i++) {
+        if (!boxes[i].IsEmpty() && overlaps(boxes[i])) {
+            items.push_back(i);
+        }
+    }
+    return items;
+}
+
+} // namespace
+
+TEST_CASE("SceneBVH frustum and sphere queries match a linear scan") {
+    std::vector<BoundingBox> boxes = MakeGrid(20);
+    boxes[7] = BoundingBox{};
+    SceneBVH bvh;
+    bvh.Build(boxes);
+    CHECK(bvh.GetItemCount() == boxes.size());
+
+    const Frustum frustum = MakeTestFrustum();
+    std::vector<uint32_t> visible;
+    bvh.QueryFrustum(frustum, visible);
+    const std::vector<uint32_t> expected =
+        BruteForce(boxes, [&](const BoundingBox &box) { return IntersectsFrustum(box, frustum); });
+    CHECK_FALSE(expected.empty());
+    CHECK(Sorted(visible) == expected);
+
+    std::vector<uint32_t> nearby;
+    bvh.QuerySphere({6.0f, 0.0f, 6.0f}, 2.0f, nearby);
+    CHECK(Sorted(nearby) == BruteForce(boxes, [](const BoundingBox &box) {
+        return IntersectsSphere(box, {6.0f, 0.0f, 6.0f}, 2.0f);
+    }));
+    CHECK(nearby.size() == 5);
+}
+
+TEST_CASE("SceneBVH raycast returns the nearest box entered") {
+    const std::vector<BoundingBox> boxes = MakeGrid(10);
+    SceneBVH bvh;
+    bvh.Build(boxes);
+
+    // Along the first row from the -X side: cube 0 is entered first.
+    Ray ray;
+    ray.origin = {-5.0f, 0.0f, 0.0f};
+    ray.direction = {1.0f, 0.0f, 0.0f};
+    SceneBVHHit hit;
+    REQUIRE(bvh.Raycast(ray, 100.0f, hit));
+    CHECK(hit.item == 0);
+    CHECK(hit.distance == doctest::Approx(4.5f));
+
+    std::vector<uint32_t> crossed;
+    bvh.QueryRay(ray, 100.0f, crossed);
+    CHECK(crossed.size() == 10);
+
+    // Too short to reach, and pointing away.
+    CHECK_FALSE(bvh.Raycast(ray, 4.0f, hit));
+    ray.direction = {-1.0f, 0.0f, 0.0f};
+    CHECK_FALSE(bvh.Raycast(ray, 100.0f, hit));
+
+    // Starting inside a box hits it at zero.
+    ray.origin = {2.0f, 0.0f, 2.0f};
+    ray.direction = {0.0f, 1.0f, 0.0f};
+    REQUIRE(bvh.Raycast(ray, 100.0f, hit));
+    CHECK(hit.item == 11);
+    CHECK(hit.distance == 0.0f);
+}
+
+TEST_CASE("SceneBVH refit follows moved items") {
+    const std::vector<BoundingBox> boxes = MakeGrid(8);
+    SceneBVH bvh;
+    bvh.Build(boxes);
+    const uint32_t nodeCount = bvh.GetNodeCount();
+
+    // Move item 0 far out along +Y; queries see it only after Refit.
+    const BoundingBox moved = MakeBox({-0.5f, 99.5f, -0.5f}, {0.5f, 100.5f, 0.5f});
+    bvh.SetItemBounds(0, moved);
+    bvh.Refit();
+    CHECK(bvh.GetNodeCount() == nodeCount);
+    CHECK(bvh.GetBounds().max.y == doctest::Approx(100.5f));
+
+    std::vector<uint32_t> found;
+    bvh.QuerySphere({0.0f, 100.0f, 0.0f}, 1.0f, found);
+    CHECK(found == std::vector<uint32_t>{0});
+    found.clear();
+    bvh.QuerySphere({0.0f, 0.0f, 0.0f}, 0.6f, found);
+    CHECK(found.empty());
+
+    // Emptied items drop out of every query.
+    bvh.SetItemBounds(0, BoundingBox{});
+    bvh.Refit();
+    Ray ray;
+    ray.origin = {0.0f, 200.0f, 0.0f};
+    ray.direction = {0.0f, -1.0f, 0.0f};
+    found.clear();
+    bvh.QueryRay(ray, 1000.0f, found);
+    CHECK(found.empty());
+}
+
+TEST_CASE("SceneBVH handles empty and single-item trees") {
+    SceneBVH bvh;
+    bvh.Build(std::vector<BoundingBox>{});
+    std::vector<uint32_t> found;
+    bvh.QuerySphere({0.0f, 0.0f, 0.0f}, 100.0f, found);
+    CHECK(found.empty());
+    CHECK(bvh.GetBounds().IsEmpty());
+
+    bvh.Build(std::vector<BoundingBox>{MakeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f})});
+    bvh.QuerySphere({0.0f, 0.0f, 0.0f}, 0.1f, found);
+    CHECK(found == std::vector<uint32_t>{0});
+}
+
+// Timing comparison against linear scans; skipped by default, run with
+// --no-skip.
+TEST_CASE("SceneBVH benchmark at 100k objects" * doctest::skip()) {
+    using Clock = std::chrono::steady_clock;
+    auto milliseconds = [](Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+
+    const std::vector<BoundingBox> boxes = MakeGrid(317); // ~100k
+    const Frustum frustum = MakeTestFrustum();
+
+    Clock::time_point start = Clock::now();
+    SceneBVH bvh;
+    bvh.Build(boxes);
+    const double buildTime = milliseconds(Clock::now() - start);
+
+    constexpr int Iterations = 100;
+    std::vector<uint32_t> visible;
+    start = Clock::now();
+    for (int i = 0; i < Iterations; i++) {
+        visible.clear();
+        bvh.QueryFrustum(frustum, visible);
+    }
+    const double bvhTime = milliseconds(Clock::now() - start) / Iterations;
+
+    std::vector<uint32_t> expected;
+    start = Clock::now();
+    for (int i = 0; i < Iterations; i++) {
+        expected = BruteForce(
+            boxes, [&](const BoundingBox &box) { return IntersectsFrustum(box, frustum); });
+    }
+    const double linearTime = milliseconds(Clock::now() - start) / Iterations;
+    CHECK(Sorted(visible) == expected);
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < boxes.size(); i += 10) {
+        bvh.SetItemBounds(i, MakeBox(boxes[i].min + 0.25f, boxes[i].max + 0.25f));
+    }
+    bvh.Refit();
+    const double refitTime = milliseconds(Clock::now() - start);
+
+    MESSAGE("build " << buildTime << " ms, refit 10% " << refitTime << " ms, frustum query "
+                     << bvhTime << " ms vs linear " << linearTime << " ms ("
+                     << visible.size() << " of " << boxes.size() << " visible)");
+}
@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <Lucky/ShadowAtlas.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+bool Overlaps(const ShadowAtlasTile &a, const ShadowAtlasTile &b) {
+    return a.x < b.x + b.size && b.x < a.x + a.size && a.y < b.y + b.size && b.y < a.y + a.size;
+}
+
+} // namespace
+
+TEST_CASE("PackShadowAtlas places tiles without overlap inside the atlas") {
+    const std::vector<ShadowTileRequest> requests = {
+        {256, 1, 1.0f},
+        {1024, 1, 2.0f},
+        {512, 6, 3.0f},
+        {128, 1, 0.5f},
+    };
+    const ShadowAtlasLayout layout = PackShadowAtlas(requests, 2048, 128, 48);
+
+    REQUIRE(layout.firstTile.size() == 4);
+    REQUIRE(layout.tiles.size() == 9);
+    for (size_t i = 0; i < layout.tiles.size(); i++) {
+        const ShadowAtlasTile &tile = layout.tiles[i];
+        CHECK(tile.x % tile.size == 0);
+        CHECK(tile.y % tile.size == 0);
+        CHECK(tile.x + tile.size <= 2048);
+        CHECK(tile.y + tile.size <= 2048);
+        for (size_t j = i + 1; j < layout.tiles.size(); j++) {
+            CHECK_FALSE(Overlaps(tile, layout.tiles[j]));
+        }
+    }
+
+    // The largest tile claims the first cell; the point light's faces
+    // are stored consecutively.
+    const ShadowAtlasTile &big = layout.tiles[layout.firstTile[1]];
+    CHECK(big.x == 0);
+    CHECK(big.y == 0);
+    CHECK(big.size == 1024);
+    for (int face = 0; face < 6; face++) {
+        CHECK(layout.tiles[layout.firstTile[2] + face].size == 512);
+    }
+}
+
+TEST_CASE("PackShadowAtlas shrinks the least important request first") {
+    // Two 2048 tiles cannot share a 2048 atlas. The low-priority one
+    // halves all the way down to the minimum first; only then does the
+    // important one give up a level.
+    const std::vector<ShadowTileRequest> requests = {
+        {2048, 1, 10.0f},
+        {2048, 1, 1.0f},
+    };
+    const ShadowAtlasLayout layout = PackShadowAtlas(requests, 2048, 128, 48);
+
+    REQUIRE(layout.firstTile[0] >= 0);
+    REQUIRE(layout.firstTile[1] >= 0);
+    CHECK(layout.tiles[layout.firstTile[0]].size == 1024);
+    CHECK(layout.tiles[layout.firstTile[1]].size == 128);
+}
+
+TEST_CASE("PackShadowAtlas drops the least important request when nothing can shrink") {
+    const std::vector<ShadowTileRequest> requests = {
+        {128, 1, 5.0f},
+        {128, 1, 1.0f},
+        {128, 1, 3.0f},
+    };
+    const ShadowAtlasLayout layout = PackShadowAtlas(requests, 256, 128, 2);
+    CHECK(layout.firstTile[0] >= 0);
+    CHECK(layout.firstTile[1] == -1);
+    CHECK(layout.firstTile[2] >= 0);
+    CHECK(layout.tiles.size() == 2);
+}
+
+TEST_CASE("PackShadowAtlas is stable for unchanged requests") {
+    const std::vector<ShadowTileRequest> requests = {
+        {512, 1, 1.0f},
+        {512, 1, 2.0f},
+        {256, 6, 3.0f},
+    };
+    const ShadowAtlasLayout a = PackShadowAtlas(requests, 2048, 128, 48);
+    const ShadowAtlasLayout b = PackShadowAtlas(requests, 2048, 128, 48);
+    REQUIRE(a.tiles.size() == b.tiles.size());
+    for (size_t i = 0; i < a.tiles.size(); i++) {
+        CHECK(a.tiles[i].x == b.tiles[i].x);
+        CHECK(a.tiles[i].y == b.tiles[i].y);
+    }
+    // Equal sizes keep request order regardless of priority.
+    CHECK(a.tiles[a.firstTile[0]].x == 0);
+    CHECK(a.tiles[a.firstTile[0]].y == 0);
+}
+
+TEST_CASE("ShadowTileSizeForCoverage rounds up to a clamped power of two") {
+    CHECK(ShadowTileSizeForCoverage(0.0f, 128, 2048) == 128);
+    CHECK(ShadowTileSizeForCoverage(300.0f, 128, 2048) == 512);
+    CHECK(ShadowTileSizeForCoverage(512.0f, 128, 2048) == 512);
+    CHECK(ShadowTileSizeForCoverage(100000.0f, 128, 2048) == 2048);
+}
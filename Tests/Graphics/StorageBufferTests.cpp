@@ -0,0 +1,49 @@
+#include <cstdint>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <Lucky/StorageBuffer.hpp>
+
+using namespace Lucky;
+
+TEST_CASE("FindChangedRanges reports nothing for identical arrays") {
+    const std::vector<uint32_t> values = {1, 2, 3, 4};
+    const auto ranges = FindChangedRanges(values.data(), 4, values.data(), 4);
+    CHECK(ranges.empty());
+}
+
+TEST_CASE("FindChangedRanges treats every element as changed without a previous copy") {
+    const std::vector<uint32_t> values = {1, 2, 3};
+    const auto ranges = FindChangedRanges<uint32_t>(nullptr, 0, values.data(), 3);
+    REQUIRE(ranges.size() == 1);
+    CHECK(ranges[0].first == 0);
+    CHECK(ranges[0].count == 3);
+}
+
+TEST_CASE("FindChangedRanges merges runs closer than the gap and splits distant ones") {
+    std::vector<uint32_t> previous(20, 0);
+    std::vector<uint32_t> current = previous;
+    current[2] = 1;
+    current[4] = 1;  // one unchanged element between: merged
+    current[15] = 1; // far away: its own range
+
+    const auto ranges = FindChangedRanges(previous.data(), 20, current.data(), 20, 4);
+    REQUIRE(ranges.size() == 2);
+    CHECK(ranges[0].first == 2);
+    CHECK(ranges[0].count == 3);
+    CHECK(ranges[1].first == 15);
+    CHECK(ranges[1].count == 1);
+
+    const auto unmerged = FindChangedRanges(previous.data(), 20, current.data(), 20, 1);
+    CHECK(unmerged.size() == 3);
+}
+
+TEST_CASE("FindChangedRanges reports elements appended past the previous count") {
+    const std::vector<uint32_t> previous = {1, 2};
+    const std::vector<uint32_t> current = {1, 2, 3, 4};
+    const auto ranges = FindChangedRanges(previous.data(), 2, current.data(), 4);
+    REQUIRE(ranges.size() == 1);
+    CHECK(ranges[0].first == 2);
+    CHECK(ranges[0].count == 2);
+}
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include <doctest/doctest.h>
+
+#include <glm/glm.hpp>
+
+#include <Lucky/Mesh.hpp>
+#include <Lucky/VertexCompression.hpp>
+
+using namespace Lucky;
+
+TEST_CASE("Half floats round trip and round to nearest") {
+    // Values a half holds exactly come back unchanged.
+    for (float value : {0.0f, 1.0f, -2.5f, 0.125f, 1024.0f, 65504.0f}) {
+        CHECK(HalfToFloat(FloatToHalf(value)) == value);
+    }
+    CHECK(FloatToHalf(1.0f) == 0x3C00);
+    CHECK(FloatToHalf(-0.0f) == 0x8000);
+
+    // Halfway between 1 and the next half (1 + 2^-10) rounds to even.
+    CHECK(FloatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3C00);
+    CHECK(FloatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)) == 0x3C02);
+
+    // UVs in [0, 1] keep three decimal digits.
+    for (int i = 0; i <= 1000; i++) {
+        const float uv = static_cast<float>(i) / 1000.0f;
+        CHECK(std::abs(HalfToFloat(FloatToHalf(uv)) - uv) <= 0.0005f);
+    }
+
+    // Subnormals survive, and anything out of range saturates.
+    const float smallest = std::ldexp(1.0f, -24);
+    CHECK(FloatToHalf(smallest) == 0x0001);
+    CHECK(HalfToFloat(0x0001) == smallest);
+    CHECK(HalfToFloat(0x03FF) == std::ldexp(1023.0f, -24));
+    CHECK(FloatToHalf(1.0e6f) == 0x7C00);
+    CHECK(std::isinf(HalfToFloat(FloatToHalf(-std::numeric_limits<float>::infinity()))));
+    CHECK(std::isnan(HalfToFloat(FloatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST_CASE("Octahedral encoding keeps directions within a hundredth of a degree") {
+    // Directions spread over the whole sphere, including both poles and
+    // the folded lower hemisphere.
+    // The chord between unit vectors is the angle between them, to well
+    // within float precision at these sizes.
+    float worstChord = 0.0f;
+    for (int i = 0; i <= 64; i++) {
+        const float z = 1.0f - 2.0f * static_cast<float>(i) / 64.0f;
+        const float radius = std::sqrt(std::max(1.0f - z * z, 0.0f));
+        for (int j = 0; j < 64; j++) {
+            const float angle = static_cast<float>(j) * 6.2831853f / 64.0f;
+            const glm::vec3 direction(radius * std::cos(angle), radius * std::sin(angle), z);
+            int16_t x, y;
+            EncodeOctahedral(direction, x, y);
+            const glm::vec3 decoded = DecodeOctahedral(x, y);
+            CHECK(std::abs(glm::length(decoded) - 1.0f) < 1.0e-5f);
+            worstChord =
+                std::max(worstChord, glm::length(decoded - glm::normalize(direction)));
+        }
+    }
+    const float worstDegrees = worstChord * 57.29578f;
+    MESSAGE("worst error " << worstDegrees << " degrees");
+    CHECK(worstDegrees < 0.01f);
+
+    int16_t x, y;
+    EncodeOctahedral(glm::vec3(0.0f, 0.0f, -1.0f), x, y);
+    CHECK(DecodeOctahedral(x, y).z == doctest::Approx(-1.0f));
+}
+
+TEST_CASE("CompressVertex keeps the tangent's handedness exact") {
+    Vertex3D vertex{};
+    vertex.x = 1.5f;
+    vertex.u = 0.25f;
+    vertex.v = 0.75f;
+    vertex.ny = 1.0f;
+    vertex.tx = 1.0f;
+    vertex.tw = -1.0f;
+
+    const CompressedVertex3D packed = CompressVertex(vertex);
+    CHECK(packed.x == 1.5f);
+    CHECK(HalfToFloat(packed.u) == 0.25f);
+    CHECK(HalfToFloat(packed.v) == 0.75f);
+    CHECK(DecodeOctahedral(packed.nx, packed.ny).y == doctest::Approx(1.0f));
+    CHECK(DecodeOctahedral(packed.tx, packed.ty).x == doctest::Approx(1.0f));
+    CHECK(packed.tw == -32767);
+
+    vertex.tw = 1.0f;
+    CHECK(CompressVertex(vertex).tw == 32767);
+}
+
+TEST_CASE("QuantizeVertex positions decode within a step of the bounding box") {
+    BoundingBox bounds;
+    bounds.min = glm::vec3(-2.0f, 0.0f, 3.0f);
+    bounds.max = glm::vec3(6.0f, 0.0f, 3.5f);
+    const glm::vec3 extent = bounds.max - bounds.min;
+
+    for (int i = 0; i <= 10; i++) {
+        const float t = static_cast<float>(i) / 10.0f;
+        Vertex3D vertex{};
+        vertex.x = bounds.min.x + t * extent.x;
+        vertex.y = 0.0f;
+        vertex.z = bounds.min.z + (1.0f - t) * extent.z;
+        vertex.nz = 1.0f;
+
+        const QuantizedVertex3D packed = QuantizeVertex(vertex, bounds);
+        const glm::vec3 decoded =
+            bounds.min + glm::vec3(packed.x, packed.y, packed.z) / 65535.0f * extent;
+        CHECK(std::abs(decoded.x - vertex.x) <= extent.x / 65535.0f);
+        CHECK(std::abs(decoded.z - vertex.z) <= extent.z / 65535.0f);
+        // The flat Y axis quantizes to its only value.
+        CHECK(packed.y == 0);
+        CHECK(decoded.y == 0.0f);
+    }
+}
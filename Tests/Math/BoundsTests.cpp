@@ -0,0 +1,124 @@
+#include <cfloat>
+#include <cmath>
+
+#include <doctest/doctest.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Lucky/Bounds.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+BoundingBox MakeBox(const glm::vec3 &min, const glm::vec3 &max) {
+    BoundingBox box;
+    box.min = min;
+    box.max = max;
+    return box;
+}
+
+} // namespace
+
+TEST_CASE("Default BoundingBox is empty and grows with ExpandBounds") {
+    BoundingBox box;
+    CHECK(box.IsEmpty());
+
+    ExpandBounds(box, {1.0f, 2.0f, 3.0f});
+    CHECK_FALSE(box.IsEmpty());
+    CHECK(box.min == glm::vec3(1.0f, 2.0f, 3.0f));
+    CHECK(box.max == glm::vec3(1.0f, 2.0f, 3.0f));
+
+    ExpandBounds(box, {-1.0f, 4.0f, 0.0f});
+    CHECK(box.min == glm::vec3(-1.0f, 2.0f, 0.0f));
+    CHECK(box.max == glm::vec3(1.0f, 4.0f, 3.0f));
+}
+
+TEST_CASE("MergeBounds ignores empty boxes") {
+    const BoundingBox a = MakeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    const BoundingBox merged = MergeBounds(a, BoundingBox{});
+    CHECK(merged.min == a.min);
+    CHECK(merged.max == a.max);
+}
+
+TEST_CASE("TransformBounds translates and encloses rotated boxes") {
+    const BoundingBox unit = MakeBox({-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f});
+
+    const BoundingBox moved =
+        TransformBounds(unit, glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, 0.0f, 0.0f)));
+    CHECK(moved.min.x == doctest::Approx(4.0f));
+    CHECK(moved.max.x == doctest::Approx(6.0f));
+
+    // A 45-degree turn about Y widens the X/Z extents to sqrt(2).
+    const BoundingBox turned = TransformBounds(
+        unit, glm::rotate(glm::mat4(1.0f), glm::radians(45.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    CHECK(turned.max.x == doctest::Approx(std::sqrt(2.0f)));
+    CHECK(turned.max.z == doctest::Approx(std::sqrt(2.0f)));
+    CHECK(turned.max.y == doctest::Approx(1.0f));
+
+    CHECK(TransformBounds(BoundingBox{}, glm::mat4(1.0f)).IsEmpty());
+}
+
+TEST_CASE("IntersectsFrustum accepts boxes in view and rejects boxes behind the camera") {
+    const glm::mat4 view =
+        glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 proj = glm::perspectiveRH_ZO(glm::radians(90.0f), 1.0f, 0.1f, 50.0f);
+    const Frustum frustum = MakeFrustum(proj * view);
+
+    CHECK(IntersectsFrustum(MakeBox({-1.0f, -1.0f, -11.0f}, {1.0f, 1.0f, -9.0f}), frustum));
+    CHECK_FALSE(IntersectsFrustum(MakeBox({-1.0f, -1.0f, 9.0f}, {1.0f, 1.0f, 11.0f}), frustum));
+    CHECK_FALSE(IntersectsFrustum(MakeBox({30.0f, -1.0f, -11.0f}, {32.0f, 1.0f, -9.0f}), frustum));
+    CHECK_FALSE(IntersectsFrustum(MakeBox({-1.0f, -1.0f, -80.0f}, {1.0f, 1.0f, -60.0f}), frustum));
+    CHECK_FALSE(IntersectsFrustum(BoundingBox{}, frustum));
+}
+
+TEST_CASE("IntersectsFrustum tests spheres, including in an object's local space") {
+    const glm::mat4 view =
+        glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 proj = glm::perspectiveRH_ZO(glm::radians(90.0f), 1.0f, 0.1f, 50.0f);
+    const Frustum frustum = MakeFrustum(proj * view);
+
+    CHECK(IntersectsFrustum(glm::vec3(0.0f, 0.0f, -10.0f), 1.0f, frustum));
+    CHECK_FALSE(IntersectsFrustum(glm::vec3(0.0f, 0.0f, 10.0f), 1.0f, frustum));
+    CHECK(IntersectsFrustum(glm::vec3(0.0f, 0.0f, 0.5f), 1.0f, frustum));
+
+    // Folding an object's transform into the frustum lets its local
+    // bounds be tested as-is.
+    const glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -60.0f));
+    const Frustum local = MakeFrustum(proj * view * model);
+    CHECK_FALSE(IntersectsFrustum(glm::vec3(0.0f), 5.0f, local));
+    CHECK(IntersectsFrustum(glm::vec3(0.0f), 11.0f, local));
+    CHECK(IntersectsFrustum(glm::vec3(0.0f, 0.0f, 20.0f), 1.0f, local));
+}
+
+TEST_CASE("IntersectsSphere measures distance to the nearest point of the box") {
+    const BoundingBox box = MakeBox({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    CHECK(IntersectsSphere(box, {0.5f, 0.5f, 0.5f}, 0.1f));
+    CHECK(IntersectsSphere(box, {3.0f, 0.5f, 0.5f}, 2.0f));
+    CHECK_FALSE(IntersectsSphere(box, {3.0f, 0.5f, 0.5f}, 1.9f));
+    CHECK_FALSE(IntersectsSphere(BoundingBox{}, {0.0f, 0.0f, 0.0f}, 100.0f));
+}
+
+TEST_CASE("ProjectedPixelsPerUnit shrinks with distance under perspective only") {
+    const glm::mat4 view =
+        glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 perspective = glm::perspectiveRH_ZO(glm::radians(90.0f), 1.0f, 0.1f, 50.0f);
+    const BoundingBox near = MakeBox({-1.0f, -1.0f, -11.0f}, {1.0f, 1.0f, -9.0f});
+    const BoundingBox far = MakeBox({-1.0f, -1.0f, -21.0f}, {1.0f, 1.0f, -19.0f});
+
+    // A 90 degree view 100 pixels tall spans 100 pixels over two units
+    // of height at distance 1; the nearest face decides.
+    CHECK(ProjectedPixelsPerUnit(near, perspective * view, 100.0f) ==
+          doctest::Approx(50.0f / 9.0f));
+    CHECK(ProjectedPixelsPerUnit(far, perspective * view, 100.0f) ==
+          doctest::Approx(50.0f / 19.0f));
+    CHECK(ProjectedPixelsPerUnit(MakeBox({-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}),
+              perspective * view,
+              100.0f) == FLT_MAX);
+    CHECK(ProjectedPixelsPerUnit(BoundingBox{}, perspective * view, 100.0f) == 0.0f);
+
+    const glm::mat4 orthographic = glm::orthoRH_ZO(-10.0f, 10.0f, -10.0f, 10.0f, 0.1f, 50.0f);
+    CHECK(ProjectedPixelsPerUnit(near, orthographic * view, 100.0f) == doctest::Approx(5.0f));
+    CHECK(ProjectedPixelsPerUnit(far, orthographic * view, 100.0f) == doctest::Approx(5.0f));
+}
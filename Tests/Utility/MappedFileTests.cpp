@@ -0,0 +1,46 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <doctest/doctest.h>
+
+#include <Lucky/MappedFile.hpp>
+
+using namespace Lucky;
+
+namespace {
+
+std::string WriteTempFile(const char *name, const std::string &contents) {
+    const std::string path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    stream << contents;
+    return path;
+}
+
+} // namespace
+
+TEST_CASE("MappedFile exposes the whole file") {
+    const std::string contents = std::string("mapped\0bytes", 12);
+    const std::string path = WriteTempFile("lucky_mapped_file.bin", contents);
+    {
+        MappedFile file(path);
+        REQUIRE(file.GetSize() == contents.size());
+        CHECK(std::memcmp(file.GetData(), contents.data(), contents.size()) == 0);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("MappedFile maps an empty file to nothing and rejects a missing one") {
+    const std::string path = WriteTempFile("lucky_mapped_empty.bin", "");
+    {
+        MappedFile file(path);
+        CHECK(file.GetSize() == 0);
+        CHECK(file.GetData() == nullptr);
+    }
+    std::remove(path.c_str());
+
+    CHECK_THROWS_AS(MappedFile{path}, std::runtime_error);
+}
@@ -0,0 +1,86 @@
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <glm/glm.hpp>
+
+#include <Lucky/SimulationThread.hpp>
+
+using namespace Lucky;
+
+TEST_CASE("SimulationThread publishes each step one Step call later") {
+    int steps = 0;
+    std::thread::id simulationThreadId;
+    SimulationThread simulation([&](float deltaSeconds, FrameSnapshot &snapshot) {
+        snapshot.Clear();
+        steps++;
+        simulationThreadId = std::this_thread::get_id();
+        snapshot.scene.ambientColor = glm::vec3(static_cast<float>(steps), deltaSeconds, 0.0f);
+    });
+    CHECK(simulation.GetRenderSnapshot() == nullptr);
+
+    simulation.Step(0.5f);
+    CHECK(simulation.GetRenderSnapshot() == nullptr);
+
+    simulation.Step(0.25f);
+    const FrameSnapshot *first = simulation.GetRenderSnapshot();
+    REQUIRE(first != nullptr);
+    CHECK(first->scene.ambientColor.x == 1.0f);
+    CHECK(first->scene.ambientColor.y == 0.5f);
+
+    // The second step wrote the other snapshot, so the first stayed
+    // intact while it ran.
+    simulation.Step(0.125f);
+    const FrameSnapshot *second = simulation.GetRenderSnapshot();
+    REQUIRE(second != nullptr);
+    CHECK(second != first);
+    CHECK(second->scene.ambientColor.x == 2.0f);
+    CHECK(second->scene.ambientColor.y == 0.25f);
+
+    simulation.Wait();
+    CHECK(steps == 3);
+    CHECK(simulationThreadId != std::this_thread::get_id());
+}
+
+TEST_CASE("SimulationThread rethrows a failed step from the next Step") {
+    bool fail = true;
+    SimulationThread simulation([&](float, FrameSnapshot &) {
+        if (fail) {
+            throw std::runtime_error("step failed");
+        }
+    });
+    simulation.Step(0.0f);
+    CHECK_THROWS_AS(simulation.Step(0.0f), std::runtime_error);
+    CHECK(simulation.GetRenderSnapshot() == nullptr);
+
+    fail = false;
+    simulation.Step(0.0f);
+    simulation.Step(0.0f);
+    CHECK(simulation.GetRenderSnapshot() != nullptr);
+}
+
+TEST_CASE("FrameSnapshot owns the joint palettes it captures") {
+    std::vector<glm::mat4> joints(3, glm::mat4(1.0f));
+    Scene3D scene;
+    SkinnedSceneObject skinned;
+    skinned.jointMatrices = &joints;
+    scene.skinnedObjects.push_back(skinned);
+    scene.skinnedObjects.push_back(SkinnedSceneObject{});
+
+    FrameSnapshot snapshot;
+    snapshot.CaptureScene(scene);
+    joints[0][3].x = 5.0f;
+
+    REQUIRE(snapshot.scene.skinnedObjects.size() == 2);
+    const std::vector<glm::mat4> *captured = snapshot.scene.skinnedObjects[0].jointMatrices;
+    REQUIRE(captured != nullptr);
+    CHECK(captured != &joints);
+    CHECK(captured->size() == 3);
+    CHECK((*captured)[0][3].x == 0.0f);
+    CHECK(snapshot.scene.skinnedObjects[1].jointMatrices == nullptr);
+
+    snapshot.Clear();
+    CHECK(snapshot.scene.skinnedObjects.empty());
+}
@@ -0,0 +1,82 @@
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <Lucky/ThreadPool.hpp>
+
+using namespace Lucky;
+
+TEST_CASE("ThreadPool starts at least one worker") {
+    ThreadPool pool;
+    CHECK(pool.GetWorkerCount() >= 1);
+
+    ThreadPool two(2);
+    CHECK(two.GetWorkerCount() == 2);
+}
+
+TEST_CASE("ParallelFor visits every index exactly once in grain-sized ranges") {
+    ThreadPool pool(3);
+    std::vector<std::atomic<int>> visits(1000);
+    std::atomic<uint32_t> oversized{0};
+
+    pool.ParallelFor(1000, 7, [&](uint32_t begin, uint32_t end) {
+        if (end - begin > 7) {
+            oversized++;
+        }
+        for (uint32_t i = begin; i < end; i++) {
+            visits[i]++;
+        }
+    });
+
+    CHECK(oversized == 0);
+    for (const std::atomic<int> &count : visits) {
+        CHECK(count == 1);
+    }
+}
+
+TEST_CASE("ParallelFor with nothing to do never calls the body") {
+    ThreadPool pool(2);
+    bool called = false;
+    pool.ParallelFor(0, 4, [&](uint32_t, uint32_t) { called = true; });
+    CHECK_FALSE(called);
+}
+
+TEST_CASE("ParallelFor can run inside a submitted task") {
+    ThreadPool pool(2);
+    std::atomic<uint32_t> sum{0};
+    std::future<void> done = pool.Submit([&] {
+        pool.ParallelFor(100, 10, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                sum += i;
+            }
+        });
+    });
+    done.get();
+    CHECK(sum == 4950);
+}
+
+TEST_CASE("ParallelFor rethrows the body's exception after all chunks finish") {
+    ThreadPool pool(2);
+    std::atomic<uint32_t> finished{0};
+    CHECK_THROWS_AS(pool.ParallelFor(8,
+                        1,
+                        [&](uint32_t begin, uint32_t) {
+                            finished++;
+                            if (begin == 3) {
+                                throw std::runtime_error("chunk failed");
+                            }
+                        }),
+        std::runtime_error);
+    CHECK(finished == 8);
+}
+
+TEST_CASE("Submit runs the task and reports completion through the future") {
+    ThreadPool pool(1);
+    std::atomic<bool> ran{false};
+    pool.Submit([&] { ran = true; }).get();
+    CHECK(ran);
+}